@@ -32,6 +32,7 @@ from pandas.types.missing import isnull
 import pandas.core.common as com
 import pandas.algos as algos
 import pandas.hashtable as htable
+from pandas.core.config import get_option
 from pandas.compat import string_types
 from pandas.tslib import iNaT
 
@@ -299,14 +300,36 @@ def factorize(values, sort=False, order=None, na_sentinel=-1, size_hint=None):
     is_timedelta = is_timedelta64_dtype(vals)
     (hash_klass, vec_klass), vals = _get_data_algo(vals, _hashtables)
 
-    table = hash_klass(size_hint or len(vals))
-    uniques = vec_klass()
-    labels = table.get_labels(vals, uniques, 0, na_sentinel, True)
+    strings = None
+    if hash_klass is htable.PyObjectHashTable:
+        strings = htable.factorize_strings(vals, check_null=True)
+
+    if strings is not None:
+        labels, first = strings
+        if na_sentinel != -1:
+            labels[labels == -1] = na_sentinel
+        uniques = vals.take(first)
+    elif hash_klass is not htable.PyObjectHashTable:
+        # numeric values are factorized in their own type, addressing small
+        # ranges of integers directly
+        if is_float_dtype(vals):
+            mask = vals != vals
+        elif vals.dtype == np.int64:
+            mask = vals == iNaT
+        else:
+            mask = None
+        f = getattr(htable, 'factorize_' + vals.dtype.name)
+        labels, uniques = f(vals, mask, na_sentinel,
+                            get_option('compute.factorize_threads'))
+        uniques = _upcast_numeric(uniques)
+    else:
+        table = hash_klass(size_hint or len(vals))
+        uniques = vec_klass()
+        labels = table.get_labels(vals, uniques, 0, na_sentinel, True)
+        uniques = uniques.to_array()
 
     labels = _ensure_platform_int(labels)
 
-    uniques = uniques.to_array()
-
     if sort and len(uniques) > 0:
         uniques, labels = safe_sort(uniques, labels, na_sentinel=na_sentinel,
                                     assume_unique=True)
@@ -429,12 +452,10 @@ def _value_counts_arraylike(values, dropna=True):
         if is_period_type:
             keys = PeriodIndex._simple_new(keys, freq=freq)
 
-    elif is_integer_dtype(dtype):
-        values = _ensure_int64(values)
-        keys, counts = htable.value_count_int64(values, dropna)
-    elif is_float_dtype(dtype):
-        values = _ensure_float64(values)
-        keys, counts = htable.value_count_float64(values, dropna)
+    elif is_integer_dtype(dtype) or is_float_dtype(dtype):
+        f, values = _get_numeric_hashtable_func(values, 'value_count')
+        keys, counts = f(values, dropna)
+        keys = _upcast_numeric(keys)
     else:
         values = _ensure_object(values)
         mask = isnull(values)
@@ -479,12 +500,10 @@ def duplicated(values, keep='first'):
     elif isinstance(values, (ABCSeries, ABCIndex)):
         values = values.values
 
-    if is_integer_dtype(dtype):
-        values = _ensure_int64(values)
-        duplicated = htable.duplicated_int64(values, keep=keep)
-    elif is_float_dtype(dtype):
-        values = _ensure_float64(values)
-        duplicated = htable.duplicated_float64(values, keep=keep)
+    # the converted values, such as categorical codes, are integers
+    if is_integer_dtype(values) or is_float_dtype(values):
+        f, values = _get_numeric_hashtable_func(values, 'duplicated')
+        duplicated = f(values, keep=keep)
     else:
         values = _ensure_object(values)
         duplicated = htable.duplicated_object(values, keep=keep)
@@ -747,13 +766,60 @@ def _hashtable_algo(f, dtype, return_dtype=None):
 
 _hashtables = {
     'float64': (htable.Float64HashTable, htable.Float64Vector),
+    'float32': (htable.Float32HashTable, htable.Float32Vector),
     'int64': (htable.Int64HashTable, htable.Int64Vector),
+    'int32': (htable.Int32HashTable, htable.Int32Vector),
+    'int16': (htable.Int16HashTable, htable.Int16Vector),
+    'int8': (htable.Int8HashTable, htable.Int8Vector),
+    'uint64': (htable.UInt64HashTable, htable.UInt64Vector),
+    'uint32': (htable.UInt32HashTable, htable.UInt32Vector),
+    'uint16': (htable.UInt16HashTable, htable.UInt16Vector),
+    'uint8': (htable.UInt8HashTable, htable.UInt8Vector),
     'generic': (htable.PyObjectHashTable, htable.ObjectVector)
 }
 
 
-def _get_data_algo(values, func_map):
+def _has_native_algo(values, names):
+    """
+    Whether the numeric values can be passed as they are to the algorithm
+    for their dtype among names, which takes a writeable native-endian array
+    """
+    if not isinstance(values, np.ndarray):
+        return False
+    dtype = values.dtype
+    return (dtype.name in names and
+            (is_integer_dtype(dtype) or is_float_dtype(dtype)) and
+            dtype.isnative and values.flags.writeable)
+
+
+def _get_numeric_hashtable_func(values, name):
+    """
+    The hashtable function `name` for the dtype of the integer or float
+    values, which are converted to int64 or float64 if it has none
+    """
+    if not _has_native_algo(values, _hashtables):
+        if is_float_dtype(values):
+            values = _ensure_float64(values)
+        else:
+            values = _ensure_int64(values)
+    return getattr(htable, '%s_%s' % (name, values.dtype.name)), values
+
+
+def _upcast_numeric(values):
+    """
+    Integer or float results computed in a narrower type, converted to the
+    int64 or float64 they have always been returned as
+    """
     if is_float_dtype(values):
+        return _ensure_float64(values)
+    return _ensure_int64(values)
+
+
+def _get_data_algo(values, func_map):
+    if _has_native_algo(values, func_map):
+        f = func_map[values.dtype.name]
+
+    elif is_float_dtype(values):
         f = func_map['float64']
         values = _ensure_float64(values)
 
@@ -395,6 +395,17 @@ with cf.config_prefix('mode'):
     cf.register_option('chained_assignment', 'warn', chained_assignment,
                        validator=is_one_of_factory([None, 'warn', 'raise']))
 
+factorize_threads_doc = """
+: int
+    The number of threads used to factorize large int64 and float64 arrays,
+    as in pd.factorize and when computing the group keys of a groupby.
+    The threads are only used on arrays of more than about a million values
+"""
+
+with cf.config_prefix('compute'):
+    cf.register_option('factorize_threads', 1, factorize_threads_doc,
+                       validator=is_int)
+
 # Set up the io.excel specific configuration.
 writer_engine_doc = """
 : string
@@ -51,7 +51,7 @@ from pandas.util.validators import validate_kwargs
 
 import pandas.core.algorithms as algos
 import pandas.core.common as com
-from pandas.core.config import option_context
+from pandas.core.config import option_context, get_option
 import pandas.lib as lib
 from pandas.lib import Timestamp
 import pandas.tslib as tslib
@@ -4405,13 +4405,17 @@ def _compress_group_index(group_index, sort=True):
     (comp_ids) into the list of unique labels (obs_group_ids).
     """
 
-    size_hint = min(len(group_index), _hash._SIZE_HINT_LIMIT)
-    table = _hash.Int64HashTable(size_hint)
-
     group_index = _ensure_int64(group_index)
 
     # note, group labels come out ascending (ie, 1,2,3 etc)
-    comp_ids, obs_group_ids = table.get_labels_groupby(group_index)
+    nthreads = get_option('compute.factorize_threads')
+    if nthreads > 1:
+        comp_ids, obs_group_ids = _hash.factorize_int64(
+            group_index, group_index < 0, -1, nthreads)
+    else:
+        size_hint = min(len(group_index), _hash._SIZE_HINT_LIMIT)
+        table = _hash.Int64HashTable(size_hint)
+        comp_ids, obs_group_ids = table.get_labels_groupby(group_index)
 
     if sort and len(obs_group_ids) > 0:
         obs_group_ids, comp_ids = _reorder_by_uniques(obs_group_ids, comp_ids)
@@ -1,21 +1,75 @@
-from khash cimport kh_int64_t, kh_float64_t, kh_pymap_t, int64_t, float64_t
+from khash cimport kh_pymap_t
+from numpy cimport (int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t,
+                    uint32_t, uint64_t, float32_t, float64_t)
+from swisstable cimport (swiss_int8_t, swiss_int16_t, swiss_int32_t,
+                         swiss_int64_t, swiss_uint8_t, swiss_uint16_t,
+                         swiss_uint32_t, swiss_uint64_t, swiss_float32_t,
+                         swiss_float64_t)
 
 # prototypes for sharing
 
 cdef class HashTable:
     pass
 
+cdef class Float64HashTable(HashTable):
+    cdef swiss_float64_t *table
+
+    cpdef get_item(self, float64_t val)
+    cpdef set_item(self, float64_t key, Py_ssize_t val)
+
+cdef class Float32HashTable(HashTable):
+    cdef swiss_float32_t *table
+
+    cpdef get_item(self, float32_t val)
+    cpdef set_item(self, float32_t key, Py_ssize_t val)
+
 cdef class Int64HashTable(HashTable):
-    cdef kh_int64_t *table
+    cdef swiss_int64_t *table
 
     cpdef get_item(self, int64_t val)
     cpdef set_item(self, int64_t key, Py_ssize_t val)
 
-cdef class Float64HashTable(HashTable):
-    cdef kh_float64_t *table
+cdef class Int32HashTable(HashTable):
+    cdef swiss_int32_t *table
 
-    cpdef get_item(self, float64_t val)
-    cpdef set_item(self, float64_t key, Py_ssize_t val)
+    cpdef get_item(self, int32_t val)
+    cpdef set_item(self, int32_t key, Py_ssize_t val)
+
+cdef class Int16HashTable(HashTable):
+    cdef swiss_int16_t *table
+
+    cpdef get_item(self, int16_t val)
+    cpdef set_item(self, int16_t key, Py_ssize_t val)
+
+cdef class Int8HashTable(HashTable):
+    cdef swiss_int8_t *table
+
+    cpdef get_item(self, int8_t val)
+    cpdef set_item(self, int8_t key, Py_ssize_t val)
+
+cdef class UInt64HashTable(HashTable):
+    cdef swiss_uint64_t *table
+
+    cpdef get_item(self, uint64_t val)
+    cpdef set_item(self, uint64_t key, Py_ssize_t val)
+
+cdef class UInt32HashTable(HashTable):
+    cdef swiss_uint32_t *table
+
+    cpdef get_item(self, uint32_t val)
+    cpdef set_item(self, uint32_t key, Py_ssize_t val)
+
+cdef class UInt16HashTable(HashTable):
+    cdef swiss_uint16_t *table
+
+    cpdef get_item(self, uint16_t val)
+    cpdef set_item(self, uint16_t key, Py_ssize_t val)
+
+cdef class UInt8HashTable(HashTable):
+    cdef swiss_uint8_t *table
+
+    cpdef get_item(self, uint8_t val)
+    cpdef set_item(self, uint8_t key, Py_ssize_t val)
 
 cdef class PyObjectHashTable(HashTable):
     cdef kh_pymap_t *table
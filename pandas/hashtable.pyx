@@ -3,8 +3,11 @@
 from cpython cimport PyObject, Py_INCREF, PyList_Check, PyTuple_Check
 
 from khash cimport *
+from swisstable cimport *
 from numpy cimport *
 from cpython cimport PyMem_Malloc, PyMem_Realloc, PyMem_Free
+from libc.stdlib cimport free
+from libc.string cimport memcpy
 
 from util cimport _checknan
 cimport util
@@ -15,6 +18,9 @@ nan = np.nan
 cdef extern from "numpy/npy_math.h":
     double NAN "NPY_NAN"
 
+cdef extern from "headers/stdint.h":
+    enum: INT32_MAX
+
 cimport cython
 cimport numpy as cnp
 
@@ -113,6 +119,67 @@ cdef class Int64Factorizer:
         return labels
 
 
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_strings(ndarray[object] values, object mask=None,
+                      bint check_null=False):
+    """
+    Factorize an array of str (bytes str on Python 2) by their UTF-8 bytes,
+    without hashing or comparing them as Python objects
+
+    Returns
+    -------
+    labels : ndarray[int64]
+        -1 where mask is True and, if check_null, for None and NaN
+    first : ndarray[int64]
+        position of the first occurrence of each distinct value
+
+    or None if some other value is not exactly a str
+    """
+    cdef:
+        Py_ssize_t i, length, n = len(values)
+        const char *key
+        int64_t count = 0, prior, label
+        ndarray[int64_t] labels = np.empty(n, dtype=np.int64)
+        ndarray[uint8_t, cast=True] skip
+        bint has_mask = mask is not None
+        Int64Vector first = Int64Vector()
+        swiss_bytes_t *table
+        object val
+
+    if has_mask:
+        skip = np.asarray(mask, dtype=np.bool_)
+
+    table = swiss_bytes_new(min(n, _SIZE_HINT_LIMIT))
+    if table is NULL:
+        raise MemoryError()
+    try:
+        for i in range(n):
+            if has_mask and skip[i]:
+                labels[i] = -1
+                continue
+
+            val = values[i]
+            key = util.get_string_key(val, &length)
+            if key is NULL:
+                if check_null and (val is None or val != val):
+                    labels[i] = -1
+                    continue
+                return None
+
+            prior = count
+            if swiss_bytes_get_or_insert(table, key, length, &count,
+                                         &label) != 0:
+                raise MemoryError()
+            if count != prior:
+                first.append(i)
+            labels[i] = label
+    finally:
+        swiss_bytes_free(table)
+
+    return labels, first.to_array()
+
+
 @cython.wraparound(False)
 @cython.boundscheck(False)
 cdef build_count_table_object(ndarray[object] values,
@@ -147,6 +214,12 @@ cpdef value_count_object(ndarray[object] values,
         kh_pymap_t *table
         int k
 
+    strings = factorize_strings(values, mask)
+    if strings is not None:
+        labels, first = strings
+        counts = np.bincount(labels[labels >= 0], minlength=len(first))
+        return values.take(first), counts.astype(np.int64)
+
     table = kh_init_pymap()
     build_count_table_object(values, mask, table)
 
@@ -195,39 +268,11 @@ def mode_object(ndarray[object] values, ndarray[uint8_t, cast=True] mask):
     return modes[:j + 1]
 
 
-@cython.wraparound(False)
-@cython.boundscheck(False)
 def mode_int64(int64_t[:] values):
-    cdef:
-        int count, max_count = 2
-        int j = -1 # so you can do +=
-        int k
-        kh_int64_t *table
-        ndarray[int64_t] modes
-
-    table = kh_init_int64()
-
-    build_count_table_int64(values, table, 0)
-
-    modes = np.empty(table.n_buckets, dtype=np.int64)
-
-    with nogil:
-        for k in range(table.n_buckets):
-            if kh_exist_int64(table, k):
-                count = table.vals[k]
-
-                if count == max_count:
-                    j += 1
-                elif count > max_count:
-                    max_count = count
-                    j = 0
-                else:
-                    continue
-                modes[j] = table.keys[k]
-
-    kh_destroy_int64(table)
-
-    return modes[:j + 1]
+    keys, counts = value_count_int64(values, False)
+    if len(counts) == 0 or counts.max() < 2:
+        return keys[:0]
+    return keys[counts == counts.max()]
 
 
 @cython.wraparound(False)
@@ -238,6 +283,10 @@ def duplicated_object(ndarray[object] values, object keep='first'):
         dict seen = dict()
         object row
 
+    strings = factorize_strings(values)
+    if strings is not None:
+        return duplicated_int64(strings[0], keep)
+
     n = len(values)
     cdef ndarray[uint8_t] result = np.zeros(n, dtype=np.uint8)
 
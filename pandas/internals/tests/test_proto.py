@@ -74,3 +74,21 @@ class TestLibPandas(tm.TestCase):
 
         result[0] = 12
         assert result[0] == 12
+
+    def test_string_array_from_buffers(self):
+        offsets = np.array([0, 3, 3, 3, 7], dtype=np.int32)
+        data = np.frombuffer(u'foobär'.encode('utf8'), dtype=np.uint8)
+        result = lib.string_array(offsets, data,
+                                  mask=np.array([0, 0, 1, 0], dtype=bool))
+
+        assert len(result) == 4
+        assert result.dtype.name == 'string'
+        assert result[0] == u'foo'
+        assert result[1] == u''
+        assert result[2] is NA
+        assert result[3] == u'bär'
+
+        # offsets past the end of the data
+        offsets[-1] = 8
+        self.assertRaises(lib.CPandasBadStatus, lib.string_array, offsets,
+                          data)
@@ -200,9 +200,8 @@ decimal : str, default '.'
     Character to recognize as decimal point (e.g. use ',' for European data).
 float_precision : string, default None
     Specifies which converter the C engine should use for floating-point
-    values. The options are `None` for the ordinary converter,
-    `high` for the high-precision converter, and `round_trip` for the
-    round-trip converter.
+    values. The options are `None` or `high` for the ordinary converter,
+    which is correctly rounded, and `round_trip` for Python's converter.
 lineterminator : str (length 1), default None
     Character to break file into lines. Only valid with C parser.
 quotechar : str (length 1), optional
@@ -270,6 +269,25 @@ memory_map : boolean, default False
     If a filepath is provided for `filepath_or_buffer`, map the file object
     directly onto memory and access the data directly from there. Using this
     option can improve performance because there is no longer any I/O overhead.
+    When the whole file is read at once with the C engine, the parser's
+    buffers are also sized for the file up front instead of being grown as
+    it is tokenized.
+tokenize_threads : int, default 1
+    Number of threads used to tokenize a memory mapped file with the C engine.
+    Only applies when the whole file is read at once (``memory_map=True``,
+    ``low_memory=False`` and no `chunksize` or `nrows`) and no `escapechar`,
+    `comment` or rows to skip after the header are given; otherwise the file
+    is tokenized on a single thread.
+tokenize_dtypes : boolean, default False
+    With the C engine, convert the columns whose `dtype` is int64, float64 or
+    bool while the file is tokenized instead of keeping each field as a
+    string until the column is converted. A value that does not parse as the
+    column's type raises instead of falling back to type inference.
+read_ahead : int, default 0
+    With the C engine, number of chunks to read ahead of the tokenizer on a
+    background thread, so that reading and decompressing the input overlap
+    with parsing it. 0 reads each chunk when the tokenizer needs it. Has no
+    effect with `memory_map`.
 
 Returns
 -------
@@ -457,6 +475,9 @@ _c_parser_defaults = {
     'use_unsigned': False,
     'low_memory': True,
     'memory_map': False,
+    'tokenize_threads': 1,
+    'tokenize_dtypes': False,
+    'read_ahead': 0,
     'buffer_lines': None,
     'error_bad_lines': True,
     'warn_bad_lines': True,
@@ -473,6 +494,9 @@ _c_unsupported = set(['skipfooter'])
 _python_unsupported = set([
     'low_memory',
     'buffer_lines',
+    'tokenize_threads',
+    'tokenize_dtypes',
+    'read_ahead',
     'error_bad_lines',
     'warn_bad_lines',
     'dtype',
@@ -560,6 +584,9 @@ def _make_parser_function(name, sep=','):
                  low_memory=_c_parser_defaults['low_memory'],
                  buffer_lines=None,
                  memory_map=False,
+                 tokenize_threads=1,
+                 tokenize_dtypes=False,
+                 read_ahead=0,
                  float_precision=None):
 
         # Alias sep -> delimiter.
@@ -626,6 +653,9 @@ def _make_parser_function(name, sep=','):
                     encoding=encoding,
                     squeeze=squeeze,
                     memory_map=memory_map,
+                    tokenize_threads=tokenize_threads,
+                    tokenize_dtypes=tokenize_dtypes,
+                    read_ahead=read_ahead,
                     float_precision=float_precision,
 
                     na_filter=na_filter,
@@ -1454,12 +1484,13 @@ class CParserWrapper(ParserBase):
         self._implicit_index = self._reader.leading_cols > 0
 
     def close(self):
-        for f in self.handles:
-            f.close()
+        # the reader may be reading ahead from the handles
         try:
             self._reader.close()
         except:
             pass
+        for f in self.handles:
+            f.close()
 
     def _set_noconvert_columns(self):
         names = self.orig_names
@@ -1659,9 +1690,8 @@ def TextParser(*args, **kwds):
         can be inferred, there often will be a large parsing speed-up.
     float_precision : string, default None
         Specifies which converter the C engine should use for floating-point
-        values. The options are None for the ordinary converter,
-        'high' for the high-precision converter, and 'round_trip' for the
-        round-trip converter.
+        values. The options are None or 'high' for the ordinary converter,
+        which is correctly rounded, and 'round_trip' for Python's converter.
     """
     kwds['engine'] = 'python'
     return TextFileReader(*args, **kwds)
@@ -178,6 +178,52 @@ nan 2
         self.assertTrue(sum(precise_errors) <= sum(normal_errors))
         self.assertTrue(max(precise_errors) <= max(normal_errors))
 
+    def test_exact_conversion(self):
+        # halfway cases, long mantissas and subnormals
+        values = ['0.1', '1e23', '9007199254740993', '2.2250738585072011e-308',
+                  '4.9406564584124654e-324', '1.7976931348623157e308',
+                  '0.3066101993807095471566981359501369297504425048828125',
+                  '1.00000000000000011102230246251565404236316680908203125',
+                  '1.000000000000000111022302462515654042363166809082031251',
+                  '-123456789012345678901234567890e-40', '7.0e-10']
+        data = 'a\n' + '\n'.join(values)
+        expected = [float(v) for v in values]
+
+        for precision in [None, 'high']:
+            result = self.read_csv(StringIO(data), float_precision=precision)
+            self.assertEqual(result['a'].tolist(), expected)
+
+        data = 'a\n' + '\n'.join(v.replace('.', ',') for v in values)
+        result = self.read_csv(StringIO(data), decimal=',')
+        self.assertEqual(result['a'].tolist(), expected)
+
+        data = 'a;b\n1.234.567,890123456789012345678901;1e400'
+        result = self.read_csv(StringIO(data), sep=';', decimal=',',
+                               thousands='.')
+        self.assertEqual(result['a'][0], 1234567.890123456789012345678901)
+        self.assertEqual(result['b'][0], '1e400')
+
+    def test_int64_digit_counts(self):
+        # integers are parsed 8 digits at a time up to 18 digits, and one
+        # digit at a time past that or with a thousands separator
+        values = [int('9' * n) for n in range(1, 19)]
+        values += [int('1' + '0' * n) for n in range(8, 18)]
+        values += [2**63 - 1, -2**63, -int('9' * 18), 0]
+        values += [int('123456789' * 2)]
+
+        data = 'a\n' + '\n'.join(str(v) for v in values)
+        result = self.read_csv(StringIO(data))
+        self.assertEqual(result['a'].dtype, np.int64)
+        self.assertEqual(result['a'].tolist(), values)
+
+        data = 'a\n' + '\n'.join(format(v, ',') for v in values)
+        result = self.read_csv(StringIO(data), thousands=',')
+        self.assertEqual(result['a'].tolist(), values)
+
+        # overflow is still detected on the long path
+        result = self.read_csv(StringIO('a\n' + str(2**63)))
+        self.assertEqual(result['a'][0], str(2**63))
+
     def test_pass_dtype(self):
         data = """\
 one,two
@@ -561,3 +607,166 @@ No,No,No"""
 
         result = self.read_csv(StringIO(data), names=names)
         tm.assert_frame_equal(result, expected)
+
+    def test_long_unquoted_fields(self):
+        # Runs of ordinary characters are copied in bulk, so check fields
+        # longer than the 16-byte scan width that end in every kind of
+        # special character
+        long_a = 'a' * 37
+        long_b = 'b' * 16
+        data = ('{a},{b}\\,x,1\r\n'
+                '{b}{a},2 # {a}\n'
+                '{a}\\\\,{b}\r'
+                '{b}z,4').format(a=long_a, b=long_b)
+        result = self.read_csv(StringIO(data), header=None, dtype=object,
+                               escapechar='\\', comment='#')
+        expected = DataFrame([[long_a, long_b + ',x', '1'],
+                              [long_b + long_a, '2 ', np.nan],
+                              [long_a + '\\', long_b, np.nan],
+                              [long_b + 'z', '4', np.nan]])
+        tm.assert_frame_equal(result, expected)
+
+    def test_tokenize_threads(self):
+        # Large enough to be split into several ranges, with line terminators
+        # inside quotes and quote characters inside unquoted fields near the
+        # range boundaries
+        row = '{0},"multi\nline {0}",x{0}y,"a,""b"""\n'
+        data = 'a,b,c,d\n' + ''.join(row.format(i) for i in range(80000))
+        data += '1,2,"tail"c,"\n3"'
+
+        with tm.ensure_clean('__tokenize_threads__.csv') as path:
+            with open(path, 'w') as f:
+                f.write(data)
+
+            expected = self.read_csv(path)
+            for nthreads in [2, 3, 8]:
+                result = self.read_csv(path, memory_map=True,
+                                       tokenize_threads=nthreads)
+                tm.assert_frame_equal(result, expected)
+
+            # literal quotes throw off the guessed record boundaries
+            with open(path, 'w') as f:
+                f.write(data.replace('y,', '"y,'))
+            expected = self.read_csv(path)
+            result = self.read_csv(path, memory_map=True, tokenize_threads=4)
+            tm.assert_frame_equal(result, expected)
+
+    def test_memory_map_presized(self):
+        # The buffers are sized from samples of the file, which must not
+        # matter when the samples are off: rows getting wider towards the
+        # end, and a quoted field with many line terminators that samples
+        # can start inside of
+        rows = ['{0},"x\n{0}"\n'.format(i) for i in range(40000)]
+        rows += ['{0},"{1}"\n'.format(i, 'y,' * (i % 50)) for i in range(40000)]
+        rows.insert(20000, '0,"{0}"\n'.format('\n,' * 300000))
+        data = 'a,b\n' + ''.join(rows)
+
+        with tm.ensure_clean('__memory_map_presized__.csv') as path:
+            with open(path, 'w') as f:
+                f.write(data)
+
+            expected = self.read_csv(path)
+            result = self.read_csv(path, memory_map=True)
+            tm.assert_frame_equal(result, expected)
+            self.assertEqual(len(result), 80001)
+
+    def test_read_ahead(self):
+        # several chunks of the default tokenize_chunksize
+        row = '{0},"quoted\n{0}",{0}.5\n'
+        data = 'a,b,c\n' + ''.join(row.format(i) for i in range(50000))
+        expected = self.read_csv(StringIO(data))
+
+        for read_ahead in [1, 3]:
+            result = self.read_csv(StringIO(data), read_ahead=read_ahead)
+            tm.assert_frame_equal(result, expected)
+
+            reader = self.read_csv(StringIO(data), read_ahead=read_ahead,
+                                   chunksize=7000)
+            tm.assert_frame_equal(pd.concat(reader), expected)
+
+        with tm.ensure_clean('__read_ahead__.csv.gz') as path:
+            import gzip
+            with gzip.GzipFile(path, 'wb') as f:
+                f.write(data.encode('ascii'))
+
+            result = self.read_csv(path, compression='gzip', read_ahead=2)
+            tm.assert_frame_equal(result, expected)
+
+            # stopped with reads still pending
+            reader = self.read_csv(path, compression='gzip', read_ahead=2,
+                                   chunksize=10)
+            tm.assert_frame_equal(reader.get_chunk(), expected[:10])
+            reader.close()
+
+        # the exception of a failed read is raised by read_csv
+        class FailingReader(object):
+            def __init__(self):
+                self.reads = 0
+
+            def read(self, nbytes):
+                self.reads += 1
+                if self.reads > 2:
+                    raise ValueError('read failed')
+                return 'a,b\n' + '1,2\n' * 100000
+
+        with tm.assertRaisesRegexp(ValueError, 'read failed'):
+            self.read_csv(FailingReader(), read_ahead=2)
+
+    def test_gzip_path(self):
+        # gzip files given by path are decompressed by the parser itself
+        import gzip
+
+        data = 'a,b\n' + ''.join('{0},x{0}\n'.format(i) for i in range(30000))
+        expected = self.read_csv(StringIO(data))
+
+        with tm.ensure_clean('__gzip_path__.csv.gz') as path:
+            # concatenated members read as one file
+            with open(path, 'wb') as f:
+                for part in [data[:1000], data[1000:]]:
+                    buf = compat.BytesIO()
+                    with gzip.GzipFile(fileobj=buf, mode='wb') as gz:
+                        gz.write(part.encode('ascii'))
+                    f.write(buf.getvalue())
+
+            result = self.read_csv(path, compression='gzip')
+            tm.assert_frame_equal(result, expected)
+
+            with open(path, 'rb') as f:
+                compressed = f.read()
+            with open(path, 'wb') as f:
+                f.write(compressed[:len(compressed) // 2])
+            with tm.assertRaisesRegexp(IOError, 'unexpected end of file'):
+                self.read_csv(path, compression='gzip')
+
+            with open(path, 'wb') as f:
+                f.write(data.encode('ascii'))
+            with tm.assertRaisesRegexp(IOError, 'Not a gzipped file'):
+                self.read_csv(path, compression='gzip')
+
+    def test_tokenize_dtypes(self):
+        data = ('a,b,c,d\n'
+                '1,2.5,True,x\n'
+                '2,NA,false,y\n'
+                '3,inf,TRUE,\n'
+                '-4,,False,z\n'
+                '5,1e3\n')
+        dtype = {'a': 'int64', 'b': 'float64', 'c': 'bool', 'd': object}
+        expected = self.read_csv(StringIO(data), dtype=dtype)
+        result = self.read_csv(StringIO(data), dtype=dtype,
+                               tokenize_dtypes=True)
+        tm.assert_frame_equal(result, expected)
+
+        result = self.read_csv(StringIO(data), dtype=dtype,
+                               tokenize_dtypes=True, chunksize=2)
+        tm.assert_frame_equal(pd.concat(result), expected)
+
+        # without falling back to inference for values that do not parse
+        with tm.assertRaisesRegexp(ValueError,
+                                   "Unable to parse 'x' as int64"):
+            self.read_csv(StringIO(data), dtype={'d': 'int64'},
+                          tokenize_dtypes=True)
+
+        with tm.assertRaisesRegexp(ValueError,
+                                   'Integer column has NA values'):
+            self.read_csv(StringIO('a\n1\nNA\n'), dtype='int64',
+                          tokenize_dtypes=True)
@@ -332,6 +332,32 @@ a,b,c
         self.assertTrue((result[1] == exp[1]).all())
         self.assertTrue((result[2] == exp[2]).all())
 
+    def test_native_string_storage(self):
+        try:
+            import pandas.native  # noqa
+        except ImportError:
+            raise nose.SkipTest('libpandas native module not built')
+
+        data = u'a,b,c\n1,foo,x\n2,NA,\n3,bär,z\n4,,w'
+        reader = TextReader(StringIO(data), delimiter=',',
+                            string_storage='native')
+        result = reader.read()
+
+        # numeric columns are unaffected
+        self.assert_numpy_array_equal(result[0], np.arange(1, 5))
+        strings = result[1]
+        self.assertEqual(len(strings), 4)
+        self.assertEqual(strings.dtype.name, 'string')
+        self.assertEqual(strings[0], 'foo')
+        self.assertTrue(pandas.native.isnull(strings[1]))
+        self.assertEqual(strings[2], u'bär')
+        self.assertTrue(pandas.native.isnull(strings[3]))
+
+        self.assertRaises(ValueError, TextReader, StringIO(data),
+                          string_storage='native', low_memory=True)
+        self.assertRaises(ValueError, TextReader, StringIO(data),
+                          string_storage='arrow')
+
     def test_cr_delimited(self):
         def _test(text, **kwargs):
             nice_text = text.replace('\r', '\r\n')
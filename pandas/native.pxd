@@ -18,6 +18,7 @@ from libc.stdint cimport *
 from libcpp cimport bool as c_bool
 from libcpp.string cimport string
 from libcpp.vector cimport vector
+from libcpp.map cimport map
 from libcpp.memory cimport shared_ptr
 
 from cpython cimport PyObject
@@ -63,6 +64,7 @@ cdef extern from "pandas/api.h" namespace "pandas::DataType":
         TypeId_CATEGORY " pandas::DataType::TypeId::CATEGORY"
         TypeId_TIMESTAMP " pandas::DataType::TypeId::TIMESTAMP"
         TypeId_TIMESTAMP_TZ " pandas::DataType::TypeId::TIMESTAMP_TZ"
+        TypeId_STRING " pandas::DataType::TypeId::STRING"
 
 cdef extern from "pandas/api.h" namespace "pandas":
 
@@ -112,6 +114,9 @@ cdef extern from "pandas/api.h" namespace "pandas":
     cdef cppclass CategoryType(DataType):
         pass
 
+    cdef cppclass StringType(DataType):
+        pass
+
     cdef cppclass CArray" pandas::Array":
 
         const TypePtr& type()
@@ -127,13 +132,42 @@ cdef extern from "pandas/api.h" namespace "pandas":
     cdef cppclass CBooleanArray" pandas::BooleanArray"(CArray):
         pass
 
+    cdef cppclass CStringArray" pandas::StringArray"(CArray):
+        int32_t value_length(int64_t i)
+
     ctypedef shared_ptr[CArray] ArrayPtr
 
     Status numpy_type_num_to_pandas(int type_num, TypeId* pandas_type)
     Status primitive_type_from_enum(TypeId tp_enum, DataType** out)
 
     Status array_from_numpy(PyObject* arr, CArray** out)
-    Status array_from_masked_numpy(PyObject* arr, CArray** out)
+    Status array_from_masked_numpy(PyObject* arr, PyObject* mask, CArray** out)
+    Status string_array_from_numpy(PyObject* offsets, PyObject* data,
+                                   PyObject* mask, CArray** out)
+
+
+cdef extern from "pandas/memory.h" namespace "pandas" nogil:
+
+    cdef cppclass MemoryPool:
+        int64_t bytes_allocated()
+
+    cdef cppclass AllocationStats:
+        int64_t bytes_allocated
+        int64_t max_bytes_allocated
+        int64_t num_allocations
+
+    cdef cppclass TrackingMemoryPool(MemoryPool):
+        AllocationStats stats()
+        vector[int64_t] size_histogram()
+        map[string, AllocationStats] tag_stats()
+        void ResetPeak()
+
+    MemoryPool* default_memory_pool()
+    void set_default_memory_pool(MemoryPool* pool)
+    TrackingMemoryPool* default_tracking_memory_pool()
+
+    void PushMemoryTag(const string& tag)
+    void PopMemoryTag()
 
 
 cdef extern from "pandas/pytypes.h" namespace "pandas::py":
@@ -10,6 +10,8 @@ cimport pandas.native as lp
 
 from cpython cimport PyObject
 from cython.operator cimport dereference as deref
+from cython.operator cimport preincrement as inc
+from libcpp.map cimport map
 cimport cpython
 
 cdef extern from "Python.h":
@@ -33,6 +35,7 @@ PYOBJECT = lp.TypeId_PYOBJECT
 CATEGORY = lp.TypeId_CATEGORY
 TIMESTAMP = lp.TypeId_TIMESTAMP
 TIMESTAMP_TZ = lp.TypeId_TIMESTAMP_TZ
+STRING = lp.TypeId_STRING
 
 
 class CPandasException(Exception):
@@ -261,12 +264,18 @@ cdef class CategoryArray(Array):
     pass
 
 
+cdef class StringArray(Array):
+    pass
+
+
 cdef Array wrap_array(const lp.ArrayPtr& arr):
     cdef:
         Array result
 
     if arr.get().type_id() == lp.TypeId_CATEGORY:
         result = CategoryArray()
+    elif arr.get().type_id() == lp.TypeId_STRING:
+        result = StringArray()
     else:
         result = Array()
 
@@ -298,19 +307,116 @@ cpdef PandasType convert_numpy_dtype(cnp.dtype dtype):
     return primitive_type(pandas_typenum)
 
 
-def to_array(values):
+def to_array(values, mask=None):
     if isinstance(values, np.ndarray):
-        return numpy_to_pandas_array(values)
+        return numpy_to_pandas_array(values, mask)
     else:
         raise TypeError(type(values))
 
 
-cdef numpy_to_pandas_array(ndarray arr):
+cdef numpy_to_pandas_array(ndarray arr, object mask=None):
     cdef:
         Array result
         CArray* array_obj
         lp.ArrayPtr sp_array
 
-    check_status(lp.array_from_numpy(<PyObject*> arr, &array_obj))
+    if mask is None:
+        check_status(lp.array_from_numpy(<PyObject*> arr, &array_obj))
+    else:
+        mask = np.asarray(mask)
+        check_status(lp.array_from_masked_numpy(<PyObject*> arr,
+                                                <PyObject*> mask,
+                                                &array_obj))
     sp_array.reset(array_obj)
     return wrap_array(sp_array)
+
+
+def string_array(offsets, data, mask=None):
+    """
+    StringArray over the UTF-8 bytes of its values packed in data (uint8),
+    value i spanning data[offsets[i]:offsets[i + 1]] (offsets is int32 with
+    one more entry than there are values). References the NumPy memory
+    without copying it. mask is true where the value is missing
+    """
+    cdef:
+        CArray* array_obj
+        lp.ArrayPtr sp_array
+        ndarray np_offsets = np.asarray(offsets)
+        ndarray np_data = np.asarray(data)
+        object np_mask = None
+
+    if mask is not None:
+        np_mask = np.asarray(mask)
+    check_status(lp.string_array_from_numpy(<PyObject*> np_offsets,
+                                            <PyObject*> np_data,
+                                            <PyObject*> np_mask,
+                                            &array_obj))
+    sp_array.reset(array_obj)
+    return wrap_array(sp_array)
+
+
+# ----------------------------------------------------------------------
+# Memory instrumentation
+
+
+def enable_memory_tracking(enable=True):
+    """
+    Route default pool allocations through a tracking pool, so that
+    memory_stats() reports on them
+    """
+    if enable:
+        lp.set_default_memory_pool(lp.default_tracking_memory_pool())
+    else:
+        lp.set_default_memory_pool(NULL)
+
+
+cdef _allocation_stats_to_dict(lp.AllocationStats stats):
+    return {
+        'bytes_allocated': stats.bytes_allocated,
+        'max_bytes_allocated': stats.max_bytes_allocated,
+        'num_allocations': stats.num_allocations,
+    }
+
+
+def memory_stats():
+    """
+    Statistics of the tracking pool enabled by enable_memory_tracking(). The
+    i-th histogram entry counts allocations of sizes in [2^(i-1), 2^i)
+    """
+    cdef:
+        lp.TrackingMemoryPool* pool = lp.default_tracking_memory_pool()
+        map[string, lp.AllocationStats] tag_stats = pool.tag_stats()
+        map[string, lp.AllocationStats].iterator it = tag_stats.begin()
+
+    result = _allocation_stats_to_dict(pool.stats())
+    result['size_histogram'] = list(pool.size_histogram())
+
+    tags = {}
+    while it != tag_stats.end():
+        tags[deref(it).first.decode('utf8')] = (
+            _allocation_stats_to_dict(deref(it).second))
+        inc(it)
+    result['tags'] = tags
+    return result
+
+
+def reset_peak_memory():
+    lp.default_tracking_memory_pool().ResetPeak()
+
+
+cdef class memory_tag:
+    """
+    Context manager attributing memory allocated by this thread to a tag,
+    e.g. with memory_tag('groupby'): ...
+    """
+    cdef string tag
+
+    def __cinit__(self, tag):
+        self.tag = tag.encode('utf8')
+
+    def __enter__(self):
+        lp.PushMemoryTag(self.tag)
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        lp.PopMemoryTag()
@@ -28,7 +28,7 @@ cdef extern from "stdlib.h":
 cimport cython
 cimport numpy as cnp
 
-from numpy cimport ndarray, uint8_t, uint64_t
+from numpy cimport ndarray, uint8_t, int32_t, uint64_t
 
 import numpy as np
 cimport util
@@ -185,6 +185,17 @@ cdef extern from "parser/tokenizer.h":
 
         int skip_empty_lines
 
+    ctypedef enum ColumnType:
+        COLUMN_WORDS
+        COLUMN_INT64
+        COLUMN_FLOAT64
+        COLUMN_BOOL
+
+    ctypedef struct typed_column_t:
+        int type
+        char *values
+        uint8_t *na
+
     ctypedef struct coliter_t:
         char **words
         int *line_start
@@ -201,6 +212,11 @@ cdef extern from "parser/tokenizer.h":
 
     int parser_set_skipfirstnrows(parser_t *self, int64_t nrows)
 
+    int parser_add_typed_column(parser_t *self, int col, int type,
+                                void *na_set, void *true_set, void *false_set)
+    int parser_convert_typed_columns(parser_t *self, int start_line)
+    typed_column_t *parser_typed_column(parser_t *self, int col)
+
     void parser_set_default_options(parser_t *self)
 
     int parser_consume_rows(parser_t *self, size_t nrows)
@@ -212,14 +228,13 @@ cdef extern from "parser/tokenizer.h":
     int tokenize_all_rows(parser_t *self) nogil
     int tokenize_nrows(parser_t *self, size_t nrows) nogil
 
-    int64_t str_to_int64(char *p_item, int64_t int_min,
-                         int64_t int_max, int *error, char tsep) nogil
+    int64_t str_to_int64(const char *p_item, const char *buf_end,
+                         int64_t int_min, int64_t int_max, int *error,
+                         char tsep) nogil
 #    uint64_t str_to_uint64(char *p_item, uint64_t uint_max, int *error)
 
-    double xstrtod(const char *p, char **q, char decimal, char sci,
-                   char tsep, int skip_trailing) nogil
-    double precise_xstrtod(const char *p, char **q, char decimal, char sci,
-                           char tsep, int skip_trailing) nogil
+    double exact_xstrtod(const char *p, char **q, char decimal, char sci,
+                         char tsep, int skip_trailing) nogil
     double round_trip(const char *p, char **q, char decimal, char sci,
                       char tsep, int skip_trailing) nogil
 
@@ -236,6 +251,7 @@ cdef extern from "parser/io.h":
     int del_mmap(void *src)
     void* buffer_mmap_bytes(void *source, size_t nbytes,
                             size_t *bytes_read, int *status)
+    int tokenize_mmap_parallel(parser_t *self, int nthreads) nogil
 
     void *new_file_source(char *fname, size_t buffer_size)
 
@@ -250,6 +266,19 @@ cdef extern from "parser/io.h":
     void* buffer_rd_bytes(void *source, size_t nbytes,
                           size_t *bytes_read, int *status)
 
+    void *new_gzip_source(char *fname, size_t buffer_size)
+    int del_gzip_source(void *src)
+    void* buffer_gzip_bytes(void *source, size_t nbytes,
+                            size_t *bytes_read, int *status)
+
+    void *new_readahead_source(void *source, io_callback cb_io,
+                               io_cleanup cb_cleanup, size_t buffer_size,
+                               int nbuffers)
+    void readahead_stop(void *src) nogil
+    int del_readahead_source(void *src)
+    void* buffer_readahead_bytes(void *source, size_t nbytes,
+                                 size_t *bytes_read, int *status)
+
 
 DEFAULT_CHUNKSIZE = 256 * 1024
 
@@ -282,6 +311,10 @@ cdef class TextReader:
 
     cdef public:
         int leading_cols, table_width, skipfooter, buffer_lines
+        int tokenize_threads, read_ahead
+        bint tokenize_dtypes, typed_columns_ready
+        object string_storage, string_array
+        list typed_na_lists
         object allow_leading_cols
         object delimiter, converters, delim_whitespace
         object na_values
@@ -311,6 +344,10 @@ cdef class TextReader:
 
                   memory_map=False,
                   tokenize_chunksize=DEFAULT_CHUNKSIZE,
+                  tokenize_threads=1,
+                  tokenize_dtypes=False,
+                  read_ahead=0,
+                  string_storage='object',
                   delim_whitespace=False,
 
                   compression=None,
@@ -367,10 +404,16 @@ cdef class TextReader:
 
         self.compression = compression
         self.memory_map = memory_map
+        self.tokenize_threads = tokenize_threads
+        self.tokenize_dtypes = tokenize_dtypes
+        self.typed_columns_ready = False
+        self.typed_na_lists = []
+        self.read_ahead = read_ahead
 
         self.parser.usecols = (usecols is not None)
 
         self._setup_parser_source(source)
+        self._setup_read_ahead()
         parser_set_default_options(self.parser)
 
         parser_init(self.parser)
@@ -465,10 +508,10 @@ cdef class TextReader:
 
         self.verbose = verbose
         self.low_memory = low_memory
-        self.parser.converter = xstrtod
-        if float_precision == 'high':
-            self.parser.converter = precise_xstrtod
-        elif float_precision == 'round_trip':
+        # 'high' used to select a more precise but slower converter; the
+        # default one is now correctly rounded
+        self.parser.converter = exact_xstrtod
+        if float_precision == 'round_trip':
             self.parser.converter = round_trip
 
         # encoding
@@ -482,6 +525,19 @@ cdef class TextReader:
 
         self.encoding = encoding
 
+        if string_storage not in ('object', 'native'):
+            raise ValueError("string_storage must be 'object' or 'native'")
+        if string_storage == 'native':
+            if _string_path(self.c_encoding) == ENCODED:
+                raise ValueError("string_storage='native' requires UTF-8 "
+                                 "encoded input")
+            if low_memory or as_recarray:
+                raise ValueError("string_storage='native' is not supported "
+                                 "with low_memory or as_recarray")
+            from pandas.native import string_array
+            self.string_array = string_array
+        self.string_storage = string_storage
+
         if isinstance(dtype, dict):
             dtype = {k: pandas_dtype(dtype[k])
                      for k in dtype}
@@ -547,6 +603,7 @@ cdef class TextReader:
         pass
 
     def __dealloc__(self):
+        self._stop_read_ahead()
         parser_free(self.parser)
         kh_destroy_str(self.true_set)
         kh_destroy_str(self.false_set)
@@ -554,6 +611,7 @@ cdef class TextReader:
     def close(self):
         # we need to properly close an open derived
         # filehandle here, e.g. and UTFRecoder
+        self._stop_read_ahead()
         if self.dsource is not None:
             try:
                 self.dsource.close()
@@ -601,6 +659,21 @@ cdef class TextReader:
         self.parser.cb_io = NULL
         self.parser.cb_cleanup = NULL
 
+        if self.compression == 'gzip' and isinstance(source, basestring):
+            fname = source
+            if not isinstance(fname, bytes):
+                fname = fname.encode(sys.getfilesystemencoding() or 'utf-8')
+
+            # decompressed without Python if zlib is available; otherwise,
+            # or if the file cannot be opened, by the gzip module below
+            ptr = new_gzip_source(fname, self.parser.chunksize)
+            if ptr != NULL:
+                self.parser.source = ptr
+                self.parser.cb_io = &buffer_gzip_bytes
+                self.parser.cb_cleanup = &del_gzip_source
+                self.dsource = source
+                return
+
         if self.compression:
             if self.compression == 'gzip':
                 import gzip
@@ -685,6 +758,26 @@ cdef class TextReader:
 
         self.dsource = source
 
+    cdef _setup_read_ahead(self):
+        cdef void *ptr
+
+        if self.read_ahead > 0 and self.parser.cb_io != &buffer_mmap_bytes:
+            # falls back to reading synchronously if no thread can be started
+            ptr = new_readahead_source(self.parser.source, self.parser.cb_io,
+                                       self.parser.cb_cleanup,
+                                       self.parser.chunksize,
+                                       self.read_ahead + 1)
+            if ptr != NULL:
+                self.parser.source = ptr
+                self.parser.cb_io = &buffer_readahead_bytes
+                self.parser.cb_cleanup = &del_readahead_source
+
+    cdef _stop_read_ahead(self):
+        # the reading thread may need the GIL to finish its current read
+        if self.parser.cb_io == &buffer_readahead_bytes:
+            with nogil:
+                readahead_stop(self.parser.source)
+
     cdef _get_header(self):
         # header is now a list of lists, so field_count should use header[0]
 
@@ -912,6 +1005,10 @@ cdef class TextReader:
         cdef:
             int buffered_lines
             int irows, footer = 0
+            int nthreads = self.tokenize_threads
+
+        if self.tokenize_dtypes and not self.typed_columns_ready:
+            self._setup_typed_columns()
 
         self._start_clock()
 
@@ -925,8 +1022,14 @@ cdef class TextReader:
                 raise ValueError('skipfooter can only be used to read '
                                  'the whole file')
         else:
-            with nogil:
-                status = tokenize_all_rows(self.parser)
+            if self.parser.cb_io == &buffer_mmap_bytes:
+                # the rest of the file is already in memory, so the buffers
+                # can be sized for it up front
+                with nogil:
+                    status = tokenize_mmap_parallel(self.parser, nthreads)
+            else:
+                with nogil:
+                    status = tokenize_all_rows(self.parser)
 
             if self.parser.warn_msg != NULL:
                 print >> sys.stderr, self.parser.warn_msg
@@ -1044,12 +1147,21 @@ cdef class TextReader:
                 continue
 
             # Should return as the desired dtype (inferred or specified)
-            col_res, na_count = self._convert_tokens(
-                i, start, end, name, na_filter, na_hashset, na_flist)
+            if parser_typed_column(self.parser, i) != NULL:
+                col_res, na_count = self._typed_column_values(i, start, end,
+                                                              na_flist)
+            else:
+                col_res, na_count = self._convert_tokens(
+                    i, start, end, name, na_filter, na_hashset, na_flist)
 
             if na_filter:
                 self._free_na_set(na_hashset)
 
+            if not isinstance(col_res, np.ndarray):
+                # a native StringArray, which keeps its own nulls
+                results[i] = col_res
+                continue
+
             if upcast_na and na_count > 0:
                 col_res = _maybe_upcast(col_res)
 
@@ -1067,13 +1179,105 @@ cdef class TextReader:
 
         return results
 
-    cdef inline _convert_tokens(self, Py_ssize_t i, int start, int end,
-                                object name, bint na_filter,
-                                kh_str_t *na_hashset,
-                                object na_flist):
+    cdef _setup_typed_columns(self):
+        # Columns with an int64, float64 or bool dtype are converted by the
+        # tokenizer as their fields end, including the data lines already
+        # tokenized along with the header
         cdef:
-            object col_dtype = None
+            int col_type
+            kh_str_t *na_hashset
+
+        self.typed_columns_ready = True
+        if self.dtype is None:
+            return
+
+        nused = 0
+        for i in range(self.table_width):
+            if i < self.leading_cols:
+                name = i
+            elif self.usecols and nused == len(self.usecols):
+                break
+            else:
+                name = self._get_column_name(i, nused)
+                if self.has_usecols and not (i in self.usecols or
+                                             name in self.usecols):
+                    continue
+                nused += 1
+
+            col_dtype = self._get_column_dtype(i, name)
+            if (col_dtype is None or i in self.noconvert or
+                    self._get_converter(i, name) is not None):
+                continue
+
+            try:
+                col_dtype = np.dtype(col_dtype)
+            except TypeError:
+                continue
+
+            if col_dtype == np.int64:
+                col_type = COLUMN_INT64
+            elif col_dtype == np.float64:
+                col_type = COLUMN_FLOAT64
+            elif col_dtype == np.bool_:
+                col_type = COLUMN_BOOL
+            else:
+                continue
+
+            na_hashset = NULL
+            if self.na_filter:
+                na_list, na_flist = self._get_na_list(i, name)
+                if na_list is not None:
+                    # the table points into the bytes of the list
+                    self.typed_na_lists.append(na_list)
+                    na_hashset = kset_from_list(na_list)
+
+            if parser_add_typed_column(self.parser, i, col_type, na_hashset,
+                                       self.true_set, self.false_set) < 0:
+                raise MemoryError()
 
+        if parser_convert_typed_columns(self.parser, self.parser_start) < 0:
+            raise_parser_error('Error converting data', self.parser)
+
+    cdef _typed_column_values(self, Py_ssize_t i, int start, int end,
+                              object na_flist):
+        cdef:
+            typed_column_t *column = parser_typed_column(self.parser, i)
+            size_t lines = end - start
+            Py_ssize_t itemsize
+            ndarray values, na
+
+        if column.type == COLUMN_INT64:
+            dtype = np.dtype(np.int64)
+        elif column.type == COLUMN_FLOAT64:
+            dtype = np.dtype(np.float64)
+        else:
+            dtype = np.dtype(np.uint8)
+
+        itemsize = dtype.itemsize
+        values = np.empty(lines, dtype=dtype)
+        na = np.empty(lines, dtype=np.bool_)
+        if lines > 0:
+            memcpy(values.data, column.values + start * itemsize,
+                   lines * itemsize)
+            memcpy(na.data, column.na + start, lines)
+
+        if column.type == COLUMN_FLOAT64 and len(na_flist) > 0:
+            na |= np.in1d(values, list(na_flist))
+
+        na_count = na.sum()
+        if na_count > 0:
+            if column.type == COLUMN_INT64:
+                raise ValueError("Integer column has NA values in "
+                                 "column {column}".format(column=i))
+            values[na] = na_values[np.bool_ if column.type == COLUMN_BOOL
+                                   else dtype.type]
+
+        if column.type == COLUMN_BOOL:
+            values = values.view(np.bool_)
+        return values, na_count
+
+    cdef _get_column_dtype(self, Py_ssize_t i, object name):
+        col_dtype = None
         if self.dtype is not None:
             if isinstance(self.dtype, dict):
                 if name in self.dtype:
@@ -1086,6 +1290,17 @@ cdef class TextReader:
                     col_dtype = np.dtype(self.dtype.descr[i][1])
                 else:
                     col_dtype = self.dtype
+        return col_dtype
+
+    cdef inline _convert_tokens(self, Py_ssize_t i, int start, int end,
+                                object name, bint na_filter,
+                                kh_str_t *na_hashset,
+                                object na_flist):
+        cdef:
+            object col_dtype = None
+
+        if self.dtype is not None:
+            col_dtype = self._get_column_dtype(i, name)
 
             if col_dtype is not None:
                 col_res, na_count = self._convert_with_dtype(
@@ -1216,7 +1431,11 @@ cdef class TextReader:
 
         cdef StringPath path = _string_path(self.c_encoding)
 
-        if path == UTF8:
+        if self.string_storage == 'native':
+            offsets, data, mask, na_count = _string_buffers(
+                self.parser, i, start, end, na_filter, na_hashset)
+            return self.string_array(offsets, data, mask), na_count
+        elif path == UTF8:
             return _string_box_utf8(self.parser, i, start, end, na_filter,
                                     na_hashset)
         elif path == ENCODED:
@@ -1519,6 +1738,89 @@ cdef _string_box_decode(parser_t *parser, int col,
     return result, na_count
 
 
+cdef _string_buffers(parser_t *parser, int col,
+                     int line_start, int line_end,
+                     bint na_filter, kh_str_t *na_hashset):
+    # The fields packed together with their offsets, as taken by
+    # pandas.native.string_array, instead of an object per field
+    cdef:
+        int na_count = 0
+        size_t lines
+        int64_t nbytes
+        ndarray offsets, data, mask
+
+    lines = line_end - line_start
+    offsets = np.empty(lines + 1, dtype=np.int32)
+    mask = np.zeros(lines, dtype=np.bool_)
+    with nogil:
+        nbytes = _string_offsets_nogil(parser, col, line_start, line_end,
+                                       na_filter, na_hashset,
+                                       <int32_t *> offsets.data,
+                                       <uint8_t *> mask.data, &na_count)
+    if nbytes > INT32_MAX:
+        raise ValueError("Column {column} has more than 2GB of string "
+                         "data".format(column=col))
+
+    data = np.empty(nbytes, dtype=np.uint8)
+    with nogil:
+        _string_copy_nogil(parser, col, line_start, line_end,
+                           <int32_t *> offsets.data, <uint8_t *> mask.data,
+                           <char *> data.data)
+    return offsets, data, mask, na_count
+
+cdef inline int64_t _string_offsets_nogil(parser_t *parser, int col,
+                                          int line_start, int line_end,
+                                          bint na_filter,
+                                          kh_str_t *na_hashset,
+                                          int32_t *offsets, uint8_t *mask,
+                                          int *na_count) nogil:
+    # Returns the total length of the fields, and stops early once it no
+    # longer fits in the offsets
+    cdef:
+        size_t i
+        size_t lines = line_end - line_start
+        int64_t nbytes = 0
+        coliter_t it
+        const char *word = NULL
+        khiter_t k
+
+    coliter_setup(&it, parser, col, line_start)
+    for i in range(lines):
+        COLITER_NEXT(it, word)
+        offsets[i] = <int32_t> nbytes
+
+        if na_filter:
+            k = kh_get_str(na_hashset, word)
+            # in the hash table
+            if k != na_hashset.n_buckets:
+                na_count[0] += 1
+                mask[i] = 1
+                continue
+
+        nbytes += strlen(word)
+        if nbytes > INT32_MAX:
+            return nbytes
+    offsets[lines] = <int32_t> nbytes
+    return nbytes
+
+cdef inline void _string_copy_nogil(parser_t *parser, int col,
+                                    int line_start, int line_end,
+                                    int32_t *offsets, uint8_t *mask,
+                                    char *data) nogil:
+    cdef:
+        size_t i
+        size_t lines = line_end - line_start
+        coliter_t it
+        const char *word = NULL
+
+    coliter_setup(&it, parser, col, line_start)
+    for i in range(lines):
+        COLITER_NEXT(it, word)
+        if not mask[i]:
+            memcpy(data + offsets[i], <void *> word,
+                   offsets[i + 1] - offsets[i])
+
+
 @cython.boundscheck(False)
 cdef _categorical_convert(parser_t *parser, int col,
                           int line_start, int line_end,
@@ -1761,6 +2063,8 @@ cdef inline int _try_int64_nogil(parser_t *parser, int col, int line_start,
         size_t lines = line_end - line_start
         coliter_t it
         const char *word = NULL
+        # every word is in the stream, which str_to_int64 may read to its end
+        const char *stream_end = parser.stream + parser.stream_len
         khiter_t k
 
     na_count[0] = 0
@@ -1776,14 +2080,14 @@ cdef inline int _try_int64_nogil(parser_t *parser, int col, int line_start,
                 data[i] = NA
                 continue
 
-            data[i] = str_to_int64(word, INT64_MIN, INT64_MAX,
+            data[i] = str_to_int64(word, stream_end, INT64_MIN, INT64_MAX,
                                    &error, parser.thousands)
             if error != 0:
                 return error
     else:
         for i in range(lines):
             COLITER_NEXT(it, word)
-            data[i] = str_to_int64(word, INT64_MIN, INT64_MAX,
+            data[i] = str_to_int64(word, stream_end, INT64_MIN, INT64_MAX,
                                    &error, parser.thousands)
             if error != 0:
                 return error
@@ -23,6 +23,20 @@ cdef void append_data_float64(Float64VectorData *data,
     data.n += 1
 
 
+ctypedef struct Float32VectorData:
+    float32_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_float32(Float32VectorData *data,
+                                float32_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
+
 ctypedef struct Int64VectorData:
     int64_t *data
     size_t n, m
@@ -36,9 +50,115 @@ cdef void append_data_int64(Int64VectorData *data,
     data.data[data.n] = x
     data.n += 1
 
+
+ctypedef struct Int32VectorData:
+    int32_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_int32(Int32VectorData *data,
+                                int32_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
+
+ctypedef struct Int16VectorData:
+    int16_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_int16(Int16VectorData *data,
+                                int16_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
+
+ctypedef struct Int8VectorData:
+    int8_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_int8(Int8VectorData *data,
+                                int8_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
+
+ctypedef struct UInt64VectorData:
+    uint64_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_uint64(UInt64VectorData *data,
+                                uint64_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
+
+ctypedef struct UInt32VectorData:
+    uint32_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_uint32(UInt32VectorData *data,
+                                uint32_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
+
+ctypedef struct UInt16VectorData:
+    uint16_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_uint16(UInt16VectorData *data,
+                                uint16_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
+
+ctypedef struct UInt8VectorData:
+    uint8_t *data
+    size_t n, m
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cdef void append_data_uint8(UInt8VectorData *data,
+                                uint8_t x) nogil:
+
+    data.data[data.n] = x
+    data.n += 1
+
 ctypedef fused vector_data:
-    Int64VectorData
     Float64VectorData
+    Float32VectorData
+    Int64VectorData
+    Int32VectorData
+    Int16VectorData
+    Int8VectorData
+    UInt64VectorData
+    UInt32VectorData
+    UInt16VectorData
+    UInt8VectorData
 
 cdef bint needs_resize(vector_data *data) nogil:
     return data.n == data.m
@@ -86,6 +206,45 @@ cdef class Float64Vector:
 
         append_data_float64(self.data, x)
 
+cdef class Float32Vector:
+
+    cdef:
+        Float32VectorData *data
+        ndarray ao
+
+    def __cinit__(self):
+        self.data = <Float32VectorData *>PyMem_Malloc(
+            sizeof(Float32VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.float32)
+        self.data.data = <float32_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <float32_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
+
+    def __len__(self):
+        return self.data.n
+
+    def to_array(self):
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
+        return self.ao
+
+    cdef inline void append(self, float32_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_float32(self.data, x)
+
 cdef class Int64Vector:
 
     cdef:
@@ -125,582 +284,2146 @@ cdef class Int64Vector:
 
         append_data_int64(self.data, x)
 
+cdef class Int32Vector:
 
-cdef class ObjectVector:
+    cdef:
+        Int32VectorData *data
+        ndarray ao
+
+    def __cinit__(self):
+        self.data = <Int32VectorData *>PyMem_Malloc(
+            sizeof(Int32VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.int32)
+        self.data.data = <int32_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <int32_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
+
+    def __len__(self):
+        return self.data.n
+
+    def to_array(self):
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
+        return self.ao
+
+    cdef inline void append(self, int32_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_int32(self.data, x)
+
+cdef class Int16Vector:
 
     cdef:
-        PyObject **data
-        size_t n, m
+        Int16VectorData *data
         ndarray ao
 
     def __cinit__(self):
-        self.n = 0
-        self.m = _INIT_VEC_CAP
-        self.ao = np.empty(_INIT_VEC_CAP, dtype=object)
-        self.data = <PyObject**> self.ao.data
+        self.data = <Int16VectorData *>PyMem_Malloc(
+            sizeof(Int16VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.int16)
+        self.data.data = <int16_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <int16_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
 
     def __len__(self):
-        return self.n
+        return self.data.n
 
-    cdef inline append(self, object o):
-        if self.n == self.m:
-            self.m = max(self.m * 2, _INIT_VEC_CAP)
-            self.ao.resize(self.m)
-            self.data = <PyObject**> self.ao.data
+    def to_array(self):
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
+        return self.ao
 
-        Py_INCREF(o)
-        self.data[self.n] = <PyObject*> o
-        self.n += 1
+    cdef inline void append(self, int16_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_int16(self.data, x)
+
+cdef class Int8Vector:
+
+    cdef:
+        Int8VectorData *data
+        ndarray ao
+
+    def __cinit__(self):
+        self.data = <Int8VectorData *>PyMem_Malloc(
+            sizeof(Int8VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.int8)
+        self.data.data = <int8_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <int8_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
+
+    def __len__(self):
+        return self.data.n
 
     def to_array(self):
-        self.ao.resize(self.n)
-        self.m = self.n
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
+        return self.ao
+
+    cdef inline void append(self, int8_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_int8(self.data, x)
+
+cdef class UInt64Vector:
+
+    cdef:
+        UInt64VectorData *data
+        ndarray ao
+
+    def __cinit__(self):
+        self.data = <UInt64VectorData *>PyMem_Malloc(
+            sizeof(UInt64VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.uint64)
+        self.data.data = <uint64_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <uint64_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
+
+    def __len__(self):
+        return self.data.n
+
+    def to_array(self):
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
         return self.ao
 
+    cdef inline void append(self, uint64_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_uint64(self.data, x)
+
+cdef class UInt32Vector:
+
+    cdef:
+        UInt32VectorData *data
+        ndarray ao
+
+    def __cinit__(self):
+        self.data = <UInt32VectorData *>PyMem_Malloc(
+            sizeof(UInt32VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.uint32)
+        self.data.data = <uint32_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <uint32_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
+
+    def __len__(self):
+        return self.data.n
+
+    def to_array(self):
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
+        return self.ao
+
+    cdef inline void append(self, uint32_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_uint32(self.data, x)
+
+cdef class UInt16Vector:
+
+    cdef:
+        UInt16VectorData *data
+        ndarray ao
+
+    def __cinit__(self):
+        self.data = <UInt16VectorData *>PyMem_Malloc(
+            sizeof(UInt16VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.uint16)
+        self.data.data = <uint16_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <uint16_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
+
+    def __len__(self):
+        return self.data.n
+
+    def to_array(self):
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
+        return self.ao
+
+    cdef inline void append(self, uint16_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_uint16(self.data, x)
+
+cdef class UInt8Vector:
+
+    cdef:
+        UInt8VectorData *data
+        ndarray ao
+
+    def __cinit__(self):
+        self.data = <UInt8VectorData *>PyMem_Malloc(
+            sizeof(UInt8VectorData))
+        if not self.data:
+            raise MemoryError()
+        self.data.n = 0
+        self.data.m = _INIT_VEC_CAP
+        self.ao = np.empty(self.data.m, dtype=np.uint8)
+        self.data.data = <uint8_t*> self.ao.data
+
+    cdef resize(self):
+        self.data.m = max(self.data.m * 4, _INIT_VEC_CAP)
+        self.ao.resize(self.data.m)
+        self.data.data = <uint8_t*> self.ao.data
+
+    def __dealloc__(self):
+        PyMem_Free(self.data)
+
+    def __len__(self):
+        return self.data.n
+
+    def to_array(self):
+        self.ao.resize(self.data.n)
+        self.data.m = self.data.n
+        return self.ao
+
+    cdef inline void append(self, uint8_t x):
+
+        if needs_resize(self.data):
+            self.resize()
+
+        append_data_uint8(self.data, x)
+
+
+cdef class ObjectVector:
+
+    cdef:
+        PyObject **data
+        size_t n, m
+        ndarray ao
+
+    def __cinit__(self):
+        self.n = 0
+        self.m = _INIT_VEC_CAP
+        self.ao = np.empty(_INIT_VEC_CAP, dtype=object)
+        self.data = <PyObject**> self.ao.data
+
+    def __len__(self):
+        return self.n
+
+    cdef inline append(self, object o):
+        if self.n == self.m:
+            self.m = max(self.m * 2, _INIT_VEC_CAP)
+            self.ao.resize(self.m)
+            self.data = <PyObject**> self.ao.data
+
+        Py_INCREF(o)
+        self.data[self.n] = <PyObject*> o
+        self.n += 1
+
+    def to_array(self):
+        self.ao.resize(self.n)
+        self.m = self.n
+        return self.ao
+
+
+#----------------------------------------------------------------------
+# HashTable
+#----------------------------------------------------------------------
+
+
+cdef class HashTable:
+    pass
+
+cdef class Float64HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_float64_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_float64_size(self.table)
+
+    def __dealloc__(self):
+        swiss_float64_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_float64_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, float64_t val):
+        cdef int64_t loc
+        if swiss_float64_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, float64_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_float64_get(self.table, val, &val)
+
+    cpdef set_item(self, float64_t key, Py_ssize_t val):
+        if swiss_float64_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, float64_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_float64_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[float64_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_float64_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, float64_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            float64_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_float64_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, float64_t values):
+        uniques = Float64Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, float64_t[::1] keys, Float64Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            Float64VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_float64_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_float64(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, float64_t[:] values, Float64Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            float64_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            float64_t val
+
+        if check_null:
+            skip = np.empty(n, dtype=np.uint8)
+            with nogil:
+                for i in range(n):
+                    val = keys[i]
+                    skip[i] = val != val
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, float64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            float64_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            Float64Vector uniques = Float64Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
+
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, float64_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            float64_t[::1] keys = np.ascontiguousarray(values)
+            Float64Vector uniques = Float64Vector()
+
+        self._get_labels(keys, uniques, swiss_float64_size(self.table),
+                         None, -1)
+        return uniques.to_array()
+
+cdef class Float32HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_float32_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_float32_size(self.table)
+
+    def __dealloc__(self):
+        swiss_float32_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_float32_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, float32_t val):
+        cdef int64_t loc
+        if swiss_float32_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, float32_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_float32_get(self.table, val, &val)
+
+    cpdef set_item(self, float32_t key, Py_ssize_t val):
+        if swiss_float32_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, float32_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_float32_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[float32_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_float32_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, float32_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            float32_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_float32_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, float32_t values):
+        uniques = Float32Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, float32_t[::1] keys, Float32Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            Float32VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_float32_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_float32(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, float32_t[:] values, Float32Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            float32_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            float32_t val
+
+        if check_null:
+            skip = np.empty(n, dtype=np.uint8)
+            with nogil:
+                for i in range(n):
+                    val = keys[i]
+                    skip[i] = val != val
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, float32_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            float32_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            Float32Vector uniques = Float32Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
+
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, float32_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            float32_t[::1] keys = np.ascontiguousarray(values)
+            Float32Vector uniques = Float32Vector()
+
+        self._get_labels(keys, uniques, swiss_float32_size(self.table),
+                         None, -1)
+        return uniques.to_array()
+
+cdef class Int64HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_int64_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_int64_size(self.table)
+
+    def __dealloc__(self):
+        swiss_int64_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_int64_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, int64_t val):
+        cdef int64_t loc
+        if swiss_int64_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, int64_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_int64_get(self.table, val, &val)
+
+    cpdef set_item(self, int64_t key, Py_ssize_t val):
+        if swiss_int64_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, int64_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int64_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[int64_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int64_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, int64_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            int64_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_int64_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, int64_t values):
+        uniques = Int64Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, int64_t[::1] keys, Int64Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            Int64VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_int64_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_int64(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, int64_t[:] values, Int64Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int64_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            int64_t val
+
+        if check_null:
+            skip = np.empty(n, dtype=np.uint8)
+            with nogil:
+                for i in range(n):
+                    val = keys[i]
+                    skip[i] = val == iNaT
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int64_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            Int64Vector uniques = Int64Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
+
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, int64_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            int64_t[::1] keys = np.ascontiguousarray(values)
+            Int64Vector uniques = Int64Vector()
+
+        self._get_labels(keys, uniques, swiss_int64_size(self.table),
+                         None, -1)
+        return uniques.to_array()
+
+cdef class Int32HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_int32_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_int32_size(self.table)
+
+    def __dealloc__(self):
+        swiss_int32_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_int32_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, int32_t val):
+        cdef int64_t loc
+        if swiss_int32_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, int32_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_int32_get(self.table, val, &val)
+
+    cpdef set_item(self, int32_t key, Py_ssize_t val):
+        if swiss_int32_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, int32_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int32_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[int32_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int32_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, int32_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            int32_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_int32_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, int32_t values):
+        uniques = Int32Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, int32_t[::1] keys, Int32Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            Int32VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_int32_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_int32(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, int32_t[:] values, Int32Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int32_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            int32_t val
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, int32_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int32_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            Int32Vector uniques = Int32Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
+
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, int32_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            int32_t[::1] keys = np.ascontiguousarray(values)
+            Int32Vector uniques = Int32Vector()
+
+        self._get_labels(keys, uniques, swiss_int32_size(self.table),
+                         None, -1)
+        return uniques.to_array()
+
+cdef class Int16HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_int16_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_int16_size(self.table)
+
+    def __dealloc__(self):
+        swiss_int16_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_int16_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, int16_t val):
+        cdef int64_t loc
+        if swiss_int16_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, int16_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_int16_get(self.table, val, &val)
+
+    cpdef set_item(self, int16_t key, Py_ssize_t val):
+        if swiss_int16_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, int16_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int16_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[int16_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int16_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, int16_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            int16_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_int16_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, int16_t values):
+        uniques = Int16Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, int16_t[::1] keys, Int16Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            Int16VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_int16_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_int16(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, int16_t[:] values, Int16Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int16_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            int16_t val
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, int16_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int16_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            Int16Vector uniques = Int16Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
+
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, int16_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            int16_t[::1] keys = np.ascontiguousarray(values)
+            Int16Vector uniques = Int16Vector()
+
+        self._get_labels(keys, uniques, swiss_int16_size(self.table),
+                         None, -1)
+        return uniques.to_array()
+
+cdef class Int8HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_int8_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_int8_size(self.table)
+
+    def __dealloc__(self):
+        swiss_int8_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_int8_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, int8_t val):
+        cdef int64_t loc
+        if swiss_int8_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, int8_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_int8_get(self.table, val, &val)
+
+    cpdef set_item(self, int8_t key, Py_ssize_t val):
+        if swiss_int8_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, int8_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int8_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[int8_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_int8_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, int8_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            int8_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_int8_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, int8_t values):
+        uniques = Int8Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, int8_t[::1] keys, Int8Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            Int8VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_int8_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_int8(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, int8_t[:] values, Int8Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int8_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            int8_t val
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, int8_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int8_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            Int8Vector uniques = Int8Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
+
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, int8_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            int8_t[::1] keys = np.ascontiguousarray(values)
+            Int8Vector uniques = Int8Vector()
+
+        self._get_labels(keys, uniques, swiss_int8_size(self.table),
+                         None, -1)
+        return uniques.to_array()
+
+cdef class UInt64HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_uint64_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_uint64_size(self.table)
+
+    def __dealloc__(self):
+        swiss_uint64_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_uint64_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, uint64_t val):
+        cdef int64_t loc
+        if swiss_uint64_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, uint64_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_uint64_get(self.table, val, &val)
+
+    cpdef set_item(self, uint64_t key, Py_ssize_t val):
+        if swiss_uint64_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, uint64_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_uint64_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[uint64_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_uint64_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, uint64_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            uint64_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_uint64_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, uint64_t values):
+        uniques = UInt64Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, uint64_t[::1] keys, UInt64Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            UInt64VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_uint64_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_uint64(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, uint64_t[:] values, UInt64Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            uint64_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            uint64_t val
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, uint64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            uint64_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            UInt64Vector uniques = UInt64Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
+
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, uint64_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            uint64_t[::1] keys = np.ascontiguousarray(values)
+            UInt64Vector uniques = UInt64Vector()
+
+        self._get_labels(keys, uniques, swiss_uint64_size(self.table),
+                         None, -1)
+        return uniques.to_array()
+
+cdef class UInt32HashTable(HashTable):
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_uint32_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
+
+    def __len__(self):
+        return swiss_uint32_size(self.table)
+
+    def __dealloc__(self):
+        swiss_uint32_free(self.table)
+
+    def __contains__(self, object key):
+        cdef int64_t loc
+        return swiss_uint32_get(self.table, key, &loc) == 1
+
+    cpdef get_item(self, uint32_t val):
+        cdef int64_t loc
+        if swiss_uint32_get(self.table, val, &loc):
+            return loc
+        else:
+            raise KeyError(val)
+
+    def get_iter_test(self, uint32_t key, Py_ssize_t iterations):
+        cdef:
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_uint32_get(self.table, val, &val)
+
+    cpdef set_item(self, uint32_t key, Py_ssize_t val):
+        if swiss_uint32_set(self.table, key, val) != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map(self, uint32_t[:] keys, int64_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_uint32_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def map_locations(self, ndarray[uint32_t, ndim=1] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            int ret = 0
+
+        with nogil:
+            for i in range(n):
+                ret |= swiss_uint32_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
+
+    @cython.boundscheck(False)
+    def lookup(self, uint32_t[:] values):
+        cdef:
+            Py_ssize_t n = len(values)
+            uint32_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
+
+        if n > 0:
+            with nogil:
+                swiss_uint32_lookup(self.table, &keys[0], n, &locs[0])
+
+        return np.asarray(locs)
+
+    def factorize(self, uint32_t values):
+        uniques = UInt32Vector()
+        labels = self.get_labels(values, uniques, 0, 0)
+        return uniques.to_array(), labels
+
+    @cython.boundscheck(False)
+    cdef _get_labels(self, uint32_t[::1] keys, UInt32Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
+        cdef:
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
+            int ret = 0
+            UInt32VectorData *ud
+
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
+        ud = uniques.data
+
+        with nogil:
+            ret = swiss_uint32_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
+
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
+                    if needs_resize(ud):
+                        with gil:
+                            uniques.resize()
+                    append_data_uint32(ud, keys[i])
+
+        return np.asarray(labels)
+
+    @cython.boundscheck(False)
+    def get_labels(self, uint32_t[:] values, UInt32Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            uint32_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            uint32_t val
+
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
+
+    @cython.boundscheck(False)
+    def get_labels_groupby(self, uint32_t[:] values):
+        cdef:
+            Py_ssize_t i, n = len(values)
+            uint32_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            UInt32Vector uniques = UInt32Vector()
+
+        # specific for groupby
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] < 0
 
-#----------------------------------------------------------------------
-# HashTable
-#----------------------------------------------------------------------
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
 
+    @cython.boundscheck(False)
+    def unique(self, uint32_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            uint32_t[::1] keys = np.ascontiguousarray(values)
+            UInt32Vector uniques = UInt32Vector()
 
-cdef class HashTable:
-    pass
+        self._get_labels(keys, uniques, swiss_uint32_size(self.table),
+                         None, -1)
+        return uniques.to_array()
 
-cdef class Float64HashTable(HashTable):
+cdef class UInt16HashTable(HashTable):
 
     def __cinit__(self, size_hint=1):
-        self.table = kh_init_float64()
-        if size_hint is not None:
-            kh_resize_float64(self.table, size_hint)
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_uint16_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
 
     def __len__(self):
-        return self.table.size
+        return swiss_uint16_size(self.table)
 
     def __dealloc__(self):
-        kh_destroy_float64(self.table)
+        swiss_uint16_free(self.table)
 
     def __contains__(self, object key):
-        cdef khiter_t k
-        k = kh_get_float64(self.table, key)
-        return k != self.table.n_buckets
+        cdef int64_t loc
+        return swiss_uint16_get(self.table, key, &loc) == 1
 
-    cpdef get_item(self, float64_t val):
-        cdef khiter_t k
-        k = kh_get_float64(self.table, val)
-        if k != self.table.n_buckets:
-            return self.table.vals[k]
+    cpdef get_item(self, uint16_t val):
+        cdef int64_t loc
+        if swiss_uint16_get(self.table, val, &loc):
+            return loc
         else:
             raise KeyError(val)
 
-    def get_iter_test(self, float64_t key, Py_ssize_t iterations):
-        cdef Py_ssize_t i, val=0
-        for i in range(iterations):
-            k = kh_get_float64(self.table, val)
-            if k != self.table.n_buckets:
-                val = self.table.vals[k]
-
-    cpdef set_item(self, float64_t key, Py_ssize_t val):
+    def get_iter_test(self, uint16_t key, Py_ssize_t iterations):
         cdef:
-            khiter_t k
-            int ret = 0
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_uint16_get(self.table, val, &val)
 
-        k = kh_put_float64(self.table, key, &ret)
-        self.table.keys[k] = key
-        if kh_exist_float64(self.table, k):
-            self.table.vals[k] = val
-        else:
-            raise KeyError(key)
+    cpdef set_item(self, uint16_t key, Py_ssize_t val):
+        if swiss_uint16_set(self.table, key, val) != 0:
+            raise MemoryError()
 
     @cython.boundscheck(False)
-    def map(self, float64_t[:] keys, int64_t[:] values):
+    def map(self, uint16_t[:] keys, int64_t[:] values):
         cdef:
             Py_ssize_t i, n = len(values)
             int ret = 0
-            float64_t key
-            khiter_t k
 
         with nogil:
             for i in range(n):
-                key = keys[i]
-                k = kh_put_float64(self.table, key, &ret)
-                self.table.vals[k] = <Py_ssize_t> values[i]
+                ret |= swiss_uint16_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
 
     @cython.boundscheck(False)
-    def map_locations(self, ndarray[float64_t, ndim=1] values):
+    def map_locations(self, ndarray[uint16_t, ndim=1] values):
         cdef:
             Py_ssize_t i, n = len(values)
             int ret = 0
-            float64_t val
-            khiter_t k
 
         with nogil:
             for i in range(n):
-                val = values[i]
-                k = kh_put_float64(self.table, val, &ret)
-                self.table.vals[k] = i
+                ret |= swiss_uint16_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
 
     @cython.boundscheck(False)
-    def lookup(self, float64_t[:] values):
+    def lookup(self, uint16_t[:] values):
         cdef:
-            Py_ssize_t i, n = len(values)
-            int ret = 0
-            float64_t val
-            khiter_t k
-            int64_t[:] locs = np.empty(n, dtype=np.int64)
+            Py_ssize_t n = len(values)
+            uint16_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
 
-        with nogil:
-            for i in range(n):
-                val = values[i]
-                k = kh_get_float64(self.table, val)
-                if k != self.table.n_buckets:
-                    locs[i] = self.table.vals[k]
-                else:
-                    locs[i] = -1
+        if n > 0:
+            with nogil:
+                swiss_uint16_lookup(self.table, &keys[0], n, &locs[0])
 
         return np.asarray(locs)
 
-    def factorize(self, float64_t values):
-        uniques = Float64Vector()
+    def factorize(self, uint16_t values):
+        uniques = UInt16Vector()
         labels = self.get_labels(values, uniques, 0, 0)
         return uniques.to_array(), labels
 
     @cython.boundscheck(False)
-    def get_labels(self, float64_t[:] values, Float64Vector uniques,
-                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
-                   bint check_null=True):
+    cdef _get_labels(self, uint16_t[::1] keys, UInt16Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
         cdef:
-            Py_ssize_t i, n = len(values)
-            int64_t[:] labels
-            Py_ssize_t idx, count = count_prior
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
             int ret = 0
-            float64_t val
-            khiter_t k
-            Float64VectorData *ud
+            UInt16VectorData *ud
 
-        labels = np.empty(n, dtype=np.int64)
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
         ud = uniques.data
 
         with nogil:
-            for i in range(n):
-                val = values[i]
-
-                if check_null and val != val:
-                    labels[i] = na_sentinel
-                    continue
-
-                k = kh_get_float64(self.table, val)
-
-                if k != self.table.n_buckets:
-                    idx = self.table.vals[k]
-                    labels[i] = idx
-                else:
-                    k = kh_put_float64(self.table, val, &ret)
-                    self.table.vals[k] = count
+            ret = swiss_uint16_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
 
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
                     if needs_resize(ud):
                         with gil:
                             uniques.resize()
-                    append_data_float64(ud, val)
-                    labels[i] = count
-                    count += 1
+                    append_data_uint16(ud, keys[i])
 
         return np.asarray(labels)
 
     @cython.boundscheck(False)
-    def get_labels_groupby(self, float64_t[:] values):
+    def get_labels(self, uint16_t[:] values, UInt16Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
         cdef:
             Py_ssize_t i, n = len(values)
-            int64_t[:] labels
-            Py_ssize_t idx, count = 0
-            int ret = 0
-            float64_t val
-            khiter_t k
-            Float64Vector uniques = Float64Vector()
-            Float64VectorData *ud
-
-        labels = np.empty(n, dtype=np.int64)
-        ud = uniques.data
-
-        with nogil:
-            for i in range(n):
-                val = values[i]
-
-                # specific for groupby
-                if val < 0:
-                    labels[i] = -1
-                    continue
-
-                k = kh_get_float64(self.table, val)
-                if k != self.table.n_buckets:
-                    idx = self.table.vals[k]
-                    labels[i] = idx
-                else:
-                    k = kh_put_float64(self.table, val, &ret)
-                    self.table.vals[k] = count
-
-                    if needs_resize(ud):
-                        with gil:
-                            uniques.resize()
-                    append_data_float64(ud, val)
-                    labels[i] = count
-                    count += 1
+            uint16_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            uint16_t val
 
-        arr_uniques = uniques.to_array()
-
-        return np.asarray(labels), arr_uniques
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
 
     @cython.boundscheck(False)
-    def unique(self, float64_t[:] values):
+    def get_labels_groupby(self, uint16_t[:] values):
         cdef:
             Py_ssize_t i, n = len(values)
-            int ret = 0
-            float64_t val
-            khiter_t k
-            bint seen_na = 0
-            Float64Vector uniques = Float64Vector()
-            Float64VectorData *ud
-
-        ud = uniques.data
+            uint16_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            UInt16Vector uniques = UInt16Vector()
 
+        # specific for groupby
         with nogil:
             for i in range(n):
-                val = values[i]
+                skip[i] = keys[i] < 0
 
-                if val == val:
-                    k = kh_get_float64(self.table, val)
-                    if k == self.table.n_buckets:
-                        kh_put_float64(self.table, val, &ret)
-                        if needs_resize(ud):
-                            with gil:
-                                uniques.resize()
-                        append_data_float64(ud, val)
-                elif not seen_na:
-                    seen_na = 1
-                    if needs_resize(ud):
-                        with gil:
-                            uniques.resize()
-                    append_data_float64(ud, NAN)
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
+
+    @cython.boundscheck(False)
+    def unique(self, uint16_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            uint16_t[::1] keys = np.ascontiguousarray(values)
+            UInt16Vector uniques = UInt16Vector()
 
+        self._get_labels(keys, uniques, swiss_uint16_size(self.table),
+                         None, -1)
         return uniques.to_array()
 
-cdef class Int64HashTable(HashTable):
+cdef class UInt8HashTable(HashTable):
 
     def __cinit__(self, size_hint=1):
-        self.table = kh_init_int64()
-        if size_hint is not None:
-            kh_resize_int64(self.table, size_hint)
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_uint8_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
 
     def __len__(self):
-        return self.table.size
+        return swiss_uint8_size(self.table)
 
     def __dealloc__(self):
-        kh_destroy_int64(self.table)
+        swiss_uint8_free(self.table)
 
     def __contains__(self, object key):
-        cdef khiter_t k
-        k = kh_get_int64(self.table, key)
-        return k != self.table.n_buckets
+        cdef int64_t loc
+        return swiss_uint8_get(self.table, key, &loc) == 1
 
-    cpdef get_item(self, int64_t val):
-        cdef khiter_t k
-        k = kh_get_int64(self.table, val)
-        if k != self.table.n_buckets:
-            return self.table.vals[k]
+    cpdef get_item(self, uint8_t val):
+        cdef int64_t loc
+        if swiss_uint8_get(self.table, val, &loc):
+            return loc
         else:
             raise KeyError(val)
 
-    def get_iter_test(self, int64_t key, Py_ssize_t iterations):
-        cdef Py_ssize_t i, val=0
-        for i in range(iterations):
-            k = kh_get_int64(self.table, val)
-            if k != self.table.n_buckets:
-                val = self.table.vals[k]
-
-    cpdef set_item(self, int64_t key, Py_ssize_t val):
+    def get_iter_test(self, uint8_t key, Py_ssize_t iterations):
         cdef:
-            khiter_t k
-            int ret = 0
+            Py_ssize_t i
+            int64_t val = 0
+        for i in range(iterations):
+            swiss_uint8_get(self.table, val, &val)
 
-        k = kh_put_int64(self.table, key, &ret)
-        self.table.keys[k] = key
-        if kh_exist_int64(self.table, k):
-            self.table.vals[k] = val
-        else:
-            raise KeyError(key)
+    cpdef set_item(self, uint8_t key, Py_ssize_t val):
+        if swiss_uint8_set(self.table, key, val) != 0:
+            raise MemoryError()
 
     @cython.boundscheck(False)
-    def map(self, int64_t[:] keys, int64_t[:] values):
+    def map(self, uint8_t[:] keys, int64_t[:] values):
         cdef:
             Py_ssize_t i, n = len(values)
             int ret = 0
-            int64_t key
-            khiter_t k
 
         with nogil:
             for i in range(n):
-                key = keys[i]
-                k = kh_put_int64(self.table, key, &ret)
-                self.table.vals[k] = <Py_ssize_t> values[i]
+                ret |= swiss_uint8_set(self.table, keys[i], values[i])
+
+        if ret != 0:
+            raise MemoryError()
 
     @cython.boundscheck(False)
-    def map_locations(self, ndarray[int64_t, ndim=1] values):
+    def map_locations(self, ndarray[uint8_t, ndim=1] values):
         cdef:
             Py_ssize_t i, n = len(values)
             int ret = 0
-            int64_t val
-            khiter_t k
 
         with nogil:
             for i in range(n):
-                val = values[i]
-                k = kh_put_int64(self.table, val, &ret)
-                self.table.vals[k] = i
+                ret |= swiss_uint8_set(self.table, values[i], i)
+
+        if ret != 0:
+            raise MemoryError()
 
     @cython.boundscheck(False)
-    def lookup(self, int64_t[:] values):
+    def lookup(self, uint8_t[:] values):
         cdef:
-            Py_ssize_t i, n = len(values)
-            int ret = 0
-            int64_t val
-            khiter_t k
-            int64_t[:] locs = np.empty(n, dtype=np.int64)
+            Py_ssize_t n = len(values)
+            uint8_t[::1] keys = np.ascontiguousarray(values)
+            int64_t[::1] locs = np.empty(n, dtype=np.int64)
 
-        with nogil:
-            for i in range(n):
-                val = values[i]
-                k = kh_get_int64(self.table, val)
-                if k != self.table.n_buckets:
-                    locs[i] = self.table.vals[k]
-                else:
-                    locs[i] = -1
+        if n > 0:
+            with nogil:
+                swiss_uint8_lookup(self.table, &keys[0], n, &locs[0])
 
         return np.asarray(locs)
 
-    def factorize(self, int64_t values):
-        uniques = Int64Vector()
+    def factorize(self, uint8_t values):
+        uniques = UInt8Vector()
         labels = self.get_labels(values, uniques, 0, 0)
         return uniques.to_array(), labels
 
     @cython.boundscheck(False)
-    def get_labels(self, int64_t[:] values, Int64Vector uniques,
-                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
-                   bint check_null=True):
+    cdef _get_labels(self, uint8_t[::1] keys, UInt8Vector uniques,
+                     int64_t count_prior, uint8_t[::1] skip,
+                     int64_t skip_label):
+        # Labels keys[0:n] with the table. Keys that were not in the table
+        # take the labels count_prior, count_prior + 1, ... and are appended
+        # to uniques in that order
         cdef:
-            Py_ssize_t i, n = len(values)
-            int64_t[:] labels
-            Py_ssize_t idx, count = count_prior
+            Py_ssize_t i, n = len(keys)
+            int64_t[::1] labels = np.empty(n, dtype=np.int64)
+            uint8_t[::1] inserted = np.empty(n, dtype=np.uint8)
+            int64_t count = count_prior
+            uint8_t *skip_data = NULL
             int ret = 0
-            int64_t val
-            khiter_t k
-            Int64VectorData *ud
+            UInt8VectorData *ud
 
-        labels = np.empty(n, dtype=np.int64)
+        if n == 0:
+            return np.asarray(labels)
+
+        if skip is not None:
+            skip_data = &skip[0]
         ud = uniques.data
 
         with nogil:
-            for i in range(n):
-                val = values[i]
-
-                if check_null and val == iNaT:
-                    labels[i] = na_sentinel
-                    continue
-
-                k = kh_get_int64(self.table, val)
-
-                if k != self.table.n_buckets:
-                    idx = self.table.vals[k]
-                    labels[i] = idx
-                else:
-                    k = kh_put_int64(self.table, val, &ret)
-                    self.table.vals[k] = count
+            ret = swiss_uint8_get_labels(self.table, &keys[0], n, &count,
+                                             &labels[0], skip_data,
+                                             skip_label, &inserted[0])
+        if ret != 0:
+            raise MemoryError()
 
+        # Labels cannot tell the new keys apart, as values stored by set_item
+        # or map_locations may equal the labels handed out here
+        with nogil:
+            for i in range(n):
+                if inserted[i]:
                     if needs_resize(ud):
                         with gil:
                             uniques.resize()
-                    append_data_int64(ud, val)
-                    labels[i] = count
-                    count += 1
+                    append_data_uint8(ud, keys[i])
 
         return np.asarray(labels)
 
     @cython.boundscheck(False)
-    def get_labels_groupby(self, int64_t[:] values):
+    def get_labels(self, uint8_t[:] values, UInt8Vector uniques,
+                   Py_ssize_t count_prior, Py_ssize_t na_sentinel,
+                   bint check_null=True):
         cdef:
             Py_ssize_t i, n = len(values)
-            int64_t[:] labels
-            Py_ssize_t idx, count = 0
-            int ret = 0
-            int64_t val
-            khiter_t k
-            Int64Vector uniques = Int64Vector()
-            Int64VectorData *ud
-
-        labels = np.empty(n, dtype=np.int64)
-        ud = uniques.data
-
-        with nogil:
-            for i in range(n):
-                val = values[i]
-
-                # specific for groupby
-                if val < 0:
-                    labels[i] = -1
-                    continue
-
-                k = kh_get_int64(self.table, val)
-                if k != self.table.n_buckets:
-                    idx = self.table.vals[k]
-                    labels[i] = idx
-                else:
-                    k = kh_put_int64(self.table, val, &ret)
-                    self.table.vals[k] = count
-
-                    if needs_resize(ud):
-                        with gil:
-                            uniques.resize()
-                    append_data_int64(ud, val)
-                    labels[i] = count
-                    count += 1
+            uint8_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = None
+            uint8_t val
 
-        arr_uniques = uniques.to_array()
-
-        return np.asarray(labels), arr_uniques
+        return self._get_labels(keys, uniques, count_prior, skip, na_sentinel)
 
     @cython.boundscheck(False)
-    def unique(self, int64_t[:] values):
+    def get_labels_groupby(self, uint8_t[:] values):
         cdef:
             Py_ssize_t i, n = len(values)
-            int ret = 0
-            int64_t val
-            khiter_t k
-            bint seen_na = 0
-            Int64Vector uniques = Int64Vector()
-            Int64VectorData *ud
-
-        ud = uniques.data
+            uint8_t[::1] keys = np.ascontiguousarray(values)
+            uint8_t[::1] skip = np.empty(n, dtype=np.uint8)
+            UInt8Vector uniques = UInt8Vector()
 
+        # specific for groupby
         with nogil:
             for i in range(n):
-                val = values[i]
+                skip[i] = keys[i] < 0
 
-                k = kh_get_int64(self.table, val)
-                if k == self.table.n_buckets:
-                    kh_put_int64(self.table, val, &ret)
-                    if needs_resize(ud):
-                        with gil:
-                            uniques.resize()
-                    append_data_int64(ud, val)
+        labels = self._get_labels(keys, uniques, 0, skip, -1)
+        return labels, uniques.to_array()
 
+    @cython.boundscheck(False)
+    def unique(self, uint8_t[:] values):
+        # The table treats all NaNs as one key, so a NaN is kept once, where
+        # it first occurs
+        cdef:
+            uint8_t[::1] keys = np.ascontiguousarray(values)
+            UInt8Vector uniques = UInt8Vector()
+
+        self._get_labels(keys, uniques, swiss_uint8_size(self.table),
+                         None, -1)
         return uniques.to_array()
 
 
+cdef inline const char *_string_key(object val, Py_ssize_t *length) except NULL:
+    cdef const char *key = util.get_string_key(val, length)
+    if key is NULL:
+        raise TypeError('expected a str, got {0!r}'.format(val))
+    return key
+
+
 cdef class StringHashTable(HashTable):
-    cdef kh_str_t *table
+    # Keyed on the UTF-8 bytes of str values, which the table copies into
+    # an arena of its own
+    cdef swiss_bytes_t *table
+
+    def __cinit__(self, size_hint=1):
+        if size_hint is None:
+            size_hint = 1
+        self.table = swiss_bytes_new(size_hint)
+        if self.table is NULL:
+            raise MemoryError()
 
-    def __cinit__(self, int size_hint=1):
-        self.table = kh_init_str()
-        if size_hint is not None:
-            kh_resize_str(self.table, size_hint)
+    def __len__(self):
+        return swiss_bytes_size(self.table)
 
     def __dealloc__(self):
-        kh_destroy_str(self.table)
+        swiss_bytes_free(self.table)
 
     cpdef get_item(self, object val):
-        cdef khiter_t k
-        k = kh_get_str(self.table, util.get_c_string(val))
-        if k != self.table.n_buckets:
-            return self.table.vals[k]
+        cdef:
+            Py_ssize_t length
+            const char *key = _string_key(val, &length)
+            int64_t loc
+        if swiss_bytes_get(self.table, key, length, &loc):
+            return loc
         else:
             raise KeyError(val)
 
     def get_iter_test(self, object key, Py_ssize_t iterations):
-        cdef Py_ssize_t i, val
+        cdef:
+            Py_ssize_t i, length
+            int64_t val
         for i in range(iterations):
-            k = kh_get_str(self.table, util.get_c_string(key))
-            if k != self.table.n_buckets:
-                val = self.table.vals[k]
+            swiss_bytes_get(self.table, _string_key(key, &length), length,
+                            &val)
 
     cpdef set_item(self, object key, Py_ssize_t val):
         cdef:
-            khiter_t k
-            int ret = 0
-            char* buf
-
-        buf = util.get_c_string(key)
-
-        k = kh_put_str(self.table, buf, &ret)
-        self.table.keys[k] = key
-        if kh_exist_str(self.table, k):
-            self.table.vals[k] = val
-        else:
-            raise KeyError(key)
+            Py_ssize_t length
+            const char *buf = _string_key(key, &length)
+        if swiss_bytes_set(self.table, buf, length, val) != 0:
+            raise MemoryError()
 
     def get_indexer(self, ndarray[object] values):
         cdef:
-            Py_ssize_t i, n = len(values)
+            Py_ssize_t i, length, n = len(values)
             ndarray[int64_t] labels = np.empty(n, dtype=np.int64)
-            char *buf
+            const char *buf
             int64_t *resbuf = <int64_t*> labels.data
-            khiter_t k
-            kh_str_t *table = self.table
 
         for i in range(n):
-            buf = util.get_c_string(values[i])
-            k = kh_get_str(table, buf)
-            if k != table.n_buckets:
-                resbuf[i] = table.vals[k]
-            else:
+            buf = _string_key(values[i], &length)
+            if not swiss_bytes_get(self.table, buf, length, &resbuf[i]):
                 resbuf[i] = -1
         return labels
 
     def unique(self, ndarray[object] values):
         cdef:
-            Py_ssize_t i, n = len(values)
-            int ret = 0
+            Py_ssize_t i, length, n = len(values)
+            int64_t count = swiss_bytes_size(self.table), prior, loc
             object val
-            char *buf
-            khiter_t k
+            const char *buf
             ObjectVector uniques = ObjectVector()
 
         for i in range(n):
             val = values[i]
-            buf = util.get_c_string(val)
-            k = kh_get_str(self.table, buf)
-            if k == self.table.n_buckets:
-                kh_put_str(self.table, buf, &ret)
+            buf = _string_key(val, &length)
+            prior = count
+            if swiss_bytes_get_or_insert(self.table, buf, length, &count,
+                                         &loc) != 0:
+                raise MemoryError()
+            if count != prior:
                 uniques.append(val)
 
         return uniques.to_array()
 
     def factorize(self, ndarray[object] values):
         cdef:
-            Py_ssize_t i, n = len(values)
+            Py_ssize_t i, length, n = len(values)
             ndarray[int64_t] labels = np.empty(n, dtype=np.int64)
             dict reverse = {}
-            Py_ssize_t idx, count = 0
-            int ret = 0
+            int64_t count = swiss_bytes_size(self.table), prior, loc
             object val
-            char *buf
-            khiter_t k
+            const char *buf
 
         for i in range(n):
             val = values[i]
-            buf = util.get_c_string(val)
-            k = kh_get_str(self.table, buf)
-            if k != self.table.n_buckets:
-                idx = self.table.vals[k]
-                labels[i] = idx
-            else:
-                k = kh_put_str(self.table, buf, &ret)
-                # print 'putting %s, %s' % (val, count)
-
-                self.table.vals[k] = count
-                reverse[count] = val
-                labels[i] = count
-                count += 1
+            buf = _string_key(val, &length)
+            prior = count
+            if swiss_bytes_get_or_insert(self.table, buf, length, &count,
+                                         &loc) != 0:
+                raise MemoryError()
+            if count != prior:
+                reverse[loc] = val
+            labels[i] = loc
 
         return reverse, labels
 
+    @cython.boundscheck(False)
+    def get_labels_buffers(self, int32_t[::1] offsets, uint8_t[::1] data,
+                           object mask=None, int64_t na_sentinel=-1):
+        """
+        Labels of strings given as the offsets and UTF-8 data buffers of a
+        native string array, such as those of TextReader with
+        string_storage='native'. Strings not yet in the table get the
+        labels len(self), len(self) + 1, ... in order of first occurrence,
+        and those where mask is True get na_sentinel
+        """
+        cdef:
+            Py_ssize_t i, n = len(offsets) - 1
+            int64_t[::1] labels = np.empty(max(n, 0), dtype=np.int64)
+            int64_t count = swiss_bytes_size(self.table)
+            uint8_t[::1] skip
+            uint8_t *skip_data = NULL
+            const uint8_t *data_ptr = NULL
+            int ret = 0
+
+        if n <= 0:
+            return np.asarray(labels)
+        # The table reads every string without further checks
+        if offsets[0] < 0:
+            raise ValueError('offsets must be non-negative')
+        for i in range(n):
+            if offsets[i + 1] < offsets[i]:
+                raise ValueError('offsets must not decrease')
+        if offsets[n] > len(data):
+            raise ValueError('offsets out of bounds of data')
+        if mask is not None:
+            skip = np.ascontiguousarray(mask, dtype=np.uint8)
+            if len(skip) != n:
+                raise ValueError('mask must have one value per string')
+            skip_data = &skip[0]
+        if len(data) > 0:
+            data_ptr = &data[0]
+
+        with nogil:
+            ret = swiss_bytes_get_labels(self.table, &offsets[0], data_ptr, n,
+                                         &count, &labels[0], skip_data,
+                                         na_sentinel)
+        if ret != 0:
+            raise MemoryError()
+        return np.asarray(labels)
+
+    def keys_buffers(self):
+        """
+        The keys in the order they were inserted, as int32 offsets and uint8
+        data buffers
+        """
+        cdef:
+            const int64_t *key_offsets
+            const uint8_t *key_data
+            Py_ssize_t i, n = swiss_bytes_size(self.table)
+            ndarray[int32_t] offsets = np.zeros(n + 1, dtype=np.int32)
+            ndarray[uint8_t] data
+
+        swiss_bytes_keys(self.table, &key_offsets, &key_data)
+        if n == 0:
+            return offsets, np.empty(0, dtype=np.uint8)
+        if key_offsets[n] > INT32_MAX:
+            raise ValueError('keys have more than 2GB of data')
+        for i in range(n + 1):
+            offsets[i] = key_offsets[i]
+        data = np.empty(key_offsets[n], dtype=np.uint8)
+        if key_offsets[n] > 0:
+            memcpy(data.data, key_data, key_offsets[n])
+        return offsets, data
+
 
 na_sentinel = object
 
@@ -11,187 +11,1523 @@ WARNING: DO NOT edit .pxi FILE directly, .pxi is generated from .pxi.in
 
 @cython.wraparound(False)
 @cython.boundscheck(False)
-cdef build_count_table_float64(float64_t[:] values,
-                                 kh_float64_t *table, bint dropna):
+cpdef value_count_float64(float64_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
     cdef:
-        khiter_t k
         Py_ssize_t i, n = len(values)
-        float64_t val
+        float64_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        float64_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        float64_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
         int ret = 0
 
+    if n == 0:
+        return np.empty(0, dtype=np.float64), np.empty(0, dtype=np.int64)
+
+    if dropna:
+        skip = np.empty(n, dtype=np.uint8)
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] != keys[i]
+        skip_data = &skip[0]
+
     with nogil:
-        kh_resize_float64(table, n)
+        ret = swiss_float64_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
 
-        for i in range(n):
-            val = values[i]
-            if val == val or not dropna:
-                k = kh_get_float64(table, val)
-                if k != table.n_buckets:
-                    table.vals[k] += 1
-                else:
-                    k = kh_put_float64(table, val, &ret)
-                    table.vals[k] = 1
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.float64)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(float64_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
+
+    return np.asarray(result_keys), np.asarray(result_counts)
 
 
 @cython.wraparound(False)
 @cython.boundscheck(False)
-cpdef value_count_float64(float64_t[:] values, bint dropna):
+def duplicated_float64(float64_t[:] values,
+                         object keep='first'):
     cdef:
-        Py_ssize_t i=0
-        kh_float64_t *table
-        float64_t[:] result_keys
-        int64_t[:] result_counts
-        int k
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        float64_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        float64_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
 
-    table = kh_init_float64()
-    build_count_table_float64(values, table, dropna)
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
 
-    result_keys = np.empty(table.n_occupied, dtype=np.float64)
-    result_counts = np.zeros(table.n_occupied, dtype=np.int64)
+    if n == 0:
+        return out
 
+    # The values are marked through their labels, which index a flag array
     with nogil:
-        for k in range(table.n_buckets):
-            if kh_exist_float64(table, k):
-                result_keys[i] = table.keys[k]
-                result_counts[i] = table.vals[k]
-                i += 1
-    kh_destroy_float64(table)
+        ret = swiss_float64_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_float64(float64_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[float64]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        float64_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        float64_t *uniques_data = NULL
+        float64_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.float64)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_float64_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.float64)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(float64_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_float32(float32_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        float32_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        float32_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        float32_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.float32), np.empty(0, dtype=np.int64)
+
+    if dropna:
+        skip = np.empty(n, dtype=np.uint8)
+        with nogil:
+            for i in range(n):
+                skip[i] = keys[i] != keys[i]
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_float32_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.float32)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(float32_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
 
     return np.asarray(result_keys), np.asarray(result_counts)
 
 
 @cython.wraparound(False)
 @cython.boundscheck(False)
-def duplicated_float64(float64_t[:] values,
+def duplicated_float32(float32_t[:] values,
+                         object keep='first'):
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        float32_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        float32_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
+
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
+
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_float32_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_float32(float32_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[float32]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        float32_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        float32_t *uniques_data = NULL
+        float32_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.float32)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_float32_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.float32)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(float32_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_int64(int64_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int64_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int64_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        int64_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.int64), np.empty(0, dtype=np.int64)
+
+    with nogil:
+        ret = swiss_int64_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.int64)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(int64_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
+
+    return np.asarray(result_keys), np.asarray(result_counts)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def duplicated_int64(int64_t[:] values,
                          object keep='first'):
     cdef:
-        int ret = 0, k
-        float64_t value
         Py_ssize_t i, n = len(values)
-        kh_float64_t * table = kh_init_float64()
+        int64_t label
+        int64_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        int64_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
         ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
+
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
+
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_int64_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
 
-    kh_resize_float64(table, min(n, _SIZE_HINT_LIMIT))
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_int64(int64_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[int64]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        int64_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int64_t *uniques_data = NULL
+        int64_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.int64)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_int64_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_int32(int32_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int32_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int32_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        int32_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.int32), np.empty(0, dtype=np.int64)
+
+    with nogil:
+        ret = swiss_int32_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.int32)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(int32_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
+
+    return np.asarray(result_keys), np.asarray(result_counts)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def duplicated_int32(int32_t[:] values,
+                         object keep='first'):
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        int32_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        int32_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
 
     if keep not in ('last', 'first', False):
         raise ValueError('keep must be either "first", "last" or False')
 
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_int32_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
     if keep == 'last':
         with nogil:
-            for i from n > i >=0:
-                kh_put_float64(table, values[i], &ret)
-                out[i] = ret == 0
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
     elif keep == 'first':
         with nogil:
             for i from 0 <= i < n:
-                kh_put_float64(table, values[i], &ret)
-                out[i] = ret == 0
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
     else:
+        # seen counts the occurrences up to 2
         with nogil:
             for i from 0 <= i < n:
-                value = values[i]
-                k = kh_get_float64(table, value)
-                if k != table.n_buckets:
-                    out[table.vals[k]] = 1
-                    out[i] = 1
-                else:
-                    k = kh_put_float64(table, value, &ret)
-                    table.keys[k] = value
-                    table.vals[k] = i
-                    out[i] = 0
-    kh_destroy_float64(table)
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
     return out
 
 
 @cython.wraparound(False)
 @cython.boundscheck(False)
-cdef build_count_table_int64(int64_t[:] values,
-                                 kh_int64_t *table, bint dropna):
+def factorize_int32(int32_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[int32]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        int32_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int32_t *uniques_data = NULL
+        int32_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.int32)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_int32_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.int32)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(int32_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_int16(int16_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
     cdef:
-        khiter_t k
         Py_ssize_t i, n = len(values)
-        int64_t val
+        int16_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int16_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        int16_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
         int ret = 0
 
+    if n == 0:
+        return np.empty(0, dtype=np.int16), np.empty(0, dtype=np.int64)
+
     with nogil:
-        kh_resize_int64(table, n)
+        ret = swiss_int16_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.int16)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(int16_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
 
-        for i in range(n):
-            val = values[i]
-            if val == val or not dropna:
-                k = kh_get_int64(table, val)
-                if k != table.n_buckets:
-                    table.vals[k] += 1
-                else:
-                    k = kh_put_int64(table, val, &ret)
-                    table.vals[k] = 1
+    return np.asarray(result_keys), np.asarray(result_counts)
 
 
 @cython.wraparound(False)
 @cython.boundscheck(False)
-cpdef value_count_int64(int64_t[:] values, bint dropna):
+def duplicated_int16(int16_t[:] values,
+                         object keep='first'):
     cdef:
-        Py_ssize_t i=0
-        kh_int64_t *table
-        int64_t[:] result_keys
-        int64_t[:] result_counts
-        int k
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        int16_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        int16_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
 
-    table = kh_init_int64()
-    build_count_table_int64(values, table, dropna)
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
 
-    result_keys = np.empty(table.n_occupied, dtype=np.int64)
-    result_counts = np.zeros(table.n_occupied, dtype=np.int64)
+    if n == 0:
+        return out
 
+    # The values are marked through their labels, which index a flag array
     with nogil:
-        for k in range(table.n_buckets):
-            if kh_exist_int64(table, k):
-                result_keys[i] = table.keys[k]
-                result_counts[i] = table.vals[k]
-                i += 1
-    kh_destroy_int64(table)
+        ret = swiss_int16_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_int16(int16_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[int16]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        int16_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int16_t *uniques_data = NULL
+        int16_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.int16)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_int16_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.int16)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(int16_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_int8(int8_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int8_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int8_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        int8_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.int8), np.empty(0, dtype=np.int64)
+
+    with nogil:
+        ret = swiss_int8_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.int8)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(int8_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
 
     return np.asarray(result_keys), np.asarray(result_counts)
 
 
 @cython.wraparound(False)
 @cython.boundscheck(False)
-def duplicated_int64(int64_t[:] values,
+def duplicated_int8(int8_t[:] values,
+                         object keep='first'):
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        int8_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        int8_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
+
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
+
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_int8_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_int8(int8_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[int8]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        int8_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        int8_t *uniques_data = NULL
+        int8_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.int8)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_int8_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.int8)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(int8_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_uint64(uint64_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        uint64_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint64_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        uint64_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.uint64), np.empty(0, dtype=np.int64)
+
+    with nogil:
+        ret = swiss_uint64_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.uint64)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(uint64_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
+
+    return np.asarray(result_keys), np.asarray(result_counts)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def duplicated_uint64(uint64_t[:] values,
+                         object keep='first'):
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        uint64_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint64_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
+
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
+
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_uint64_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_uint64(uint64_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[uint64]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        uint64_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint64_t *uniques_data = NULL
+        uint64_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.uint64)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_uint64_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.uint64)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(uint64_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_uint32(uint32_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        uint32_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint32_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        uint32_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.uint32), np.empty(0, dtype=np.int64)
+
+    with nogil:
+        ret = swiss_uint32_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.uint32)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(uint32_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
+
+    return np.asarray(result_keys), np.asarray(result_counts)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def duplicated_uint32(uint32_t[:] values,
+                         object keep='first'):
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        uint32_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint32_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
+
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
+
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_uint32_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_uint32(uint32_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[uint32]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        uint32_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint32_t *uniques_data = NULL
+        uint32_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.uint32)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_uint32_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.uint32)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(uint32_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_uint16(uint16_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        uint16_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint16_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        uint16_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.uint16), np.empty(0, dtype=np.int64)
+
+    with nogil:
+        ret = swiss_uint16_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.uint16)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(uint16_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
+
+    return np.asarray(result_keys), np.asarray(result_counts)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def duplicated_uint16(uint16_t[:] values,
                          object keep='first'):
     cdef:
-        int ret = 0, k
-        int64_t value
         Py_ssize_t i, n = len(values)
-        kh_int64_t * table = kh_init_int64()
+        int64_t label
+        uint16_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint16_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
         ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
+
+    if keep not in ('last', 'first', False):
+        raise ValueError('keep must be either "first", "last" or False')
+
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_uint16_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
+    if keep == 'last':
+        with nogil:
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    elif keep == 'first':
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
+    else:
+        # seen counts the occurrences up to 2
+        with nogil:
+            for i from 0 <= i < n:
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
+    return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_uint16(uint16_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
 
-    kh_resize_int64(table, min(n, _SIZE_HINT_LIMIT))
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[uint16]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        uint16_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint16_t *uniques_data = NULL
+        uint16_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.uint16)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_uint16_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.uint16)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(uint16_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+cpdef value_count_uint8(uint8_t[:] values, bint dropna):
+    """
+    The distinct values, leaving out NaN if dropna, and their counts.
+    Integers in a small range are counted directly and come out sorted
+    """
+    cdef:
+        Py_ssize_t i, n = len(values)
+        uint8_t[::1] keys = np.ascontiguousarray(values)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint8_t *keys_data = NULL
+        int64_t *counts_data = NULL
+        uint8_t[::1] result_keys
+        int64_t[::1] result_counts
+        int64_t num_uniques = 0
+        int ret = 0
+
+    if n == 0:
+        return np.empty(0, dtype=np.uint8), np.empty(0, dtype=np.int64)
+
+    with nogil:
+        ret = swiss_uint8_value_counts(&keys[0], n, skip_data, &keys_data,
+                                           &counts_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        result_keys = np.empty(num_uniques, dtype=np.uint8)
+        result_counts = np.empty(num_uniques, dtype=np.int64)
+        if num_uniques > 0:
+            memcpy(&result_keys[0], keys_data,
+                   num_uniques * sizeof(uint8_t))
+            memcpy(&result_counts[0], counts_data,
+                   num_uniques * sizeof(int64_t))
+    finally:
+        free(keys_data)
+        free(counts_data)
+
+    return np.asarray(result_keys), np.asarray(result_counts)
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def duplicated_uint8(uint8_t[:] values,
+                         object keep='first'):
+    cdef:
+        Py_ssize_t i, n = len(values)
+        int64_t label
+        uint8_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t *uniques_data = NULL
+        int64_t num_uniques = 0
+        uint8_t[::1] seen
+        ndarray[uint8_t, ndim=1, cast=True] out = np.empty(n, dtype='bool')
+        int ret = 0
 
     if keep not in ('last', 'first', False):
         raise ValueError('keep must be either "first", "last" or False')
 
+    if n == 0:
+        return out
+
+    # The values are marked through their labels, which index a flag array
+    with nogil:
+        ret = swiss_uint8_factorize(&keys[0], n, 1, &labels[0], NULL, -1,
+                                        &uniques_data, &num_uniques)
+    free(uniques_data)
+    if ret != 0:
+        raise MemoryError()
+
+    seen = np.zeros(num_uniques, dtype=np.uint8)
     if keep == 'last':
         with nogil:
-            for i from n > i >=0:
-                kh_put_int64(table, values[i], &ret)
-                out[i] = ret == 0
+            for i from n > i >= 0:
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
     elif keep == 'first':
         with nogil:
             for i from 0 <= i < n:
-                kh_put_int64(table, values[i], &ret)
-                out[i] = ret == 0
+                label = labels[i]
+                out[i] = seen[label]
+                seen[label] = 1
     else:
+        # seen counts the occurrences up to 2
         with nogil:
             for i from 0 <= i < n:
-                value = values[i]
-                k = kh_get_int64(table, value)
-                if k != table.n_buckets:
-                    out[table.vals[k]] = 1
-                    out[i] = 1
-                else:
-                    k = kh_put_int64(table, value, &ret)
-                    table.keys[k] = value
-                    table.vals[k] = i
-                    out[i] = 0
-    kh_destroy_int64(table)
+                label = labels[i]
+                if seen[label] < 2:
+                    seen[label] += 1
+            for i from 0 <= i < n:
+                out[i] = seen[labels[i]] > 1
     return out
+
+
+@cython.wraparound(False)
+@cython.boundscheck(False)
+def factorize_uint8(uint8_t[:] values, object mask=None,
+                        int64_t na_sentinel=-1, int nthreads=1):
+    """
+    Factorize values with up to nthreads threads, which are only used on
+    large arrays. Values where mask is True are labeled na_sentinel
+
+    Returns
+    -------
+    labels : ndarray[int64]
+    uniques : ndarray[uint8]
+        the distinct values in order of first occurrence
+    """
+    cdef:
+        Py_ssize_t n = len(values)
+        uint8_t[::1] keys = np.ascontiguousarray(values)
+        int64_t[::1] labels = np.empty(n, dtype=np.int64)
+        uint8_t[::1] skip
+        uint8_t *skip_data = NULL
+        uint8_t *uniques_data = NULL
+        uint8_t[::1] uniques
+        int64_t num_uniques = 0
+        int ret = 0
+
+    # The C call reads one mask value per key without the GIL
+    if mask is not None and len(mask) != n:
+        raise ValueError('mask must have the length of values')
+
+    if n == 0:
+        return np.asarray(labels), np.empty(0, dtype=np.uint8)
+
+    if mask is not None:
+        skip = np.ascontiguousarray(mask, dtype=np.uint8)
+        skip_data = &skip[0]
+
+    with nogil:
+        ret = swiss_uint8_factorize(&keys[0], n, nthreads, &labels[0],
+                                        skip_data, na_sentinel,
+                                        &uniques_data, &num_uniques)
+    if ret != 0:
+        raise MemoryError()
+
+    try:
+        uniques = np.empty(num_uniques, dtype=np.uint8)
+        if num_uniques > 0:
+            memcpy(&uniques[0], uniques_data,
+                   num_uniques * sizeof(uint8_t))
+    finally:
+        free(uniques_data)
+
+    return np.asarray(labels), np.asarray(uniques)
@@ -113,6 +113,31 @@ get_c_string(PyObject* obj) {
 #endif
 }
 
+// The UTF-8 bytes of a str (of a bytes str on Python 2) without copying
+// them, or NULL if obj is not exactly a str or cannot be encoded
+PANDAS_INLINE const char*
+get_string_key(PyObject* obj, Py_ssize_t* length) {
+#if PY_VERSION_HEX >= 0x03030000
+  const char *key;
+  if (!PyUnicode_CheckExact(obj)) {
+    return NULL;
+  }
+  key = PyUnicode_AsUTF8AndSize(obj, length);
+  if (key == NULL) {
+    PyErr_Clear();
+  }
+  return key;
+#elif PY_VERSION_HEX >= 0x03000000
+  return NULL;
+#else
+  if (!PyString_CheckExact(obj)) {
+    return NULL;
+  }
+  *length = PyString_GET_SIZE(obj);
+  return PyString_AS_STRING(obj);
+#endif
+}
+
 PANDAS_INLINE PyObject*
 char_to_string(char* data) {
 #if PY_VERSION_HEX >= 0x03000000
@@ -166,6 +166,122 @@ void* buffer_rd_bytes(void *source, size_t nbytes,
 }
 
 
+/*
+
+  gzip source
+
+ */
+
+#ifdef HAVE_ZLIB
+
+#include <zlib.h>
+
+void *new_gzip_source(char *fname, size_t buffer_size) {
+    gzip_source *gzs;
+    gzFile gz;
+
+    gz = gzopen(fname, "rb");
+    if (gz == NULL) {
+        return NULL;
+    }
+
+    // zlib reads the compressed file in chunks of the same size
+    gzbuffer(gz, (unsigned) buffer_size);
+
+    gzs = (gzip_source *) malloc(sizeof(gzip_source));
+    if (gzs == NULL) {
+        gzclose(gz);
+        return NULL;
+    }
+
+    gzs->buffer = (char *) malloc(buffer_size + 1);
+    if (gzs->buffer == NULL) {
+        gzclose(gz);
+        free(gzs);
+        return NULL;
+    }
+    gzs->buffer[buffer_size] = '\0';
+
+    gzs->gz = (void *) gz;
+    gzs->buffer_size = buffer_size;
+
+    return (void *) gzs;
+}
+
+int del_gzip_source(void *gzs) {
+    if (gzs == NULL)
+        return 0;
+
+    gzclose((gzFile) GZS(gzs)->gz);
+    free(GZS(gzs)->buffer);
+    free(gzs);
+
+    return 0;
+}
+
+void* buffer_gzip_bytes(void *source, size_t nbytes,
+                        size_t *bytes_read, int *status) {
+    gzip_source *src = GZS(source);
+    gzFile gz = (gzFile) src->gz;
+    PyGILState_STATE state;
+    const char *msg = NULL;
+    int errnum = Z_OK;
+    int length;
+
+    if (nbytes > src->buffer_size) {
+        nbytes = src->buffer_size;
+    }
+
+    // the GIL is not needed, unless to report an error
+    length = gzread(gz, src->buffer, (unsigned) nbytes);
+
+    if (length > 0 && gzdirect(gz)) {
+        // zlib passes other files through as they are; Python's gzip does not
+        msg = "Not a gzipped file";
+    } else if (length <= 0) {
+        // including a truncated stream, which only shows at its end
+        msg = gzerror(gz, &errnum);
+        if (errnum == Z_OK) {
+            msg = NULL;
+        }
+    }
+
+    if (msg != NULL) {
+        state = PyGILState_Ensure();
+        PyErr_Format(PyExc_IOError, "Error reading gzip file: %s", msg);
+        PyGILState_Release(state);
+
+        *bytes_read = 0;
+        *status = CALLING_READ_FAILED;
+        return NULL;
+    }
+
+    *bytes_read = length;
+    *status = length == 0 ? REACHED_EOF : 0;
+
+    return (void *) src->buffer;
+}
+
+#else
+
+void *new_gzip_source(char *fname, size_t buffer_size) {
+    return NULL;
+}
+
+int del_gzip_source(void *gzs) {
+    return 0;
+}
+
+void* buffer_gzip_bytes(void *source, size_t nbytes,
+                        size_t *bytes_read, int *status) {
+    *bytes_read = 0;
+    *status = CALLING_READ_FAILED;
+    return NULL;
+}
+
+#endif
+
+
 #ifdef HAVE_MMAP
 
 #include <sys/stat.h>
@@ -260,6 +376,17 @@ void* buffer_mmap_bytes(void *source, size_t nbytes,
     return retval;
 }
 
+int tokenize_mmap_parallel(parser_t *self, int nthreads) {
+    memory_map *src = MM(self->source);
+    char *data = src->memmap + src->position;
+    size_t len = src->last_pos - src->position;
+
+    /* the parser takes the rest of the mapping at once */
+    src->position = src->last_pos;
+
+    return tokenize_all_rows_parallel(self, data, len, nthreads);
+}
+
 #else
 
 /* kludgy */
@@ -279,4 +406,275 @@ void* buffer_mmap_bytes(void *source, size_t nbytes,
   return NULL;
 }
 
+int tokenize_mmap_parallel(parser_t *self, int nthreads) {
+  return tokenize_all_rows(self);
+}
+
+#endif
+
+
+/*
+
+  Read-ahead source
+
+ */
+
+#ifndef _WIN32
+
+static void *readahead_thread(void *arg) {
+    readahead_source *src = RAS(arg);
+    PyGILState_STATE thread_state, state;
+    PyThreadState *save;
+    size_t bytes_read;
+    int slot, status;
+    char *data;
+
+    // Keep a Python thread state for the life of the thread, without the
+    // GIL: a Python file object is read under a thread state of its own,
+    // which would be discarded along with the exception of a failed read
+    thread_state = PyGILState_Ensure();
+    save = PyEval_SaveThread();
+
+    pthread_mutex_lock(&src->mutex);
+    while (!src->stop) {
+        if (src->count == src->nbuffers) {
+            pthread_cond_wait(&src->drained, &src->mutex);
+            continue;
+        }
+
+        // the slot after the filled ones belongs to this thread until it is
+        // counted, so it is filled without the lock
+        slot = (src->head + src->count) % src->nbuffers;
+        pthread_mutex_unlock(&src->mutex);
+
+        data = (char *) src->cb_io(src->source, src->buffer_size,
+                                   &bytes_read, &status);
+
+        if (status == 0 && bytes_read > src->caps[slot]) {
+            // e.g. a Python file object returning text, which is encoded
+            char *newbuf = (char *) realloc(src->buffers[slot], bytes_read);
+            if (newbuf == NULL) {
+                status = CALLING_READ_FAILED;
+            } else {
+                src->buffers[slot] = newbuf;
+                src->caps[slot] = bytes_read;
+            }
+        }
+        if (status == 0) {
+            memcpy(src->buffers[slot], data, bytes_read);
+        } else if (status == CALLING_READ_FAILED) {
+            // keep the exception for the thread that gets the status
+            state = PyGILState_Ensure();
+            PyErr_Fetch(&src->err_type, &src->err_value,
+                        &src->err_traceback);
+            PyGILState_Release(state);
+        }
+
+        pthread_mutex_lock(&src->mutex);
+        if (status != 0) {
+            src->status = status;
+            pthread_cond_signal(&src->filled);
+            break;
+        }
+        src->lengths[slot] = bytes_read;
+        src->count++;
+        pthread_cond_signal(&src->filled);
+    }
+    pthread_mutex_unlock(&src->mutex);
+
+    PyEval_RestoreThread(save);
+    PyGILState_Release(thread_state);
+
+    return NULL;
+}
+
+void *new_readahead_source(void *source, io_callback cb_io,
+                           io_cleanup cb_cleanup, size_t buffer_size,
+                           int nbuffers) {
+    readahead_source *src;
+    int i;
+
+    if (nbuffers < 2) {
+        return NULL;
+    }
+
+    src = (readahead_source *) calloc(1, sizeof(readahead_source));
+    if (src == NULL) {
+        return NULL;
+    }
+
+    src->source = source;
+    src->cb_io = cb_io;
+    src->cb_cleanup = cb_cleanup;
+    src->nbuffers = nbuffers;
+    src->buffer_size = buffer_size;
+
+    src->buffers = (char **) calloc(nbuffers, sizeof(char *));
+    src->caps = (size_t *) calloc(nbuffers, sizeof(size_t));
+    src->lengths = (size_t *) calloc(nbuffers, sizeof(size_t));
+    if (src->buffers == NULL || src->caps == NULL || src->lengths == NULL) {
+        goto fail;
+    }
+    for (i = 0; i < nbuffers; ++i) {
+        src->buffers[i] = (char *) malloc(buffer_size);
+        if (src->buffers[i] == NULL) {
+            goto fail;
+        }
+        src->caps[i] = buffer_size;
+    }
+
+    pthread_mutex_init(&src->mutex, NULL);
+    pthread_cond_init(&src->filled, NULL);
+    pthread_cond_init(&src->drained, NULL);
+
+#if PY_VERSION_HEX < 0x03070000
+    // the thread takes the GIL to read from Python file objects
+    PyEval_InitThreads();
+#endif
+
+    if (pthread_create(&src->thread, NULL, readahead_thread, src) != 0) {
+        pthread_mutex_destroy(&src->mutex);
+        pthread_cond_destroy(&src->filled);
+        pthread_cond_destroy(&src->drained);
+        goto fail;
+    }
+    src->started = 1;
+
+    return (void *) src;
+
+fail:
+    if (src->buffers != NULL) {
+        for (i = 0; i < nbuffers; ++i) {
+            free(src->buffers[i]);
+        }
+    }
+    free(src->buffers);
+    free(src->caps);
+    free(src->lengths);
+    free(src);
+    return NULL;
+}
+
+void readahead_stop(void *source) {
+    readahead_source *src = RAS(source);
+
+    if (!src->started) {
+        return;
+    }
+
+    pthread_mutex_lock(&src->mutex);
+    src->stop = 1;
+    pthread_cond_signal(&src->drained);
+    pthread_mutex_unlock(&src->mutex);
+
+    pthread_join(src->thread, NULL);
+    src->started = 0;
+
+    // nothing is read past what the thread buffered
+    if (src->status == 0) {
+        src->status = REACHED_EOF;
+    }
+}
+
+int del_readahead_source(void *source) {
+    readahead_source *src = RAS(source);
+    int i, status = 0;
+
+    if (src == NULL)
+        return 0;
+
+    readahead_stop(src);
+
+    if (src->cb_cleanup != NULL) {
+        status = src->cb_cleanup(src->source);
+    }
+
+    Py_XDECREF(src->err_type);
+    Py_XDECREF(src->err_value);
+    Py_XDECREF(src->err_traceback);
+
+    for (i = 0; i < src->nbuffers; ++i) {
+        free(src->buffers[i]);
+    }
+    free(src->buffers);
+    free(src->caps);
+    free(src->lengths);
+
+    pthread_mutex_destroy(&src->mutex);
+    pthread_cond_destroy(&src->filled);
+    pthread_cond_destroy(&src->drained);
+    free(src);
+
+    return status;
+}
+
+void* buffer_readahead_bytes(void *source, size_t nbytes,
+                             size_t *bytes_read, int *status) {
+    readahead_source *src = RAS(source);
+    PyGILState_STATE state;
+    void *retval = NULL;
+
+    // nbytes is ignored: chunks have the size given to the reading thread
+
+    pthread_mutex_lock(&src->mutex);
+
+    // the tokenizer is done with the buffer it got last time
+    if (src->held) {
+        src->held = 0;
+        src->head = (src->head + 1) % src->nbuffers;
+        src->count--;
+        pthread_cond_signal(&src->drained);
+    }
+
+    while (src->count == 0 && src->status == 0) {
+        pthread_cond_wait(&src->filled, &src->mutex);
+    }
+
+    if (src->count > 0) {
+        src->held = 1;
+        retval = (void *) src->buffers[src->head];
+        *bytes_read = src->lengths[src->head];
+        *status = 0;
+    } else {
+        *bytes_read = 0;
+        *status = src->status;
+    }
+
+    pthread_mutex_unlock(&src->mutex);
+
+    if (*status == CALLING_READ_FAILED && src->err_type != NULL) {
+        // raise the exception of the failed read in this thread
+        state = PyGILState_Ensure();
+        PyErr_Restore(src->err_type, src->err_value, src->err_traceback);
+        src->err_type = NULL;
+        src->err_value = NULL;
+        src->err_traceback = NULL;
+        PyGILState_Release(state);
+    }
+
+    return retval;
+}
+
+#else
+
+void *new_readahead_source(void *source, io_callback cb_io,
+                           io_cleanup cb_cleanup, size_t buffer_size,
+                           int nbuffers) {
+    return NULL;
+}
+
+void readahead_stop(void *src) {
+}
+
+int del_readahead_source(void *src) {
+    return 0;
+}
+
+void* buffer_readahead_bytes(void *source, size_t nbytes,
+                             size_t *bytes_read, int *status) {
+    *bytes_read = 0;
+    *status = CALLING_READ_FAILED;
+    return NULL;
+}
+
 #endif
@@ -61,6 +61,38 @@ int del_mmap(void *src);
 void* buffer_mmap_bytes(void *source, size_t nbytes,
                         size_t *bytes_read, int *status);
 
+/* Tokenize the rest of a memory-mapped source using up to nthreads threads */
+int tokenize_mmap_parallel(parser_t *self, int nthreads);
+
+
+#if !defined(_WIN32) && !defined(HAVE_ZLIB)
+#define HAVE_ZLIB
+#endif
+
+/*
+  gzip file read and decompressed with zlib, without going through Python.
+  Concatenated gzip members are read as one stream, like Python's gzip.
+ */
+typedef struct _gzip_source {
+    /* gzFile of the open file; void * so that zlib.h is only needed in io.c */
+    void *gz;
+
+    char *buffer;
+
+    /* Size (in bytes) of the buffer. */
+    size_t buffer_size;
+} gzip_source;
+
+#define GZS(source) ((gzip_source *)source)
+
+/* Returns NULL if the file cannot be opened, or where zlib is missing. */
+void *new_gzip_source(char *fname, size_t buffer_size);
+
+int del_gzip_source(void *src);
+
+void* buffer_gzip_bytes(void *source, size_t nbytes,
+                        size_t *bytes_read, int *status);
+
 
 typedef struct _rd_source {
     PyObject* obj;
@@ -83,3 +115,73 @@ void* buffer_file_bytes(void *source, size_t nbytes,
 void* buffer_rd_bytes(void *source, size_t nbytes,
                       size_t *bytes_read, int *status);
 
+
+/*
+  Read-ahead wrapper around another source: a thread reads the next chunks
+  of the wrapped source into a ring of buffers while the tokenizer works on
+  the current one, so that reading (and decompressing, for Python file
+  objects) overlaps with tokenizing. The tokenizer holds one buffer at a
+  time, until its next call.
+ */
+#ifndef _WIN32
+
+#include <pthread.h>
+
+typedef struct _readahead_source {
+    /* The wrapped source and its callbacks, only used by the thread. */
+    void *source;
+    io_callback cb_io;
+    io_cleanup cb_cleanup;
+
+    /* Ring of nbuffers buffers, of capacities caps and filled to lengths. */
+    int nbuffers;
+    size_t buffer_size;
+    char **buffers;
+    size_t *caps;
+    size_t *lengths;
+
+    /* The count filled buffers start at head; the first one is the
+       tokenizer's if held is set. */
+    int head;
+    int count;
+    int held;
+
+    /* Status of the read that ended the source (0 until then), and the
+       Python exception it raised, if any. */
+    int status;
+    PyObject *err_type;
+    PyObject *err_value;
+    PyObject *err_traceback;
+
+    int stop;
+    int started;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t filled;
+    pthread_cond_t drained;
+} readahead_source;
+
+#define RAS(source) ((readahead_source *)source)
+
+#endif
+
+/*
+  Wrap a source to read up to nbuffers - 1 chunks of buffer_size bytes
+  ahead. Returns NULL on failure, or where threads are not supported, in
+  which case the source is left alone.
+ */
+void *new_readahead_source(void *source, io_callback cb_io,
+                           io_cleanup cb_cleanup, size_t buffer_size,
+                           int nbuffers);
+
+/*
+  Stop the reading thread. This must be called without holding the GIL, as
+  the thread takes it to finish, and before the source is deleted while
+  holding the GIL.
+ */
+void readahead_stop(void *src);
+
+int del_readahead_source(void *src);
+
+void* buffer_readahead_bytes(void *source, size_t nbytes,
+                             size_t *bytes_read, int *status);
@@ -23,6 +23,9 @@ See LICENSE for the license
 #include <math.h>
 #include <float.h>
 
+#include "../headers/portable.h"
+#include "powers_of_five.h"
+
 
 //#define READ_ERROR_OUT_OF_MEMORY   1
 
@@ -65,10 +68,19 @@ static void *safe_realloc(void *buffer, size_t size) {
 
 
 void coliter_setup(coliter_t *self, parser_t *parser, int i, int start) {
+    int j;
+
     // column i, starting at 0
     self->words = parser->words;
     self->col = i;
     self->line_start = parser->line_start + start;
+
+    // typed columns before i have no words
+    for (j = 0; j < i && j < parser->ncolumns; ++j) {
+        if (parser->columns[j].type != COLUMN_WORDS) {
+            self->col--;
+        }
+    }
 }
 
 coliter_t *coliter_new(parser_t *self, int i) {
@@ -84,7 +96,7 @@ coliter_t *coliter_new(parser_t *self, int i) {
 }
 
 
- /* int64_t str_to_int64(const char *p_item, int64_t int_min, int64_t int_max, int *error); */
+ /* int64_t str_to_int64(const char *p_item, const char *buf_end, int64_t int_min, int64_t int_max, int *error); */
  /* uint64_t str_to_uint64(const char *p_item, uint64_t uint_max, int *error); */
 
 
@@ -184,11 +196,22 @@ int parser_clear_data_buffers(parser_t *self) {
 
 int parser_cleanup(parser_t *self) {
     int    status = 0;
+    int    i;
 
     // XXX where to put this
     free_if_not_null((void *) &self->error_msg);
     free_if_not_null((void *) &self->warn_msg);
 
+    for (i = 0; i < self->ncolumns; ++i) {
+        free_if_not_null((void *) &self->columns[i].values);
+        free_if_not_null((void *) &self->columns[i].na);
+        if (self->columns[i].na_set != NULL) {
+            kh_destroy_str((kh_str_t*) self->columns[i].na_set);
+        }
+    }
+    free_if_not_null((void *) &self->columns);
+    self->ncolumns = 0;
+
     if (self->skipset != NULL) {
         kh_destroy_int64((kh_int64_t*) self->skipset);
         self->skipset = NULL;
@@ -223,6 +246,8 @@ int parser_init(parser_t *self) {
     self->line_fields = NULL;
     self->error_msg = NULL;
     self->warn_msg = NULL;
+    self->columns = NULL;
+    self->ncolumns = 0;
 
     // token stream
     self->stream = (char*) malloc(STREAM_INIT_SIZE * sizeof(char));
@@ -408,7 +433,212 @@ static int push_char(parser_t *self, char c) {
     return 0;
 }
 
+/*
+
+  Typed columns
+
+ */
+
+static int grow_typed_column(typed_column_t *column, int length) {
+    int cap = column->cap;
+    size_t elsize = column->type == COLUMN_BOOL ? sizeof(uint8_t) : 8;
+    void *newptr;
+
+    if (length < cap)
+        return 0;
+
+    while (cap <= length) {
+        cap = cap ? cap << 1 : STREAM_INIT_SIZE;
+    }
+
+    newptr = safe_realloc((void *) column->values, cap * elsize);
+    if (newptr == NULL)
+        return PARSER_OUT_OF_MEMORY;
+    column->values = (char*) newptr;
+
+    newptr = safe_realloc((void *) column->na, cap * sizeof(uint8_t));
+    if (newptr == NULL)
+        return PARSER_OUT_OF_MEMORY;
+    column->na = (uint8_t*) newptr;
+
+    column->cap = cap;
+    return 0;
+}
+
+static int in_str_set(void *set, const char *word) {
+    kh_str_t *table = (kh_str_t*) set;
+    return table != NULL && kh_get_str(table, word) != table->n_buckets;
+}
+
+/*
+  Convert word, the field at position col of line row, in the same way as
+  the conversion of words in parser.pyx
+ */
+static int convert_typed_field(parser_t *self, int col, int row,
+                               const char *word) {
+    typed_column_t *column = &self->columns[col];
+    int error = 0;
+    char *p_end;
+    double value;
+    const char *type_name = "bool";
+
+    if (grow_typed_column(column, row) < 0) {
+        self->error_msg = (char*) malloc(100);
+        sprintf(self->error_msg, "out of memory");
+        return -1;
+    }
+
+    if (in_str_set(column->na_set, word)) {
+        column->na[row] = 1;
+        return 0;
+    }
+    column->na[row] = 0;
+
+    switch (column->type) {
+    case COLUMN_INT64:
+        type_name = "int64";
+        ((int64_t*) column->values)[row] = str_to_int64(
+            word, self->stream + self->stream_len, INT64_MIN, INT64_MAX,
+            &error, self->thousands);
+        break;
+
+    case COLUMN_FLOAT64:
+        type_name = "float64";
+        errno = 0;
+        value = self->converter(word, &p_end, self->decimal, self->sci,
+                                self->thousands, 1);
+        if (errno != 0 || *p_end || p_end == word) {
+            if (strcasecmp(word, "inf") == 0 || strcasecmp(word, "+inf") == 0) {
+                value = HUGE_VAL;
+            } else if (strcasecmp(word, "-inf") == 0) {
+                value = -HUGE_VAL;
+            } else {
+                error = ERROR_INVALID_CHARS;
+            }
+        }
+        ((double*) column->values)[row] = value;
+        break;
+
+    case COLUMN_BOOL:
+        if (in_str_set(column->true_set, word)) {
+            column->values[row] = 1;
+        } else if (in_str_set(column->false_set, word)) {
+            column->values[row] = 0;
+        } else {
+            error = to_boolean(word, (uint8_t*) column->values + row);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if (error != 0) {
+        self->error_msg = (char*) malloc(200);
+        sprintf(self->error_msg, "Unable to parse '%.40s' as %s in column %d",
+                word, type_name, col);
+        return -1;
+    }
+    return 0;
+}
+
+static int end_typed_field(parser_t *self, int col) {
+    // null terminate token, convert it and drop it from the stream
+    if (push_char(self, '\0') < 0)
+        return -1;
+
+    if (convert_typed_field(self, col, self->lines, self->pword_start) < 0)
+        return -1;
+
+    self->stream_len = self->word_start;
+
+    // increment line field count
+    self->line_fields[self->lines]++;
+
+    return 0;
+}
+
+int parser_add_typed_column(parser_t *self, int col, int type, void *na_set,
+                            void *true_set, void *false_set) {
+    int i;
+    void *newptr;
+    typed_column_t *column;
+
+    if (col >= self->ncolumns) {
+        newptr = safe_realloc((void *) self->columns,
+                              (col + 1) * sizeof(typed_column_t));
+        if (newptr == NULL)
+            return PARSER_OUT_OF_MEMORY;
+        self->columns = (typed_column_t*) newptr;
+
+        for (i = self->ncolumns; i <= col; ++i) {
+            memset(&self->columns[i], 0, sizeof(typed_column_t));
+            self->columns[i].type = COLUMN_WORDS;
+        }
+        self->ncolumns = col + 1;
+    }
+
+    column = &self->columns[col];
+    if (column->na_set != NULL) {
+        kh_destroy_str((kh_str_t*) column->na_set);
+    }
+    column->type = type;
+    column->na_set = na_set;
+    column->true_set = true_set;
+    column->false_set = false_set;
+    return 0;
+}
+
+int parser_convert_typed_columns(parser_t *self, int start_line) {
+    int line, col, fields, word, nwords;
+
+    if (start_line > self->lines)
+        start_line = self->lines;
+    nwords = self->line_start[start_line];
+
+    // convert the typed fields of the lines from start_line on, including
+    // the one in progress, and move up the words that are left
+    for (line = start_line; line <= self->lines; ++line) {
+        fields = self->line_fields[line];
+        word = self->line_start[line];
+        self->line_start[line] = nwords;
+
+        for (col = 0; col < fields; ++col, ++word) {
+            if (col < self->ncolumns && self->columns[col].type != COLUMN_WORDS) {
+                if (convert_typed_field(self, col, line, self->words[word]) < 0)
+                    return -1;
+            } else {
+                self->words[nwords] = self->words[word];
+                self->word_starts[nwords] = self->word_starts[word];
+                nwords++;
+            }
+        }
+
+        for (col = fields; line < self->lines && col < self->ncolumns; ++col) {
+            if (self->columns[col].type != COLUMN_WORDS &&
+                convert_typed_field(self, col, line, "") < 0)
+                return -1;
+        }
+    }
+    self->words_len = nwords;
+
+    return 0;
+}
+
+typed_column_t *parser_typed_column(parser_t *self, int col) {
+    if (col < self->ncolumns && self->columns[col].type != COLUMN_WORDS) {
+        return &self->columns[col];
+    }
+    return NULL;
+}
+
 int P_INLINE end_field(parser_t *self) {
+    int col = self->line_fields[self->lines];
+
+    if (col < self->ncolumns && self->columns[col].type != COLUMN_WORDS) {
+        return end_typed_field(self, col);
+    }
+
     // XXX cruft
 //    self->numeric_field = 0;
     if (self->words_len >= self->words_cap) {
@@ -462,7 +692,7 @@ static void append_warning(parser_t *self, const char *msg) {
 }
 
 static int end_line(parser_t *self) {
-    int fields;
+    int col, fields;
     int ex_fields = self->expected_fields;
     char *msg;
 
@@ -487,7 +717,7 @@ static int end_line(parser_t *self) {
         self->file_lines++;
 
         // skip the tokens from this bad line
-        self->line_start[self->lines] += fields;
+        self->line_start[self->lines] = self->words_len;
 
         // reset field count
         self->line_fields[self->lines] = 0;
@@ -501,7 +731,7 @@ static int end_line(parser_t *self) {
         self->file_lines++;
 
         // skip the tokens from this bad line
-        self->line_start[self->lines] += fields;
+        self->line_start[self->lines] = self->words_len;
 
         // reset field count
         self->line_fields[self->lines] = 0;
@@ -537,11 +767,19 @@ static int end_line(parser_t *self) {
             }
 
             while (fields < ex_fields){
-                end_field(self);
+                if (end_field(self) < 0)
+                    return -1;
                 fields++;
             }
         }
 
+        // typed columns past the end of the line are missing
+        for (col = fields; col < self->ncolumns; ++col) {
+            if (self->columns[col].type != COLUMN_WORDS &&
+                convert_typed_field(self, col, self->lines, "") < 0)
+                return -1;
+        }
+
         // increment both line counts
         self->file_lines++;
         self->lines++;
@@ -553,8 +791,8 @@ static int end_line(parser_t *self) {
             sprintf(self->error_msg, "Buffer overflow caught - possible malformed input file.\n"); \
             return PARSER_OUT_OF_MEMORY;                \
         }
-        self->line_start[self->lines] = (self->line_start[self->lines - 1] +
-                                         fields);
+        // the words of typed fields are not kept
+        self->line_start[self->lines] = self->words_len;
 
         TRACE(("end_line: new line start: %d\n", self->line_start[self->lines]));
 
@@ -715,6 +953,119 @@ static int parser_buffer_bytes(parser_t *self, size_t nbytes) {
         self->datapos += 3;                                               \
     }
 
+/*
+
+  Fast path for unquoted fields
+
+  Most fields are short runs of ordinary characters: characters that leave
+  the state machine in IN_FIELD and are copied to the stream unchanged. Once
+  a field has started, the run up to the next delimiter, line terminator,
+  escape or comment character is located 16 bytes at a time and copied to
+  the stream in bulk. Quoted fields always go through the state machine.
+
+*/
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TOKENIZER_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#define FIELD_SCANNER_CHARS 6
+
+typedef struct field_scanner_t {
+    // characters that end a run; unused slots repeat one of the others
+    char chars[FIELD_SCANNER_CHARS];
+    // nonzero for the same characters, for the scalar tail
+    char special[256];
+} field_scanner_t;
+
+static void field_scanner_init(field_scanner_t *scanner, parser_t *self) {
+    int n = 0, k;
+
+    if (self->delim_whitespace) {
+        scanner->chars[n++] = ' ';
+        scanner->chars[n++] = '\t';
+    } else {
+        scanner->chars[n++] = self->delimiter;
+    }
+    if (self->lineterminator == '\0') {
+        scanner->chars[n++] = '\n';
+        scanner->chars[n++] = '\r';
+    } else {
+        scanner->chars[n++] = self->lineterminator;
+    }
+    if (self->escapechar != '\0') {
+        scanner->chars[n++] = self->escapechar;
+    }
+    if (self->commentchar != '\0') {
+        scanner->chars[n++] = self->commentchar;
+    }
+    for (k = n; k < FIELD_SCANNER_CHARS; ++k) {
+        scanner->chars[k] = scanner->chars[0];
+    }
+
+    memset(scanner->special, 0, sizeof(scanner->special));
+    for (k = 0; k < n; ++k) {
+        scanner->special[(unsigned char) scanner->chars[k]] = 1;
+    }
+}
+
+// Length of the run of ordinary characters at the start of buf[0:n]
+static int field_scanner_run(const field_scanner_t *scanner, const char *buf, int n) {
+    int k = 0;
+#ifdef TOKENIZER_SSE2
+    __m128i c0 = _mm_set1_epi8(scanner->chars[0]);
+    __m128i c1 = _mm_set1_epi8(scanner->chars[1]);
+    __m128i c2 = _mm_set1_epi8(scanner->chars[2]);
+    __m128i c3 = _mm_set1_epi8(scanner->chars[3]);
+    __m128i c4 = _mm_set1_epi8(scanner->chars[4]);
+    __m128i c5 = _mm_set1_epi8(scanner->chars[5]);
+    __m128i v, m;
+    int mask;
+#if defined(_MSC_VER)
+    unsigned long first;
+#endif
+
+    for (; k + 16 <= n; k += 16) {
+        v = _mm_loadu_si128((const __m128i *) (buf + k));
+        m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, c0), _mm_cmpeq_epi8(v, c1)),
+                         _mm_or_si128(_mm_cmpeq_epi8(v, c2), _mm_cmpeq_epi8(v, c3)));
+        m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi8(v, c4), _mm_cmpeq_epi8(v, c5)));
+        mask = _mm_movemask_epi8(m);
+        if (mask != 0) {
+#if defined(_MSC_VER)
+            _BitScanForward(&first, (unsigned long) mask);
+            return k + (int) first;
+#else
+            return k + __builtin_ctz(mask);
+#endif
+        }
+    }
+#endif
+    while (k < n && !scanner->special[(unsigned char) buf[k]]) {
+        ++k;
+    }
+    return k;
+}
+
+// Copy the rest of the current run of ordinary characters to the stream,
+// leaving i and buf on the last character copied
+#define COPY_FIELD_RUN()                                                \
+    {                                                                   \
+        int run = field_scanner_run(&scanner, buf, self->datalen - i - 1); \
+        if (run > maxstreamsize - slen) {                               \
+            run = maxstreamsize - slen;                                 \
+        }                                                               \
+        memcpy(stream, buf, run);                                       \
+        stream += run;                                                  \
+        slen += run;                                                    \
+        buf += run;                                                     \
+        i += run;                                                       \
+    }
+
 int skip_this_line(parser_t *self, int64_t rownum) {
     if (self->skipset != NULL) {
         return ( kh_get_int64((kh_int64_t*) self->skipset, self->file_lines) !=
@@ -732,8 +1083,10 @@ int tokenize_bytes(parser_t *self, size_t line_limit)
     char c;
     char *stream;
     char *buf = self->data + self->datapos;
+    field_scanner_t scanner;
 
     start_lines = self->lines;
+    field_scanner_init(&scanner, self);
 
     if (make_stream_space(self, self->datalen - self->datapos) < 0) {
         self->error_msg = "out of memory";
@@ -928,6 +1281,7 @@ int tokenize_bytes(parser_t *self, size_t line_limit)
                 // }
 
                 PUSH_CHAR(c);
+                COPY_FIELD_RUN();
                 self->state = IN_FIELD;
             }
             break;
@@ -973,6 +1327,7 @@ int tokenize_bytes(parser_t *self, size_t line_limit)
             } else {
                 // normal character - save in field
                 PUSH_CHAR(c);
+                COPY_FIELD_RUN();
             }
             break;
 
@@ -1161,7 +1516,9 @@ static int parser_handle_eof(parser_t *self) {
 }
 
 int parser_consume_rows(parser_t *self, size_t nrows) {
-    int i, offset, word_deletions, char_count;
+    int i, offset, word_deletions, char_count, remaining;
+    size_t elsize;
+    typed_column_t *column;
 
     if (nrows > self->lines) {
         nrows = self->lines;
@@ -1171,10 +1528,13 @@ int parser_consume_rows(parser_t *self, size_t nrows) {
     if (nrows == 0)
         return 0;
 
-    /* cannot guarantee that nrows + 1 has been observed */
-    word_deletions = self->line_start[nrows - 1] + self->line_fields[nrows - 1];
-    char_count = (self->word_starts[word_deletions - 1] +
-                  strlen(self->words[word_deletions - 1]) + 1);
+    /* the words of line nrows, or the word in progress, come next */
+    word_deletions = self->line_start[nrows];
+    if (word_deletions < self->words_len) {
+        char_count = self->word_starts[word_deletions];
+    } else {
+        char_count = self->word_start;
+    }
 
     TRACE(("parser_consume_rows: Deleting %d words, %d chars\n", word_deletions, char_count));
 
@@ -1216,6 +1576,18 @@ int parser_consume_rows(parser_t *self, size_t nrows) {
 
         self->line_fields[i] = self->line_fields[offset];
     }
+    /* move typed values, including any of the line in progress */
+    for (i = 0; i < self->ncolumns; ++i) {
+        column = &self->columns[i];
+        if (column->type == COLUMN_WORDS || column->cap <= nrows)
+            continue;
+
+        elsize = column->type == COLUMN_BOOL ? sizeof(uint8_t) : 8;
+        remaining = (column->cap > self->lines ? self->lines + 1 : self->lines) - nrows;
+        memmove(column->values, column->values + nrows * elsize, remaining * elsize);
+        memmove(column->na, column->na + nrows, remaining);
+    }
+
     self->lines -= nrows;
     /* self->line_fields[self->lines] = 0; */
 
@@ -1391,6 +1763,546 @@ int tokenize_all_rows(parser_t *self) {
     return status;
 }
 
+/*
+
+  Multi-threaded tokenization
+
+  The remaining input is split into byte ranges that each start at a record
+  boundary and are tokenized by separate parsers in parallel, whose output is
+  then appended to the main parser in order.
+
+  A record boundary cannot be found locally, since a line terminator may be
+  inside a quoted field. A first parallel pass counts the quote characters in
+  each range; the parity of the quotes that precede a point then tells whether
+  it is inside quotes, and the range is moved to start after the first
+  terminator outside quotes. This is only a guess, as quote characters inside
+  unquoted fields are literal: it is checked when the results are appended,
+  since a range ends at a record boundary exactly when its parser finishes in
+  START_RECORD. Whatever follows a wrong guess is tokenized serially, as is any
+  range whose parser reported an error or warning (so that messages carry the
+  right line numbers) or whose first line would have been padded or dropped
+  given the line before it.
+
+ */
+
+#ifndef _WIN32
+#include <pthread.h>
+#define TOKENIZER_THREADS 1
+#endif
+
+// Smaller ranges are not worth a thread
+#define PARALLEL_MIN_RANGE (1 * MB)
+// Bounds the memory held by the parsers of a round of ranges
+#define PARALLEL_MAX_RANGE (64 * MB)
+
+typedef struct tokenize_task_t {
+    parser_t parser;
+    const char *data;
+    size_t len;
+    size_t quotes;
+    int status;
+} tokenize_task_t;
+
+/*
+  Tokenize data[0:len] after the data already consumed, without reaching EOF
+ */
+static int tokenize_range(parser_t *self, const char *data, size_t len) {
+    size_t n;
+
+    while (len > 0) {
+        n = len < (size_t) self->chunksize ? len : (size_t) self->chunksize;
+        self->data = (char*) data;
+        self->datalen = (int) n;
+        self->datapos = 0;
+        if (tokenize_bytes(self, 0) < 0)
+            return -1;
+        data += n;
+        len -= n;
+    }
+    return 0;
+}
+
+#ifdef TOKENIZER_THREADS
+
+static void *count_quotes_task(void *arg) {
+    tokenize_task_t *task = (tokenize_task_t*) arg;
+    const char *p = task->data;
+    const char *end = task->data + task->len;
+    char quotechar = task->parser.quotechar;
+
+    task->quotes = 0;
+    while ((p = memchr(p, quotechar, end - p)) != NULL) {
+        task->quotes++;
+        p++;
+    }
+    return NULL;
+}
+
+static void *tokenize_task(void *arg) {
+    tokenize_task_t *task = (tokenize_task_t*) arg;
+    if (task->status == 0) {
+        task->status = tokenize_range(&task->parser, task->data, task->len);
+    }
+    return NULL;
+}
+
+static void run_tasks(void *(*fn)(void *), tokenize_task_t *tasks, int ntasks) {
+    int i;
+    int *started = (int*) calloc(ntasks, sizeof(int));
+    pthread_t *threads = (pthread_t*) malloc(ntasks * sizeof(pthread_t));
+
+    for (i = 1; i < ntasks; ++i) {
+        if (threads != NULL && started != NULL) {
+            started[i] = pthread_create(&threads[i], NULL, fn, &tasks[i]) == 0;
+        }
+    }
+    // run anything that could not get a thread on this one
+    for (i = 0; i < ntasks; ++i) {
+        if (started == NULL || !started[i]) {
+            fn(&tasks[i]);
+        }
+    }
+    for (i = 1; i < ntasks; ++i) {
+        if (started != NULL && started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    free(started);
+    free(threads);
+}
+
+static int init_task_parser(parser_t *self, parser_t *worker) {
+    // copy the options, then give the worker buffers of its own
+    *worker = *self;
+    worker->source = NULL;
+    worker->cb_io = NULL;
+    worker->cb_cleanup = NULL;
+    worker->skipset = NULL;
+    if (parser_init(worker) < 0)
+        return -1;
+
+    // the first line is accepted as-is, and checked against the line
+    // before it when the output is appended
+    worker->header_end = -1;
+    worker->skip_first_N_rows = -1;
+
+    // not the start of the file, so no byte order mark
+    worker->file_lines = 1;
+    return 0;
+}
+
+/*
+  Append the output of a worker parser. self must be at a record boundary
+ */
+static int append_task_parser(parser_t *self, parser_t *worker) {
+    int i, nbytes;
+    int stream_offset = self->stream_len;
+    int words_offset = self->words_len;
+    int lines_offset = self->lines;
+
+    nbytes = worker->stream_len;
+    if (nbytes < worker->words_len)
+        nbytes = worker->words_len;
+    if (nbytes < worker->lines + 1)
+        nbytes = worker->lines + 1;
+    if (make_stream_space(self, nbytes) < 0) {
+        self->error_msg = (char*) malloc(100);
+        sprintf(self->error_msg, "out of memory");
+        return -1;
+    }
+
+    memcpy(self->stream + stream_offset, worker->stream, worker->stream_len);
+
+    for (i = 0; i < worker->words_len; ++i) {
+        self->word_starts[words_offset + i] = worker->word_starts[i] + stream_offset;
+        self->words[words_offset + i] = (self->stream +
+                                         self->word_starts[words_offset + i]);
+    }
+
+    // including the line in progress, if any
+    for (i = 0; i <= worker->lines; ++i) {
+        self->line_start[lines_offset + i] = worker->line_start[i] + words_offset;
+        self->line_fields[lines_offset + i] = worker->line_fields[i];
+    }
+
+    self->stream_len += worker->stream_len;
+    self->words_len += worker->words_len;
+    self->lines += worker->lines;
+    self->file_lines += worker->file_lines - 1;
+
+    self->word_start = worker->word_start + stream_offset;
+    self->pword_start = self->stream + self->word_start;
+    self->state = worker->state;
+    return 0;
+}
+
+/*
+  Whether end_line in self would have kept the first line of worker as it is
+ */
+static int first_line_matches(parser_t *self, parser_t *worker) {
+    int fields, ex_fields;
+
+    if (self->expected_fields >= 0 || worker->lines == 0)
+        return 1;
+
+    fields = worker->line_fields[0];
+    ex_fields = self->line_fields[self->lines - 1];
+    return fields == ex_fields || (fields > ex_fields && self->usecols);
+}
+
+static int tokenize_parallel(parser_t *self, const char *data, size_t len,
+                             int nthreads) {
+    size_t range_size, parity, pos;
+    size_t *starts = NULL;
+    tokenize_task_t *tasks = NULL;
+    char terminator;
+    int nranges, first, ntasks, inside, i, j;
+    int status = 0;
+
+    range_size = len / nthreads;
+    if (range_size < PARALLEL_MIN_RANGE)
+        range_size = PARALLEL_MIN_RANGE;
+    if (range_size > PARALLEL_MAX_RANGE)
+        range_size = PARALLEL_MAX_RANGE;
+    nranges = (int) ((len + range_size - 1) / range_size);
+
+    starts = (size_t*) malloc((nranges + 1) * sizeof(size_t));
+    tasks = (tokenize_task_t*) malloc(nthreads * sizeof(tokenize_task_t));
+    if (starts == NULL || tasks == NULL) {
+        free(starts);
+        free(tasks);
+        return tokenize_range(self, data, len);
+    }
+
+    for (i = 0; i < nranges; ++i) {
+        starts[i] = i * range_size;
+    }
+    starts[nranges] = len;
+
+    // First pass: count the quotes in each range
+    terminator = self->lineterminator == '\0' ? '\n' : self->lineterminator;
+    parity = 0;
+    for (first = 0; first < nranges; first += nthreads) {
+        ntasks = nranges - first < nthreads ? nranges - first : nthreads;
+        for (j = 0; j < ntasks; ++j) {
+            tasks[j].parser.quotechar = self->quotechar;
+            tasks[j].data = data + starts[first + j];
+            tasks[j].len = starts[first + j + 1] - starts[first + j];
+            tasks[j].quotes = 0;
+        }
+        if (self->quoting != QUOTE_NONE) {
+            run_tasks(count_quotes_task, tasks, ntasks);
+        }
+
+        // Move each range start past the first terminator outside quotes.
+        // If there is none before the next range, the two are merged
+        for (j = 0; j < ntasks; ++j) {
+            i = first + j;
+            if (i > 0) {
+                inside = parity & 1;
+                for (pos = starts[i]; pos < starts[i + 1]; ++pos) {
+                    if (data[pos] == terminator && !inside)
+                        break;
+                    if (data[pos] == self->quotechar && self->quoting != QUOTE_NONE)
+                        inside = !inside;
+                }
+                starts[i] = pos < starts[i + 1] ? pos + 1 : (size_t) -1;
+            }
+            parity += tasks[j].quotes;
+        }
+    }
+    for (i = nranges - 1; i > 0; --i) {
+        if (starts[i] == (size_t) -1)
+            starts[i] = starts[i + 1];
+    }
+
+    // Second pass: tokenize the ranges a round at a time and append the
+    // results in order
+    for (first = 0; first < nranges; first += nthreads) {
+        ntasks = nranges - first < nthreads ? nranges - first : nthreads;
+        for (j = 0; j < ntasks; ++j) {
+            tasks[j].data = data + starts[first + j];
+            tasks[j].len = starts[first + j + 1] - starts[first + j];
+            tasks[j].status = init_task_parser(self, &tasks[j].parser);
+        }
+        run_tasks(tokenize_task, tasks, ntasks);
+
+        for (j = 0; j < ntasks; ++j) {
+            i = first + j;
+            if (status != 0 || tasks[j].len == 0) {
+                // already fell back to the serial tokenizer
+            } else if (tasks[j].status < 0 || tasks[j].parser.warn_msg != NULL ||
+                       !first_line_matches(self, &tasks[j].parser)) {
+                status = 1;
+                if (tokenize_range(self, data + starts[i], len - starts[i]) < 0)
+                    status = -1;
+            } else if (append_task_parser(self, &tasks[j].parser) < 0) {
+                status = -1;
+            } else if (starts[i + 1] < len && self->state != START_RECORD) {
+                // the next range did not start at a record boundary
+                status = 1;
+                if (tokenize_range(self, data + starts[i + 1],
+                                   len - starts[i + 1]) < 0)
+                    status = -1;
+            }
+            parser_cleanup(&tasks[j].parser);
+        }
+        if (status != 0)
+            break;
+    }
+
+    free(starts);
+    free(tasks);
+    return status < 0 ? -1 : 0;
+}
+
+#endif
+
+/*
+  Sizing the buffers up front for an input that is all in memory. The
+  records and fields are counted in a few windows spread over the input, 8
+  bytes at a time, and the buffers are grown once to fit the estimate,
+  instead of being doubled and copied as the tokenizer fills them. The
+  estimate is only a hint: make_stream_space still checks every chunk.
+ */
+
+#define SAMPLE_WINDOWS 16
+#define SAMPLE_WINDOW_SIZE (64 * KB)
+
+#define BYTES_01 0x0101010101010101ULL
+#define BYTES_7F 0x7F7F7F7F7F7F7F7FULL
+#define BYTES_80 0x8080808080808080ULL
+
+// The high bit of each byte of v that is c
+P_INLINE uint64_t bytes_equal(uint64_t v, unsigned char c) {
+    uint64_t x = v ^ (BYTES_01 * c);
+    return ~(((x & BYTES_7F) + BYTES_7F) | x) & BYTES_80;
+}
+
+// Number of bytes with their high bit set in mask
+P_INLINE size_t count_bytes(uint64_t mask) {
+    return (size_t) (((mask >> 7) * BYTES_01) >> 56);
+}
+
+/*
+  Count the terminators and delimiters outside quotes in data[0:len], which
+  must not start inside quotes. Escape characters and bare '\r' line
+  endings are not taken into account
+ */
+static void count_records(parser_t *self, const char *data, size_t len,
+                          size_t *records, size_t *fields) {
+    unsigned char terminator, delimiter, quotechar;
+    uint64_t v, quotes, inside, in_quotes = 0;
+    size_t i, nrecords = 0, nfields = 0;
+    int use_quotes;
+
+    terminator = self->lineterminator == '\0' ? '\n' : self->lineterminator;
+    delimiter = self->delim_whitespace ? ' ' : self->delimiter;
+    quotechar = self->quotechar;
+    use_quotes = self->quoting != QUOTE_NONE && quotechar != '\0';
+
+    for (i = 0; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        memcpy(&v, data + i, sizeof(uint64_t));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        v = __builtin_bswap64(v);
+#endif
+        // in_quotes and inside are all ones in the bytes that follow an odd
+        // number of quote characters
+        inside = in_quotes;
+        if (use_quotes) {
+            quotes = bytes_equal(v, quotechar) >> 7;
+            if (quotes) {
+                // prefix parity of the quotes, one bit per byte
+                quotes ^= quotes << 8;
+                quotes ^= quotes << 16;
+                quotes ^= quotes << 32;
+                inside ^= quotes * 0xFF;
+                in_quotes = (uint64_t) 0 - (inside >> 63);
+            }
+        }
+        nrecords += count_bytes(bytes_equal(v, terminator) & ~inside);
+        nfields += count_bytes(bytes_equal(v, delimiter) & ~inside);
+    }
+    for (; i < len; ++i) {
+        unsigned char c = (unsigned char) data[i];
+        if (use_quotes && c == quotechar) {
+            in_quotes = ~in_quotes;
+        } else if (!in_quotes) {
+            nrecords += (c == terminator);
+            nfields += (c == delimiter);
+        }
+    }
+
+    *records = nrecords;
+    *fields = nfields;
+}
+
+/*
+  Estimate the records and fields in data[0:len]. Small inputs are counted
+  whole; larger ones in SAMPLE_WINDOWS windows, each starting after a
+  terminator, scaled up by the bytes sampled with 1/8 to spare
+ */
+static void estimate_records(parser_t *self, const char *data, size_t len,
+                             size_t *records, size_t *fields) {
+    const char *p, *end;
+    size_t n, sampled, nrecords, nfields, window_records, window_fields;
+    char terminator;
+    int i;
+
+    if (len <= SAMPLE_WINDOWS * SAMPLE_WINDOW_SIZE) {
+        count_records(self, data, len, records, fields);
+        return;
+    }
+
+    terminator = self->lineterminator == '\0' ? '\n' : self->lineterminator;
+    sampled = nrecords = nfields = 0;
+    for (i = 0; i < SAMPLE_WINDOWS; ++i) {
+        p = data + (len / SAMPLE_WINDOWS) * i;
+        end = p + SAMPLE_WINDOW_SIZE;
+        if (i > 0 && (p = memchr(p, terminator, end - p)) == NULL)
+            continue;
+        if (i > 0)
+            ++p;
+        n = (size_t) (end - p);
+        count_records(self, p, n, &window_records, &window_fields);
+        sampled += n;
+        nrecords += window_records;
+        nfields += window_fields;
+    }
+    if (sampled == 0) {
+        // no terminators at all: a few very long lines
+        *records = *fields = 0;
+        return;
+    }
+
+    *records = (size_t) ((double) nrecords * len / sampled * 1.125) + 1;
+    *fields = (size_t) ((double) nfields * len / sampled * 1.125) + 1;
+}
+
+static int reserve_buffer(void **buffer, int *capacity, size_t target,
+                          int elsize) {
+    void *newbuffer;
+
+    if (target <= (size_t) *capacity) {
+        return 0;
+    }
+    newbuffer = safe_realloc(*buffer, target * elsize);
+    if (newbuffer == NULL) {
+        return PARSER_OUT_OF_MEMORY;
+    }
+    *buffer = newbuffer;
+    *capacity = (int) target;
+    return 0;
+}
+
+static int reserve_for_data(parser_t *self, const char *data, size_t len) {
+    size_t records, fields, chunk, stream_target, words_target, lines_target;
+    char *orig_stream = self->stream;
+    int i, cap;
+
+    estimate_records(self, data, len, &records, &fields);
+
+    // make_stream_space asks for room for a whole chunk on top of what is
+    // used, twice over for the stream
+    chunk = len < (size_t) self->chunksize ? len : (size_t) self->chunksize;
+    stream_target = self->stream_len + len + 2 * chunk + 2;
+    words_target = self->words_len + records + fields + chunk + 2;
+    lines_target = self->lines + records + chunk + 3;
+    if (stream_target > INT_MAX || words_target > INT_MAX) {
+        return 0;
+    }
+
+    if (reserve_buffer((void **) &self->stream, &self->stream_cap,
+                       stream_target, sizeof(char)) < 0) {
+        return PARSER_OUT_OF_MEMORY;
+    }
+    if (self->stream != orig_stream) {
+        self->pword_start = self->stream + self->word_start;
+        for (i = 0; i < self->words_len; ++i) {
+            self->words[i] = self->stream + self->word_starts[i];
+        }
+    }
+
+    cap = self->words_cap;
+    if (reserve_buffer((void **) &self->words, &cap, words_target,
+                       sizeof(char *)) < 0 ||
+        reserve_buffer((void **) &self->word_starts, &self->words_cap,
+                       words_target, sizeof(int)) < 0) {
+        return PARSER_OUT_OF_MEMORY;
+    }
+
+    cap = self->lines_cap;
+    if (reserve_buffer((void **) &self->line_start, &cap, lines_target,
+                       sizeof(int)) < 0 ||
+        reserve_buffer((void **) &self->line_fields, &self->lines_cap,
+                       lines_target, sizeof(int)) < 0) {
+        return PARSER_OUT_OF_MEMORY;
+    }
+
+    return 0;
+}
+
+int tokenize_all_rows_parallel(parser_t *self, const char *data, size_t len,
+                               int nthreads) {
+    const char *p;
+    size_t pos, n;
+    char terminator;
+    int status;
+
+    if (self->state == FINISHED) {
+        return 0;
+    }
+
+    // Finish the bytes already buffered, then move on to the first record
+    // boundary after the header
+    if (self->datapos < self->datalen && tokenize_bytes(self, 0) < 0)
+        return -1;
+
+    terminator = self->lineterminator == '\0' ? '\n' : self->lineterminator;
+    pos = 0;
+    while (pos < len && (self->state != START_RECORD ||
+                         self->lines <= self->header_end + 1)) {
+        p = memchr(data + pos, terminator, len - pos);
+        n = p == NULL ? len - pos : (size_t) (p - (data + pos)) + 1;
+        if (tokenize_range(self, data + pos, n) < 0)
+            return -1;
+        pos += n;
+    }
+
+    status = 0;
+    if (pos < len && reserve_for_data(self, data + pos, len - pos) < 0) {
+        self->error_msg = (char*) malloc(100);
+        sprintf(self->error_msg, "out of memory");
+        return -1;
+    }
+    if (pos < len) {
+#ifdef TOKENIZER_THREADS
+        // The ranges are tokenized without an escape character, comment
+        // character or rows left to skip, which would all need the state of
+        // the line before, and without typed columns
+        if (nthreads > 1 && len - pos >= 2 * PARALLEL_MIN_RANGE &&
+            self->escapechar == '\0' && self->commentchar == '\0' &&
+            self->skipset == NULL && self->skip_first_N_rows < self->file_lines &&
+            self->ncolumns == 0) {
+            status = tokenize_parallel(self, data + pos, len - pos, nthreads);
+        } else {
+            status = tokenize_range(self, data + pos, len - pos);
+        }
+#else
+        status = tokenize_range(self, data + pos, len - pos);
+#endif
+    }
+    if (status < 0)
+        return -1;
+
+    // close out the last line as on reaching EOF
+    self->datalen = 0;
+    self->datapos = 0;
+    status = parser_handle_eof(self);
+    self->state = FINISHED;
+    return status;
+}
+
 /* SEL - does not look like this routine is used anywhere
 void test_count_lines(char *fname) {
     clock_t start = clock();
@@ -1961,13 +2873,549 @@ double atof(const char *str)
 // End of xstrtod code
 // ---------------------------------------------------------------------------
 
-int64_t str_to_int64(const char *p_item, int64_t int_min, int64_t int_max,
-                     int *error, char tsep)
+// ---------------------------------------------------------------------------
+// Implementation of exact_xstrtod
+//
+// Correctly rounded conversion after D. Lemire, "Number Parsing at a
+// Gigabyte per Second" (2021). While scanning, the first 19 significant
+// digits are gathered in an integer w and the value is w * 10^q, possibly
+// plus the digits that did not fit. It is rounded by
+//
+// * plain double arithmetic when w < 2^53 and |q| <= 22, as both w and 10^q
+//   are then exact doubles (Clinger's fast path);
+// * the Eisel-Lemire algorithm, which multiplies w by a 128 bit truncation
+//   of 5^q. It is exact when w holds all of the digits; otherwise w and
+//   w + 1 bracket the value and are both rounded;
+// * when they round differently, comparing all of the digits against the
+//   halfway point between the two candidates with big integers.
+
+#define EXACT_MAX_DIGITS 800
+
+typedef struct {
+    uint64_t mantissa;  // explicit bits, without the hidden bit
+    int power2;         // biased exponent, 0x7FF for infinity
+} adjusted_mantissa;
+
+P_INLINE uint64_t full_multiplication(uint64_t a, uint64_t b, uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t) a * b;
+    *low = (uint64_t) r;
+    return (uint64_t) (r >> 64);
+#else
+    uint64_t a_lo = (uint32_t) a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t) b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t) hi_lo + lo_hi;
+    *low = (cross << 32) | (uint32_t) lo_lo;
+    return hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+P_INLINE int leading_zeroes(uint64_t w)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(w);
+#else
+    int n = 0;
+    while (!(w & ((uint64_t) 1 << 63))) {
+        w <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Rounds w * 10^q, w != 0, to the nearest double
+static adjusted_mantissa eisel_lemire(int64_t q, uint64_t w)
+{
+    adjusted_mantissa answer;
+    const uint64_t *power;
+    uint64_t high, low, second_low;
+    int lz, upperbit, shift;
+
+    if (q < SMALLEST_POWER_OF_FIVE) {
+        answer.mantissa = 0;
+        answer.power2 = 0;
+        return answer;
+    }
+    if (q > LARGEST_POWER_OF_FIVE) {
+        answer.mantissa = 0;
+        answer.power2 = 0x7FF;
+        return answer;
+    }
+
+    lz = leading_zeroes(w);
+    w <<= lz;
+
+    // The 55 bits needed for rounding are exact unless they are all ones;
+    // then the low word of 5^q can carry into them
+    power = power_of_five_128 + 2 * (q - SMALLEST_POWER_OF_FIVE);
+    high = full_multiplication(w, power[0], &low);
+    if ((high & 0x1FF) == 0x1FF) {
+        uint64_t second_high = full_multiplication(w, power[1], &second_low);
+        low += second_high;
+        high += (second_high > low);
+    }
+
+    upperbit = (int) (high >> 63);
+    shift = upperbit + 9;
+    answer.mantissa = high >> shift;
+    // floor(log2(10^q)) + 63, the exponent of the product
+    answer.power2 = (int) ((((152170 + 65536) * q) >> 16) + 63 + upperbit -
+                           lz + 1023);
+
+    if (answer.power2 <= 0) {
+        // subnormal: shift out the bits below 2^-1074 before rounding
+        if (-answer.power2 + 1 >= 64) {
+            answer.mantissa = 0;
+            answer.power2 = 0;
+            return answer;
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < ((uint64_t) 1 << 52) ? 0 : 1;
+        return answer;
+    }
+
+    // Only w * 5^q with q in [-4, 23] can fall exactly halfway between two
+    // doubles; round those to even instead of up
+    if (low <= 1 && q >= -4 && q <= 23 && (answer.mantissa & 3) == 1 &&
+        (answer.mantissa << shift) == high) {
+        answer.mantissa &= ~(uint64_t) 1;
+    }
+
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= ((uint64_t) 2 << 52)) {
+        answer.mantissa = (uint64_t) 1 << 52;
+        answer.power2++;
+    }
+    answer.mantissa &= ~((uint64_t) 1 << 52);
+    if (answer.power2 >= 0x7FF) {
+        answer.mantissa = 0;
+        answer.power2 = 0x7FF;
+    }
+    return answer;
+}
+
+// Little-endian unsigned big integer, large enough for EXACT_MAX_DIGITS
+// digits times a power of two or five of the same magnitude
+#define BIGINT_LIMBS 128
+
+typedef struct {
+    uint32_t limbs[BIGINT_LIMBS];
+    int len;
+} bigint_t;
+
+static void bigint_mul_add(bigint_t *b, uint32_t mul, uint32_t add)
+{
+    uint64_t carry = add;
+    int i;
+
+    for (i = 0; i < b->len; i++) {
+        carry += (uint64_t) b->limbs[i] * mul;
+        b->limbs[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+    if (carry && b->len < BIGINT_LIMBS) {
+        b->limbs[b->len++] = (uint32_t) carry;
+    }
+}
+
+static void bigint_mul_pow5(bigint_t *b, int n)
+{
+    static const uint32_t small_pow5[] = {
+        1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+        48828125, 244140625, 1220703125
+    };
+
+    for (; n >= 13; n -= 13) {
+        bigint_mul_add(b, small_pow5[13], 0);
+    }
+    bigint_mul_add(b, small_pow5[n], 0);
+}
+
+static void bigint_shift_left(bigint_t *b, int n)
+{
+    int words = n / 32, bits = n % 32, i;
+
+    if (b->len == 0) {
+        return;
+    }
+    if (b->len + words + 1 > BIGINT_LIMBS) {
+        words = BIGINT_LIMBS - b->len - 1;
+    }
+    if (bits) {
+        uint32_t carry = 0;
+        for (i = 0; i < b->len; i++) {
+            uint32_t limb = b->limbs[i];
+            b->limbs[i] = (limb << bits) | carry;
+            carry = limb >> (32 - bits);
+        }
+        if (carry) {
+            b->limbs[b->len++] = carry;
+        }
+    }
+    if (words) {
+        memmove(b->limbs + words, b->limbs, b->len * sizeof(uint32_t));
+        memset(b->limbs, 0, words * sizeof(uint32_t));
+        b->len += words;
+    }
+}
+
+static int bigint_compare(const bigint_t *a, const bigint_t *b)
+{
+    int i;
+
+    if (a->len != b->len) {
+        return a->len < b->len ? -1 : 1;
+    }
+    for (i = a->len - 1; i >= 0; i--) {
+        if (a->limbs[i] != b->limbs[i]) {
+            return a->limbs[i] < b->limbs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/*
+  Round the number whose mantissa is the text [p, end), made of digits,
+  thousands separators and at most one decimal point, times 10^exp10, given
+  that it lies between the positive double lower and the next one up.
+ */
+static adjusted_mantissa digit_comparison(const char *p, const char *end,
+                                          char decimal, int64_t exp10,
+                                          adjusted_mantissa lower)
+{
+    bigint_t digits, halfway;
+    uint32_t chunk = 0;
+    int nchunk = 0, ndigits = 0, truncated = 0, in_fraction = 0;
+    int64_t dexp = exp10;
+    int64_t hexp, mexp;
+    uint64_t m;
+    int cmp;
+
+    // digits = all significant digits, up to EXACT_MAX_DIGITS of them, so
+    // that the number is digits * 10^dexp
+    digits.len = 0;
+    for (; p < end; p++) {
+        if (*p == decimal) {
+            in_fraction = 1;
+            continue;
+        }
+        if (!isdigit(*p)) {
+            continue;
+        }
+        if (ndigits == 0 && *p == '0') {
+            dexp -= in_fraction;
+            continue;
+        }
+        if (ndigits == EXACT_MAX_DIGITS) {
+            truncated |= *p != '0';
+            dexp += !in_fraction;
+            continue;
+        }
+        chunk = chunk * 10 + (*p - '0');
+        ndigits++;
+        dexp -= in_fraction;
+        if (++nchunk == 9) {
+            bigint_mul_add(&digits, 1000000000, chunk);
+            chunk = 0;
+            nchunk = 0;
+        }
+    }
+    if (nchunk) {
+        static const uint32_t pow10[] = {
+            1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+        };
+        bigint_mul_add(&digits, pow10[nchunk], chunk);
+    }
+
+    // halfway = (2 m + 1) * 2^(hexp), the midpoint between lower and the
+    // next double up
+    if (lower.power2 == 0) {
+        m = lower.mantissa;
+        mexp = -1074;
+    } else {
+        m = lower.mantissa | ((uint64_t) 1 << 52);
+        mexp = lower.power2 - 1075;
+    }
+    m = 2 * m + 1;
+    hexp = mexp - 1;
+    halfway.limbs[0] = (uint32_t) m;
+    halfway.limbs[1] = (uint32_t) (m >> 32);
+    halfway.len = halfway.limbs[1] ? 2 : 1;
+
+    // Compare digits * 5^dexp * 2^dexp with halfway * 2^hexp
+    if (dexp >= 0) {
+        bigint_mul_pow5(&digits, (int) dexp);
+    } else {
+        bigint_mul_pow5(&halfway, (int) -dexp);
+        hexp -= dexp;
+        dexp = 0;
+    }
+    if (dexp > hexp) {
+        bigint_shift_left(&digits, (int) (dexp - hexp));
+    } else {
+        bigint_shift_left(&halfway, (int) (hexp - dexp));
+    }
+
+    cmp = bigint_compare(&digits, &halfway);
+    if (cmp > 0 || (cmp == 0 && (truncated || (m & 2)))) {
+        // above halfway, or exactly halfway with an odd lower: round up
+        lower.mantissa++;
+        if (lower.mantissa == ((uint64_t) 1 << 52)) {
+            lower.mantissa = 0;
+            lower.power2++;
+        }
+        if (lower.power2 == 0x7FF) {
+            lower.mantissa = 0;
+        }
+    }
+    return lower;
+}
+
+double exact_xstrtod(const char *str, char **endptr, char decimal,
+                     char sci, char tsep, int skip_trailing)
+{
+    // Powers of ten that are exact doubles
+    static const double exact_pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *p = str;
+    const char *mantissa_start, *mantissa_end, *exp_start;
+    uint64_t w = 0;
+    int64_t exponent = 0;
+    int64_t exp_sci = 0;
+    int64_t n;
+    int negative, exp_negative;
+    int num_digits = 0;
+    int num_significant = 0;
+    int truncated = 0;
+    adjusted_mantissa am;
+    uint64_t bits;
+    double number;
+
+    errno = 0;
+
+    // Skip leading whitespace
+    while (isspace(*p)) p++;
+
+    // Handle optional sign
+    negative = 0;
+    switch (*p) {
+        case '-': negative = 1; // Fall through to increment position
+        case '+': p++;
+    }
+    mantissa_start = p;
+
+    // Process string of digits, keeping at most 19 significant ones in w
+    while (isdigit(*p)) {
+        if (num_significant < 19) {
+            w = w * 10 + (*p - '0');
+            num_significant += (w != 0);
+        } else {
+            truncated |= *p != '0';
+            exponent++;
+        }
+        p++;
+        num_digits++;
+
+        p += (tsep != '\0' && *p == tsep);
+    }
+
+    // Process decimal part
+    if (*p == decimal) {
+        p++;
+
+        while (isdigit(*p)) {
+            if (num_significant < 19) {
+                w = w * 10 + (*p - '0');
+                num_significant += (w != 0);
+                exponent--;
+            } else {
+                truncated |= *p != '0';
+            }
+            p++;
+            num_digits++;
+        }
+    }
+    mantissa_end = p;
+
+    if (num_digits == 0) {
+        errno = ERANGE;
+        if (endptr) *endptr = (char *) str;
+        return 0.0;
+    }
+
+    // Process an exponent string
+    if (toupper(*p) == toupper(sci)) {
+        exp_start = p;
+        exp_negative = 0;
+        switch (*++p) {
+            case '-': exp_negative = 1;   // Fall through to increment pos
+            case '+': p++;
+        }
+
+        if (isdigit(*p)) {
+            n = 0;
+            while (isdigit(*p)) {
+                // past 10^5 the result is zero or infinity anyway
+                if (n < 100000) n = n * 10 + (*p - '0');
+                p++;
+            }
+            exp_sci = exp_negative ? -n : n;
+            exponent += exp_sci;
+        } else {
+            // If no digits after the 'e'/'E', un-consume it
+            p = exp_start;
+        }
+    }
+
+    if (w == 0) {
+        number = 0.0;
+    } else if (!truncated && w <= ((uint64_t) 1 << 53) &&
+               exponent >= -22 && exponent <= 22) {
+        number = (double) w;
+        if (exponent < 0)
+            number /= exact_pow10[-exponent];
+        else
+            number *= exact_pow10[exponent];
+    } else {
+        am = eisel_lemire(exponent, w);
+        if (truncated) {
+            adjusted_mantissa upper = eisel_lemire(exponent, w + 1);
+            if (upper.mantissa != am.mantissa || upper.power2 != am.power2) {
+                am = digit_comparison(mantissa_start, mantissa_end, decimal,
+                                      exp_sci, am);
+            }
+        }
+        bits = am.mantissa | ((uint64_t) am.power2 << 52);
+        memcpy(&number, &bits, sizeof(double));
+    }
+
+    if (number == HUGE_VAL) {
+        errno = ERANGE;
+    }
+    if (negative) number = -number;
+
+    if (skip_trailing) {
+        // Skip trailing whitespace
+        while (isspace(*p)) p++;
+    }
+
+    if (endptr) *endptr = (char *) p;
+    return number;
+}
+
+/*
+  SWAR ("SIMD within a register") integer parsing: 8 characters are loaded
+  into one 64 bit word, in which the leading digits are found and converted
+  together.
+
+  The load may read past the end of the string, into the rest of the buffer
+  holding it, but never past the end of that buffer. The bytes after the
+  digits are ignored.
+ */
+
+// The 8 bytes at p, or the bytes before end padded with zeros (which are not
+// digits) if there are fewer
+P_INLINE uint64_t swar_load(const char *p, const char *end)
+{
+    uint64_t val = 0;
+
+    if ((size_t) (end - p) >= sizeof(uint64_t)) {
+        memcpy(&val, p, sizeof(uint64_t));
+    } else {
+        memcpy(&val, p, end - p);
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+    return val;
+}
+
+// Number of leading bytes of val (in string order) that are digits
+P_INLINE int swar_count_digits(uint64_t val)
+{
+    // A byte is a digit if it is at most 9 once '0' is xor'ed out; adding
+    // 0x76 to its low 7 bits then leaves the high bit clear
+    uint64_t x = val ^ 0x3030303030303030ULL;
+    uint64_t nondigit = (((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7676767676767676ULL)
+                         | x) & 0x8080808080808080ULL;
+    int n = 0;
+
+    if (nondigit == 0) {
+        return 8;
+    }
+#if defined(__GNUC__)
+    n = __builtin_ctzll(nondigit);
+#else
+    while (!(nondigit & 1)) {
+        nondigit >>= 1;
+        n++;
+    }
+#endif
+    return n >> 3;
+}
+
+// Value of the first ndigits bytes of val, 0 < ndigits <= 8, which are digits
+P_INLINE uint64_t swar_parse_digits(uint64_t val, int ndigits)
+{
+    // Shifting the digits to the top bytes turns them into the last digits
+    // of an 8 digit number with leading zeros. Bytes are combined pairwise:
+    // first digits, then pairs of digits, then the two halves
+    val = (val - 0x3030303030303030ULL) << (8 * (8 - ndigits));
+    val = (val * 10) + (val >> 8);
+    val = (((val & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+           (((val >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))))
+          >> 32;
+    return val;
+}
+
+/*
+  Parse the digits at p, in a buffer ending at end, when there are at most 18
+  of them, so that they cannot overflow. Returns the number of digits, or -1
+  if the scalar code has to be used.
+ */
+P_INLINE int swar_parse_int(const char *p, const char *end, uint64_t *number)
+{
+    static const uint64_t pow10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+    uint64_t val, result = 0;
+    int ndigits = 0, n;
+
+    do {
+        val = swar_load(p + ndigits, end);
+        n = swar_count_digits(val);
+        if (ndigits + n > 18) {
+            return -1;
+        }
+        if (n > 0) {
+            result = result * pow10[n] + swar_parse_digits(val, n);
+            ndigits += n;
+        }
+    } while (n == 8);
+
+    *number = result;
+    return ndigits;
+}
+
+int64_t str_to_int64(const char *p_item, const char *buf_end, int64_t int_min,
+                     int64_t int_max, int *error, char tsep)
 {
     const char *p = (const char *) p_item;
     int isneg = 0;
     int64_t number = 0;
-    int d;
+    uint64_t value;
+    int d, ndigits;
 
     // Skip leading spaces.
     while (isspace(*p)) {
@@ -1990,7 +3438,15 @@ int64_t str_to_int64(const char *p_item, int64_t int_min, int64_t int_max,
         return 0;
     }
 
-    if (isneg) {
+    ndigits = swar_parse_int(p, buf_end, &value);
+    if (ndigits > 0 && (tsep == '\0' || p[ndigits] != tsep)) {
+        if (isneg ? -(int64_t) value < int_min : (int64_t) value > int_max) {
+            *error = ERROR_OVERFLOW;
+            return 0;
+        }
+        number = isneg ? -(int64_t) value : (int64_t) value;
+        p += ndigits;
+    } else if (isneg) {
         // If number is greater than pre_min, at least one more digit
         // can be processed without overflowing.
         int dig_pre_min = -(int_min % 10);
@@ -134,6 +134,25 @@ typedef enum {
 } QuoteStyle;
 
 
+typedef enum {
+    COLUMN_WORDS, COLUMN_INT64, COLUMN_FLOAT64, COLUMN_BOOL
+} ColumnType;
+
+/*
+  A column converted as its fields end instead of being kept as words.
+  values[i] and na[i] belong to line i; na[i] is 1 where the field is in
+  na_set or is missing from the line, and values[i] is then undefined.
+ */
+typedef struct typed_column_t {
+    int type;
+    void *na_set;      // kh_str_t of NA strings, owned by the parser; or NULL
+    void *true_set;    // kh_str_t of extra true / false strings for bool
+    void *false_set;   //   columns, not owned; or NULL
+    char *values;
+    uint8_t *na;
+    int cap;
+} typed_column_t;
+
 typedef void* (*io_callback)(void *src, size_t nbytes, size_t *bytes_read,
                             int *status);
 typedef int (*io_cleanup)(void *src);
@@ -213,6 +232,12 @@ typedef struct parser_t {
     char *error_msg;
 
     int skip_empty_lines;
+
+    // Typed columns, indexed by field position. Their fields take no space
+    // in the words or the stream, so coliter_setup maps the remaining
+    // columns to their position in the words of a line
+    typed_column_t *columns;
+    int ncolumns;
 } parser_t;
 
 
@@ -245,6 +270,19 @@ int parser_add_skiprow(parser_t *self, int64_t row);
 
 int parser_set_skipfirstnrows(parser_t *self, int64_t nrows);
 
+/*
+  Convert the fields at position col to the given type from now on. The
+  parser takes ownership of na_set. Lines tokenized before are converted by
+  parser_convert_typed_columns, which must be called before tokenizing more.
+ */
+int parser_add_typed_column(parser_t *self, int col, int type, void *na_set,
+                            void *true_set, void *false_set);
+
+int parser_convert_typed_columns(parser_t *self, int start_line);
+
+// The typed column at position col, or NULL if it is kept as words
+typed_column_t *parser_typed_column(parser_t *self, int col);
+
 void parser_free(parser_t *self);
 
 void parser_set_default_options(parser_t *self);
@@ -255,6 +293,16 @@ int tokenize_nrows(parser_t *self, size_t nrows);
 
 int tokenize_all_rows(parser_t *self);
 
+/*
+  Tokenize all remaining rows when the rest of the input is in memory:
+  data[0:len] must be the bytes that follow those read from the source so
+  far, which must be at EOF afterwards. The buffers are sized once from an
+  estimate of the records in data. Uses up to nthreads threads on large
+  inputs.
+ */
+int tokenize_all_rows_parallel(parser_t *self, const char *data, size_t len,
+                               int nthreads);
+
 /*
 
   Have parsed / type-converted a chunk of data and want to free memory from the
@@ -263,13 +311,16 @@ int tokenize_all_rows(parser_t *self);
  */
 //int clear_parsed_lines(parser_t *self, size_t nlines);
 
-int64_t str_to_int64(const char *p_item, int64_t int_min,
+// p_item is a NUL terminated string in a buffer ending at buf_end, all of
+// which may be read
+int64_t str_to_int64(const char *p_item, const char *buf_end, int64_t int_min,
                      int64_t int_max, int *error, char tsep);
 //uint64_t str_to_uint64(const char *p_item, uint64_t uint_max, int *error);
 
 double xstrtod(const char *p, char **q, char decimal, char sci, char tsep, int skip_trailing);
 double precise_xstrtod(const char *p, char **q, char decimal, char sci, char tsep, int skip_trailing);
 double round_trip(const char *p, char **q, char decimal, char sci, char tsep, int skip_trailing);
+double exact_xstrtod(const char *p, char **q, char decimal, char sci, char tsep, int skip_trailing);
 //int P_INLINE to_complex(char *item, double *p_real, double *p_imag, char sci, char decimal);
 //int P_INLINE to_longlong(char *item, long long *p_value);
 //int P_INLINE to_longlong_thousands(char *item, long long *p_value, char tsep);
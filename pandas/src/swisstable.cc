@@ -0,0 +1,185 @@
+/*
+
+C interface to the libpandas hash tables, see swisstable.h
+
+*/
+
+#include "swisstable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+#include <vector>
+
+#include "pandas/util/binary-hash-table.h"
+#include "pandas/util/direct-table.h"
+#include "pandas/util/factorize.h"
+#include "pandas/util/hash-table.h"
+
+// The opaque handles are the tables themselves
+struct swiss_bytes_t : public pandas::BinaryHashTable {};
+
+// Sets *out to a copy of values allocated with malloc
+template <typename T>
+static bool MallocCopy(const std::vector<T> &values, T **out) {
+  // + 1 as malloc(0) may return NULL
+  const size_t nbytes = values.size() * sizeof(T);
+  *out = static_cast<T *>(malloc(nbytes + 1));
+  if (*out == NULL) {
+    return false;
+  }
+  memcpy(*out, values.data(), nbytes);
+  return true;
+}
+
+#define SWISS_TABLE_IMPL(NAME, KEY, TABLE)                                   \
+  struct swiss_##NAME##_t : public TABLE {};                                 \
+                                                                             \
+  swiss_##NAME##_t *swiss_##NAME##_new(int64_t size_hint) {                  \
+    swiss_##NAME##_t *table = new (std::nothrow) swiss_##NAME##_t();         \
+    if (table != NULL && !table->Reserve(size_hint)) {                       \
+      delete table;                                                          \
+      return NULL;                                                           \
+    }                                                                        \
+    return table;                                                            \
+  }                                                                          \
+                                                                             \
+  void swiss_##NAME##_free(swiss_##NAME##_t *table) { delete table; }        \
+                                                                             \
+  int64_t swiss_##NAME##_size(const swiss_##NAME##_t *table) {               \
+    return table->size();                                                    \
+  }                                                                          \
+                                                                             \
+  int swiss_##NAME##_get(const swiss_##NAME##_t *table, KEY key,             \
+                         int64_t *value) {                                   \
+    return table->Find(key, value);                                          \
+  }                                                                          \
+                                                                             \
+  int swiss_##NAME##_set(swiss_##NAME##_t *table, KEY key, int64_t value) {  \
+    return table->Set(key, value) ? 0 : -1;                                  \
+  }                                                                          \
+                                                                             \
+  void swiss_##NAME##_lookup(const swiss_##NAME##_t *table, const KEY *keys, \
+                             int64_t n, int64_t *values) {                   \
+    table->Find(keys, n, -1, values);                                        \
+  }                                                                          \
+                                                                             \
+  int swiss_##NAME##_get_labels(swiss_##NAME##_t *table, const KEY *keys,    \
+                                int64_t n, int64_t *next_value,              \
+                                int64_t *values, const uint8_t *skip,        \
+                                int64_t skip_value, uint8_t *inserted) {     \
+    return table->GetOrInsert(keys, n, next_value, values, skip, skip_value, \
+                              inserted)                                      \
+               ? 0                                                           \
+               : -1;                                                         \
+  }                                                                          \
+                                                                             \
+  int swiss_##NAME##_factorize(const KEY *keys, int64_t n, int nthreads,     \
+                               int64_t *labels, const uint8_t *skip,         \
+                               int64_t skip_value, KEY **uniques,            \
+                               int64_t *num_uniques) {                       \
+    try {                                                                    \
+      std::vector<KEY> result;                                               \
+      if (!pandas::ParallelFactorize(keys, n, nthreads, labels, &result,     \
+                                     skip, skip_value) ||                    \
+          !MallocCopy(result, uniques)) {                                    \
+        return -1;                                                           \
+      }                                                                      \
+      *num_uniques = result.size();                                          \
+      return 0;                                                              \
+    } catch (const std::bad_alloc &) {                                       \
+      return -1;                                                             \
+    }                                                                        \
+  }                                                                          \
+                                                                             \
+  int swiss_##NAME##_value_counts(const KEY *keys, int64_t n,                \
+                                  const uint8_t *skip, KEY **uniques,        \
+                                  int64_t **counts, int64_t *num_uniques) {  \
+    try {                                                                    \
+      std::vector<KEY> keys_result;                                          \
+      std::vector<int64_t> counts_result;                                    \
+      if (!pandas::ValueCounts(keys, n, &keys_result, &counts_result,        \
+                               skip) ||                                      \
+          !MallocCopy(keys_result, uniques)) {                               \
+        return -1;                                                           \
+      }                                                                      \
+      if (!MallocCopy(counts_result, counts)) {                              \
+        free(*uniques);                                                      \
+        return -1;                                                           \
+      }                                                                      \
+      *num_uniques = keys_result.size();                                     \
+      return 0;                                                              \
+    } catch (const std::bad_alloc &) {                                       \
+      return -1;                                                             \
+    }                                                                        \
+  }
+
+extern "C" {
+
+SWISS_TABLE_IMPL(int8, int8_t, pandas::DirectTable<int8_t>)
+SWISS_TABLE_IMPL(int16, int16_t, pandas::HashTable<int16_t>)
+SWISS_TABLE_IMPL(int32, int32_t, pandas::HashTable<int32_t>)
+SWISS_TABLE_IMPL(int64, int64_t, pandas::HashTable<int64_t>)
+SWISS_TABLE_IMPL(uint8, uint8_t, pandas::DirectTable<uint8_t>)
+SWISS_TABLE_IMPL(uint16, uint16_t, pandas::HashTable<uint16_t>)
+SWISS_TABLE_IMPL(uint32, uint32_t, pandas::HashTable<uint32_t>)
+SWISS_TABLE_IMPL(uint64, uint64_t, pandas::HashTable<uint64_t>)
+SWISS_TABLE_IMPL(float32, float, pandas::HashTable<float>)
+SWISS_TABLE_IMPL(float64, double, pandas::HashTable<double>)
+
+swiss_bytes_t *swiss_bytes_new(int64_t size_hint) {
+  swiss_bytes_t *table = new (std::nothrow) swiss_bytes_t();
+  if (table != NULL && !table->Reserve(size_hint)) {
+    delete table;
+    return NULL;
+  }
+  return table;
+}
+
+void swiss_bytes_free(swiss_bytes_t *table) { delete table; }
+
+int64_t swiss_bytes_size(const swiss_bytes_t *table) { return table->size(); }
+
+int swiss_bytes_get(const swiss_bytes_t *table, const char *key,
+                    int64_t length, int64_t *value) {
+  return table->Find(reinterpret_cast<const uint8_t *>(key), length, value);
+}
+
+int swiss_bytes_set(swiss_bytes_t *table, const char *key, int64_t length,
+                    int64_t value) {
+  return table->Set(reinterpret_cast<const uint8_t *>(key), length, value) ? 0
+                                                                           : -1;
+}
+
+int swiss_bytes_get_or_insert(swiss_bytes_t *table, const char *key,
+                              int64_t length, int64_t *next_value,
+                              int64_t *value) {
+  return table->GetOrInsert(reinterpret_cast<const uint8_t *>(key), length,
+                            next_value, value)
+             ? 0
+             : -1;
+}
+
+void swiss_bytes_lookup(const swiss_bytes_t *table, const int32_t *offsets,
+                        const uint8_t *data, int64_t n, int64_t *values) {
+  table->Find(offsets, data, n, -1, values);
+}
+
+int swiss_bytes_get_labels(swiss_bytes_t *table, const int32_t *offsets,
+                           const uint8_t *data, int64_t n,
+                           int64_t *next_value, int64_t *values,
+                           const uint8_t *skip, int64_t skip_value) {
+  return table->GetOrInsert(offsets, data, n, next_value, values, skip,
+                            skip_value)
+             ? 0
+             : -1;
+}
+
+void swiss_bytes_keys(const swiss_bytes_t *table, const int64_t **offsets,
+                      const uint8_t **data) {
+  *offsets = table->key_offsets();
+  *data = table->key_data();
+}
+
+}
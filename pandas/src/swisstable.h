@@ -0,0 +1,121 @@
+/*
+
+C interface to the hash tables of libpandas (src/pandas/util/hash-table.h,
+direct-table.h and binary-hash-table.h), which back the numeric hash tables
+and StringHashTable. The tables are opaque so that modules compiled as C can
+cimport the hashtable classes. Compilers without C++11 build the khash
+implementation in swisstable_khash.c instead.
+
+Functions returning int return 0 on success and -1 if out of memory.
+
+*/
+
+#ifndef PANDAS_SWISSTABLE_H_
+#define PANDAS_SWISSTABLE_H_
+
+#include "headers/stdint.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  There is a table type swiss_NAME_t for each numeric type, with the
+  functions below. The 8-bit tables address their keys directly instead of
+  hashing them.
+
+  new: a table with room for size_hint keys, or NULL if out of memory
+  get: sets *value and returns 1 if key is present, else returns 0
+  set: sets the value of key, inserting it if needed
+  lookup: values[i] is the value of keys[i], or -1 if it is not present
+  get_labels: values[i] is the value of keys[i]; keys not yet present are
+    inserted with the values *next_value, *next_value + 1, ... in order of
+    first occurrence. Keys for which skip (if not NULL) is nonzero are not
+    inserted and get skip_value instead. inserted[i] (if not NULL) is 1 if
+    keys[i] was inserted by this call and 0 otherwise
+
+  and, without a table:
+
+  factorize: labels[i] is the position of keys[i] in *uniques, which holds
+    the distinct keys in order of first occurrence. Integer keys in a small
+    range are addressed directly, other keys are hashed using up to nthreads
+    threads on large arrays. Keys for which skip (if not NULL) is nonzero get
+    skip_value instead. *uniques is allocated with malloc and must be freed
+  value_counts: *uniques holds the distinct keys for which skip (if not NULL)
+    is zero and *counts their numbers of occurrences, in ascending order of
+    key if they are in a small range and in order of first occurrence
+    otherwise. Both are allocated with malloc and must be freed
+ */
+
+#define SWISS_TABLE_DECLARE(NAME, KEY)                                       \
+  typedef struct swiss_##NAME##_t swiss_##NAME##_t;                          \
+                                                                             \
+  swiss_##NAME##_t *swiss_##NAME##_new(int64_t size_hint);                   \
+  void swiss_##NAME##_free(swiss_##NAME##_t *table);                         \
+  int64_t swiss_##NAME##_size(const swiss_##NAME##_t *table);                \
+  int swiss_##NAME##_get(const swiss_##NAME##_t *table, KEY key,             \
+                         int64_t *value);                                    \
+  int swiss_##NAME##_set(swiss_##NAME##_t *table, KEY key, int64_t value);   \
+  void swiss_##NAME##_lookup(const swiss_##NAME##_t *table, const KEY *keys, \
+                             int64_t n, int64_t *values);                    \
+  int swiss_##NAME##_get_labels(swiss_##NAME##_t *table, const KEY *keys,    \
+                                int64_t n, int64_t *next_value,              \
+                                int64_t *values, const uint8_t *skip,        \
+                                int64_t skip_value, uint8_t *inserted);      \
+  int swiss_##NAME##_factorize(const KEY *keys, int64_t n, int nthreads,     \
+                               int64_t *labels, const uint8_t *skip,         \
+                               int64_t skip_value, KEY **uniques,            \
+                               int64_t *num_uniques);                        \
+  int swiss_##NAME##_value_counts(const KEY *keys, int64_t n,                \
+                                  const uint8_t *skip, KEY **uniques,        \
+                                  int64_t **counts, int64_t *num_uniques);
+
+SWISS_TABLE_DECLARE(int8, int8_t)
+SWISS_TABLE_DECLARE(int16, int16_t)
+SWISS_TABLE_DECLARE(int32, int32_t)
+SWISS_TABLE_DECLARE(int64, int64_t)
+SWISS_TABLE_DECLARE(uint8, uint8_t)
+SWISS_TABLE_DECLARE(uint16, uint16_t)
+SWISS_TABLE_DECLARE(uint32, uint32_t)
+SWISS_TABLE_DECLARE(uint64, uint64_t)
+SWISS_TABLE_DECLARE(float32, float)
+SWISS_TABLE_DECLARE(float64, double)
+
+/*
+  swiss_bytes_t maps byte strings to int64 and owns copies of its keys. The
+  batch functions take keys as offsets and data: key i is the
+  offsets[i + 1] - offsets[i] bytes at data + offsets[i].
+
+  get_or_insert: sets *value to the value of key, inserting it with the
+    value (*next_value)++ if it is not present
+  keys: sets *offsets and *data to the keys in insertion order, in the same
+    layout with int64 offsets. Both are NULL while the table is empty, and
+    are invalidated by inserting keys
+ */
+
+typedef struct swiss_bytes_t swiss_bytes_t;
+
+swiss_bytes_t *swiss_bytes_new(int64_t size_hint);
+void swiss_bytes_free(swiss_bytes_t *table);
+int64_t swiss_bytes_size(const swiss_bytes_t *table);
+int swiss_bytes_get(const swiss_bytes_t *table, const char *key,
+                    int64_t length, int64_t *value);
+int swiss_bytes_set(swiss_bytes_t *table, const char *key, int64_t length,
+                    int64_t value);
+int swiss_bytes_get_or_insert(swiss_bytes_t *table, const char *key,
+                              int64_t length, int64_t *next_value,
+                              int64_t *value);
+void swiss_bytes_lookup(const swiss_bytes_t *table, const int32_t *offsets,
+                        const uint8_t *data, int64_t n, int64_t *values);
+int swiss_bytes_get_labels(swiss_bytes_t *table, const int32_t *offsets,
+                           const uint8_t *data, int64_t n,
+                           int64_t *next_value, int64_t *values,
+                           const uint8_t *skip, int64_t skip_value);
+void swiss_bytes_keys(const swiss_bytes_t *table, const int64_t **offsets,
+                      const uint8_t **data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* PANDAS_SWISSTABLE_H_ */
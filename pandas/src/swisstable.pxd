@@ -0,0 +1,267 @@
+from numpy cimport (int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t,
+                    uint32_t, uint64_t, float32_t, float64_t)
+
+cdef extern from "swisstable.h":
+    ctypedef struct swiss_int8_t:
+        pass
+
+    swiss_int8_t* swiss_int8_new(int64_t size_hint) nogil
+    void swiss_int8_free(swiss_int8_t *table) nogil
+    int64_t swiss_int8_size(const swiss_int8_t *table) nogil
+    int swiss_int8_get(const swiss_int8_t *table, int8_t key,
+                       int64_t *value) nogil
+    int swiss_int8_set(swiss_int8_t *table, int8_t key, int64_t value) nogil
+    void swiss_int8_lookup(const swiss_int8_t *table, const int8_t *keys,
+                           int64_t n, int64_t *values) nogil
+    int swiss_int8_get_labels(swiss_int8_t *table, const int8_t *keys,
+                              int64_t n, int64_t *next_value, int64_t *values,
+                              const uint8_t *skip, int64_t skip_value,
+                              uint8_t *inserted) nogil
+    int swiss_int8_factorize(const int8_t *keys, int64_t n, int nthreads,
+                             int64_t *labels, const uint8_t *skip,
+                             int64_t skip_value, int8_t **uniques,
+                             int64_t *num_uniques) nogil
+    int swiss_int8_value_counts(const int8_t *keys, int64_t n,
+                                const uint8_t *skip, int8_t **uniques,
+                                int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_int16_t:
+        pass
+
+    swiss_int16_t* swiss_int16_new(int64_t size_hint) nogil
+    void swiss_int16_free(swiss_int16_t *table) nogil
+    int64_t swiss_int16_size(const swiss_int16_t *table) nogil
+    int swiss_int16_get(const swiss_int16_t *table, int16_t key,
+                        int64_t *value) nogil
+    int swiss_int16_set(swiss_int16_t *table, int16_t key, int64_t value) nogil
+    void swiss_int16_lookup(const swiss_int16_t *table, const int16_t *keys,
+                            int64_t n, int64_t *values) nogil
+    int swiss_int16_get_labels(swiss_int16_t *table, const int16_t *keys,
+                               int64_t n, int64_t *next_value, int64_t *values,
+                               const uint8_t *skip, int64_t skip_value,
+                               uint8_t *inserted) nogil
+    int swiss_int16_factorize(const int16_t *keys, int64_t n, int nthreads,
+                              int64_t *labels, const uint8_t *skip,
+                              int64_t skip_value, int16_t **uniques,
+                              int64_t *num_uniques) nogil
+    int swiss_int16_value_counts(const int16_t *keys, int64_t n,
+                                 const uint8_t *skip, int16_t **uniques,
+                                 int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_int32_t:
+        pass
+
+    swiss_int32_t* swiss_int32_new(int64_t size_hint) nogil
+    void swiss_int32_free(swiss_int32_t *table) nogil
+    int64_t swiss_int32_size(const swiss_int32_t *table) nogil
+    int swiss_int32_get(const swiss_int32_t *table, int32_t key,
+                        int64_t *value) nogil
+    int swiss_int32_set(swiss_int32_t *table, int32_t key, int64_t value) nogil
+    void swiss_int32_lookup(const swiss_int32_t *table, const int32_t *keys,
+                            int64_t n, int64_t *values) nogil
+    int swiss_int32_get_labels(swiss_int32_t *table, const int32_t *keys,
+                               int64_t n, int64_t *next_value, int64_t *values,
+                               const uint8_t *skip, int64_t skip_value,
+                               uint8_t *inserted) nogil
+    int swiss_int32_factorize(const int32_t *keys, int64_t n, int nthreads,
+                              int64_t *labels, const uint8_t *skip,
+                              int64_t skip_value, int32_t **uniques,
+                              int64_t *num_uniques) nogil
+    int swiss_int32_value_counts(const int32_t *keys, int64_t n,
+                                 const uint8_t *skip, int32_t **uniques,
+                                 int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_int64_t:
+        pass
+
+    swiss_int64_t* swiss_int64_new(int64_t size_hint) nogil
+    void swiss_int64_free(swiss_int64_t *table) nogil
+    int64_t swiss_int64_size(const swiss_int64_t *table) nogil
+    int swiss_int64_get(const swiss_int64_t *table, int64_t key,
+                        int64_t *value) nogil
+    int swiss_int64_set(swiss_int64_t *table, int64_t key, int64_t value) nogil
+    void swiss_int64_lookup(const swiss_int64_t *table, const int64_t *keys,
+                            int64_t n, int64_t *values) nogil
+    int swiss_int64_get_labels(swiss_int64_t *table, const int64_t *keys,
+                               int64_t n, int64_t *next_value, int64_t *values,
+                               const uint8_t *skip, int64_t skip_value,
+                               uint8_t *inserted) nogil
+    int swiss_int64_factorize(const int64_t *keys, int64_t n, int nthreads,
+                              int64_t *labels, const uint8_t *skip,
+                              int64_t skip_value, int64_t **uniques,
+                              int64_t *num_uniques) nogil
+    int swiss_int64_value_counts(const int64_t *keys, int64_t n,
+                                 const uint8_t *skip, int64_t **uniques,
+                                 int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_uint8_t:
+        pass
+
+    swiss_uint8_t* swiss_uint8_new(int64_t size_hint) nogil
+    void swiss_uint8_free(swiss_uint8_t *table) nogil
+    int64_t swiss_uint8_size(const swiss_uint8_t *table) nogil
+    int swiss_uint8_get(const swiss_uint8_t *table, uint8_t key,
+                        int64_t *value) nogil
+    int swiss_uint8_set(swiss_uint8_t *table, uint8_t key, int64_t value) nogil
+    void swiss_uint8_lookup(const swiss_uint8_t *table, const uint8_t *keys,
+                            int64_t n, int64_t *values) nogil
+    int swiss_uint8_get_labels(swiss_uint8_t *table, const uint8_t *keys,
+                               int64_t n, int64_t *next_value, int64_t *values,
+                               const uint8_t *skip, int64_t skip_value,
+                               uint8_t *inserted) nogil
+    int swiss_uint8_factorize(const uint8_t *keys, int64_t n, int nthreads,
+                              int64_t *labels, const uint8_t *skip,
+                              int64_t skip_value, uint8_t **uniques,
+                              int64_t *num_uniques) nogil
+    int swiss_uint8_value_counts(const uint8_t *keys, int64_t n,
+                                 const uint8_t *skip, uint8_t **uniques,
+                                 int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_uint16_t:
+        pass
+
+    swiss_uint16_t* swiss_uint16_new(int64_t size_hint) nogil
+    void swiss_uint16_free(swiss_uint16_t *table) nogil
+    int64_t swiss_uint16_size(const swiss_uint16_t *table) nogil
+    int swiss_uint16_get(const swiss_uint16_t *table, uint16_t key,
+                         int64_t *value) nogil
+    int swiss_uint16_set(swiss_uint16_t *table, uint16_t key,
+                         int64_t value) nogil
+    void swiss_uint16_lookup(const swiss_uint16_t *table, const uint16_t *keys,
+                             int64_t n, int64_t *values) nogil
+    int swiss_uint16_get_labels(swiss_uint16_t *table, const uint16_t *keys,
+                                int64_t n, int64_t *next_value,
+                                int64_t *values, const uint8_t *skip,
+                                int64_t skip_value, uint8_t *inserted) nogil
+    int swiss_uint16_factorize(const uint16_t *keys, int64_t n, int nthreads,
+                               int64_t *labels, const uint8_t *skip,
+                               int64_t skip_value, uint16_t **uniques,
+                               int64_t *num_uniques) nogil
+    int swiss_uint16_value_counts(const uint16_t *keys, int64_t n,
+                                  const uint8_t *skip, uint16_t **uniques,
+                                  int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_uint32_t:
+        pass
+
+    swiss_uint32_t* swiss_uint32_new(int64_t size_hint) nogil
+    void swiss_uint32_free(swiss_uint32_t *table) nogil
+    int64_t swiss_uint32_size(const swiss_uint32_t *table) nogil
+    int swiss_uint32_get(const swiss_uint32_t *table, uint32_t key,
+                         int64_t *value) nogil
+    int swiss_uint32_set(swiss_uint32_t *table, uint32_t key,
+                         int64_t value) nogil
+    void swiss_uint32_lookup(const swiss_uint32_t *table, const uint32_t *keys,
+                             int64_t n, int64_t *values) nogil
+    int swiss_uint32_get_labels(swiss_uint32_t *table, const uint32_t *keys,
+                                int64_t n, int64_t *next_value,
+                                int64_t *values, const uint8_t *skip,
+                                int64_t skip_value, uint8_t *inserted) nogil
+    int swiss_uint32_factorize(const uint32_t *keys, int64_t n, int nthreads,
+                               int64_t *labels, const uint8_t *skip,
+                               int64_t skip_value, uint32_t **uniques,
+                               int64_t *num_uniques) nogil
+    int swiss_uint32_value_counts(const uint32_t *keys, int64_t n,
+                                  const uint8_t *skip, uint32_t **uniques,
+                                  int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_uint64_t:
+        pass
+
+    swiss_uint64_t* swiss_uint64_new(int64_t size_hint) nogil
+    void swiss_uint64_free(swiss_uint64_t *table) nogil
+    int64_t swiss_uint64_size(const swiss_uint64_t *table) nogil
+    int swiss_uint64_get(const swiss_uint64_t *table, uint64_t key,
+                         int64_t *value) nogil
+    int swiss_uint64_set(swiss_uint64_t *table, uint64_t key,
+                         int64_t value) nogil
+    void swiss_uint64_lookup(const swiss_uint64_t *table, const uint64_t *keys,
+                             int64_t n, int64_t *values) nogil
+    int swiss_uint64_get_labels(swiss_uint64_t *table, const uint64_t *keys,
+                                int64_t n, int64_t *next_value,
+                                int64_t *values, const uint8_t *skip,
+                                int64_t skip_value, uint8_t *inserted) nogil
+    int swiss_uint64_factorize(const uint64_t *keys, int64_t n, int nthreads,
+                               int64_t *labels, const uint8_t *skip,
+                               int64_t skip_value, uint64_t **uniques,
+                               int64_t *num_uniques) nogil
+    int swiss_uint64_value_counts(const uint64_t *keys, int64_t n,
+                                  const uint8_t *skip, uint64_t **uniques,
+                                  int64_t **counts, int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_float32_t:
+        pass
+
+    swiss_float32_t* swiss_float32_new(int64_t size_hint) nogil
+    void swiss_float32_free(swiss_float32_t *table) nogil
+    int64_t swiss_float32_size(const swiss_float32_t *table) nogil
+    int swiss_float32_get(const swiss_float32_t *table, float32_t key,
+                          int64_t *value) nogil
+    int swiss_float32_set(swiss_float32_t *table, float32_t key,
+                          int64_t value) nogil
+    void swiss_float32_lookup(const swiss_float32_t *table,
+                              const float32_t *keys, int64_t n,
+                              int64_t *values) nogil
+    int swiss_float32_get_labels(swiss_float32_t *table, const float32_t *keys,
+                                 int64_t n, int64_t *next_value,
+                                 int64_t *values, const uint8_t *skip,
+                                 int64_t skip_value, uint8_t *inserted) nogil
+    int swiss_float32_factorize(const float32_t *keys, int64_t n, int nthreads,
+                                int64_t *labels, const uint8_t *skip,
+                                int64_t skip_value, float32_t **uniques,
+                                int64_t *num_uniques) nogil
+    int swiss_float32_value_counts(const float32_t *keys, int64_t n,
+                                   const uint8_t *skip, float32_t **uniques,
+                                   int64_t **counts,
+                                   int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_float64_t:
+        pass
+
+    swiss_float64_t* swiss_float64_new(int64_t size_hint) nogil
+    void swiss_float64_free(swiss_float64_t *table) nogil
+    int64_t swiss_float64_size(const swiss_float64_t *table) nogil
+    int swiss_float64_get(const swiss_float64_t *table, float64_t key,
+                          int64_t *value) nogil
+    int swiss_float64_set(swiss_float64_t *table, float64_t key,
+                          int64_t value) nogil
+    void swiss_float64_lookup(const swiss_float64_t *table,
+                              const float64_t *keys, int64_t n,
+                              int64_t *values) nogil
+    int swiss_float64_get_labels(swiss_float64_t *table, const float64_t *keys,
+                                 int64_t n, int64_t *next_value,
+                                 int64_t *values, const uint8_t *skip,
+                                 int64_t skip_value, uint8_t *inserted) nogil
+    int swiss_float64_factorize(const float64_t *keys, int64_t n, int nthreads,
+                                int64_t *labels, const uint8_t *skip,
+                                int64_t skip_value, float64_t **uniques,
+                                int64_t *num_uniques) nogil
+    int swiss_float64_value_counts(const float64_t *keys, int64_t n,
+                                   const uint8_t *skip, float64_t **uniques,
+                                   int64_t **counts,
+                                   int64_t *num_uniques) nogil
+
+    ctypedef struct swiss_bytes_t:
+        pass
+
+    swiss_bytes_t* swiss_bytes_new(int64_t size_hint) nogil
+    void swiss_bytes_free(swiss_bytes_t *table) nogil
+    int64_t swiss_bytes_size(const swiss_bytes_t *table) nogil
+    int swiss_bytes_get(const swiss_bytes_t *table, const char *key,
+                        int64_t length, int64_t *value) nogil
+    int swiss_bytes_set(swiss_bytes_t *table, const char *key,
+                        int64_t length, int64_t value) nogil
+    int swiss_bytes_get_or_insert(swiss_bytes_t *table, const char *key,
+                                  int64_t length, int64_t *next_value,
+                                  int64_t *value) nogil
+    void swiss_bytes_lookup(const swiss_bytes_t *table,
+                            const int32_t *offsets, const uint8_t *data,
+                            int64_t n, int64_t *values) nogil
+    int swiss_bytes_get_labels(swiss_bytes_t *table, const int32_t *offsets,
+                               const uint8_t *data, int64_t n,
+                               int64_t *next_value, int64_t *values,
+                               const uint8_t *skip,
+                               int64_t skip_value) nogil
+    void swiss_bytes_keys(const swiss_bytes_t *table,
+                          const int64_t **offsets,
+                          const uint8_t **data) nogil
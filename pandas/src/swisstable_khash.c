@@ -0,0 +1,444 @@
+/*
+
+The interface of swisstable.h implemented with khash, for compilers without
+C++11 (MSVC before 2015), which cannot build the libpandas tables that
+swisstable.cc wraps. It is plain C89.
+
+As with the khash tables that pandas used before, running out of memory
+inside khash is not detected. factorize ignores nthreads, and value_counts
+returns the keys in order of first occurrence.
+
+*/
+
+#include "swisstable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "khash.h"
+
+/* Large enough for any size hint that khash's 32-bit bucket count can hold */
+#define SWISS_MAX_SIZE_HINT ((int64_t)1 << 30)
+
+/* All NaNs are one key, as are 0.0 and -0.0, so they must hash alike */
+PANDAS_INLINE khint32_t swiss_float64_hash(double key) {
+    khuint64_t bits = 0;
+    if (key == 0.0) {
+        key = 0.0;
+    } else if (key != key) {
+        return 0;
+    }
+    memcpy(&bits, &key, sizeof(bits));
+    return kh_int64_hash_func(bits);
+}
+
+#define swiss_float_hash_func(key) swiss_float64_hash((double)(key))
+#define swiss_float_hash_equal(a, b) ((a) == (b) || ((a) != (a) && (b) != (b)))
+
+#define SWISS_TABLE_IMPL(NAME, KEY, HASH, EQUAL)                              \
+    KHASH_INIT(swiss_##NAME, KEY, int64_t, 1, HASH, EQUAL)                    \
+                                                                              \
+    struct swiss_##NAME##_t {                                                 \
+        kh_swiss_##NAME##_t *h;                                               \
+    };                                                                        \
+                                                                              \
+    swiss_##NAME##_t *swiss_##NAME##_new(int64_t size_hint) {                 \
+        swiss_##NAME##_t *table =                                             \
+            (swiss_##NAME##_t *)malloc(sizeof(swiss_##NAME##_t));             \
+        if (table == NULL) {                                                  \
+            return NULL;                                                      \
+        }                                                                     \
+        table->h = kh_init_swiss_##NAME();                                    \
+        if (table->h == NULL) {                                               \
+            free(table);                                                      \
+            return NULL;                                                      \
+        }                                                                     \
+        if (size_hint > SWISS_MAX_SIZE_HINT) {                                \
+            size_hint = SWISS_MAX_SIZE_HINT;                                  \
+        }                                                                     \
+        if (size_hint > 0) {                                                  \
+            kh_resize_swiss_##NAME(table->h, (khint_t)size_hint);             \
+        }                                                                     \
+        return table;                                                         \
+    }                                                                         \
+                                                                              \
+    void swiss_##NAME##_free(swiss_##NAME##_t *table) {                       \
+        if (table != NULL) {                                                  \
+            kh_destroy_swiss_##NAME(table->h);                                \
+            free(table);                                                      \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    int64_t swiss_##NAME##_size(const swiss_##NAME##_t *table) {              \
+        return kh_size(table->h);                                             \
+    }                                                                         \
+                                                                              \
+    int swiss_##NAME##_get(const swiss_##NAME##_t *table, KEY key,            \
+                           int64_t *value) {                                  \
+        khiter_t k = kh_get_swiss_##NAME(table->h, key);                      \
+        if (k == table->h->n_buckets) {                                       \
+            return 0;                                                         \
+        }                                                                     \
+        *value = table->h->vals[k];                                           \
+        return 1;                                                             \
+    }                                                                         \
+                                                                              \
+    int swiss_##NAME##_set(swiss_##NAME##_t *table, KEY key, int64_t value) { \
+        int ret = 0;                                                          \
+        khiter_t k = kh_put_swiss_##NAME(table->h, key, &ret);                \
+        table->h->vals[k] = value;                                            \
+        return 0;                                                             \
+    }                                                                         \
+                                                                              \
+    void swiss_##NAME##_lookup(const swiss_##NAME##_t *table, const KEY *keys, \
+                               int64_t n, int64_t *values) {                  \
+        int64_t i;                                                            \
+        khiter_t k;                                                           \
+        for (i = 0; i < n; ++i) {                                             \
+            k = kh_get_swiss_##NAME(table->h, keys[i]);                       \
+            values[i] = k == table->h->n_buckets ? -1 : table->h->vals[k];    \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    int swiss_##NAME##_get_labels(swiss_##NAME##_t *table, const KEY *keys,   \
+                                  int64_t n, int64_t *next_value,             \
+                                  int64_t *values, const uint8_t *skip,       \
+                                  int64_t skip_value, uint8_t *inserted) {    \
+        int64_t i;                                                            \
+        int ret = 0;                                                          \
+        khiter_t k;                                                           \
+        for (i = 0; i < n; ++i) {                                             \
+            if (skip != NULL && skip[i]) {                                    \
+                values[i] = skip_value;                                       \
+                ret = 0;                                                      \
+            } else {                                                          \
+                k = kh_put_swiss_##NAME(table->h, keys[i], &ret);             \
+                if (ret) {                                                    \
+                    table->h->vals[k] = (*next_value)++;                      \
+                }                                                             \
+                values[i] = table->h->vals[k];                                \
+            }                                                                 \
+            if (inserted != NULL) {                                           \
+                inserted[i] = ret != 0;                                       \
+            }                                                                 \
+        }                                                                     \
+        return 0;                                                             \
+    }                                                                         \
+                                                                              \
+    int swiss_##NAME##_factorize(const KEY *keys, int64_t n, int nthreads,    \
+                                 int64_t *labels, const uint8_t *skip,        \
+                                 int64_t skip_value, KEY **uniques,           \
+                                 int64_t *num_uniques) {                      \
+        int64_t i, count = 0;                                                 \
+        int ret = 0;                                                          \
+        khiter_t k;                                                           \
+        kh_swiss_##NAME##_t *h;                                               \
+        /* + 1 as malloc(0) may return NULL */                                \
+        KEY *result = (KEY *)malloc(n * sizeof(KEY) + 1);                     \
+        (void)nthreads;                                                       \
+        if (result == NULL) {                                                 \
+            return -1;                                                        \
+        }                                                                     \
+        h = kh_init_swiss_##NAME();                                           \
+        if (h == NULL) {                                                      \
+            free(result);                                                     \
+            return -1;                                                        \
+        }                                                                     \
+        for (i = 0; i < n; ++i) {                                             \
+            if (skip != NULL && skip[i]) {                                    \
+                labels[i] = skip_value;                                       \
+                continue;                                                     \
+            }                                                                 \
+            k = kh_put_swiss_##NAME(h, keys[i], &ret);                        \
+            if (ret) {                                                        \
+                h->vals[k] = count;                                           \
+                result[count++] = keys[i];                                    \
+            }                                                                 \
+            labels[i] = h->vals[k];                                           \
+        }                                                                     \
+        kh_destroy_swiss_##NAME(h);                                           \
+        *uniques = result;                                                    \
+        *num_uniques = count;                                                 \
+        return 0;                                                             \
+    }                                                                         \
+                                                                              \
+    int swiss_##NAME##_value_counts(const KEY *keys, int64_t n,               \
+                                    const uint8_t *skip, KEY **uniques,       \
+                                    int64_t **counts, int64_t *num_uniques) { \
+        int64_t i, count = 0;                                                 \
+        int ret = 0;                                                          \
+        khiter_t k;                                                           \
+        kh_swiss_##NAME##_t *h;                                               \
+        KEY *result = (KEY *)malloc(n * sizeof(KEY) + 1);                     \
+        int64_t *result_counts = (int64_t *)malloc(n * sizeof(int64_t) + 1);  \
+        if (result == NULL || result_counts == NULL) {                        \
+            free(result);                                                     \
+            free(result_counts);                                              \
+            return -1;                                                        \
+        }                                                                     \
+        h = kh_init_swiss_##NAME();                                           \
+        if (h == NULL) {                                                      \
+            free(result);                                                     \
+            free(result_counts);                                              \
+            return -1;                                                        \
+        }                                                                     \
+        for (i = 0; i < n; ++i) {                                             \
+            if (skip != NULL && skip[i]) {                                    \
+                continue;                                                     \
+            }                                                                 \
+            k = kh_put_swiss_##NAME(h, keys[i], &ret);                        \
+            if (ret) {                                                        \
+                h->vals[k] = count;                                           \
+                result[count] = keys[i];                                      \
+                result_counts[count++] = 0;                                   \
+            }                                                                 \
+            ++result_counts[h->vals[k]];                                      \
+        }                                                                     \
+        kh_destroy_swiss_##NAME(h);                                           \
+        *uniques = result;                                                    \
+        *counts = result_counts;                                              \
+        *num_uniques = count;                                                 \
+        return 0;                                                             \
+    }
+
+SWISS_TABLE_IMPL(int8, int8_t, kh_int_hash_func, kh_int_hash_equal)
+SWISS_TABLE_IMPL(int16, int16_t, kh_int_hash_func, kh_int_hash_equal)
+SWISS_TABLE_IMPL(int32, int32_t, kh_int_hash_func, kh_int_hash_equal)
+SWISS_TABLE_IMPL(int64, int64_t, kh_int64_hash_func, kh_int64_hash_equal)
+SWISS_TABLE_IMPL(uint8, uint8_t, kh_int_hash_func, kh_int_hash_equal)
+SWISS_TABLE_IMPL(uint16, uint16_t, kh_int_hash_func, kh_int_hash_equal)
+SWISS_TABLE_IMPL(uint32, uint32_t, kh_int_hash_func, kh_int_hash_equal)
+SWISS_TABLE_IMPL(uint64, uint64_t, kh_int64_hash_func, kh_int64_hash_equal)
+SWISS_TABLE_IMPL(float32, float, swiss_float_hash_func, swiss_float_hash_equal)
+SWISS_TABLE_IMPL(float64, double, swiss_float_hash_func,
+                 swiss_float_hash_equal)
+
+/*
+  A byte string key is length bytes at *base + offset. The keys in the table
+  point at the table's own copy, whose address changes as it grows; the keys
+  searched for point at the caller's data.
+ */
+typedef struct {
+    const uint8_t *const *base;
+    int64_t offset;
+    int64_t length;
+    khint32_t hash;
+} swiss_bytes_key_t;
+
+#define swiss_bytes_key_data(key) (*(key).base + (key).offset)
+#define swiss_bytes_hash_func(key) ((key).hash)
+#define swiss_bytes_hash_equal(a, b)                                    \
+    ((a).hash == (b).hash && (a).length == (b).length &&                \
+     ((a).length == 0 ||                                                \
+      memcmp(swiss_bytes_key_data(a), swiss_bytes_key_data(b),          \
+             (size_t)(a).length) == 0))
+
+KHASH_INIT(swiss_bytes, swiss_bytes_key_t, int64_t, 1, swiss_bytes_hash_func,
+           swiss_bytes_hash_equal)
+
+struct swiss_bytes_t {
+    kh_swiss_bytes_t *h;
+    /* The keys in insertion order, as in swiss_bytes_keys */
+    const uint8_t *data;
+    int64_t *offsets;
+    int64_t data_capacity;
+    int64_t offsets_capacity;
+};
+
+static swiss_bytes_key_t swiss_bytes_make_key(const uint8_t *const *base,
+                                              int64_t offset,
+                                              int64_t length) {
+    swiss_bytes_key_t key;
+    const uint8_t *data = *base + offset;
+    khint32_t hash = 0;
+    int64_t i;
+    for (i = 0; i < length; ++i) {
+        hash = (hash << 5) - hash + data[i];
+    }
+    key.base = base;
+    key.offset = offset;
+    key.length = length;
+    key.hash = hash;
+    return key;
+}
+
+/* Appends a copy of key to the keys of table, returning its offset or -1 */
+static int64_t swiss_bytes_append(swiss_bytes_t *table,
+                                  const swiss_bytes_key_t *key) {
+    int64_t size = kh_size(table->h);
+    int64_t start = size > 0 ? table->offsets[size] : 0;
+    int64_t capacity;
+    void *grown;
+
+    if (size + 2 > table->offsets_capacity) {
+        capacity = table->offsets_capacity > 0 ? 2 * table->offsets_capacity
+                                               : 16;
+        grown = realloc(table->offsets, capacity * sizeof(int64_t));
+        if (grown == NULL) {
+            return -1;
+        }
+        table->offsets = (int64_t *)grown;
+        table->offsets_capacity = capacity;
+    }
+    if (start + key->length > table->data_capacity) {
+        capacity = table->data_capacity > 0 ? 2 * table->data_capacity : 64;
+        while (capacity < start + key->length) {
+            capacity *= 2;
+        }
+        grown = realloc((void *)table->data, capacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        table->data = (const uint8_t *)grown;
+        table->data_capacity = capacity;
+    }
+    if (key->length > 0) {
+        memcpy((uint8_t *)table->data + start, swiss_bytes_key_data(*key),
+               (size_t)key->length);
+    }
+    table->offsets[size] = start;
+    table->offsets[size + 1] = start + key->length;
+    return start;
+}
+
+/*
+  Sets *k to the bucket of key, inserting a copy of it if it is not present,
+  and *inserted to whether it was
+ */
+static int swiss_bytes_insert(swiss_bytes_t *table,
+                              const swiss_bytes_key_t *key, khiter_t *k,
+                              int *inserted) {
+    swiss_bytes_key_t copy = *key;
+    int ret = 0;
+    *k = kh_get_swiss_bytes(table->h, *key);
+    *inserted = *k == table->h->n_buckets;
+    if (!*inserted) {
+        return 0;
+    }
+    /* Copy the key first, so that the table never holds the caller's */
+    copy.base = &table->data;
+    copy.offset = swiss_bytes_append(table, key);
+    if (copy.offset < 0) {
+        return -1;
+    }
+    *k = kh_put_swiss_bytes(table->h, copy, &ret);
+    return 0;
+}
+
+swiss_bytes_t *swiss_bytes_new(int64_t size_hint) {
+    swiss_bytes_t *table = (swiss_bytes_t *)calloc(1, sizeof(swiss_bytes_t));
+    if (table == NULL) {
+        return NULL;
+    }
+    table->h = kh_init_swiss_bytes();
+    if (table->h == NULL) {
+        free(table);
+        return NULL;
+    }
+    if (size_hint > SWISS_MAX_SIZE_HINT) {
+        size_hint = SWISS_MAX_SIZE_HINT;
+    }
+    if (size_hint > 0) {
+        kh_resize_swiss_bytes(table->h, (khint_t)size_hint);
+    }
+    return table;
+}
+
+void swiss_bytes_free(swiss_bytes_t *table) {
+    if (table != NULL) {
+        kh_destroy_swiss_bytes(table->h);
+        free((void *)table->data);
+        free(table->offsets);
+        free(table);
+    }
+}
+
+int64_t swiss_bytes_size(const swiss_bytes_t *table) {
+    return kh_size(table->h);
+}
+
+int swiss_bytes_get(const swiss_bytes_t *table, const char *key,
+                    int64_t length, int64_t *value) {
+    const uint8_t *data = (const uint8_t *)key;
+    khiter_t k = kh_get_swiss_bytes(table->h,
+                                    swiss_bytes_make_key(&data, 0, length));
+    if (k == table->h->n_buckets) {
+        return 0;
+    }
+    *value = table->h->vals[k];
+    return 1;
+}
+
+int swiss_bytes_set(swiss_bytes_t *table, const char *key, int64_t length,
+                    int64_t value) {
+    const uint8_t *data = (const uint8_t *)key;
+    swiss_bytes_key_t probe = swiss_bytes_make_key(&data, 0, length);
+    khiter_t k;
+    int inserted;
+    if (swiss_bytes_insert(table, &probe, &k, &inserted) != 0) {
+        return -1;
+    }
+    table->h->vals[k] = value;
+    return 0;
+}
+
+int swiss_bytes_get_or_insert(swiss_bytes_t *table, const char *key,
+                              int64_t length, int64_t *next_value,
+                              int64_t *value) {
+    const uint8_t *data = (const uint8_t *)key;
+    swiss_bytes_key_t probe = swiss_bytes_make_key(&data, 0, length);
+    khiter_t k;
+    int inserted;
+    if (swiss_bytes_insert(table, &probe, &k, &inserted) != 0) {
+        return -1;
+    }
+    if (inserted) {
+        table->h->vals[k] = (*next_value)++;
+    }
+    *value = table->h->vals[k];
+    return 0;
+}
+
+void swiss_bytes_lookup(const swiss_bytes_t *table, const int32_t *offsets,
+                        const uint8_t *data, int64_t n, int64_t *values) {
+    int64_t i;
+    khiter_t k;
+    for (i = 0; i < n; ++i) {
+        k = kh_get_swiss_bytes(
+            table->h, swiss_bytes_make_key(&data, offsets[i],
+                                           offsets[i + 1] - offsets[i]));
+        values[i] = k == table->h->n_buckets ? -1 : table->h->vals[k];
+    }
+}
+
+int swiss_bytes_get_labels(swiss_bytes_t *table, const int32_t *offsets,
+                           const uint8_t *data, int64_t n,
+                           int64_t *next_value, int64_t *values,
+                           const uint8_t *skip, int64_t skip_value) {
+    int64_t i;
+    swiss_bytes_key_t probe;
+    khiter_t k;
+    int inserted;
+    for (i = 0; i < n; ++i) {
+        if (skip != NULL && skip[i]) {
+            values[i] = skip_value;
+            continue;
+        }
+        probe = swiss_bytes_make_key(&data, offsets[i],
+                                     offsets[i + 1] - offsets[i]);
+        if (swiss_bytes_insert(table, &probe, &k, &inserted) != 0) {
+            return -1;
+        }
+        if (inserted) {
+            table->h->vals[k] = (*next_value)++;
+        }
+        values[i] = table->h->vals[k];
+    }
+    return 0;
+}
+
+void swiss_bytes_keys(const swiss_bytes_t *table, const int64_t **offsets,
+                      const uint8_t **data) {
+    *offsets = table->offsets;
+    *data = table->data;
+}
@@ -292,13 +292,167 @@ class TestFactorize(tm.TestCase):
         test_cases = [
             (hashtable.PyObjectHashTable, hashtable.ObjectVector, 'object'),
             (hashtable.Float64HashTable, hashtable.Float64Vector, 'float64'),
-            (hashtable.Int64HashTable, hashtable.Int64Vector, 'int64')]
+            (hashtable.Float32HashTable, hashtable.Float32Vector, 'float32'),
+            (hashtable.Int64HashTable, hashtable.Int64Vector, 'int64'),
+            (hashtable.Int32HashTable, hashtable.Int32Vector, 'int32'),
+            (hashtable.UInt8HashTable, hashtable.UInt8Vector, 'uint8')]
 
         for (tbl, vect, dtype) in test_cases:
             # resizing to empty is a special case
             _test_vector_resize(tbl(), vect(), dtype, 0)
             _test_vector_resize(tbl(), vect(), dtype, 10)
 
+    def test_unique_after_map_locations(self):
+        # keys stored by map_locations are not new, even where their location
+        # is the next label to hand out
+        for name in ['Float64', 'Float32', 'Int64', 'Int32', 'Int16', 'Int8',
+                     'UInt64', 'UInt32', 'UInt16', 'UInt8']:
+            dtype = name.lower()
+            htable = getattr(hashtable, name + 'HashTable')
+            vect = getattr(hashtable, name + 'Vector')
+
+            table = htable()
+            table.map_locations(np.array([5, 5, 6], dtype=dtype))
+            result = table.unique(np.array([6, 9, 9], dtype=dtype))
+            tm.assert_numpy_array_equal(result, np.array([9], dtype=dtype))
+
+            table = htable()
+            table.map_locations(np.array([5, 5, 6], dtype=dtype))
+            uniques = vect()
+            labels = table.get_labels(np.array([6, 9, 5, 7], dtype=dtype),
+                                      uniques, 2, -1)
+            tm.assert_numpy_array_equal(labels,
+                                        np.array([2, 2, 1, 3], dtype=np.int64))
+            tm.assert_numpy_array_equal(uniques.to_array(),
+                                        np.array([9, 7], dtype=dtype))
+
+    def test_factorize_threads(self):
+        # factorizing on several threads gives the same labels and uniques
+        rs = RandomState(1234)
+        n = (1 << 20) + 1000
+        int_vals = rs.randint(0, 100000, size=n).astype(np.int64)
+        int_vals[::7] = pd.tslib.iNaT
+        float_vals = rs.randint(0, 100000, size=n) / 3.
+        float_vals[::5] = np.nan
+
+        for vals in [int_vals, float_vals]:
+            for sort in [False, True]:
+                expected = algos.factorize(vals, sort=sort)
+                with pd.option_context('compute.factorize_threads', 4):
+                    result = algos.factorize(vals, sort=sort)
+                tm.assert_numpy_array_equal(result[0], expected[0])
+                tm.assert_numpy_array_equal(result[1], expected[1])
+
+        group_index = rs.randint(-1, 1000, size=n).astype(np.int64)
+        expected = pd.core.groupby._compress_group_index(group_index)
+        with pd.option_context('compute.factorize_threads', 4):
+            result = pd.core.groupby._compress_group_index(group_index)
+        tm.assert_numpy_array_equal(result[0], expected[0])
+        tm.assert_numpy_array_equal(result[1], expected[1])
+
+        # the mask must have a value for every key
+        self.assertRaises(ValueError, hashtable.factorize_int64, int_vals,
+                          np.zeros(n - 1, dtype=bool))
+
+    def test_factorize_numeric_dtypes(self):
+        # every numeric dtype is factorized in its own type, small ranges of
+        # integers by direct addressing, with the uniques as before
+        rs = RandomState(1234)
+        wide = rs.randint(0, 100, size=5000) * 1000003
+        narrow = rs.randint(0, 100, size=5000)
+        for dtype in ['int8', 'int16', 'int32', 'int64', 'uint8', 'uint16',
+                      'uint32', 'uint64', 'float32', 'float64']:
+            for ints in [narrow, wide]:
+                vals = ints.astype(dtype)
+                if vals.dtype.itemsize < 4 and ints is wide:
+                    continue
+                if vals.dtype.kind == 'f':
+                    vals[::7] = np.nan
+                    expected = vals.astype(np.float64)
+                else:
+                    expected = vals.astype(np.int64)
+
+                labels, uniques = algos.factorize(vals)
+                exp_labels, exp_uniques = algos.factorize(expected)
+                tm.assert_numpy_array_equal(labels, exp_labels)
+                tm.assert_numpy_array_equal(uniques, exp_uniques)
+
+                tm.assert_numpy_array_equal(algos.duplicated(vals),
+                                            algos.duplicated(expected))
+                tm.assert_numpy_array_equal(
+                    algos.duplicated(vals, keep=False),
+                    algos.duplicated(expected, keep=False))
+
+                result = algos.value_counts(vals, dropna=False)
+                exp = algos.value_counts(expected, dropna=False)
+                tm.assert_series_equal(result.sort_index(), exp.sort_index())
+
+        # a read-only array is converted first
+        vals = narrow.astype(np.int32)
+        vals.flags.writeable = False
+        labels, uniques = algos.factorize(vals)
+        tm.assert_numpy_array_equal(uniques,
+                                    algos.factorize(narrow)[1])
+
+    def test_factorize_strings(self):
+        vals = np.array(['b', u'é', None, 'a', 'b', np.nan, '',
+                         u'é', 'a'], dtype=object)
+
+        labels, uniques = algos.factorize(vals)
+        exp = np.array([0, 1, -1, 2, 0, -1, 3, 1, 2], dtype=np.int_)
+        tm.assert_numpy_array_equal(labels, exp)
+        exp = np.array(['b', u'é', 'a', ''], dtype=object)
+        tm.assert_numpy_array_equal(uniques, exp)
+
+        labels, uniques = algos.factorize(vals, sort=True, na_sentinel=-99)
+        exp = np.array([2, 3, -99, 1, 2, -99, 0, 3, 1], dtype=np.int_)
+        tm.assert_numpy_array_equal(labels, exp)
+        exp = np.array(['', 'a', 'b', u'é'], dtype=object)
+        tm.assert_numpy_array_equal(uniques, exp)
+
+        # values which are not str go through the object hash table
+        vals = np.array(['a', 1, 'a', 1.5, 1], dtype=object)
+        self.assertIsNone(hashtable.factorize_strings(vals))
+        labels, uniques = algos.factorize(vals)
+        exp = np.array([0, 1, 0, 2, 1], dtype=np.int_)
+        tm.assert_numpy_array_equal(labels, exp)
+        exp = np.array(['a', 1, 1.5], dtype=object)
+        tm.assert_numpy_array_equal(uniques, exp)
+
+    def test_string_hashtable_buffers(self):
+        table = hashtable.StringHashTable()
+        table.set_item('b', 5)
+        self.assertEqual(table.get_item('b'), 5)
+        self.assertRaises(KeyError, table.get_item, 'a')
+
+        # 'b', 'a', '', 'a', 'cc'
+        offsets = np.array([0, 1, 2, 2, 3, 5], dtype=np.int32)
+        data = np.frombuffer(b'baacc', dtype=np.uint8).copy()
+        labels = table.get_labels_buffers(offsets, data)
+        exp = np.array([5, 1, 2, 1, 3], dtype=np.int64)
+        tm.assert_numpy_array_equal(labels, exp)
+
+        mask = np.array([False, False, True, False, False])
+        labels = table.get_labels_buffers(offsets, data, mask, -9)
+        exp = np.array([5, 1, -9, 1, 3], dtype=np.int64)
+        tm.assert_numpy_array_equal(labels, exp)
+
+        # buffers that would be read out of bounds
+        self.assertRaises(ValueError, table.get_labels_buffers,
+                          offsets, data, mask[:4])
+        self.assertRaises(ValueError, table.get_labels_buffers,
+                          np.array([-1, 1], dtype=np.int32), data)
+        self.assertRaises(ValueError, table.get_labels_buffers,
+                          np.array([0, 3, 1, 5], dtype=np.int32), data)
+        self.assertRaises(ValueError, table.get_labels_buffers,
+                          np.array([0, 6], dtype=np.int32), data)
+
+        key_offsets, key_data = table.keys_buffers()
+        tm.assert_numpy_array_equal(
+            key_offsets, np.array([0, 1, 2, 2, 4], dtype=np.int32))
+        self.assertEqual(key_data.tobytes(), b'bacc')
+        self.assertEqual(len(table), 4)
+
     def test_complex_sorting(self):
         # gh 12666 - check no segfault
         # Test not valid numpy versions older than 1.11
@@ -442,7 +442,7 @@ class CleanCommand(Command):
 
                 if os.path.splitext(f)[-1] in ('.pyc', '.so', '.o',
                                                '.pyo',
-                                               '.pyd', '.c', '.orig'):
+                                               '.pyd', '.c', '.cpp', '.orig'):
                     self._clean_me.append(filepath)
             for d in dirs:
                 if d == '__pycache__':
@@ -489,6 +489,9 @@ class CheckSDist(sdist_class):
                  'pandas/src/testing.pyx',
                  'pandas/io/sas/saslib.pyx']
 
+    # extensions compiled as C++
+    _cpp_pyxfiles = ['pandas/hashtable.pyx']
+
     def initialize_options(self):
         sdist_class.initialize_options(self)
 
@@ -506,6 +509,8 @@ class CheckSDist(sdist_class):
         else:
             for pyxfile in self._pyxfiles:
                 cfile = pyxfile[:-3] + 'c'
+                if pyxfile in self._cpp_pyxfiles:
+                    cfile += 'pp'
                 msg = "C-source file '%s' not found." % (cfile) +\
                     " Run 'setup.py cython' before sdist."
                 assert os.path.isfile(cfile), msg
@@ -527,8 +532,32 @@ class CheckingBuildExt(build_ext):
                 Please install Cython or download a release package of pandas.
                 """ % src)
 
+    def add_cxx11_flags(self, extensions):
+        compiler = self.compiler.compiler_type
+        for ext in extensions:
+            if ext.name not in cxx11_extensions:
+                continue
+            if compiler == 'msvc':
+                # MSVC 2015 (Python 3.5) is the first to support C++11, and
+                # needs no flags for it. Older versions build the C fallbacks
+                if sys.version_info < (3, 5):
+                    fallbacks = cxx11_extensions[ext.name]
+                    ext.sources = [fallbacks.get(src, src)
+                                   for src in ext.sources]
+                continue
+            compile_args = ['-std=c++11', '-pthread']
+            link_args = ['-pthread']
+            if is_platform_mac():
+                # The default libstdc++ of older OS X has no C++11 library
+                compile_args += ['-stdlib=libc++', '-mmacosx-version-min=10.7']
+                link_args += ['-stdlib=libc++', '-mmacosx-version-min=10.7']
+            # The argument lists may be shared between extensions
+            ext.extra_compile_args = ext.extra_compile_args + compile_args
+            ext.extra_link_args = ext.extra_link_args + link_args
+
     def build_extensions(self):
         self.check_cython_extensions(self.extensions)
+        self.add_cxx11_flags(self.extensions)
         build_ext.build_extensions(self)
 
 
@@ -623,8 +652,21 @@ ext_data = dict(
          'depends': lib_depends},
     hashtable={'pyxfile': 'hashtable',
                'pxdfiles': ['hashtable'],
-               'depends': (['pandas/src/klib/khash_python.h']
-                           + _pxi_dep['hashtable'])},
+               'language': 'c++',
+               'cxx11': {'pandas/src/swisstable.cc':
+                         'pandas/src/swisstable_khash.c'},
+               'include': common_include + ['src'],
+               'depends': (['pandas/src/klib/khash.h',
+                            'pandas/src/klib/khash_python.h',
+                            'pandas/src/swisstable.h',
+                            'src/pandas/util/binary-hash-table.h',
+                            'src/pandas/util/direct-table.h',
+                            'src/pandas/util/factorize.h',
+                            'src/pandas/util/hash-table.h',
+                            'src/pandas/util/hash-util.h',
+                            'src/pandas/util/macros.h']
+                           + _pxi_dep['hashtable']),
+               'sources': ['pandas/src/swisstable.cc']},
     tslib={'pyxfile': 'tslib',
            'depends': tseries_depends,
            'sources': ['pandas/src/datetime/np_datetime.c',
@@ -649,8 +691,10 @@ ext_data = dict(
              'depends': ['pandas/src/skiplist.pyx',
                          'pandas/src/skiplist.h']},
     parser={'pyxfile': 'parser',
+            'libraries': ['z'] if not is_platform_windows() else [],
             'depends': ['pandas/src/parser/tokenizer.h',
                         'pandas/src/parser/io.h',
+                        'pandas/src/parser/powers_of_five.h',
                         'pandas/src/numpy_helper.h'],
             'sources': ['pandas/src/parser/tokenizer.c',
                         'pandas/src/parser/io.c']},
@@ -665,8 +709,18 @@ ext_data["io.sas.saslib"] = {'pyxfile': 'io/sas/saslib'}
 
 extensions = []
 
+# The extensions built from the C++11 sources under src/pandas, which
+# CheckingBuildExt compiles and links with the flags of the compiler in use.
+# Each maps its C++11 sources to the C sources built instead by compilers
+# without C++11
+cxx11_extensions = {}
+
 for name, data in ext_data.items():
-    sources = [srcpath(data['pyxfile'], suffix=suffix, subdir='')]
+    language = data.get('language', 'c')
+    if suffix == '.pyx' or language == 'c':
+        sources = [srcpath(data['pyxfile'], suffix=suffix, subdir='')]
+    else:
+        sources = [srcpath(data['pyxfile'], suffix='.cpp', subdir='')]
     pxds = [pxd(x) for x in data.get('pxdfiles', [])]
     if suffix == '.pyx' and pxds:
         sources.extend(pxds)
@@ -679,8 +733,12 @@ for name, data in ext_data.items():
                     sources=sources,
                     depends=data.get('depends', []),
                     include_dirs=include,
+                    libraries=data.get('libraries', []),
+                    language=language,
                     extra_compile_args=extra_compile_args)
 
+    if 'cxx11' in data:
+        cxx11_extensions[obj.name] = data['cxx11']
     extensions.append(obj)
 
 #----------------------------------------------------------------------
@@ -12,5 +12,6 @@
 #include "pandas/types/boolean.h"
 #include "pandas/types/category.h"
 #include "pandas/types/numeric.h"
+#include "pandas/types/string.h"
 
 #endif  // PANDAS_API_H
@@ -3,18 +3,23 @@
 
 // Test non-type specific array functionality
 
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "pandas/array.h"
 #include "pandas/common.h"
 #include "pandas/memory.h"
+#include "pandas/pytypes.h"
 #include "pandas/test-util.h"
 #include "pandas/type.h"
 #include "pandas/types/numeric.h"
+#include "pandas/types/string.h"
 
 using std::string;
 
@@ -45,6 +50,153 @@ TEST_F(TestArray, Attrs) {
   ASSERT_EQ(values_.size(), array_->length());
 }
 
+TEST_F(TestArray, NullCount) {
+  ASSERT_EQ(0, array_->GetNullCount());
+  ASSERT_FALSE(array_->HasNulls());
+
+  std::vector<double> values = {0, NAN, 2, NAN, NAN};
+  auto buffer = std::make_shared<Buffer>(
+      reinterpret_cast<const uint8_t*>(values.data()), values.size() * sizeof(double));
+  DoubleArray arr(values.size(), buffer);
+  ASSERT_EQ(3, arr.GetNullCount());
+  ASSERT_TRUE(arr.HasNulls());
+}
+
+TEST_F(TestArray, IntegerNullCount) {
+  const int64_t length = 100;
+  auto data = std::make_shared<PoolBuffer>();
+  ASSERT_OK(data->Resize(length * sizeof(int64_t)));
+  memset(data->mutable_data(), 0, data->size());
+
+  // No bitmap means no nulls
+  Int64Array no_bitmap(length, data, nullptr);
+  ASSERT_EQ(0, no_bitmap.GetNullCount());
+
+  auto bitmap = std::make_shared<PoolBuffer>();
+  ASSERT_OK(bitmap->Resize(BitUtil::BytesForBits(length)));
+  memset(bitmap->mutable_data(), 0xFF, bitmap->size());
+  for (int64_t i = 0; i < length; i += 7) {
+    BitUtil::ClearBit(bitmap->mutable_data(), i);
+  }
+  Int64Array arr(length, data, bitmap);
+  ASSERT_EQ(15, arr.GetNullCount());
+
+  // Setting an item invalidates the cached count. Use None as the NA
+  // singleton
+  py::init_natype(reinterpret_cast<PyObject*>(Py_TYPE(Py_None)), Py_None);
+  OwnedRef five(PyLong_FromLong(5));
+  ASSERT_OK(arr.SetItem(0, five.obj()));
+  ASSERT_EQ(14, arr.GetNullCount());
+  ASSERT_OK(arr.SetItem(1, Py_None));
+  ASSERT_EQ(15, arr.GetNullCount());
+
+  // A caller-provided count is trusted
+  Int64Array known(length, data, bitmap, 15);
+  ASSERT_EQ(15, known.GetNullCount());
+}
+
+TEST_F(TestArray, IntegerCopy) {
+  const int64_t length = 100;
+  auto data = std::make_shared<PoolBuffer>();
+  ASSERT_OK(data->Resize(length * sizeof(int32_t)));
+  auto values = reinterpret_cast<int32_t*>(data->mutable_data());
+  auto bitmap = std::make_shared<PoolBuffer>();
+  ASSERT_OK(bitmap->Resize(BitUtil::BytesForBits(length)));
+  memset(bitmap->mutable_data(), 0xFF, bitmap->size());
+  for (int64_t i = 0; i < length; ++i) {
+    values[i] = static_cast<int32_t>(i);
+    if (i % 3 == 0) { BitUtil::ClearBit(bitmap->mutable_data(), i); }
+  }
+  Int32Array arr(length, data, bitmap);
+
+  // Unaligned offsets shift the validity bits
+  for (int64_t offset : {0, 3, 8, 13}) {
+    std::shared_ptr<Array> out;
+    ASSERT_OK(arr.Copy(offset, length - offset - 5, &out));
+    ASSERT_EQ(DataType::INT32, out->type_id());
+
+    auto copied = static_cast<const Int32Array*>(out.get());
+    const uint8_t* copied_bits = copied->valid_bits()->data();
+    for (int64_t i = 0; i < copied->length(); ++i) {
+      ASSERT_EQ(offset + i, copied->data()[i]);
+      ASSERT_EQ((offset + i) % 3 != 0, BitUtil::GetBit(copied_bits, i));
+    }
+  }
+}
+
+static std::shared_ptr<StringArray> MakeStringArray(
+    const std::vector<std::string>& values, const std::vector<bool>& is_null) {
+  auto offsets = std::make_shared<PoolBuffer>();
+  auto data = std::make_shared<PoolBuffer>();
+  auto bitmap = std::make_shared<PoolBuffer>();
+  const int64_t length = values.size();
+  EXPECT_OK(offsets->Resize((length + 1) * sizeof(int32_t)));
+  EXPECT_OK(bitmap->Resize(BitUtil::BytesForBits(length)));
+  memset(bitmap->mutable_data(), 0xFF, bitmap->size());
+
+  std::string bytes;
+  auto offset_values = reinterpret_cast<int32_t*>(offsets->mutable_data());
+  for (int64_t i = 0; i < length; ++i) {
+    offset_values[i] = static_cast<int32_t>(bytes.size());
+    if (is_null[i]) {
+      BitUtil::ClearBit(bitmap->mutable_data(), i);
+    } else {
+      bytes += values[i];
+    }
+  }
+  offset_values[length] = static_cast<int32_t>(bytes.size());
+  EXPECT_OK(data->Resize(bytes.size()));
+  memcpy(data->mutable_data(), bytes.data(), bytes.size());
+  return std::make_shared<StringArray>(length, offsets, data, bitmap);
+}
+
+TEST_F(TestArray, StringValues) {
+  std::vector<std::string> values = {"foo", "", "b\xc3\xa4r", "", "quux"};
+  auto arr = MakeStringArray(values, {false, false, false, true, false});
+  ASSERT_EQ(DataType::STRING, arr->type_id());
+  ASSERT_EQ("string", arr->type()->ToString());
+  ASSERT_EQ(1, arr->GetNullCount());
+  ASSERT_TRUE(arr->IsNull(3));
+  ASSERT_FALSE(arr->IsNull(1));
+
+  for (int64_t i : {0, 1, 2, 4}) {
+    int32_t length;
+    const uint8_t* value = arr->GetValue(i, &length);
+    ASSERT_EQ(values[i], std::string(reinterpret_cast<const char*>(value), length));
+    ASSERT_EQ(length, arr->value_length(i));
+  }
+  ASSERT_FALSE(arr->SetItem(0, Py_None).ok());
+}
+
+TEST_F(TestArray, StringCopy) {
+  std::vector<std::string> values;
+  std::vector<bool> is_null;
+  for (int i = 0; i < 50; ++i) {
+    values.push_back(std::string(i % 7, 'a' + i % 26));
+    is_null.push_back(i % 5 == 0);
+  }
+  auto arr = MakeStringArray(values, is_null);
+
+  // The copied offsets start from 0
+  for (int64_t offset : {0, 3, 8, 13}) {
+    std::shared_ptr<Array> out;
+    ASSERT_OK(arr->Copy(offset, 50 - offset - 5, &out));
+    auto copied = static_cast<const StringArray*>(out.get());
+    ASSERT_EQ(0, copied->offsets()[0]);
+    ASSERT_TRUE(copied->owns_data());
+    for (int64_t i = 0; i < copied->length(); ++i) {
+      ASSERT_EQ(is_null[offset + i], copied->IsNull(i));
+      if (is_null[offset + i]) { continue; }
+      int32_t length;
+      const uint8_t* value = copied->GetValue(i, &length);
+      ASSERT_EQ(values[offset + i],
+          std::string(reinterpret_cast<const char*>(value), length));
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// Array view object
 // ----------------------------------------------------------------------
 // Array view object
 
@@ -125,6 +277,25 @@ TEST_F(TestArrayView, EnsureMutable) {
   ASSERT_EQ(1, view2.ref_count());
 }
 
+TEST_F(TestArrayView, EnsureMutableForeignMemory) {
+  auto buffer = std::make_shared<ForeignBuffer>(
+      reinterpret_cast<const uint8_t*>(values_.data()), values_.size() * sizeof(value_t));
+  ArrayView view(std::make_shared<DoubleArray>(values_.size(), buffer));
+  const Array* ap = view.data().get();
+  ASSERT_FALSE(ap->owns_data());
+
+  // Sole reference, but the memory belongs to someone else
+  ASSERT_OK(view.EnsureMutable());
+  ASSERT_NE(ap, view.data().get());
+  ASSERT_TRUE(view.data()->owns_data());
+
+  auto copied = static_cast<const DoubleArray*>(view.data().get());
+  ASSERT_NE(values_.data(), copied->data());
+  for (size_t i = 0; i < values_.size(); ++i) {
+    ASSERT_EQ(values_[i], copied->data()[i]);
+  }
+}
+
 TEST_F(TestArrayView, Slice) {
   ArrayView s1 = view_.Slice(3);
   ASSERT_EQ(2, s1.ref_count());
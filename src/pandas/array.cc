@@ -11,8 +11,19 @@ namespace pandas {
 // ----------------------------------------------------------------------
 // Array
 
-Array::Array(const std::shared_ptr<DataType>& type, int64_t length)
-    : type_(type), length_(length) {}
+Array::Array(const std::shared_ptr<DataType>& type, int64_t length, int64_t null_count)
+    : type_(type), length_(length), null_count_(null_count) {}
+
+constexpr int64_t Array::kUnknownNullCount;
+
+int64_t Array::GetNullCount() const {
+  int64_t null_count = null_count_.load(std::memory_order_relaxed);
+  if (null_count == kUnknownNullCount) {
+    null_count = ComputeNullCount();
+    null_count_.store(null_count, std::memory_order_relaxed);
+  }
+  return null_count;
+}
 
 Status Array::Copy(std::shared_ptr<Array>* out) const {
   return Copy(0, length_, out);
@@ -65,7 +76,7 @@ ArrayView& ArrayView::operator=(ArrayView&& other) {
 }
 
 Status ArrayView::EnsureMutable() {
-  if (ref_count() > 1) {
+  if (ref_count() > 1 || !data_->owns_data()) {
     std::shared_ptr<Array> copied_data;
     RETURN_NOT_OK(data_->Copy(&copied_data));
     data_ = copied_data;
@@ -5,6 +5,7 @@
 
 #include "pandas/config.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,7 +32,13 @@ class Array {
   // Copy the entire array (using the virtual Copy function)
   Status Copy(std::shared_ptr<Array>* out) const;
 
-  virtual int64_t GetNullCount() = 0;
+  // The number of null values is computed on first use and cached until the
+  // array is mutated
+  int64_t GetNullCount() const;
+
+  // O(1) once the null count is cached; fast paths use this to skip bitmap
+  // and NaN checks altogether
+  bool HasNulls() const { return GetNullCount() > 0; }
 
   virtual PyObject* GetItem(int64_t i) = 0;
   virtual Status SetItem(int64_t i, PyObject* val) = 0;
@@ -45,7 +52,20 @@ class Array {
   std::shared_ptr<DataType> type_;
   int64_t length_;
 
-  Array(const std::shared_ptr<DataType>& type, int64_t length);
+  // Negative while the null count is not known
+  static constexpr int64_t kUnknownNullCount = -1;
+  mutable std::atomic<int64_t> null_count_;
+
+  Array(const std::shared_ptr<DataType>& type, int64_t length,
+      int64_t null_count = kUnknownNullCount);
+
+  // Count the nulls in the array, without consulting the cache
+  virtual int64_t ComputeNullCount() const = 0;
+
+  // Must be called by any operation that may change which values are null
+  void InvalidateNullCount() {
+    null_count_.store(kUnknownNullCount, std::memory_order_relaxed);
+  }
 
  private:
   DISALLOW_COPY_AND_ASSIGN(Array);
@@ -69,8 +89,9 @@ class ArrayView {
   ArrayView& operator=(const ArrayView& other);
   ArrayView& operator=(ArrayView&& other);
 
-  // If the contained array is not the sole reference to that array, then
-  // mutation operations must produce a copy of the referenced
+  // If the contained array is not the sole reference to that array, or it
+  // does not own its memory (e.g. it wraps a NumPy array), then mutation
+  // operations must produce a copy of the referenced
   Status EnsureMutable();
 
   // Construct view from start offset to the end of the array
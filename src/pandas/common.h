@@ -26,6 +26,13 @@ using ResizableBuffer = arrow::ResizableBuffer;
 using PoolBuffer = arrow::PoolBuffer;
 using Status = arrow::Status;
 
+// A buffer over memory owned by another object, such as a NumPy array. Arrays
+// never write to it in place; it is copied the first time it is mutated
+class PANDAS_EXPORT ForeignBuffer : public Buffer {
+ public:
+  ForeignBuffer(const uint8_t* data, int64_t size) : Buffer(data, size) {}
+};
+
 class OwnedRef {
  public:
   OwnedRef() : obj_(nullptr) {}
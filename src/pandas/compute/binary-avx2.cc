@@ -0,0 +1,25 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// AVX2 variants of the binary kernels. This translation unit is compiled
+// with -mavx2 and must only be entered after checking GetSimdLevel()
+
+#include <cstdint>
+
+#include "pandas/compute/binary-internal.h"
+
+namespace pandas {
+
+namespace internal {
+
+template <typename T>
+const BinaryKernels<T>* GetAvx2BinaryKernels() {
+  static const BinaryKernels<T> kernels = MakeBinaryKernels<T>();
+  return &kernels;
+}
+
+PANDAS_INSTANTIATE_BINARY_KERNELS(GetAvx2BinaryKernels);
+
+}  // namespace internal
+
+}  // namespace pandas
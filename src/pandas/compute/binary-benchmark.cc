@@ -0,0 +1,107 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/binary.h"
+#include "pandas/types/numeric.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+constexpr int64_t kLength = 1 << 20;
+
+// A 1M-value array; with_nulls gives integer arrays a validity bitmap with
+// about 10% of values null
+template <typename ArrayType>
+static std::shared_ptr<Array> MakeArray(bool with_nulls, uint32_t seed) {
+  using T = typename ArrayType::T;
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> values(1, 1000);
+  std::bernoulli_distribution is_null(0.1);
+
+  auto data = std::make_shared<PoolBuffer>();
+  data->Resize(kLength * sizeof(T));
+  T* out = reinterpret_cast<T*>(data->mutable_data());
+  auto bitmap = std::make_shared<PoolBuffer>();
+  bitmap->Resize(BitUtil::BytesForBits(kLength));
+  memset(bitmap->mutable_data(), 0xFF, bitmap->size());
+  for (int64_t i = 0; i < kLength; ++i) {
+    out[i] = static_cast<T>(values(rng));
+    if (with_nulls && is_null(rng)) { BitUtil::ClearBit(bitmap->mutable_data(), i); }
+  }
+  return std::make_shared<ArrayType>(kLength, data, with_nulls ? bitmap : nullptr);
+}
+
+template <>
+std::shared_ptr<Array> MakeArray<DoubleArray>(bool with_nulls, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> values(1, 1000);
+  auto data = std::make_shared<PoolBuffer>();
+  data->Resize(kLength * sizeof(double));
+  double* out = reinterpret_cast<double*>(data->mutable_data());
+  for (int64_t i = 0; i < kLength; ++i) {
+    out[i] = values(rng);
+  }
+  return std::make_shared<DoubleArray>(kLength, data);
+}
+
+// Arguments: SIMD level, whether the inputs have nulls. Outputs are
+// preallocated so that only the kernels are measured
+template <typename LeftType, typename RightType, typename OutType>
+static void BM_Add(benchmark::State& state) {  // NOLINT non-const reference
+  SetSimdLevel(static_cast<SimdLevel>(state.range_x()));
+  ArrayView left(MakeArray<LeftType>(state.range_y() != 0, 1));
+  ArrayView right(MakeArray<RightType>(state.range_y() != 0, 2));
+  PoolBuffer values;
+  PoolBuffer valid_bits;
+  values.Resize(kLength * sizeof(OutType));
+  valid_bits.Resize(BitUtil::BytesForBits(kLength));
+  while (state.KeepRunning()) {
+    Arithmetic(ArithmeticOp::ADD, left, right, &values, &valid_bits);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+  SetSimdLevel(DetectSimdLevel());
+}
+
+template <typename LeftType, typename RightType>
+static void BM_Less(benchmark::State& state) {  // NOLINT non-const reference
+  SetSimdLevel(static_cast<SimdLevel>(state.range_x()));
+  ArrayView left(MakeArray<LeftType>(state.range_y() != 0, 1));
+  ArrayView right(MakeArray<RightType>(state.range_y() != 0, 2));
+  PoolBuffer values;
+  PoolBuffer valid_bits;
+  values.Resize(BitUtil::BytesForBits(kLength));
+  valid_bits.Resize(BitUtil::BytesForBits(kLength));
+  while (state.KeepRunning()) {
+    Compare(CompareOp::LESS, left, right, &values, &valid_bits);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+  SetSimdLevel(DetectSimdLevel());
+}
+
+static void BinaryArgs(benchmark::internal::Benchmark* bench) {
+  for (int level : {1, 2}) {
+    for (int with_nulls : {0, 1}) {
+      bench->ArgPair(level, with_nulls);
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Add, Int64Array, Int64Array, int64_t)->Apply(BinaryArgs);
+BENCHMARK_TEMPLATE(BM_Add, Int32Array, Int64Array, int64_t)->Apply(BinaryArgs);
+BENCHMARK_TEMPLATE(BM_Add, DoubleArray, DoubleArray, double)->Apply(BinaryArgs);
+BENCHMARK_TEMPLATE(BM_Add, Int32Array, DoubleArray, double)->Apply(BinaryArgs);
+BENCHMARK_TEMPLATE(BM_Less, Int64Array, Int64Array)->Apply(BinaryArgs);
+BENCHMARK_TEMPLATE(BM_Less, DoubleArray, DoubleArray)->Apply(BinaryArgs);
+
+}  // namespace pandas
@@ -0,0 +1,206 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Element-wise kernels shared by binary.cc and binary-avx2.cc. Like the
+// reduction kernels, they are compiled once per instruction set and so live in
+// an anonymous namespace. Both inputs have already been converted to the
+// common type T; the loops have no branches so that the compiler vectorizes
+// them.
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "pandas/compute/binary.h"
+
+namespace pandas {
+
+namespace internal {
+
+constexpr int kNumArithmeticOps = static_cast<int>(ArithmeticOp::DIVIDE) + 1;
+constexpr int kNumCompareOps = static_cast<int>(CompareOp::GREATER_EQUAL) + 1;
+
+template <typename T>
+struct BinaryKernels {
+  // out[i] = left[i] OP right[i], indexed by ArithmeticOp. Division is only
+  // defined for floating point T (the kernel is null otherwise)
+  void (*arithmetic[kNumArithmeticOps])(
+      const T* left, const T* right, int64_t length, T* out);
+
+  // out[i] = 1 if the comparison holds and 0 otherwise, indexed by CompareOp
+  void (*compare[kNumCompareOps])(
+      const T* left, const T* right, int64_t length, uint8_t* out);
+
+  // out[i] = 1 if neither left[i] nor right[i] is NaN
+  void (*not_nan)(const T* left, const T* right, int64_t length, uint8_t* out);
+};
+
+template <typename T>
+const BinaryKernels<T>* GetSse42BinaryKernels();
+
+template <typename T>
+const BinaryKernels<T>* GetAvx2BinaryKernels();
+
+namespace {
+
+// Integer arithmetic is done in an unsigned type at least as wide as int, so
+// that overflow wraps instead of being undefined (small types would otherwise
+// be promoted to int)
+template <typename T, typename Enable = void>
+struct WrapType {
+  using type = T;
+};
+
+template <typename T>
+struct WrapType<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+  using type = typename std::conditional<sizeof(T) < sizeof(unsigned int), unsigned int,
+      typename std::make_unsigned<T>::type>::type;
+};
+
+struct AddOp {
+  template <typename T>
+  static T Call(T left, T right) {
+    using W = typename WrapType<T>::type;
+    return static_cast<T>(static_cast<W>(left) + static_cast<W>(right));
+  }
+};
+
+struct SubtractOp {
+  template <typename T>
+  static T Call(T left, T right) {
+    using W = typename WrapType<T>::type;
+    return static_cast<T>(static_cast<W>(left) - static_cast<W>(right));
+  }
+};
+
+struct MultiplyOp {
+  template <typename T>
+  static T Call(T left, T right) {
+    using W = typename WrapType<T>::type;
+    return static_cast<T>(static_cast<W>(left) * static_cast<W>(right));
+  }
+};
+
+struct DivideOp {
+  template <typename T>
+  static T Call(T left, T right) {
+    return left / right;
+  }
+};
+
+struct EqualOp {
+  template <typename T>
+  static bool Call(T left, T right) {
+    return left == right;
+  }
+};
+
+struct NotEqualOp {
+  template <typename T>
+  static bool Call(T left, T right) {
+    return left != right;
+  }
+};
+
+struct LessOp {
+  template <typename T>
+  static bool Call(T left, T right) {
+    return left < right;
+  }
+};
+
+struct LessEqualOp {
+  template <typename T>
+  static bool Call(T left, T right) {
+    return left <= right;
+  }
+};
+
+struct GreaterOp {
+  template <typename T>
+  static bool Call(T left, T right) {
+    return left > right;
+  }
+};
+
+struct GreaterEqualOp {
+  template <typename T>
+  static bool Call(T left, T right) {
+    return left >= right;
+  }
+};
+
+template <typename T, typename OP>
+void ArithmeticKernel(const T* left, const T* right, int64_t length, T* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = OP::template Call<T>(left[i], right[i]);
+  }
+}
+
+template <typename T, typename OP>
+void CompareKernel(const T* left, const T* right, int64_t length, uint8_t* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = OP::template Call<T>(left[i], right[i]);
+  }
+}
+
+template <typename T>
+void NotNaNKernel(const T* left, const T* right, int64_t length, uint8_t* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = (left[i] == left[i]) & (right[i] == right[i]);
+  }
+}
+
+template <typename T>
+auto GetDivideKernel(std::true_type) -> decltype(&ArithmeticKernel<T, DivideOp>) {
+  return &ArithmeticKernel<T, DivideOp>;
+}
+
+template <typename T>
+auto GetDivideKernel(std::false_type) -> decltype(&ArithmeticKernel<T, DivideOp>) {
+  return nullptr;
+}
+
+template <typename T>
+BinaryKernels<T> MakeBinaryKernels() {
+  BinaryKernels<T> kernels;
+  kernels.arithmetic[static_cast<int>(ArithmeticOp::ADD)] = &ArithmeticKernel<T, AddOp>;
+  kernels.arithmetic[static_cast<int>(ArithmeticOp::SUBTRACT)] =
+      &ArithmeticKernel<T, SubtractOp>;
+  kernels.arithmetic[static_cast<int>(ArithmeticOp::MULTIPLY)] =
+      &ArithmeticKernel<T, MultiplyOp>;
+  kernels.arithmetic[static_cast<int>(ArithmeticOp::DIVIDE)] =
+      GetDivideKernel<T>(std::is_floating_point<T>());
+
+  kernels.compare[static_cast<int>(CompareOp::EQUAL)] = &CompareKernel<T, EqualOp>;
+  kernels.compare[static_cast<int>(CompareOp::NOT_EQUAL)] = &CompareKernel<T, NotEqualOp>;
+  kernels.compare[static_cast<int>(CompareOp::LESS)] = &CompareKernel<T, LessOp>;
+  kernels.compare[static_cast<int>(CompareOp::LESS_EQUAL)] =
+      &CompareKernel<T, LessEqualOp>;
+  kernels.compare[static_cast<int>(CompareOp::GREATER)] = &CompareKernel<T, GreaterOp>;
+  kernels.compare[static_cast<int>(CompareOp::GREATER_EQUAL)] =
+      &CompareKernel<T, GreaterEqualOp>;
+
+  kernels.not_nan = &NotNaNKernel<T>;
+  return kernels;
+}
+
+}  // namespace
+
+// Explicitly instantiate a kernel table getter for every numeric c_type
+#define PANDAS_INSTANTIATE_BINARY_KERNELS(GETTER)             \
+  template const BinaryKernels<int8_t>* GETTER<int8_t>();     \
+  template const BinaryKernels<uint8_t>* GETTER<uint8_t>();   \
+  template const BinaryKernels<int16_t>* GETTER<int16_t>();   \
+  template const BinaryKernels<uint16_t>* GETTER<uint16_t>(); \
+  template const BinaryKernels<int32_t>* GETTER<int32_t>();   \
+  template const BinaryKernels<uint32_t>* GETTER<uint32_t>(); \
+  template const BinaryKernels<int64_t>* GETTER<int64_t>();   \
+  template const BinaryKernels<uint64_t>* GETTER<uint64_t>(); \
+  template const BinaryKernels<float>* GETTER<float>();       \
+  template const BinaryKernels<double>* GETTER<double>()
+
+}  // namespace internal
+
+}  // namespace pandas
@@ -0,0 +1,263 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/binary.h"
+#include "pandas/test-util.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+static DataType::TypeId ResultTypeId(
+    ArithmeticOp op, const DataType& left, const DataType& right) {
+  std::shared_ptr<DataType> type;
+  EXPECT_OK(ArithmeticResultType(op, left, right, &type));
+  return type->type();
+}
+
+TEST(BinaryTypeTests, Promotion) {
+  const ArithmeticOp add = ArithmeticOp::ADD;
+  ASSERT_EQ(DataType::INT32, ResultTypeId(add, *Int32Type::SINGLETON, *Int8Type::SINGLETON));
+  ASSERT_EQ(
+      DataType::UINT16, ResultTypeId(add, *UInt8Type::SINGLETON, *UInt16Type::SINGLETON));
+  ASSERT_EQ(DataType::INT16, ResultTypeId(add, *Int16Type::SINGLETON, *UInt8Type::SINGLETON));
+  ASSERT_EQ(DataType::INT64, ResultTypeId(add, *UInt32Type::SINGLETON, *Int8Type::SINGLETON));
+  ASSERT_EQ(
+      DataType::FLOAT64, ResultTypeId(add, *Int64Type::SINGLETON, *UInt64Type::SINGLETON));
+  ASSERT_EQ(
+      DataType::FLOAT32, ResultTypeId(add, *Int16Type::SINGLETON, *FloatType::SINGLETON));
+  ASSERT_EQ(
+      DataType::FLOAT64, ResultTypeId(add, *FloatType::SINGLETON, *Int32Type::SINGLETON));
+  ASSERT_EQ(
+      DataType::FLOAT64, ResultTypeId(add, *FloatType::SINGLETON, *DoubleType::SINGLETON));
+
+  // True division
+  ASSERT_EQ(DataType::FLOAT64,
+      ResultTypeId(ArithmeticOp::DIVIDE, *Int8Type::SINGLETON, *Int8Type::SINGLETON));
+  ASSERT_EQ(DataType::FLOAT32,
+      ResultTypeId(ArithmeticOp::DIVIDE, *FloatType::SINGLETON, *FloatType::SINGLETON));
+}
+
+// Runs every test at each SIMD level supported by the host
+class TestBinary : public ::testing::TestWithParam<SimdLevel> {
+ public:
+  void SetUp() {
+    if (static_cast<int>(GetParam()) > static_cast<int>(DetectSimdLevel())) {
+      skip_ = true;
+    }
+    SetSimdLevel(GetParam());
+  }
+
+  void TearDown() { SetSimdLevel(DetectSimdLevel()); }
+
+ protected:
+  bool skip_ = false;
+};
+
+TEST_P(TestBinary, IntegerNullPropagation) {
+  if (skip_) { return; }
+  // More than one block, with nulls in both inputs
+  const int64_t length = 3000;
+  std::vector<int64_t> left_values;
+  std::vector<int32_t> right_values;
+  std::vector<bool> left_valid;
+  std::vector<bool> right_valid;
+  for (int64_t i = 0; i < length; ++i) {
+    left_values.push_back(i * 3 - 1000);
+    right_values.push_back(static_cast<int32_t>(7 - i));
+    left_valid.push_back(i % 5 != 0);
+    right_valid.push_back(i % 7 != 0);
+  }
+  auto left = std::make_shared<Int64Array>(
+      length, BufferFromVector(left_values), BitmapFromVector(left_valid));
+  auto right = std::make_shared<Int32Array>(
+      length, BufferFromVector(right_values), BitmapFromVector(right_valid));
+
+  // Unaligned offsets into both bitmaps
+  const int64_t left_offset = 3;
+  const int64_t right_offset = 13;
+  const int64_t n = 2900;
+  ArrayView left_view(left, left_offset, n);
+  ArrayView right_view(right, right_offset, n);
+
+  std::shared_ptr<Array> result;
+  ASSERT_OK(Subtract(left_view, right_view, &result));
+  ASSERT_EQ(DataType::INT64, result->type_id());
+  auto arr = std::static_pointer_cast<Int64Array>(result);
+
+  int64_t ex_null_count = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    bool valid = left_valid[left_offset + i] && right_valid[right_offset + i];
+    ex_null_count += !valid;
+    ASSERT_EQ(valid, BitUtil::GetBit(arr->valid_bits()->data(), i)) << i;
+    if (valid) {
+      ASSERT_EQ(left_values[left_offset + i] - right_values[right_offset + i],
+          arr->data()[i]);
+    }
+  }
+  ASSERT_EQ(ex_null_count, arr->GetNullCount());
+
+  // Without nulls the result has no bitmap
+  auto dense = std::make_shared<Int64Array>(length, BufferFromVector(left_values));
+  ASSERT_OK(Add(ArrayView(dense), ArrayView(dense), &result));
+  auto dense_result = std::static_pointer_cast<Int64Array>(result);
+  ASSERT_FALSE(dense_result->valid_bits());
+  ASSERT_EQ(2 * left_values[100], dense_result->data()[100]);
+}
+
+TEST_P(TestBinary, FloatingResults) {
+  if (skip_) { return; }
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<int32_t> int_values = {1, 2, 3, 4, 5, 6, 0, 8};
+  std::vector<bool> is_valid = {true, false, true, true, true, true, true, false};
+  std::vector<double> double_values = {0.5, 1, nan, 2, 4, 8, 0, 1};
+  auto ints = std::make_shared<Int32Array>(
+      int_values.size(), BufferFromVector(int_values), BitmapFromVector(is_valid));
+  auto doubles =
+      std::make_shared<DoubleArray>(double_values.size(), BufferFromVector(double_values));
+
+  // Nulls of the integer input become NaN
+  std::shared_ptr<Array> result;
+  ASSERT_OK(Multiply(ArrayView(ints), ArrayView(doubles), &result));
+  ASSERT_EQ(DataType::FLOAT64, result->type_id());
+  const double* out = std::static_pointer_cast<DoubleArray>(result)->data();
+  ASSERT_EQ(0.5, out[0]);
+  ASSERT_TRUE(std::isnan(out[1]));
+  ASSERT_TRUE(std::isnan(out[2]));
+  ASSERT_EQ(20, out[4]);
+  ASSERT_TRUE(std::isnan(out[7]));
+  ASSERT_EQ(3, result->GetNullCount());
+
+  ASSERT_RAISES(Invalid, Divide(ArrayView(ints), ArrayView(ints, 1, 7), &result));
+
+  // Integer division is true division
+  ASSERT_OK(Divide(ArrayView(ints, 2, 4), ArrayView(ints, 3, 4), &result));
+  ASSERT_EQ(DataType::FLOAT64, result->type_id());
+  out = std::static_pointer_cast<DoubleArray>(result)->data();
+  ASSERT_DOUBLE_EQ(0.75, out[0]);
+  ASSERT_DOUBLE_EQ(0.8, out[1]);
+
+  // Division by zero follows IEEE 754
+  ASSERT_OK(Divide(ArrayView(ints, 5, 2), ArrayView(ints, 6, 2), &result));
+  out = std::static_pointer_cast<DoubleArray>(result)->data();
+  ASSERT_TRUE(std::isinf(out[0]));
+}
+
+TEST_P(TestBinary, IntegerOverflowWraps) {
+  if (skip_) { return; }
+  std::vector<int8_t> values = {127, -128, 100, 16};
+  std::vector<uint16_t> wide = {65535, 65535};
+  auto arr = std::make_shared<Int8Array>(values.size(), BufferFromVector(values));
+  auto wide_arr = std::make_shared<UInt16Array>(wide.size(), BufferFromVector(wide));
+
+  std::shared_ptr<Array> result;
+  ASSERT_OK(Add(ArrayView(arr), ArrayView(arr), &result));
+  const int8_t* out = std::static_pointer_cast<Int8Array>(result)->data();
+  ASSERT_EQ(-2, out[0]);
+  ASSERT_EQ(0, out[1]);
+  ASSERT_EQ(-56, out[2]);
+
+  ASSERT_OK(Multiply(ArrayView(wide_arr), ArrayView(wide_arr), &result));
+  ASSERT_EQ(1, std::static_pointer_cast<UInt16Array>(result)->data()[0]);
+}
+
+TEST_P(TestBinary, Comparisons) {
+  if (skip_) { return; }
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const int64_t length = 1500;
+  std::vector<uint8_t> left_values;
+  std::vector<float> right_values;
+  std::vector<bool> left_valid;
+  for (int64_t i = 0; i < length; ++i) {
+    left_values.push_back(static_cast<uint8_t>(i % 11));
+    right_values.push_back(i % 13 == 0 ? nan : static_cast<float>(i % 7));
+    left_valid.push_back(i % 17 != 0);
+  }
+  auto left = std::make_shared<UInt8Array>(
+      length, BufferFromVector(left_values), BitmapFromVector(left_valid));
+  auto right = std::make_shared<FloatArray>(length, BufferFromVector(right_values));
+
+  const int64_t offset = 5;
+  const int64_t n = length - offset;
+  for (int op = 0; op <= static_cast<int>(CompareOp::GREATER_EQUAL); ++op) {
+    std::shared_ptr<Buffer> values;
+    std::shared_ptr<Buffer> valid_bits;
+    ASSERT_OK(Compare(static_cast<CompareOp>(op), ArrayView(left, offset),
+        ArrayView(right, 0, n), &values, &valid_bits));
+    for (int64_t i = 0; i < n; ++i) {
+      float l = left_values[offset + i];
+      float r = right_values[i];
+      bool valid = left_valid[offset + i] && !std::isnan(r);
+      bool expected;
+      switch (static_cast<CompareOp>(op)) {
+        case CompareOp::EQUAL:
+          expected = l == r;
+          break;
+        case CompareOp::NOT_EQUAL:
+          expected = l != r;
+          break;
+        case CompareOp::LESS:
+          expected = l < r;
+          break;
+        case CompareOp::LESS_EQUAL:
+          expected = l <= r;
+          break;
+        case CompareOp::GREATER:
+          expected = l > r;
+          break;
+        default:
+          expected = l >= r;
+          break;
+      }
+      ASSERT_EQ(valid, BitUtil::GetBit(valid_bits->data(), i)) << op << " " << i;
+      ASSERT_EQ(valid && expected, BitUtil::GetBit(values->data(), i)) << op << " " << i;
+    }
+  }
+}
+
+TEST_P(TestBinary, PreallocatedOutputs) {
+  if (skip_) { return; }
+  std::vector<int16_t> values = {1, 2, 3, 4, 5};
+  std::vector<bool> is_valid = {true, true, false, true, true};
+  auto arr = std::make_shared<Int16Array>(
+      values.size(), BufferFromVector(values), BitmapFromVector(is_valid));
+  ArrayView view(arr);
+
+  PoolBuffer out_values;
+  PoolBuffer out_valid;
+  ASSERT_OK(out_values.Resize(values.size() * sizeof(int16_t)));
+  ASSERT_OK(out_valid.Resize(1));
+  ASSERT_OK(Arithmetic(ArithmeticOp::ADD, view, view, &out_values, &out_valid));
+  const int16_t* out = reinterpret_cast<const int16_t*>(out_values.data());
+  ASSERT_EQ(10, out[4]);
+  ASSERT_FALSE(BitUtil::GetBit(out_valid.data(), 2));
+  ASSERT_TRUE(BitUtil::GetBit(out_valid.data(), 3));
+
+  // Integer results with nulls need a bitmap
+  ASSERT_RAISES(Invalid, Arithmetic(ArithmeticOp::ADD, view, view, &out_values, nullptr));
+
+  // int16 + int32 needs room for int32 values
+  std::vector<int32_t> wide(5, 1);
+  auto wide_arr = std::make_shared<Int32Array>(wide.size(), BufferFromVector(wide));
+  ASSERT_RAISES(Invalid, Arithmetic(ArithmeticOp::ADD, view, ArrayView(wide_arr),
+                             &out_values, &out_valid));
+
+  ASSERT_RAISES(Invalid, Compare(CompareOp::LESS, view, view.Slice(1), &out_values,
+                             &out_valid));
+}
+
+INSTANTIATE_TEST_CASE_P(SimdLevels, TestBinary,
+    ::testing::Values(SimdLevel::NONE, SimdLevel::SSE4_2, SimdLevel::AVX2));
+
+}  // namespace pandas
@@ -0,0 +1,432 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "pandas/compute/binary.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "pandas/common.h"
+#include "pandas/compute/binary-internal.h"
+#include "pandas/compute/visit-internal.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+#include "pandas/util/bit-util.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+namespace internal {
+
+// The library baseline is SSE4.2 (-msse4.2), so the shared kernels compiled
+// in this translation unit are the SSE4.2 variants
+template <typename T>
+const BinaryKernels<T>* GetSse42BinaryKernels() {
+  static const BinaryKernels<T> kernels = MakeBinaryKernels<T>();
+  return &kernels;
+}
+
+PANDAS_INSTANTIATE_BINARY_KERNELS(GetSse42BinaryKernels);
+
+}  // namespace internal
+
+namespace {
+
+// ----------------------------------------------------------------------
+// Type promotion
+
+template <typename T>
+struct DataTypeForCType;
+
+#define DATA_TYPE_FOR_C_TYPE(C_TYPE, TYPE) \
+  template <>                              \
+  struct DataTypeForCType<C_TYPE> {        \
+    using type = TYPE;                     \
+  }
+
+DATA_TYPE_FOR_C_TYPE(int8_t, Int8Type);
+DATA_TYPE_FOR_C_TYPE(uint8_t, UInt8Type);
+DATA_TYPE_FOR_C_TYPE(int16_t, Int16Type);
+DATA_TYPE_FOR_C_TYPE(uint16_t, UInt16Type);
+DATA_TYPE_FOR_C_TYPE(int32_t, Int32Type);
+DATA_TYPE_FOR_C_TYPE(uint32_t, UInt32Type);
+DATA_TYPE_FOR_C_TYPE(int64_t, Int64Type);
+DATA_TYPE_FOR_C_TYPE(uint64_t, UInt64Type);
+DATA_TYPE_FOR_C_TYPE(float, FloatType);
+DATA_TYPE_FOR_C_TYPE(double, DoubleType);
+
+#undef DATA_TYPE_FOR_C_TYPE
+
+template <typename L, typename R>
+using Larger = typename std::conditional<sizeof(L) >= sizeof(R), L, R>::type;
+
+template <int SIZE>
+using SignedInteger = typename std::conditional<SIZE == 2, int16_t,
+    typename std::conditional<SIZE == 4, int32_t, int64_t>::type>::type;
+
+// The type that values of types L and R are converted to before an operation,
+// following the NumPy rules described in binary.h
+template <typename L, typename R, typename Enable = void>
+struct CommonCType {
+  using Integer = typename std::conditional<std::is_floating_point<L>::value, R, L>::type;
+  using Floating = typename std::conditional<std::is_floating_point<L>::value, L, R>::type;
+
+  using type = typename std::conditional<std::is_floating_point<Integer>::value,
+      Larger<L, R>, typename std::conditional<std::is_same<Floating, float>::value &&
+                                                  sizeof(Integer) <= 2,
+                        float, double>::type>::type;
+};
+
+template <typename L, typename R>
+struct CommonCType<L, R, typename std::enable_if<std::is_integral<L>::value &&
+                                                 std::is_integral<R>::value>::type> {
+  using Signed = typename std::conditional<std::is_signed<L>::value, L, R>::type;
+  using Unsigned = typename std::conditional<std::is_signed<L>::value, R, L>::type;
+
+  using MixedType = typename std::conditional<(sizeof(Signed) > sizeof(Unsigned)), Signed,
+      typename std::conditional<(sizeof(Unsigned) < 8),
+          SignedInteger<2 * sizeof(Unsigned)>, double>::type>::type;
+
+  using type = typename std::conditional<std::is_signed<L>::value == std::is_signed<R>::value,
+      Larger<L, R>, MixedType>::type;
+};
+
+template <typename L, typename R>
+struct DivideCType {
+  using Common = typename CommonCType<L, R>::type;
+  using type =
+      typename std::conditional<std::is_floating_point<Common>::value, Common, double>::type;
+};
+
+// ----------------------------------------------------------------------
+// Kernel dispatch and helpers
+
+// Inputs are converted to the common type a block at a time, so that the
+// converted values are still in cache when the kernel reads them
+constexpr int64_t kBlockSize = 1024;
+
+template <typename T>
+const internal::BinaryKernels<T>& GetBinaryKernels() {
+  if (GetSimdLevel() == SimdLevel::AVX2) { return *internal::GetAvx2BinaryKernels<T>(); }
+  return *internal::GetSse42BinaryKernels<T>();
+}
+
+// n values as type T: the values themselves when they already have type T,
+// otherwise a converted copy in buffer
+template <typename T>
+const T* ConvertBlock(const T* values, int64_t n, T* buffer) {
+  return values;
+}
+
+template <typename T, typename S>
+const T* ConvertBlock(const S* values, int64_t n, T* buffer) {
+  for (int64_t i = 0; i < n; ++i) {
+    buffer[i] = static_cast<T>(values[i]);
+  }
+  return buffer;
+}
+
+// out = left AND right over the bitmaps that are present, or all set if
+// neither is. out starts at bit 0
+void AndValidBits(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, uint8_t* out) {
+  if (left != nullptr && right != nullptr) {
+    BitmapAnd(left, left_offset, right, right_offset, length, out, 0);
+  } else if (left != nullptr) {
+    CopyBits(left, left_offset, length, out, 0);
+  } else if (right != nullptr) {
+    CopyBits(right, right_offset, length, out, 0);
+  } else {
+    SetBitsTo(out, 0, length, true);
+  }
+}
+
+Status CheckInputs(const ArrayView& left, const ArrayView& right) {
+  if (!left.data() || !right.data()) {
+    return Status::Invalid("ArrayView does not reference an array");
+  }
+  if (left.length() != right.length()) {
+    return Status::Invalid("arrays must have the same length");
+  }
+  return Status::OK();
+}
+
+Status CheckBitmapSize(const Buffer& bitmap, int64_t length) {
+  if (bitmap.size() < BitUtil::BytesForBits(length)) {
+    return Status::Invalid("output bitmap is too small");
+  }
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Visitors
+
+struct ResultTypeVisitor {
+  template <typename LEFT_TYPE, typename RIGHT_TYPE>
+  Status Visit() {
+    using L = typename LEFT_TYPE::c_type;
+    using R = typename RIGHT_TYPE::c_type;
+    if (op == ArithmeticOp::DIVIDE) {
+      *out = DataTypeForCType<typename DivideCType<L, R>::type>::type::SINGLETON;
+    } else {
+      *out = DataTypeForCType<typename CommonCType<L, R>::type>::type::SINGLETON;
+    }
+    return Status::OK();
+  }
+
+  ArithmeticOp op;
+  std::shared_ptr<DataType>* out;
+};
+
+struct ArithmeticVisitor {
+  template <typename LEFT_TYPE, typename RIGHT_TYPE>
+  Status Visit() {
+    using L = typename LEFT_TYPE::c_type;
+    using R = typename RIGHT_TYPE::c_type;
+    if (op == ArithmeticOp::DIVIDE) {
+      return Compute<LEFT_TYPE, RIGHT_TYPE, typename DivideCType<L, R>::type>();
+    }
+    return Compute<LEFT_TYPE, RIGHT_TYPE, typename CommonCType<L, R>::type>();
+  }
+
+  template <typename LEFT_TYPE, typename RIGHT_TYPE, typename T>
+  Status Compute() {
+    internal::NumericRange<LEFT_TYPE> left_range(left);
+    internal::NumericRange<RIGHT_TYPE> right_range(right);
+    const int64_t length = left.length();
+
+    if (values->size() < length * static_cast<int64_t>(sizeof(T))) {
+      return Status::Invalid("output buffer is too small");
+    }
+    const bool has_nulls = left_range.valid_bits || right_range.valid_bits;
+    if (std::is_integral<T>::value) {
+      if (valid_bits != nullptr) {
+        RETURN_NOT_OK(CheckBitmapSize(*valid_bits, length));
+      } else if (has_nulls) {
+        return Status::Invalid("a validity bitmap is needed for integer results with nulls");
+      }
+    }
+
+    auto kernel = GetBinaryKernels<T>().arithmetic[static_cast<int>(op)];
+    T* out = reinterpret_cast<T*>(values->mutable_data());
+    T left_buffer[kBlockSize];
+    T right_buffer[kBlockSize];
+    for (int64_t i = 0; i < length; i += kBlockSize) {
+      const int64_t n = std::min(kBlockSize, length - i);
+      kernel(ConvertBlock(left_range.values + i, n, left_buffer),
+          ConvertBlock(right_range.values + i, n, right_buffer), n, out + i);
+    }
+
+    SetNulls(left_range.valid_bits, left_range.bit_offset, right_range.valid_bits,
+        right_range.bit_offset, length, out, std::is_floating_point<T>());
+    return Status::OK();
+  }
+
+  template <typename T>
+  void SetNulls(const uint8_t* left_bits, int64_t left_offset, const uint8_t* right_bits,
+      int64_t right_offset, int64_t length, T* out, std::false_type) {
+    if (valid_bits == nullptr) { return; }
+    AndValidBits(left_bits, left_offset, right_bits, right_offset, length,
+        valid_bits->mutable_data());
+  }
+
+  // Floating point results mark the values that are null in an integer input
+  // as NaN; NaN in a floating point input has already propagated
+  template <typename T>
+  void SetNulls(const uint8_t* left_bits, int64_t left_offset, const uint8_t* right_bits,
+      int64_t right_offset, int64_t length, T* out, std::true_type) {
+    if (left_bits == nullptr && right_bits == nullptr) { return; }
+    uint8_t bits[kBlockSize / 8] = {};
+    for (int64_t i = 0; i < length; i += kBlockSize) {
+      const int64_t n = std::min(kBlockSize, length - i);
+      AndValidBits(left_bits, left_offset + i, right_bits, right_offset + i, n, bits);
+      for (int64_t k = 0; k < n; k += 64) {
+        uint64_t word;
+        memcpy(&word, bits + k / 8, sizeof(word));
+        if (n - k < 64) { word |= ~static_cast<uint64_t>(0) << (n - k); }
+        for (uint64_t nulls = ~word; nulls != 0; nulls &= nulls - 1) {
+          out[i + k + __builtin_ctzll(nulls)] = std::numeric_limits<T>::quiet_NaN();
+        }
+      }
+    }
+  }
+
+  ArithmeticOp op;
+  const ArrayView& left;
+  const ArrayView& right;
+  MutableBuffer* values;
+  MutableBuffer* valid_bits;
+};
+
+// Allocates the output of an arithmetic operation with result type TYPE
+struct ArithmeticArrayVisitor {
+  template <typename TYPE>
+  Status Visit() {
+    using T = typename TYPE::c_type;
+    auto data = std::make_shared<PoolBuffer>();
+    RETURN_NOT_OK(data->Resize(left.length() * sizeof(T)));
+    return Finish<TYPE>(data, std::is_floating_point<T>());
+  }
+
+  template <typename TYPE>
+  Status Finish(const std::shared_ptr<PoolBuffer>& data, std::true_type) {
+    RETURN_NOT_OK(Arithmetic(op, left, right, data.get(), nullptr));
+    *out = std::make_shared<FloatingArray<TYPE>>(left.length(), data);
+    return Status::OK();
+  }
+
+  template <typename TYPE>
+  Status Finish(const std::shared_ptr<PoolBuffer>& data, std::false_type) {
+    const int64_t length = left.length();
+    if (!left.data()->HasNulls() && !right.data()->HasNulls()) {
+      RETURN_NOT_OK(Arithmetic(op, left, right, data.get(), nullptr));
+      *out = std::make_shared<IntegerArray<TYPE>>(length, data);
+      return Status::OK();
+    }
+
+    auto valid_bits = std::make_shared<PoolBuffer>();
+    RETURN_NOT_OK(valid_bits->Resize(BitUtil::BytesForBits(length)));
+    RETURN_NOT_OK(Arithmetic(op, left, right, data.get(), valid_bits.get()));
+    const int64_t null_count = length - CountSetBits(valid_bits->data(), 0, length);
+    *out = std::make_shared<IntegerArray<TYPE>>(length, data, valid_bits, null_count);
+    return Status::OK();
+  }
+
+  ArithmeticOp op;
+  const ArrayView& left;
+  const ArrayView& right;
+  std::shared_ptr<Array>* out;
+};
+
+struct CompareVisitor {
+  template <typename LEFT_TYPE, typename RIGHT_TYPE>
+  Status Visit() {
+    using T = typename CommonCType<typename LEFT_TYPE::c_type,
+        typename RIGHT_TYPE::c_type>::type;
+    internal::NumericRange<LEFT_TYPE> left_range(left);
+    internal::NumericRange<RIGHT_TYPE> right_range(right);
+    const int64_t length = left.length();
+    RETURN_NOT_OK(CheckBitmapSize(*values, length));
+    RETURN_NOT_OK(CheckBitmapSize(*valid_bits, length));
+
+    const auto& kernels = GetBinaryKernels<T>();
+    auto kernel = kernels.compare[static_cast<int>(op)];
+    uint8_t* out_values = values->mutable_data();
+    uint8_t* out_valid = valid_bits->mutable_data();
+
+    // The kernels produce a byte per value, which is packed into the bitmaps
+    // while still in cache. Blocks start on a byte boundary of the output
+    T left_buffer[kBlockSize];
+    T right_buffer[kBlockSize];
+    uint8_t bytes[kBlockSize];
+    for (int64_t i = 0; i < length; i += kBlockSize) {
+      const int64_t n = std::min(kBlockSize, length - i);
+      const T* l = ConvertBlock(left_range.values + i, n, left_buffer);
+      const T* r = ConvertBlock(right_range.values + i, n, right_buffer);
+      kernel(l, r, n, bytes);
+      BytesToBits(bytes, n, out_values + i / 8);
+      if (std::is_floating_point<T>::value) {
+        kernels.not_nan(l, r, n, bytes);
+        BytesToBits(bytes, n, out_valid + i / 8);
+      }
+    }
+
+    if (std::is_floating_point<T>::value) {
+      // An integer input with nulls may still have been converted to T
+      if (left_range.valid_bits) {
+        BitmapAnd(out_valid, 0, left_range.valid_bits, left_range.bit_offset, length,
+            out_valid, 0);
+      }
+      if (right_range.valid_bits) {
+        BitmapAnd(out_valid, 0, right_range.valid_bits, right_range.bit_offset, length,
+            out_valid, 0);
+      }
+    } else {
+      AndValidBits(left_range.valid_bits, left_range.bit_offset, right_range.valid_bits,
+          right_range.bit_offset, length, out_valid);
+    }
+    BitmapAnd(out_values, 0, out_valid, 0, length, out_values, 0);
+    return Status::OK();
+  }
+
+  CompareOp op;
+  const ArrayView& left;
+  const ArrayView& right;
+  MutableBuffer* values;
+  MutableBuffer* valid_bits;
+};
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Public API
+
+Status ArithmeticResultType(ArithmeticOp op, const DataType& left, const DataType& right,
+    std::shared_ptr<DataType>* out) {
+  ResultTypeVisitor visitor = {op, out};
+  return internal::VisitNumericTypePair(left, right, "arithmetic", &visitor);
+}
+
+Status Arithmetic(ArithmeticOp op, const ArrayView& left, const ArrayView& right,
+    MutableBuffer* values, MutableBuffer* valid_bits) {
+  RETURN_NOT_OK(CheckInputs(left, right));
+  ArithmeticVisitor visitor = {op, left, right, values, valid_bits};
+  return internal::VisitNumericTypePair(
+      *left.data()->type(), *right.data()->type(), "arithmetic", &visitor);
+}
+
+Status Arithmetic(ArithmeticOp op, const ArrayView& left, const ArrayView& right,
+    std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckInputs(left, right));
+  std::shared_ptr<DataType> type;
+  RETURN_NOT_OK(
+      ArithmeticResultType(op, *left.data()->type(), *right.data()->type(), &type));
+  ArithmeticArrayVisitor visitor = {op, left, right, out};
+  return internal::VisitNumericType(*type, "arithmetic", &visitor);
+}
+
+Status Add(const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out) {
+  return Arithmetic(ArithmeticOp::ADD, left, right, out);
+}
+
+Status Subtract(
+    const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out) {
+  return Arithmetic(ArithmeticOp::SUBTRACT, left, right, out);
+}
+
+Status Multiply(
+    const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out) {
+  return Arithmetic(ArithmeticOp::MULTIPLY, left, right, out);
+}
+
+Status Divide(const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out) {
+  return Arithmetic(ArithmeticOp::DIVIDE, left, right, out);
+}
+
+Status Compare(CompareOp op, const ArrayView& left, const ArrayView& right,
+    MutableBuffer* values, MutableBuffer* valid_bits) {
+  RETURN_NOT_OK(CheckInputs(left, right));
+  CompareVisitor visitor = {op, left, right, values, valid_bits};
+  return internal::VisitNumericTypePair(
+      *left.data()->type(), *right.data()->type(), "comparisons", &visitor);
+}
+
+Status Compare(CompareOp op, const ArrayView& left, const ArrayView& right,
+    std::shared_ptr<Buffer>* values, std::shared_ptr<Buffer>* valid_bits) {
+  RETURN_NOT_OK(CheckInputs(left, right));
+  const int64_t nbytes = BitUtil::BytesForBits(left.length());
+  auto value_buffer = std::make_shared<PoolBuffer>();
+  auto valid_buffer = std::make_shared<PoolBuffer>();
+  RETURN_NOT_OK(value_buffer->Resize(nbytes));
+  RETURN_NOT_OK(valid_buffer->Resize(nbytes));
+  RETURN_NOT_OK(Compare(op, left, right, value_buffer.get(), valid_buffer.get()));
+  *values = value_buffer;
+  *valid_bits = valid_buffer;
+  return Status::OK();
+}
+
+}  // namespace pandas
@@ -0,0 +1,77 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Element-wise arithmetic and comparisons between two numeric arrays of the
+// same length.
+//
+// Inputs of different types are first converted to a common type following
+// NumPy: integers of the same signedness widen to the larger of the two, mixed
+// signed and unsigned integers widen to a signed type that holds both (double
+// for int64 and uint64), and integers combined with floating point values give
+// double, or float for integers of up to 16 bits combined with float. Division
+// is true division and always has a floating point result.
+//
+// A result is null where either input is null. As in the reductions, NaN is
+// null for floating point inputs. Integer results wrap on overflow.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/type.h"
+
+namespace pandas {
+
+enum class ArithmeticOp : int { ADD, SUBTRACT, MULTIPLY, DIVIDE };
+
+enum class CompareOp : int {
+  EQUAL,
+  NOT_EQUAL,
+  LESS,
+  LESS_EQUAL,
+  GREATER,
+  GREATER_EQUAL
+};
+
+// The type of the result of op applied to values of the given types
+PANDAS_EXPORT Status ArithmeticResultType(ArithmeticOp op, const DataType& left,
+    const DataType& right, std::shared_ptr<DataType>* out);
+
+// Writes the length values of the result into preallocated buffers, so that
+// repeated operations need not allocate. values needs room for length values
+// of the result type. For integer results, valid_bits receives the validity
+// bitmap and needs BytesForBits(length) bytes; it may be null if neither input
+// has nulls. Floating point results store NaN for nulls and do not use
+// valid_bits.
+PANDAS_EXPORT Status Arithmetic(ArithmeticOp op, const ArrayView& left,
+    const ArrayView& right, MutableBuffer* values, MutableBuffer* valid_bits);
+
+// As above, allocating a new array for the result
+PANDAS_EXPORT Status Arithmetic(ArithmeticOp op, const ArrayView& left,
+    const ArrayView& right, std::shared_ptr<Array>* out);
+
+PANDAS_EXPORT Status Add(
+    const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out);
+PANDAS_EXPORT Status Subtract(
+    const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out);
+PANDAS_EXPORT Status Multiply(
+    const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out);
+PANDAS_EXPORT Status Divide(
+    const ArrayView& left, const ArrayView& right, std::shared_ptr<Array>* out);
+
+// Writes the result of the comparison as a bitmap of length bits: bit i of
+// values is set when the comparison holds for the i-th pair and neither value
+// is null, and bit i of valid_bits is cleared when either value is null. Both
+// buffers need BytesForBits(length) bytes.
+PANDAS_EXPORT Status Compare(CompareOp op, const ArrayView& left,
+    const ArrayView& right, MutableBuffer* values, MutableBuffer* valid_bits);
+
+// As above, allocating the bitmaps
+PANDAS_EXPORT Status Compare(CompareOp op, const ArrayView& left,
+    const ArrayView& right, std::shared_ptr<Buffer>* values,
+    std::shared_ptr<Buffer>* valid_bits);
+
+}  // namespace pandas
@@ -0,0 +1,89 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/groupby.h"
+#include "pandas/types/numeric.h"
+
+namespace pandas {
+
+constexpr int64_t kLength = 1 << 20;
+
+// Random labels in [0, num_groups)
+static std::shared_ptr<Array> MakeLabels(int64_t num_groups) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int64_t> labels(0, num_groups - 1);
+  auto data = std::make_shared<PoolBuffer>();
+  data->Resize(kLength * sizeof(int64_t));
+  int64_t* out = reinterpret_cast<int64_t*>(data->mutable_data());
+  for (int64_t i = 0; i < kLength; ++i) {
+    out[i] = labels(rng);
+  }
+  return std::make_shared<Int64Array>(kLength, data);
+}
+
+// Doubles with 10% NaN
+static std::shared_ptr<Array> MakeValues(int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> values(-1000, 1000);
+  std::bernoulli_distribution is_null(0.1);
+  auto data = std::make_shared<PoolBuffer>();
+  data->Resize(kLength * sizeof(double));
+  double* out = reinterpret_cast<double*>(data->mutable_data());
+  for (int64_t i = 0; i < kLength; ++i) {
+    out[i] = is_null(rng) ? std::numeric_limits<double>::quiet_NaN() : values(rng);
+  }
+  return std::make_shared<DoubleArray>(kLength, data);
+}
+
+// agg({'a': ['sum', 'mean', 'max'], 'b': 'var'})
+static std::vector<GroupAggregate> MakeAggregates() {
+  ArrayView a(MakeValues(1));
+  ArrayView b(MakeValues(2));
+  return {{a, GroupAggregateOp::SUM, 0}, {a, GroupAggregateOp::MEAN, 0},
+      {a, GroupAggregateOp::MAX, 0}, {b, GroupAggregateOp::VAR, 1}};
+}
+
+// Arguments: number of groups
+static void BM_GroupbyFused(benchmark::State& state) {  // NOLINT non-const reference
+  const int64_t num_groups = state.range_x();
+  ArrayView labels(MakeLabels(num_groups));
+  const auto aggregates = MakeAggregates();
+  while (state.KeepRunning()) {
+    std::vector<std::shared_ptr<Array>> out;
+    GroupbyAggregate(labels, num_groups, aggregates, &out);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+// The same aggregations one at a time, each making its own pass over the
+// labels and its column
+static void BM_GroupbySeparate(benchmark::State& state) {  // NOLINT non-const reference
+  const int64_t num_groups = state.range_x();
+  ArrayView labels(MakeLabels(num_groups));
+  const auto aggregates = MakeAggregates();
+  while (state.KeepRunning()) {
+    std::vector<std::shared_ptr<Array>> out;
+    for (const auto& aggregate : aggregates) {
+      GroupbyAggregate(labels, num_groups, {aggregate}, &out);
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+BENCHMARK(BM_GroupbyFused)->Arg(16)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_GroupbySeparate)->Arg(16)->Arg(1 << 10)->Arg(1 << 16);
+
+}  // namespace pandas
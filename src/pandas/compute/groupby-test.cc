@@ -0,0 +1,299 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/groupby.h"
+#include "pandas/compute/reduce.h"
+#include "pandas/test-util.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+
+namespace pandas {
+
+static std::shared_ptr<Array> LabelsFromVector(const std::vector<int64_t>& labels) {
+  return std::make_shared<Int64Array>(labels.size(), BufferFromVector(labels));
+}
+
+template <typename ArrayType>
+static const ArrayType& Result(const std::shared_ptr<Array>& out) {
+  return static_cast<const ArrayType&>(*out);
+}
+
+template <typename ArrayType>
+static bool IsNull(const std::shared_ptr<Array>& out, int64_t i) {
+  const auto& valid_bits = Result<ArrayType>(out).valid_bits();
+  return valid_bits && BitUtil::BitNotSet(valid_bits->data(), i);
+}
+
+TEST(TestGroupby, AllAggregates) {
+  // Groups 0 and 2 have values, group 1 has only nulls and group 3 no rows.
+  // Rows labeled -1 belong to no group
+  std::vector<int64_t> labels = {0, 2, 0, -1, 1, 2, 0, 2, -1, 1};
+  std::vector<int64_t> ints = {1, 10, 4, 100, 7, 20, 7, 30, 100, 8};
+  std::vector<bool> is_valid = {true, true, true, true, false, true, true, true, true,
+      false};
+  std::vector<double> doubles = {1.5, NAN, 2.5, 100, NAN, -1, NAN, 4, 100, NAN};
+
+  auto int_array = std::make_shared<Int64Array>(
+      ints.size(), BufferFromVector(ints), BitmapFromVector(is_valid));
+  auto double_array =
+      std::make_shared<DoubleArray>(doubles.size(), BufferFromVector(doubles));
+  ArrayView int_view(int_array);
+  ArrayView double_view(double_array);
+
+  std::vector<GroupAggregate> aggregates = {{int_view, GroupAggregateOp::COUNT, 0},
+      {int_view, GroupAggregateOp::SUM, 0}, {int_view, GroupAggregateOp::MEAN, 0},
+      {int_view, GroupAggregateOp::MIN, 0}, {int_view, GroupAggregateOp::MAX, 0},
+      {int_view, GroupAggregateOp::VAR, 1}, {double_view, GroupAggregateOp::SUM, 0},
+      {double_view, GroupAggregateOp::MIN, 0}, {double_view, GroupAggregateOp::VAR, 0}};
+  std::vector<std::shared_ptr<Array>> out;
+  ASSERT_OK(GroupbyAggregate(ArrayView(LabelsFromVector(labels)), 4, aggregates, &out));
+  ASSERT_EQ(aggregates.size(), out.size());
+  for (const auto& result : out) {
+    ASSERT_EQ(4, result->length());
+  }
+
+  const auto& count = Result<Int64Array>(out[0]);
+  ASSERT_EQ(DataType::INT64, count.type()->type());
+  ASSERT_EQ(0, count.GetNullCount());
+  ASSERT_EQ(3, count.data()[0]);
+  ASSERT_EQ(0, count.data()[1]);
+  ASSERT_EQ(3, count.data()[2]);
+  ASSERT_EQ(0, count.data()[3]);
+
+  const auto& sum = Result<Int64Array>(out[1]);
+  ASSERT_EQ(DataType::INT64, sum.type()->type());
+  ASSERT_EQ(0, sum.GetNullCount());
+  ASSERT_EQ(12, sum.data()[0]);
+  ASSERT_EQ(0, sum.data()[1]);
+  ASSERT_EQ(60, sum.data()[2]);
+  ASSERT_EQ(0, sum.data()[3]);
+
+  const auto& mean = Result<DoubleArray>(out[2]);
+  ASSERT_DOUBLE_EQ(4, mean.data()[0]);
+  ASSERT_TRUE(std::isnan(mean.data()[1]));
+  ASSERT_DOUBLE_EQ(20, mean.data()[2]);
+  ASSERT_TRUE(std::isnan(mean.data()[3]));
+
+  // Integer minima keep their type, with the empty groups null
+  const auto& min = Result<Int64Array>(out[3]);
+  ASSERT_EQ(2, min.GetNullCount());
+  ASSERT_FALSE(IsNull<Int64Array>(out[3], 0));
+  ASSERT_TRUE(IsNull<Int64Array>(out[3], 1));
+  ASSERT_FALSE(IsNull<Int64Array>(out[3], 2));
+  ASSERT_TRUE(IsNull<Int64Array>(out[3], 3));
+  ASSERT_EQ(1, min.data()[0]);
+  ASSERT_EQ(10, min.data()[2]);
+
+  const auto& max = Result<Int64Array>(out[4]);
+  ASSERT_EQ(2, max.GetNullCount());
+  ASSERT_EQ(7, max.data()[0]);
+  ASSERT_EQ(30, max.data()[2]);
+
+  const auto& var = Result<DoubleArray>(out[5]);
+  ASSERT_DOUBLE_EQ(9, var.data()[0]);
+  ASSERT_TRUE(std::isnan(var.data()[1]));
+  ASSERT_DOUBLE_EQ(100, var.data()[2]);
+
+  const auto& double_sum = Result<DoubleArray>(out[6]);
+  ASSERT_DOUBLE_EQ(4, double_sum.data()[0]);
+  ASSERT_DOUBLE_EQ(0, double_sum.data()[1]);
+  ASSERT_DOUBLE_EQ(3, double_sum.data()[2]);
+
+  const auto& double_min = Result<DoubleArray>(out[7]);
+  ASSERT_DOUBLE_EQ(1.5, double_min.data()[0]);
+  ASSERT_TRUE(std::isnan(double_min.data()[1]));
+  ASSERT_DOUBLE_EQ(-1, double_min.data()[2]);
+  ASSERT_TRUE(std::isnan(double_min.data()[3]));
+
+  const auto& double_var = Result<DoubleArray>(out[8]);
+  ASSERT_DOUBLE_EQ(0.25, double_var.data()[0]);
+  ASSERT_TRUE(std::isnan(double_var.data()[1]));
+  ASSERT_DOUBLE_EQ(6.25, double_var.data()[2]);
+}
+
+TEST(TestGroupby, ResultTypes) {
+  std::vector<uint8_t> values = {200, 100, 250};
+  std::vector<int64_t> labels = {0, 0, 0};
+  auto array = std::make_shared<UInt8Array>(values.size(), BufferFromVector(values));
+  ArrayView view(array);
+
+  std::vector<std::shared_ptr<Array>> out;
+  ASSERT_OK(GroupbyAggregate(ArrayView(LabelsFromVector(labels)), 1,
+      {{view, GroupAggregateOp::SUM, 0}, {view, GroupAggregateOp::MAX, 0},
+          {view, GroupAggregateOp::MEAN, 0}},
+      &out));
+  ASSERT_EQ(DataType::UINT64, out[0]->type()->type());
+  ASSERT_EQ(550u, Result<UInt64Array>(out[0]).data()[0]);
+  ASSERT_EQ(DataType::UINT8, out[1]->type()->type());
+  ASSERT_EQ(250, Result<UInt8Array>(out[1]).data()[0]);
+  ASSERT_EQ(0, out[1]->GetNullCount());
+  ASSERT_EQ(DataType::FLOAT64, out[2]->type()->type());
+}
+
+TEST(TestGroupby, LargeIntegerMean) {
+  // The int64 sums of these wrap, the double sums do not
+  const int64_t big = std::numeric_limits<int64_t>::max();
+  std::vector<int64_t> values(100, big);
+  std::vector<int64_t> labels(100);
+  for (size_t i = 0; i < labels.size(); ++i) {
+    labels[i] = i % 2;
+  }
+  auto array = std::make_shared<Int64Array>(values.size(), BufferFromVector(values));
+  ArrayView view(array);
+
+  std::vector<std::shared_ptr<Array>> out;
+  ASSERT_OK(GroupbyAggregate(ArrayView(LabelsFromVector(labels)), 2,
+      {{view, GroupAggregateOp::SUM, 0}, {view, GroupAggregateOp::MEAN, 0}}, &out));
+  for (int64_t g = 0; g < 2; ++g) {
+    ASSERT_DOUBLE_EQ(static_cast<double>(big), Result<DoubleArray>(out[1]).data()[g]);
+  }
+}
+
+// Every aggregation of each group matches the corresponding reduction of the
+// values in that group
+TEST(TestGroupby, MatchesReductions) {
+  const int64_t length = 5000;
+  const int64_t offset = 13;
+  const int64_t num_groups = 37;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int64_t> group(-1, num_groups - 1);
+  std::uniform_int_distribution<int32_t> ints(-1000, 1000);
+  std::normal_distribution<double> doubles(5, 10);
+  std::bernoulli_distribution is_null(0.2);
+
+  std::vector<int64_t> labels(length);
+  std::vector<int32_t> int_values(length + offset);
+  std::vector<bool> is_valid(length + offset);
+  std::vector<double> double_values(length);
+  for (int64_t i = 0; i < length + offset; ++i) {
+    int_values[i] = ints(rng);
+    is_valid[i] = !is_null(rng);
+  }
+  for (int64_t i = 0; i < length; ++i) {
+    labels[i] = group(rng);
+    double_values[i] = is_null(rng) ? NAN : doubles(rng);
+  }
+
+  auto int_array = std::make_shared<Int32Array>(
+      int_values.size(), BufferFromVector(int_values), BitmapFromVector(is_valid));
+  auto double_array =
+      std::make_shared<DoubleArray>(length, BufferFromVector(double_values));
+
+  // The integer column is read at an offset so that its bitmap is unaligned
+  std::vector<ArrayView> columns = {ArrayView(int_array, offset, length),
+      ArrayView(double_array)};
+  std::vector<GroupAggregate> aggregates;
+  for (const auto& column : columns) {
+    for (auto op : {GroupAggregateOp::COUNT, GroupAggregateOp::SUM, GroupAggregateOp::MEAN,
+             GroupAggregateOp::MIN, GroupAggregateOp::MAX, GroupAggregateOp::VAR}) {
+      aggregates.push_back({column, op, 1});
+    }
+  }
+  std::vector<std::shared_ptr<Array>> out;
+  ASSERT_OK(GroupbyAggregate(
+      ArrayView(LabelsFromVector(labels)), num_groups, aggregates, &out));
+
+  for (int64_t g = 0; g < num_groups; ++g) {
+    std::vector<int32_t> group_ints;
+    std::vector<bool> group_valid;
+    std::vector<double> group_doubles;
+    for (int64_t i = 0; i < length; ++i) {
+      if (labels[i] != g) { continue; }
+      group_ints.push_back(int_values[offset + i]);
+      group_valid.push_back(is_valid[offset + i]);
+      group_doubles.push_back(double_values[i]);
+    }
+    std::vector<std::shared_ptr<Array>> group_arrays = {
+        std::make_shared<Int32Array>(group_ints.size(), BufferFromVector(group_ints),
+            BitmapFromVector(group_valid)),
+        std::make_shared<DoubleArray>(
+            group_doubles.size(), BufferFromVector(group_doubles))};
+
+    for (size_t c = 0; c < columns.size(); ++c) {
+      ArrayView view(group_arrays[c]);
+      const std::shared_ptr<Array>* results = out.data() + 6 * c;
+
+      int64_t count;
+      ASSERT_OK(Count(view, &count));
+      ASSERT_EQ(count, Result<Int64Array>(results[0]).data()[g]);
+
+      ReduceResult sum;
+      ASSERT_OK(Sum(view, &sum));
+      if (c == 0) {
+        ASSERT_EQ(sum.value.int64, Result<Int64Array>(results[1]).data()[g]);
+      } else {
+        ASSERT_NEAR(sum.value.float64, Result<DoubleArray>(results[1]).data()[g], 1e-9);
+      }
+
+      double mean;
+      ASSERT_OK(Mean(view, &mean));
+      ASSERT_NEAR(mean, Result<DoubleArray>(results[2]).data()[g], 1e-9);
+
+      ReduceResult min, max;
+      ASSERT_OK(Min(view, &min));
+      ASSERT_OK(Max(view, &max));
+      ASSERT_FALSE(min.is_null);
+      if (c == 0) {
+        ASSERT_FALSE(IsNull<Int32Array>(results[3], g));
+        ASSERT_EQ(min.value.int64, Result<Int32Array>(results[3]).data()[g]);
+        ASSERT_EQ(max.value.int64, Result<Int32Array>(results[4]).data()[g]);
+      } else {
+        ASSERT_EQ(min.value.float64, Result<DoubleArray>(results[3]).data()[g]);
+        ASSERT_EQ(max.value.float64, Result<DoubleArray>(results[4]).data()[g]);
+      }
+
+      double var;
+      ASSERT_OK(Var(view, 1, &var));
+      ASSERT_NEAR(var, Result<DoubleArray>(results[5]).data()[g], 1e-9 * var);
+    }
+  }
+}
+
+TEST(TestGroupby, NullLabels) {
+  std::vector<int64_t> labels = {0, 1, 0, 1, 5};
+  std::vector<bool> labels_valid = {true, false, true, true, false};
+  std::vector<int16_t> values = {1, 2, 3, 4, 5};
+  auto label_array = std::make_shared<Int64Array>(
+      labels.size(), BufferFromVector(labels), BitmapFromVector(labels_valid));
+  auto array = std::make_shared<Int16Array>(values.size(), BufferFromVector(values));
+
+  // The null label 5 is not out of range, as it belongs to no group
+  std::vector<std::shared_ptr<Array>> out;
+  ASSERT_OK(GroupbyAggregate(
+      ArrayView(label_array), 2, {{ArrayView(array), GroupAggregateOp::SUM, 0}}, &out));
+  ASSERT_EQ(4, Result<Int64Array>(out[0]).data()[0]);
+  ASSERT_EQ(4, Result<Int64Array>(out[0]).data()[1]);
+}
+
+TEST(TestGroupby, Errors) {
+  std::vector<int64_t> labels = {0, 1, 2};
+  std::vector<int32_t> values = {1, 2, 3};
+  auto label_array = LabelsFromVector(labels);
+  auto array = std::make_shared<Int32Array>(values.size(), BufferFromVector(values));
+  ArrayView view(array);
+  std::vector<std::shared_ptr<Array>> out;
+
+  ASSERT_RAISES(Invalid, GroupbyAggregate(ArrayView(label_array), 2,
+                             {{view, GroupAggregateOp::SUM, 0}}, &out));
+  ASSERT_RAISES(Invalid, GroupbyAggregate(ArrayView(label_array), 3,
+                             {{view.Slice(1), GroupAggregateOp::SUM, 0}}, &out));
+  ASSERT_RAISES(Invalid, GroupbyAggregate(ArrayView(label_array), 3,
+                             {{view, GroupAggregateOp::VAR, -1}}, &out));
+  ASSERT_RAISES(Invalid, GroupbyAggregate(ArrayView(label_array), -1, {}, &out));
+  ASSERT_RAISES(Invalid,
+      GroupbyAggregate(view, 3, {{view, GroupAggregateOp::SUM, 0}}, &out));
+  ASSERT_TRUE(out.empty());
+}
+
+}  // namespace pandas
@@ -0,0 +1,385 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "pandas/compute/groupby.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "pandas/common.h"
+#include "pandas/compute/reduce-internal.h"
+#include "pandas/compute/visit-internal.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+
+namespace pandas {
+
+namespace {
+
+// Rows are processed in blocks whose labels stay in L1 cache while every
+// column of the block is read
+constexpr int64_t kGroupbyBlockSize = 1024;
+
+using internal::NumericRange;
+
+template <typename T>
+using SumDataType = typename std::conditional<std::is_floating_point<T>::value,
+    DoubleType, typename std::conditional<std::is_signed<T>::value, Int64Type,
+                    UInt64Type>::type>::type;
+
+template <typename TYPE>
+Status FinishResult(const std::shared_ptr<PoolBuffer>& data, int64_t length,
+    const int64_t* counts, std::shared_ptr<Array>* out, std::true_type) {
+  using T = typename TYPE::c_type;
+  if (counts != nullptr) {
+    auto values = reinterpret_cast<T*>(data->mutable_data());
+    for (int64_t i = 0; i < length; ++i) {
+      if (counts[i] == 0) { values[i] = std::numeric_limits<T>::quiet_NaN(); }
+    }
+  }
+  *out = std::make_shared<FloatingArray<TYPE>>(length, data);
+  return Status::OK();
+}
+
+template <typename TYPE>
+Status FinishResult(const std::shared_ptr<PoolBuffer>& data, int64_t length,
+    const int64_t* counts, std::shared_ptr<Array>* out, std::false_type) {
+  const int64_t null_count =
+      counts == nullptr ? 0 : std::count(counts, counts + length, int64_t(0));
+  if (null_count == 0) {
+    *out = std::make_shared<IntegerArray<TYPE>>(length, data);
+    return Status::OK();
+  }
+
+  auto valid_bits = std::make_shared<PoolBuffer>();
+  const int64_t nbytes = BitUtil::BytesForBits(length);
+  RETURN_NOT_OK(valid_bits->Resize(nbytes));
+  memset(valid_bits->mutable_data(), 0, nbytes);
+  for (int64_t i = 0; i < length; ++i) {
+    if (counts[i] > 0) { BitUtil::SetBit(valid_bits->mutable_data(), i); }
+  }
+  *out = std::make_shared<IntegerArray<TYPE>>(length, data, valid_bits, null_count);
+  return Status::OK();
+}
+
+// Integer sums wrap on overflow like NumPy. The slot of no group also adds
+// up whatever lies under the nulls, so the wrapping must be well defined
+template <typename S, typename T>
+inline typename std::enable_if<std::is_integral<S>::value, S>::type WrappingAdd(
+    S sum, T value) {
+  return static_cast<S>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(value));
+}
+
+template <typename S, typename T>
+inline typename std::enable_if<!std::is_integral<S>::value, S>::type WrappingAdd(
+    S sum, T value) {
+  return sum + value;
+}
+
+// Copies values into a new array of type TYPE. If counts is given, the values
+// of the groups with a count of 0 are null
+template <typename TYPE>
+Status MakeResult(const typename TYPE::c_type* values, int64_t length,
+    const int64_t* counts, std::shared_ptr<Array>* out) {
+  using T = typename TYPE::c_type;
+  auto data = std::make_shared<PoolBuffer>();
+  RETURN_NOT_OK(data->Resize(length * sizeof(T)));
+  memcpy(data->mutable_data(), values, length * sizeof(T));
+  return FinishResult<TYPE>(data, length, counts, out, std::is_floating_point<T>());
+}
+
+// The accumulators of one column for all the aggregations requested of it.
+// Each kind of state is a separate array with a slot per group plus a final
+// slot that absorbs the rows belonging to no group, so that the update loops
+// need no branches and each touches only the state it needs.
+class ColumnAccumulator {
+ public:
+  virtual ~ColumnAccumulator() = default;
+
+  virtual Status Reserve(int64_t num_groups) = 0;
+
+  // Adds the rows [offset, offset + length) of the column. groups[i] is the
+  // group of row offset + i, or num_groups for no group. scratch has room for
+  // length labels
+  virtual void Update(
+      const int64_t* groups, int64_t offset, int64_t length, int64_t* scratch) = 0;
+
+  virtual Status Finish(const GroupAggregate& aggregate, int64_t num_groups,
+      std::shared_ptr<Array>* out) = 0;
+
+  void Add(GroupAggregateOp op) {
+    switch (op) {
+      case GroupAggregateOp::SUM:
+        need_sum_ = true;
+        break;
+      case GroupAggregateOp::MEAN:
+        need_mean_ = true;
+        break;
+      case GroupAggregateOp::MIN:
+        need_min_ = true;
+        break;
+      case GroupAggregateOp::MAX:
+        need_max_ = true;
+        break;
+      case GroupAggregateOp::VAR:
+        need_var_ = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+ protected:
+  bool need_sum_ = false;
+  bool need_mean_ = false;
+  bool need_min_ = false;
+  bool need_max_ = false;
+  bool need_var_ = false;
+};
+
+template <typename TYPE>
+class TypedColumnAccumulator : public ColumnAccumulator {
+ public:
+  using T = typename TYPE::c_type;
+  using sum_type = typename internal::SumType<T>::type;
+
+  static constexpr bool kSumIsDouble = std::is_same<sum_type, double>::value;
+
+  explicit TypedColumnAccumulator(const ArrayView& view) : range_(view) {}
+
+  Status Reserve(int64_t num_groups) override {
+    const int64_t slots = num_groups + 1;
+    try {
+      counts_.assign(slots, 0);
+      if (NeedSums()) { sums_.assign(slots, 0); }
+      if (NeedDoubleSums()) { double_sums_.assign(slots, 0); }
+      if (need_min_) { mins_.assign(slots, internal::MinOp<T>::identity()); }
+      if (need_max_) { maxs_.assign(slots, internal::MaxOp<T>::identity()); }
+      if (need_var_) {
+        means_.assign(slots, 0);
+        m2s_.assign(slots, 0);
+      }
+    } catch (const std::bad_alloc& e) {
+      return Status::OutOfMemory("groupby accumulators failed");
+    }
+    return Status::OK();
+  }
+
+  void Update(const int64_t* groups, int64_t offset, int64_t length,
+      int64_t* scratch) override {
+    const T* values = range_.values + offset;
+    if (range_.valid_bits != nullptr || std::is_floating_point<T>::value) {
+      // Send the null values to the slot of no group
+      const int64_t none = static_cast<int64_t>(counts_.size()) - 1;
+      const uint8_t* valid_bits = range_.valid_bits;
+      const int64_t bit_offset = range_.bit_offset + offset;
+      for (int64_t i = 0; i < length; ++i) {
+        const bool is_valid =
+            (valid_bits == nullptr || BitUtil::GetBit(valid_bits, bit_offset + i)) &&
+            internal::IsNotNaN(values[i]);
+        scratch[i] = is_valid ? groups[i] : none;
+      }
+      groups = scratch;
+    }
+
+    if (need_var_) {
+      // Welford's update, so that the variance needs no second pass
+      int64_t* counts = counts_.data();
+      double* means = means_.data();
+      double* m2s = m2s_.data();
+      for (int64_t i = 0; i < length; ++i) {
+        const int64_t g = groups[i];
+        const double value = static_cast<double>(values[i]);
+        const double delta = value - means[g];
+        means[g] += delta / ++counts[g];
+        m2s[g] += delta * (value - means[g]);
+      }
+    } else {
+      int64_t* counts = counts_.data();
+      for (int64_t i = 0; i < length; ++i) {
+        ++counts[groups[i]];
+      }
+    }
+    if (NeedSums()) {
+      sum_type* sums = sums_.data();
+      for (int64_t i = 0; i < length; ++i) {
+        sums[groups[i]] = WrappingAdd(sums[groups[i]], values[i]);
+      }
+    }
+    if (NeedDoubleSums()) {
+      double* sums = double_sums_.data();
+      for (int64_t i = 0; i < length; ++i) {
+        sums[groups[i]] += static_cast<double>(values[i]);
+      }
+    }
+    if (need_min_) { UpdateExtremum<internal::MinOp<T>>(groups, values, length, &mins_); }
+    if (need_max_) { UpdateExtremum<internal::MaxOp<T>>(groups, values, length, &maxs_); }
+  }
+
+  Status Finish(const GroupAggregate& aggregate, int64_t num_groups,
+      std::shared_ptr<Array>* out) override {
+    const int64_t* counts = counts_.data();
+    switch (aggregate.op) {
+      case GroupAggregateOp::COUNT:
+        return MakeResult<Int64Type>(counts, num_groups, nullptr, out);
+      case GroupAggregateOp::SUM:
+        return MakeResult<SumDataType<T>>(sums_.data(), num_groups, nullptr, out);
+      case GroupAggregateOp::MIN:
+        return MakeResult<TYPE>(mins_.data(), num_groups, counts, out);
+      case GroupAggregateOp::MAX:
+        return MakeResult<TYPE>(maxs_.data(), num_groups, counts, out);
+      default:
+        break;
+    }
+
+    auto data = std::make_shared<PoolBuffer>();
+    RETURN_NOT_OK(data->Resize(num_groups * sizeof(double)));
+    double* result = reinterpret_cast<double*>(data->mutable_data());
+    if (aggregate.op == GroupAggregateOp::MEAN) {
+      for (int64_t i = 0; i < num_groups; ++i) {
+        const double sum =
+            kSumIsDouble ? static_cast<double>(sums_[i]) : double_sums_[i];
+        result[i] = counts[i] > 0 ? sum / counts[i]
+                                  : std::numeric_limits<double>::quiet_NaN();
+      }
+    } else {
+      const int64_t ddof = aggregate.ddof;
+      for (int64_t i = 0; i < num_groups; ++i) {
+        result[i] = counts[i] > ddof ? m2s_[i] / (counts[i] - ddof)
+                                     : std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+    *out = std::make_shared<DoubleArray>(num_groups, data);
+    return Status::OK();
+  }
+
+ private:
+  // Means accumulate in double like Mean in reduce.h, which for floating point
+  // columns is the sum itself
+  bool NeedSums() const { return need_sum_ || (need_mean_ && kSumIsDouble); }
+  bool NeedDoubleSums() const { return need_mean_ && !kSumIsDouble; }
+
+  template <typename OP>
+  static void UpdateExtremum(
+      const int64_t* groups, const T* values, int64_t length, std::vector<T>* state) {
+    T* out = state->data();
+    for (int64_t i = 0; i < length; ++i) {
+      const int64_t g = groups[i];
+      out[g] = OP::Apply(out[g], values[i]);
+    }
+  }
+
+  NumericRange<TYPE> range_;
+  std::vector<int64_t> counts_;
+  std::vector<sum_type> sums_;
+  std::vector<double> double_sums_;
+  std::vector<T> mins_;
+  std::vector<T> maxs_;
+  std::vector<double> means_;
+  std::vector<double> m2s_;
+};
+
+struct AccumulatorVisitor {
+  template <typename TYPE>
+  Status Visit(const ArrayView& view) {
+    out->reset(new TypedColumnAccumulator<TYPE>(view));
+    return Status::OK();
+  }
+
+  std::unique_ptr<ColumnAccumulator>* out;
+};
+
+// Writes the group of each row of labels[offset, offset + length), with
+// num_groups for rows belonging to no group
+Status MapGroups(const NumericRange<Int64Type>& labels, int64_t offset, int64_t length,
+    int64_t num_groups, int64_t* groups) {
+  const int64_t* values = labels.values + offset;
+  const uint8_t* valid_bits = labels.valid_bits;
+  const int64_t bit_offset = labels.bit_offset + offset;
+  bool out_of_range = false;
+  for (int64_t i = 0; i < length; ++i) {
+    const int64_t label = values[i];
+    const bool in_group = label >= 0 &&
+        (valid_bits == nullptr || BitUtil::GetBit(valid_bits, bit_offset + i));
+    out_of_range |= in_group & (label >= num_groups);
+    groups[i] = in_group ? label : num_groups;
+  }
+  if (out_of_range) { return Status::Invalid("groupby label out of range"); }
+  return Status::OK();
+}
+
+bool SameColumn(const ArrayView& left, const ArrayView& right) {
+  return left.data() == right.data() && left.offset() == right.offset() &&
+         left.length() == right.length();
+}
+
+}  // namespace
+
+Status GroupbyAggregate(const ArrayView& labels, int64_t num_groups,
+    const std::vector<GroupAggregate>& aggregates,
+    std::vector<std::shared_ptr<Array>>* out) {
+  if (!labels.data()) { return Status::Invalid("ArrayView does not reference an array"); }
+  if (labels.data()->type()->type() != DataType::INT64) {
+    return Status::Invalid("groupby labels must be int64");
+  }
+  if (num_groups < 0) { return Status::Invalid("num_groups must be non-negative"); }
+  const int64_t length = labels.length();
+
+  // One accumulator per distinct column, and the column of each aggregation
+  std::vector<std::unique_ptr<ColumnAccumulator>> columns;
+  std::vector<size_t> column_of(aggregates.size());
+  for (size_t i = 0; i < aggregates.size(); ++i) {
+    const GroupAggregate& aggregate = aggregates[i];
+    if (aggregate.values.length() != length) {
+      return Status::Invalid("groupby column length does not match the labels");
+    }
+    if (aggregate.op == GroupAggregateOp::VAR && aggregate.ddof < 0) {
+      return Status::Invalid("ddof must be non-negative");
+    }
+    size_t j = 0;
+    while (j < i && !SameColumn(aggregates[j].values, aggregate.values)) {
+      ++j;
+    }
+    if (j < i) {
+      column_of[i] = column_of[j];
+    } else {
+      std::unique_ptr<ColumnAccumulator> column;
+      AccumulatorVisitor visitor = {&column};
+      RETURN_NOT_OK(internal::VisitNumericView(aggregate.values, "groupby", &visitor));
+      column_of[i] = columns.size();
+      columns.push_back(std::move(column));
+    }
+    columns[column_of[i]]->Add(aggregate.op);
+  }
+  for (const auto& column : columns) {
+    RETURN_NOT_OK(column->Reserve(num_groups));
+  }
+
+  NumericRange<Int64Type> label_range(labels);
+  std::vector<int64_t> groups(kGroupbyBlockSize);
+  std::vector<int64_t> scratch(kGroupbyBlockSize);
+  for (int64_t offset = 0; offset < length; offset += kGroupbyBlockSize) {
+    const int64_t block_length = std::min(kGroupbyBlockSize, length - offset);
+    RETURN_NOT_OK(
+        MapGroups(label_range, offset, block_length, num_groups, groups.data()));
+    for (const auto& column : columns) {
+      column->Update(groups.data(), offset, block_length, scratch.data());
+    }
+  }
+
+  for (size_t i = 0; i < aggregates.size(); ++i) {
+    std::shared_ptr<Array> result;
+    RETURN_NOT_OK(columns[column_of[i]]->Finish(aggregates[i], num_groups, &result));
+    out->push_back(result);
+  }
+  return Status::OK();
+}
+
+}  // namespace pandas
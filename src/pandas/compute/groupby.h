@@ -0,0 +1,52 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Grouped reductions over numeric arrays, as in
+// df.groupby(key).agg({'a': ['sum', 'mean', 'max'], 'b': 'var'}).
+//
+// Rows are assigned to groups by int64 labels in [0, num_groups), such as the
+// codes produced by factorizing the grouping key. Rows with a negative or
+// null label belong to no group. Nulls are skipped as in the reductions of
+// reduce.h: integer arrays skip the values marked null in their validity
+// bitmap, floating point arrays skip NaN.
+//
+// All the requested aggregations are computed together in a single pass over
+// the rows. Aggregations of the same column share their accumulators, so
+// sum, mean and max of a column read it once rather than three times.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/type.h"
+
+namespace pandas {
+
+// The type of each result follows the corresponding reduction: COUNT is
+// int64, SUM accumulates signed (unsigned) integers in int64 (uint64) and
+// floating point values in double, MEAN and VAR are double, and MIN and MAX
+// have the type of the column.
+enum class GroupAggregateOp : int { COUNT, SUM, MEAN, MIN, MAX, VAR };
+
+struct PANDAS_EXPORT GroupAggregate {
+  ArrayView values;
+  GroupAggregateOp op;
+
+  // Delta degrees of freedom of VAR, whose divisor is (count - ddof)
+  int ddof;
+};
+
+// Appends to out one array of num_groups values per aggregation, in order. A
+// group with no non-null values has a SUM of 0, a NaN MEAN, and a MIN and MAX
+// that are null (NaN for floating point columns). Its VAR is NaN if it has at
+// most ddof values. labels must be int64 and every column must have its
+// length; a label of num_groups or more is an error
+PANDAS_EXPORT Status GroupbyAggregate(const ArrayView& labels, int64_t num_groups,
+    const std::vector<GroupAggregate>& aggregates,
+    std::vector<std::shared_ptr<Array>>* out);
+
+}  // namespace pandas
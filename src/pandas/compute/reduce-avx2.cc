@@ -0,0 +1,25 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// AVX2 variants of the reduction kernels. This translation unit is compiled
+// with -mavx2 and must only be entered after checking GetSimdLevel()
+
+#include <cstdint>
+
+#include "pandas/compute/reduce-internal.h"
+
+namespace pandas {
+
+namespace internal {
+
+template <typename T>
+const ReduceKernels<T>* GetAvx2ReduceKernels() {
+  static const ReduceKernels<T> kernels = MakeReduceKernels<T>();
+  return &kernels;
+}
+
+PANDAS_INSTANTIATE_REDUCE_KERNELS(GetAvx2ReduceKernels);
+
+}  // namespace internal
+
+}  // namespace pandas
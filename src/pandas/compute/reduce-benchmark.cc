@@ -0,0 +1,135 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/reduce.h"
+#include "pandas/types/numeric.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+constexpr int64_t kLength = 1 << 20;
+
+template <typename ArrayType>
+static std::shared_ptr<Array> MakeArray(
+    const std::shared_ptr<Buffer>& data, const std::shared_ptr<Buffer>& bitmap);
+
+template <>
+std::shared_ptr<Array> MakeArray<Int64Array>(
+    const std::shared_ptr<Buffer>& data, const std::shared_ptr<Buffer>& bitmap) {
+  return std::make_shared<Int64Array>(kLength, data, bitmap);
+}
+
+template <>
+std::shared_ptr<Array> MakeArray<Int32Array>(
+    const std::shared_ptr<Buffer>& data, const std::shared_ptr<Buffer>& bitmap) {
+  return std::make_shared<Int32Array>(kLength, data, bitmap);
+}
+
+template <>
+std::shared_ptr<Array> MakeArray<DoubleArray>(
+    const std::shared_ptr<Buffer>& data, const std::shared_ptr<Buffer>& bitmap) {
+  return std::make_shared<DoubleArray>(kLength, data);
+}
+
+// A 1M-value array; when null_probability > 0, integer arrays get a validity
+// bitmap and floating point arrays get NaNs
+template <typename ArrayType>
+static std::shared_ptr<Array> MakeArray(double null_probability) {
+  using T = typename ArrayType::T;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> values(-1000, 1000);
+  std::bernoulli_distribution is_null(null_probability);
+
+  auto data = std::make_shared<PoolBuffer>();
+  data->Resize(kLength * sizeof(T));
+  T* out = reinterpret_cast<T*>(data->mutable_data());
+
+  auto bitmap = std::make_shared<PoolBuffer>();
+  bitmap->Resize(BitUtil::BytesForBits(kLength));
+  memset(bitmap->mutable_data(), 0xFF, bitmap->size());
+
+  for (int64_t i = 0; i < kLength; ++i) {
+    out[i] = static_cast<T>(values(rng));
+    if (null_probability > 0 && is_null(rng)) {
+      if (std::is_floating_point<T>::value) {
+        out[i] = std::numeric_limits<T>::quiet_NaN();
+      } else {
+        BitUtil::ClearBit(bitmap->mutable_data(), i);
+      }
+    }
+  }
+  return MakeArray<ArrayType>(data, null_probability > 0 ? bitmap : nullptr);
+}
+
+// Arguments: SIMD level, null probability in percent
+template <typename ArrayType>
+static void BM_Sum(benchmark::State& state) {  // NOLINT non-const reference
+  SetSimdLevel(static_cast<SimdLevel>(state.range_x()));
+  ArrayView view(MakeArray<ArrayType>(state.range_y() / 100.0));
+  ReduceResult result;
+  while (state.KeepRunning()) {
+    Sum(view, &result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(
+      state.iterations() * kLength * sizeof(typename ArrayType::T));
+  SetSimdLevel(DetectSimdLevel());
+}
+
+template <typename ArrayType>
+static void BM_Max(benchmark::State& state) {  // NOLINT non-const reference
+  SetSimdLevel(static_cast<SimdLevel>(state.range_x()));
+  ArrayView view(MakeArray<ArrayType>(state.range_y() / 100.0));
+  ReduceResult result;
+  while (state.KeepRunning()) {
+    Max(view, &result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(
+      state.iterations() * kLength * sizeof(typename ArrayType::T));
+  SetSimdLevel(DetectSimdLevel());
+}
+
+template <typename ArrayType>
+static void BM_Var(benchmark::State& state) {  // NOLINT non-const reference
+  SetSimdLevel(static_cast<SimdLevel>(state.range_x()));
+  ArrayView view(MakeArray<ArrayType>(state.range_y() / 100.0));
+  double result;
+  while (state.KeepRunning()) {
+    Var(view, 1, &result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(
+      state.iterations() * kLength * sizeof(typename ArrayType::T));
+  SetSimdLevel(DetectSimdLevel());
+}
+
+static void ReduceArgs(benchmark::internal::Benchmark* bench) {
+  for (int level : {0, 1, 2}) {
+    for (int null_percent : {0, 10}) {
+      bench->ArgPair(level, null_percent);
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Sum, Int64Array)->Apply(ReduceArgs);
+BENCHMARK_TEMPLATE(BM_Sum, Int32Array)->Apply(ReduceArgs);
+BENCHMARK_TEMPLATE(BM_Sum, DoubleArray)->Apply(ReduceArgs);
+BENCHMARK_TEMPLATE(BM_Max, Int64Array)->Apply(ReduceArgs);
+BENCHMARK_TEMPLATE(BM_Max, DoubleArray)->Apply(ReduceArgs);
+BENCHMARK_TEMPLATE(BM_Var, DoubleArray)->Apply(ReduceArgs);
+
+}  // namespace pandas
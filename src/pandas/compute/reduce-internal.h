@@ -0,0 +1,269 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Reduction kernels shared by reduce.cc and reduce-avx2.cc. The kernel
+// templates are compiled once per instruction set, so they live in an
+// anonymous namespace and must not call out-of-line library code (which the
+// linker could resolve to a copy compiled for a different instruction set).
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace pandas {
+
+namespace internal {
+
+// Accumulator type of sums: signed and unsigned integers accumulate in 64 bits
+// of the same signedness (wrapping on overflow, like NumPy), floats in double
+template <typename T, typename Enable = void>
+struct SumType {
+  using type = double;
+};
+
+template <typename T>
+struct SumType<T, typename std::enable_if<std::is_integral<T>::value &&
+                                          std::is_signed<T>::value>::type> {
+  using type = int64_t;
+};
+
+template <typename T>
+struct SumType<T, typename std::enable_if<std::is_integral<T>::value &&
+                                          std::is_unsigned<T>::value>::type> {
+  using type = uint64_t;
+};
+
+// Kernels operate on a contiguous range of values, an optional validity
+// bitmap and the bit offset of the first value in that bitmap. NaN is treated
+// as null for floating point values.
+template <typename T>
+struct ReduceKernels {
+  using sum_type = typename SumType<T>::type;
+
+  void (*sum_count)(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+      int64_t length, sum_type* sum, int64_t* count);
+
+  // As sum_count, accumulating in double for means like NumPy, so that the
+  // sum of large integers does not wrap
+  void (*double_sum_count)(const T* values, const uint8_t* valid_bits,
+      int64_t bit_offset, int64_t length, double* sum, int64_t* count);
+
+  // These return the number of non-null values; *out is left untouched when
+  // there are none
+  int64_t (*min)(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+      int64_t length, T* out);
+  int64_t (*max)(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+      int64_t length, T* out);
+
+  // Sum of squared deviations from the mean
+  void (*sum_squares)(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+      int64_t length, double mean, double* out);
+};
+
+// Kernel tables for each instruction set, defined for every numeric c_type
+template <typename T>
+const ReduceKernels<T>* GetScalarReduceKernels();
+
+template <typename T>
+const ReduceKernels<T>* GetSse42ReduceKernels();
+
+template <typename T>
+const ReduceKernels<T>* GetAvx2ReduceKernels();
+
+namespace {
+
+// Values are processed in blocks of 64, one word of the validity bitmap, and
+// each block is split over independent accumulator lanes so that the compiler
+// can keep them in vector registers without reassociating floating point adds
+constexpr int64_t kBlockSize = 64;
+constexpr int kLanes = 8;
+
+template <typename T>
+inline bool IsNotNaN(T value) {
+  // Always true for integers; false for NaN
+  return value == value;
+}
+
+// Load 64 validity bits starting at an arbitrary bit offset. Only reads bytes
+// that contain some of the requested bits
+inline uint64_t LoadValidityWord(const uint8_t* valid_bits, int64_t bit_offset) {
+  const uint8_t* p = valid_bits + bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  uint64_t word;
+  memcpy(&word, p, sizeof(uint64_t));
+  if (shift != 0) {
+    word = (word >> shift) | (static_cast<uint64_t>(p[8]) << (64 - shift));
+  }
+  return word;
+}
+
+// Expand the 8 bits of a bitmap byte to 8 bytes that are each 0 or 1
+inline uint64_t ExpandBitsToBytes(uint32_t byte) {
+  // Replicate the byte, keep bit j in byte j, then carry any set bit into the
+  // high bit of its byte
+  const uint64_t spread = (byte * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+  return ((spread + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+}
+
+inline bool GetValidityBit(const uint8_t* valid_bits, int64_t i) {
+  return (valid_bits[i / 8] >> (i % 8)) & 1;
+}
+
+// Calls visit(lane, value, is_valid) for every value in the range
+template <typename T, typename VISITOR>
+inline void VisitLanes(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+    int64_t length, VISITOR&& visit) {
+  int64_t i = 0;
+  if (valid_bits == nullptr) {
+    for (; i + kLanes <= length; i += kLanes) {
+      for (int j = 0; j < kLanes; ++j) {
+        const T value = values[i + j];
+        visit(j, value, IsNotNaN(value));
+      }
+    }
+  } else {
+    for (; i + kBlockSize <= length; i += kBlockSize) {
+      const uint64_t word = LoadValidityWord(valid_bits, bit_offset + i);
+      if (word == ~static_cast<uint64_t>(0)) {
+        for (int64_t k = 0; k < kBlockSize; k += kLanes) {
+          for (int j = 0; j < kLanes; ++j) {
+            const T value = values[i + k + j];
+            visit(j, value, IsNotNaN(value));
+          }
+        }
+      } else if (word != 0) {
+        // Spread the bits over one byte per value so that the lane loop reads
+        // its validity like any other vector operand
+        uint8_t is_valid[kBlockSize];
+        for (int64_t k = 0; k < kBlockSize; k += 8) {
+          const uint64_t bytes =
+              ExpandBitsToBytes(static_cast<uint32_t>(word >> k) & 0xFF);
+          memcpy(is_valid + k, &bytes, sizeof(uint64_t));
+        }
+        for (int64_t k = 0; k < kBlockSize; k += kLanes) {
+          for (int j = 0; j < kLanes; ++j) {
+            const T value = values[i + k + j];
+            visit(j, value, (is_valid[k + j] != 0) & IsNotNaN(value));
+          }
+        }
+      }
+    }
+  }
+  for (; i < length; ++i) {
+    const T value = values[i];
+    const bool bit =
+        valid_bits == nullptr || GetValidityBit(valid_bits, bit_offset + i);
+    visit(0, value, bit & IsNotNaN(value));
+  }
+}
+
+template <typename T, typename sum_type>
+void SumCountKernel(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+    int64_t length, sum_type* out_sum, int64_t* out_count) {
+  sum_type sums[kLanes] = {};
+  int64_t counts[kLanes] = {};
+  VisitLanes(values, valid_bits, bit_offset, length,
+      [&sums, &counts](int lane, T value, bool is_valid) {
+        sums[lane] += is_valid ? static_cast<sum_type>(value) : sum_type(0);
+        counts[lane] += is_valid;
+      });
+  sum_type sum = 0;
+  int64_t count = 0;
+  for (int j = 0; j < kLanes; ++j) {
+    sum += sums[j];
+    count += counts[j];
+  }
+  *out_sum = sum;
+  *out_count = count;
+}
+
+template <typename T>
+struct MinOp {
+  static constexpr T identity() {
+    return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                : std::numeric_limits<T>::max();
+  }
+  // NaN compares false and so never replaces the current value
+  static T Apply(T current, T value) { return value < current ? value : current; }
+};
+
+template <typename T>
+struct MaxOp {
+  static constexpr T identity() {
+    return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                : std::numeric_limits<T>::lowest();
+  }
+  static T Apply(T current, T value) { return value > current ? value : current; }
+};
+
+template <typename T, typename OP>
+int64_t ExtremumKernel(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+    int64_t length, T* out) {
+  T extrema[kLanes];
+  int64_t counts[kLanes] = {};
+  for (int j = 0; j < kLanes; ++j) {
+    extrema[j] = OP::identity();
+  }
+  VisitLanes(values, valid_bits, bit_offset, length,
+      [&extrema, &counts](int lane, T value, bool is_valid) {
+        extrema[lane] = is_valid ? OP::Apply(extrema[lane], value) : extrema[lane];
+        counts[lane] += is_valid;
+      });
+  T result = OP::identity();
+  int64_t count = 0;
+  for (int j = 0; j < kLanes; ++j) {
+    result = OP::Apply(result, extrema[j]);
+    count += counts[j];
+  }
+  if (count > 0) { *out = result; }
+  return count;
+}
+
+template <typename T>
+void SumSquaresKernel(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+    int64_t length, double mean, double* out) {
+  double sums[kLanes] = {};
+  VisitLanes(values, valid_bits, bit_offset, length,
+      [&sums, mean](int lane, T value, bool is_valid) {
+        const double deviation = static_cast<double>(value) - mean;
+        sums[lane] += is_valid ? deviation * deviation : 0.0;
+      });
+  double sum = 0;
+  for (int j = 0; j < kLanes; ++j) {
+    sum += sums[j];
+  }
+  *out = sum;
+}
+
+template <typename T>
+ReduceKernels<T> MakeReduceKernels() {
+  ReduceKernels<T> kernels;
+  kernels.sum_count = &SumCountKernel<T, typename SumType<T>::type>;
+  kernels.double_sum_count = &SumCountKernel<T, double>;
+  kernels.min = &ExtremumKernel<T, MinOp<T>>;
+  kernels.max = &ExtremumKernel<T, MaxOp<T>>;
+  kernels.sum_squares = &SumSquaresKernel<T>;
+  return kernels;
+}
+
+}  // namespace
+
+// Explicitly instantiate a kernel table getter for every numeric c_type
+#define PANDAS_INSTANTIATE_REDUCE_KERNELS(GETTER)             \
+  template const ReduceKernels<int8_t>* GETTER<int8_t>();     \
+  template const ReduceKernels<uint8_t>* GETTER<uint8_t>();   \
+  template const ReduceKernels<int16_t>* GETTER<int16_t>();   \
+  template const ReduceKernels<uint16_t>* GETTER<uint16_t>(); \
+  template const ReduceKernels<int32_t>* GETTER<int32_t>();   \
+  template const ReduceKernels<uint32_t>* GETTER<uint32_t>(); \
+  template const ReduceKernels<int64_t>* GETTER<int64_t>();   \
+  template const ReduceKernels<uint64_t>* GETTER<uint64_t>(); \
+  template const ReduceKernels<float>* GETTER<float>();       \
+  template const ReduceKernels<double>* GETTER<double>()
+
+}  // namespace internal
+
+}  // namespace pandas
@@ -0,0 +1,235 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/reduce.h"
+#include "pandas/test-util.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+// Runs every test at each SIMD level supported by the host
+class TestReduce : public ::testing::TestWithParam<SimdLevel> {
+ public:
+  void SetUp() {
+    if (static_cast<int>(GetParam()) > static_cast<int>(DetectSimdLevel())) {
+      skip_ = true;
+    }
+    SetSimdLevel(GetParam());
+  }
+
+  void TearDown() { SetSimdLevel(DetectSimdLevel()); }
+
+  // 200 values so that full bitmap words, partial words and the tail are all
+  // exercised; every third value is null
+  void MakeInt64Array() {
+    int64_values_.clear();
+    std::vector<bool> is_valid;
+    for (int64_t i = 0; i < 200; ++i) {
+      int64_values_.push_back(i % 2 == 0 ? i : -i);
+      is_valid.push_back(i % 3 != 0);
+    }
+    is_valid_ = is_valid;
+    int64_array_ = std::make_shared<Int64Array>(int64_values_.size(),
+        BufferFromVector(int64_values_), BitmapFromVector(is_valid));
+  }
+
+ protected:
+  bool skip_ = false;
+  std::vector<int64_t> int64_values_;
+  std::vector<bool> is_valid_;
+  std::shared_ptr<Array> int64_array_;
+};
+
+TEST_P(TestReduce, IntegerWithNulls) {
+  if (skip_) { return; }
+  MakeInt64Array();
+
+  // Check several offsets so that the bitmap is read unaligned
+  for (int64_t offset : {0, 1, 7, 8, 13, 64, 150}) {
+    ArrayView view(int64_array_, offset);
+
+    int64_t ex_sum = 0;
+    int64_t ex_count = 0;
+    int64_t ex_min = std::numeric_limits<int64_t>::max();
+    int64_t ex_max = std::numeric_limits<int64_t>::min();
+    for (size_t i = offset; i < int64_values_.size(); ++i) {
+      if (!is_valid_[i]) { continue; }
+      ex_sum += int64_values_[i];
+      ++ex_count;
+      ex_min = std::min(ex_min, int64_values_[i]);
+      ex_max = std::max(ex_max, int64_values_[i]);
+    }
+    double ex_mean = static_cast<double>(ex_sum) / ex_count;
+    double ex_var = 0;
+    for (size_t i = offset; i < int64_values_.size(); ++i) {
+      if (!is_valid_[i]) { continue; }
+      ex_var += (int64_values_[i] - ex_mean) * (int64_values_[i] - ex_mean);
+    }
+    ex_var /= (ex_count - 1);
+
+    int64_t count;
+    ASSERT_OK(Count(view, &count));
+    ASSERT_EQ(ex_count, count);
+
+    ReduceResult result;
+    ASSERT_OK(Sum(view, &result));
+    ASSERT_EQ(DataType::INT64, result.type);
+    ASSERT_FALSE(result.is_null);
+    ASSERT_EQ(ex_sum, result.value.int64);
+
+    ASSERT_OK(Min(view, &result));
+    ASSERT_EQ(ex_min, result.value.int64);
+    ASSERT_OK(Max(view, &result));
+    ASSERT_EQ(ex_max, result.value.int64);
+
+    double mean;
+    ASSERT_OK(Mean(view, &mean));
+    ASSERT_DOUBLE_EQ(ex_mean, mean);
+
+    double var;
+    ASSERT_OK(Var(view, 1, &var));
+    ASSERT_NEAR(ex_var, var, 1e-9 * ex_var);
+  }
+}
+
+TEST_P(TestReduce, AllNull) {
+  if (skip_) { return; }
+  std::vector<int32_t> values(100, 5);
+  std::vector<bool> is_valid(100, false);
+  auto arr = std::make_shared<Int32Array>(
+      values.size(), BufferFromVector(values), BitmapFromVector(is_valid));
+  ArrayView view(arr);
+
+  ReduceResult result;
+  ASSERT_OK(Sum(view, &result));
+  ASSERT_FALSE(result.is_null);
+  ASSERT_EQ(0, result.value.int64);
+
+  ASSERT_OK(Min(view, &result));
+  ASSERT_TRUE(result.is_null);
+  ASSERT_OK(Max(view, &result));
+  ASSERT_TRUE(result.is_null);
+
+  double mean;
+  ASSERT_OK(Mean(view, &mean));
+  ASSERT_TRUE(std::isnan(mean));
+}
+
+TEST_P(TestReduce, UnsignedWithoutBitmap) {
+  if (skip_) { return; }
+  std::vector<uint8_t> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(static_cast<uint8_t>(i));
+  }
+  auto arr = std::make_shared<UInt8Array>(values.size(), BufferFromVector(values));
+  ArrayView view(arr, 3, 990);
+
+  uint64_t ex_sum = 0;
+  for (int i = 3; i < 993; ++i) {
+    ex_sum += values[i];
+  }
+
+  ReduceResult result;
+  ASSERT_OK(Sum(view, &result));
+  ASSERT_EQ(DataType::UINT64, result.type);
+  ASSERT_EQ(ex_sum, result.value.uint64);
+
+  ASSERT_OK(Max(view, &result));
+  ASSERT_EQ(255, result.value.uint64);
+  ASSERT_OK(Min(view, &result));
+  ASSERT_EQ(0, result.value.uint64);
+}
+
+TEST_P(TestReduce, FloatingSkipsNaN) {
+  if (skip_) { return; }
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> values;
+  double ex_sum = 0;
+  int64_t ex_count = 0;
+  for (int i = 0; i < 101; ++i) {
+    if (i % 4 == 1) {
+      values.push_back(nan);
+    } else {
+      values.push_back(i * 0.5);
+      ex_sum += i * 0.5;
+      ++ex_count;
+    }
+  }
+  auto arr = std::make_shared<DoubleArray>(values.size(), BufferFromVector(values));
+  ArrayView view(arr);
+
+  int64_t count;
+  ASSERT_OK(Count(view, &count));
+  ASSERT_EQ(ex_count, count);
+
+  ReduceResult result;
+  ASSERT_OK(Sum(view, &result));
+  ASSERT_EQ(DataType::FLOAT64, result.type);
+  ASSERT_DOUBLE_EQ(ex_sum, result.value.float64);
+
+  ASSERT_OK(Min(view, &result));
+  ASSERT_EQ(0, result.value.float64);
+  ASSERT_OK(Max(view, &result));
+  ASSERT_EQ(50, result.value.float64);
+
+  // All NaN
+  std::vector<float> nans(20, std::numeric_limits<float>::quiet_NaN());
+  auto nan_arr = std::make_shared<FloatArray>(nans.size(), BufferFromVector(nans));
+  ASSERT_OK(Max(ArrayView(nan_arr), &result));
+  ASSERT_TRUE(result.is_null);
+  ASSERT_OK(Count(ArrayView(nan_arr), &count));
+  ASSERT_EQ(0, count);
+}
+
+TEST_P(TestReduce, VarianceDdof) {
+  if (skip_) { return; }
+  std::vector<double> values = {1, 2, 3, 4};
+  auto arr = std::make_shared<DoubleArray>(values.size(), BufferFromVector(values));
+
+  double var;
+  ASSERT_OK(Var(ArrayView(arr), 0, &var));
+  ASSERT_DOUBLE_EQ(1.25, var);
+  ASSERT_OK(Var(ArrayView(arr), 1, &var));
+  ASSERT_DOUBLE_EQ(5.0 / 3, var);
+  ASSERT_OK(Var(ArrayView(arr), 4, &var));
+  ASSERT_TRUE(std::isnan(var));
+}
+
+TEST_P(TestReduce, LargeIntegerMean) {
+  if (skip_) { return; }
+  // The int64 sum of these wraps, the double sum does not
+  const int64_t big = std::numeric_limits<int64_t>::max();
+  std::vector<int64_t> values(100, big);
+  auto arr = std::make_shared<Int64Array>(values.size(), BufferFromVector(values));
+
+  double mean;
+  ASSERT_OK(Mean(ArrayView(arr), &mean));
+  ASSERT_DOUBLE_EQ(static_cast<double>(big), mean);
+  double var;
+  ASSERT_OK(Var(ArrayView(arr), 1, &var));
+  ASSERT_EQ(0, var);
+
+  std::vector<uint64_t> unsigned_values(100, std::numeric_limits<uint64_t>::max());
+  auto unsigned_arr = std::make_shared<UInt64Array>(
+      unsigned_values.size(), BufferFromVector(unsigned_values));
+  ASSERT_OK(Mean(ArrayView(unsigned_arr), &mean));
+  ASSERT_DOUBLE_EQ(static_cast<double>(std::numeric_limits<uint64_t>::max()), mean);
+}
+
+INSTANTIATE_TEST_CASE_P(SimdLevels, TestReduce,
+    ::testing::Values(SimdLevel::NONE, SimdLevel::SSE4_2, SimdLevel::AVX2));
+
+}  // namespace pandas
@@ -0,0 +1,285 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "pandas/compute/reduce.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "pandas/common.h"
+#include "pandas/compute/reduce-internal.h"
+#include "pandas/compute/visit-internal.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+namespace internal {
+
+// ----------------------------------------------------------------------
+// Scalar kernels: one value per iteration, for CPUs without SSE4.2 and as a
+// baseline for benchmarking
+
+namespace {
+
+template <typename T>
+inline bool ScalarIsValid(
+    const T* values, const uint8_t* valid_bits, int64_t bit_offset, int64_t i) {
+  if (valid_bits != nullptr && BitUtil::BitNotSet(valid_bits, bit_offset + i)) {
+    return false;
+  }
+  return IsNotNaN(values[i]);
+}
+
+template <typename T, typename sum_type>
+void ScalarSumCount(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+    int64_t length, sum_type* out_sum, int64_t* out_count) {
+  sum_type sum = 0;
+  int64_t count = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (!ScalarIsValid(values, valid_bits, bit_offset, i)) { continue; }
+    sum += values[i];
+    ++count;
+  }
+  *out_sum = sum;
+  *out_count = count;
+}
+
+template <typename T, typename OP>
+int64_t ScalarExtremum(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+    int64_t length, T* out) {
+  T result = OP::identity();
+  int64_t count = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (!ScalarIsValid(values, valid_bits, bit_offset, i)) { continue; }
+    result = OP::Apply(result, values[i]);
+    ++count;
+  }
+  if (count > 0) { *out = result; }
+  return count;
+}
+
+template <typename T>
+void ScalarSumSquares(const T* values, const uint8_t* valid_bits, int64_t bit_offset,
+    int64_t length, double mean, double* out) {
+  double sum = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (!ScalarIsValid(values, valid_bits, bit_offset, i)) { continue; }
+    const double deviation = static_cast<double>(values[i]) - mean;
+    sum += deviation * deviation;
+  }
+  *out = sum;
+}
+
+}  // namespace
+
+template <typename T>
+const ReduceKernels<T>* GetScalarReduceKernels() {
+  static const ReduceKernels<T> kernels = {
+      &ScalarSumCount<T, typename SumType<T>::type>, &ScalarSumCount<T, double>,
+      &ScalarExtremum<T, MinOp<T>>, &ScalarExtremum<T, MaxOp<T>>,
+      &ScalarSumSquares<T>};
+  return &kernels;
+}
+
+// The library baseline is SSE4.2 (-msse4.2), so the shared kernels compiled
+// in this translation unit are the SSE4.2 variants
+template <typename T>
+const ReduceKernels<T>* GetSse42ReduceKernels() {
+  static const ReduceKernels<T> kernels = MakeReduceKernels<T>();
+  return &kernels;
+}
+
+PANDAS_INSTANTIATE_REDUCE_KERNELS(GetScalarReduceKernels);
+PANDAS_INSTANTIATE_REDUCE_KERNELS(GetSse42ReduceKernels);
+
+}  // namespace internal
+
+// ----------------------------------------------------------------------
+// Kernel and type dispatch
+
+namespace {
+
+template <typename T>
+const internal::ReduceKernels<T>& GetReduceKernels() {
+  switch (GetSimdLevel()) {
+    case SimdLevel::AVX2:
+      return *internal::GetAvx2ReduceKernels<T>();
+    case SimdLevel::SSE4_2:
+      return *internal::GetSse42ReduceKernels<T>();
+    default:
+      return *internal::GetScalarReduceKernels<T>();
+  }
+}
+
+using internal::NumericRange;
+
+void SetResult(int64_t value, ReduceResult* out) {
+  out->type = DataType::INT64;
+  out->is_null = false;
+  out->value.int64 = value;
+}
+
+void SetResult(uint64_t value, ReduceResult* out) {
+  out->type = DataType::UINT64;
+  out->is_null = false;
+  out->value.uint64 = value;
+}
+
+void SetResult(double value, ReduceResult* out) {
+  out->type = DataType::FLOAT64;
+  out->is_null = false;
+  out->value.float64 = value;
+}
+
+template <typename TYPE>
+void SumCount(const ArrayView& view,
+    typename internal::SumType<typename TYPE::c_type>::type* sum, int64_t* count) {
+  using T = typename TYPE::c_type;
+  NumericRange<TYPE> range(view);
+  GetReduceKernels<T>().sum_count(
+      range.values, range.valid_bits, range.bit_offset, range.length, sum, count);
+}
+
+template <typename TYPE>
+void ComputeMean(const ArrayView& view, double* mean, int64_t* count) {
+  using T = typename TYPE::c_type;
+  NumericRange<TYPE> range(view);
+  double sum;
+  GetReduceKernels<T>().double_sum_count(
+      range.values, range.valid_bits, range.bit_offset, range.length, &sum, count);
+  *mean = *count > 0 ? sum / *count : std::numeric_limits<double>::quiet_NaN();
+}
+
+struct CountVisitor {
+  template <typename TYPE>
+  Status Visit(const ArrayView& view) {
+    typename internal::SumType<typename TYPE::c_type>::type sum;
+    SumCount<TYPE>(view, &sum, out);
+    return Status::OK();
+  }
+
+  int64_t* out;
+};
+
+struct SumVisitor {
+  template <typename TYPE>
+  Status Visit(const ArrayView& view) {
+    typename internal::SumType<typename TYPE::c_type>::type sum;
+    int64_t count;
+    SumCount<TYPE>(view, &sum, &count);
+    SetResult(sum, out);
+    return Status::OK();
+  }
+
+  ReduceResult* out;
+};
+
+struct MeanVisitor {
+  template <typename TYPE>
+  Status Visit(const ArrayView& view) {
+    int64_t count;
+    ComputeMean<TYPE>(view, out, &count);
+    return Status::OK();
+  }
+
+  double* out;
+};
+
+template <bool IS_MIN>
+struct ExtremumVisitor {
+  template <typename TYPE>
+  Status Visit(const ArrayView& view) {
+    using T = typename TYPE::c_type;
+    using sum_type = typename internal::SumType<T>::type;
+    const auto& kernels = GetReduceKernels<T>();
+    auto kernel = IS_MIN ? kernels.min : kernels.max;
+
+    NumericRange<TYPE> range(view);
+    T value;
+    int64_t count =
+        kernel(range.values, range.valid_bits, range.bit_offset, range.length, &value);
+    SetResult(static_cast<sum_type>(count > 0 ? value : T(0)), out);
+    out->is_null = count == 0;
+    return Status::OK();
+  }
+
+  ReduceResult* out;
+};
+
+struct VarVisitor {
+  template <typename TYPE>
+  Status Visit(const ArrayView& view) {
+    using T = typename TYPE::c_type;
+    double mean;
+    int64_t count;
+    ComputeMean<TYPE>(view, &mean, &count);
+    if (count <= ddof) {
+      *out = std::numeric_limits<double>::quiet_NaN();
+      return Status::OK();
+    }
+
+    NumericRange<TYPE> range(view);
+    double sum_squares;
+    GetReduceKernels<T>().sum_squares(range.values, range.valid_bits, range.bit_offset,
+        range.length, mean, &sum_squares);
+    *out = sum_squares / (count - ddof);
+    return Status::OK();
+  }
+
+  int ddof;
+  double* out;
+};
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Public API
+
+double ReduceResult::as_double() const {
+  if (is_null) { return std::numeric_limits<double>::quiet_NaN(); }
+  switch (type) {
+    case DataType::INT64:
+      return static_cast<double>(value.int64);
+    case DataType::UINT64:
+      return static_cast<double>(value.uint64);
+    default:
+      return value.float64;
+  }
+}
+
+Status Count(const ArrayView& values, int64_t* out) {
+  CountVisitor visitor = {out};
+  return internal::VisitNumericView(values, "reductions", &visitor);
+}
+
+Status Sum(const ArrayView& values, ReduceResult* out) {
+  SumVisitor visitor = {out};
+  return internal::VisitNumericView(values, "reductions", &visitor);
+}
+
+Status Mean(const ArrayView& values, double* out) {
+  MeanVisitor visitor = {out};
+  return internal::VisitNumericView(values, "reductions", &visitor);
+}
+
+Status Min(const ArrayView& values, ReduceResult* out) {
+  ExtremumVisitor<true> visitor = {out};
+  return internal::VisitNumericView(values, "reductions", &visitor);
+}
+
+Status Max(const ArrayView& values, ReduceResult* out) {
+  ExtremumVisitor<false> visitor = {out};
+  return internal::VisitNumericView(values, "reductions", &visitor);
+}
+
+Status Var(const ArrayView& values, int ddof, double* out) {
+  if (ddof < 0) { return Status::Invalid("ddof must be non-negative"); }
+  VarVisitor visitor = {ddof, out};
+  return internal::VisitNumericView(values, "reductions", &visitor);
+}
+
+}  // namespace pandas
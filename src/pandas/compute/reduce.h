@@ -0,0 +1,53 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Null-aware reductions over numeric arrays. Integer arrays skip the values
+// marked null in their validity bitmap, floating point arrays skip NaN.
+
+#pragma once
+
+#include <cstdint>
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/type.h"
+
+namespace pandas {
+
+// The result of a reduction. Sums of signed (unsigned) integers accumulate in
+// int64 (uint64) and wrap on overflow like NumPy, min and max preserve the
+// signedness of integer input, and all other results are double.
+struct PANDAS_EXPORT ReduceResult {
+  DataType::TypeId type;
+
+  // Set when there were no non-null values to reduce
+  bool is_null;
+
+  union {
+    int64_t int64;
+    uint64_t uint64;
+    double float64;
+  } value;
+
+  double as_double() const;
+};
+
+// Number of non-null values
+PANDAS_EXPORT Status Count(const ArrayView& values, int64_t* out);
+
+// The sum of an array with no non-null values is 0
+PANDAS_EXPORT Status Sum(const ArrayView& values, ReduceResult* out);
+
+// Accumulated in double like NumPy, so integer means do not wrap. NaN if
+// there are no non-null values
+PANDAS_EXPORT Status Mean(const ArrayView& values, double* out);
+
+// Null if there are no non-null values
+PANDAS_EXPORT Status Min(const ArrayView& values, ReduceResult* out);
+PANDAS_EXPORT Status Max(const ArrayView& values, ReduceResult* out);
+
+// Variance with divisor (count - ddof), computed with a second pass over the
+// data for accuracy. NaN if count <= ddof
+PANDAS_EXPORT Status Var(const ArrayView& values, int ddof, double* out);
+
+}  // namespace pandas
@@ -0,0 +1,118 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/strings.h"
+#include "pandas/types/string.h"
+
+namespace pandas {
+
+constexpr int64_t kLength = 1 << 20;
+
+// A 1M-value array of ASCII words of 4 to 16 letters, about 10% of them null
+static std::shared_ptr<Array> MakeStringArray(uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> value_length(4, 16);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::bernoulli_distribution is_null(0.1);
+
+  auto offsets = std::make_shared<PoolBuffer>();
+  offsets->Resize((kLength + 1) * sizeof(int32_t));
+  int32_t* out_offsets = reinterpret_cast<int32_t*>(offsets->mutable_data());
+  auto bitmap = std::make_shared<PoolBuffer>();
+  bitmap->Resize(BitUtil::BytesForBits(kLength));
+  memset(bitmap->mutable_data(), 0xFF, bitmap->size());
+  std::string bytes;
+  for (int64_t i = 0; i < kLength; ++i) {
+    out_offsets[i] = static_cast<int32_t>(bytes.size());
+    for (int k = value_length(rng); k > 0; --k) {
+      bytes += static_cast<char>(letter(rng));
+    }
+    if (is_null(rng)) { BitUtil::ClearBit(bitmap->mutable_data(), i); }
+  }
+  out_offsets[kLength] = static_cast<int32_t>(bytes.size());
+
+  auto data = std::make_shared<PoolBuffer>();
+  data->Resize(bytes.size());
+  memcpy(data->mutable_data(), bytes.data(), bytes.size());
+  return std::make_shared<StringArray>(kLength, offsets, data, bitmap);
+}
+
+static void BM_StringEqual(benchmark::State& state) {  // NOLINT non-const reference
+  ArrayView strings(MakeStringArray(1));
+  PoolBuffer values;
+  PoolBuffer valid_bits;
+  values.Resize(BitUtil::BytesForBits(kLength));
+  valid_bits.Resize(BitUtil::BytesForBits(kLength));
+  while (state.KeepRunning()) {
+    StringCompare(CompareOp::EQUAL, strings, "pandas", &values, &valid_bits);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+// Argument: the MatchOp
+static void BM_StringMatch(benchmark::State& state) {  // NOLINT non-const reference
+  ArrayView strings(MakeStringArray(2));
+  const auto op = static_cast<MatchOp>(state.range_x());
+  PoolBuffer values;
+  PoolBuffer valid_bits;
+  values.Resize(BitUtil::BytesForBits(kLength));
+  valid_bits.Resize(BitUtil::BytesForBits(kLength));
+  while (state.KeepRunning()) {
+    StringMatch(op, strings, "pan", &values, &valid_bits);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+static void BM_StringLength(benchmark::State& state) {  // NOLINT non-const reference
+  ArrayView strings(MakeStringArray(3));
+  std::shared_ptr<Array> out;
+  while (state.KeepRunning()) {
+    StringLength(strings, &out);
+    benchmark::DoNotOptimize(out.get());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+static void BM_StringUpper(benchmark::State& state) {  // NOLINT non-const reference
+  ArrayView strings(MakeStringArray(4));
+  std::shared_ptr<Array> out;
+  while (state.KeepRunning()) {
+    StringUpper(strings, &out);
+    benchmark::DoNotOptimize(out.get());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+static void BM_StringHash(benchmark::State& state) {  // NOLINT non-const reference
+  ArrayView strings(MakeStringArray(5));
+  PoolBuffer hashes;
+  hashes.Resize(kLength * sizeof(uint64_t));
+  while (state.KeepRunning()) {
+    StringHash(strings, &hashes);
+    benchmark::DoNotOptimize(hashes.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+BENCHMARK(BM_StringEqual);
+BENCHMARK(BM_StringMatch)
+    ->Arg(static_cast<int>(MatchOp::STARTS_WITH))
+    ->Arg(static_cast<int>(MatchOp::ENDS_WITH))
+    ->Arg(static_cast<int>(MatchOp::CONTAINS));
+BENCHMARK(BM_StringLength);
+BENCHMARK(BM_StringUpper);
+BENCHMARK(BM_StringHash);
+
+}  // namespace pandas
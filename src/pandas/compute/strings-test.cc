@@ -0,0 +1,277 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/strings.h"
+#include "pandas/test-util.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+#include "pandas/types/string.h"
+#include "pandas/util/hash-util.h"
+
+namespace pandas {
+
+// Null values are stored as empty strings
+static std::shared_ptr<StringArray> MakeStringArray(
+    const std::vector<std::string>& values, const std::vector<bool>& is_null) {
+  auto offsets = std::make_shared<PoolBuffer>();
+  auto data = std::make_shared<PoolBuffer>();
+  auto bitmap = std::make_shared<PoolBuffer>();
+  const int64_t length = values.size();
+  EXPECT_OK(offsets->Resize((length + 1) * sizeof(int32_t)));
+  EXPECT_OK(bitmap->Resize(BitUtil::BytesForBits(length)));
+  memset(bitmap->mutable_data(), 0xFF, bitmap->size());
+
+  std::string bytes;
+  auto offset_values = reinterpret_cast<int32_t*>(offsets->mutable_data());
+  for (int64_t i = 0; i < length; ++i) {
+    offset_values[i] = static_cast<int32_t>(bytes.size());
+    if (is_null[i]) {
+      BitUtil::ClearBit(bitmap->mutable_data(), i);
+    } else {
+      bytes += values[i];
+    }
+  }
+  offset_values[length] = static_cast<int32_t>(bytes.size());
+  EXPECT_OK(data->Resize(bytes.size()));
+  memcpy(data->mutable_data(), bytes.data(), bytes.size());
+  return std::make_shared<StringArray>(length, offsets, data, bitmap);
+}
+
+static std::string ValueAt(const StringArray& arr, int64_t i) {
+  int32_t length;
+  const uint8_t* value = arr.GetValue(i, &length);
+  return std::string(reinterpret_cast<const char*>(value), length);
+}
+
+// Random lowercase values drawn from a small alphabet, so that matches and
+// ties are common
+static void MakeRandomValues(int64_t length, uint32_t seed,
+    std::vector<std::string>* values, std::vector<bool>* is_null) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> value_length(0, 12);
+  std::uniform_int_distribution<int> letter(0, 2);
+  std::bernoulli_distribution null(0.1);
+  for (int64_t i = 0; i < length; ++i) {
+    std::string value;
+    for (int k = value_length(rng); k > 0; --k) {
+      value += static_cast<char>('a' + letter(rng));
+    }
+    values->push_back(value);
+    is_null->push_back(null(rng));
+  }
+}
+
+TEST(StringKernelTests, Length) {
+  auto arr = MakeStringArray({"foo", "", "b\xc3\xa4r", "x", "\xe2\x82\xac"},
+      {false, false, false, true, false});
+  std::shared_ptr<Array> result;
+  ASSERT_OK(StringLength(ArrayView(arr), &result));
+  ASSERT_EQ(DataType::INT64, result->type_id());
+  auto lengths = std::static_pointer_cast<Int64Array>(result);
+  ASSERT_EQ(3, lengths->data()[0]);
+  ASSERT_EQ(0, lengths->data()[1]);
+  ASSERT_EQ(3, lengths->data()[2]);
+  ASSERT_EQ(1, lengths->data()[4]);
+  ASSERT_EQ(1, lengths->GetNullCount());
+  ASSERT_TRUE(BitUtil::BitNotSet(lengths->valid_bits()->data(), 3));
+
+  ASSERT_OK(StringLength(ArrayView(arr, 2, 3), &result));
+  lengths = std::static_pointer_cast<Int64Array>(result);
+  ASSERT_EQ(3, result->length());
+  ASSERT_EQ(3, lengths->data()[0]);
+  ASSERT_EQ(1, lengths->data()[2]);
+  ASSERT_EQ(1, lengths->GetNullCount());
+}
+
+TEST(StringKernelTests, CompareScalar) {
+  std::vector<std::string> values;
+  std::vector<bool> is_null;
+  MakeRandomValues(1000, 1, &values, &is_null);
+  auto arr = MakeStringArray(values, is_null);
+
+  const std::string scalar = "abc";
+  for (int64_t offset : {0, 3}) {
+    ArrayView view(arr, offset);
+    for (CompareOp op : {CompareOp::EQUAL, CompareOp::NOT_EQUAL, CompareOp::LESS,
+             CompareOp::LESS_EQUAL, CompareOp::GREATER, CompareOp::GREATER_EQUAL}) {
+      std::shared_ptr<Buffer> result;
+      std::shared_ptr<Buffer> valid_bits;
+      ASSERT_OK(StringCompare(op, view, scalar, &result, &valid_bits));
+      for (int64_t i = 0; i < view.length(); ++i) {
+        const int64_t j = offset + i;
+        bool expected = false;
+        switch (op) {
+          case CompareOp::EQUAL:
+            expected = values[j] == scalar;
+            break;
+          case CompareOp::NOT_EQUAL:
+            expected = values[j] != scalar;
+            break;
+          case CompareOp::LESS:
+            expected = values[j] < scalar;
+            break;
+          case CompareOp::LESS_EQUAL:
+            expected = values[j] <= scalar;
+            break;
+          case CompareOp::GREATER:
+            expected = values[j] > scalar;
+            break;
+          case CompareOp::GREATER_EQUAL:
+            expected = values[j] >= scalar;
+            break;
+        }
+        ASSERT_EQ(!is_null[j], BitUtil::GetBit(valid_bits->data(), i));
+        ASSERT_EQ(expected && !is_null[j], BitUtil::GetBit(result->data(), i));
+      }
+    }
+  }
+}
+
+TEST(StringKernelTests, CompareOrdersByCodePoint) {
+  // U+00E4 sorts after every ASCII character
+  auto arr = MakeStringArray({"b\xc3\xa4", "bz", "b"}, {false, false, false});
+  std::shared_ptr<Buffer> result;
+  std::shared_ptr<Buffer> valid_bits;
+  ASSERT_OK(StringCompare(CompareOp::GREATER, ArrayView(arr), "bz", &result, &valid_bits));
+  ASSERT_TRUE(BitUtil::GetBit(result->data(), 0));
+  ASSERT_FALSE(BitUtil::GetBit(result->data(), 1));
+  ASSERT_FALSE(BitUtil::GetBit(result->data(), 2));
+}
+
+TEST(StringKernelTests, Match) {
+  std::vector<std::string> values;
+  std::vector<bool> is_null;
+  MakeRandomValues(1000, 2, &values, &is_null);
+  auto arr = MakeStringArray(values, is_null);
+
+  const std::vector<std::string> patterns = {"a", "ab", "cab", "bcab"};
+  for (const std::string& pattern : patterns) {
+    for (int64_t offset : {0, 5}) {
+      ArrayView view(arr, offset);
+      for (MatchOp op : {MatchOp::STARTS_WITH, MatchOp::ENDS_WITH, MatchOp::CONTAINS}) {
+        std::shared_ptr<Buffer> result;
+        std::shared_ptr<Buffer> valid_bits;
+        ASSERT_OK(StringMatch(op, view, pattern, &result, &valid_bits));
+        for (int64_t i = 0; i < view.length(); ++i) {
+          const std::string& value = values[offset + i];
+          const size_t n = value.size();
+          const size_t m = pattern.size();
+          bool expected = false;
+          switch (op) {
+            case MatchOp::STARTS_WITH:
+              expected = n >= m && value.compare(0, m, pattern) == 0;
+              break;
+            case MatchOp::ENDS_WITH:
+              expected = n >= m && value.compare(n - m, m, pattern) == 0;
+              break;
+            case MatchOp::CONTAINS:
+              expected = value.find(pattern) != std::string::npos;
+              break;
+          }
+          const bool valid = !is_null[offset + i];
+          ASSERT_EQ(valid, BitUtil::GetBit(valid_bits->data(), i));
+          ASSERT_EQ(expected && valid, BitUtil::GetBit(result->data(), i))
+              << pattern << " " << value;
+        }
+      }
+    }
+  }
+}
+
+TEST(StringKernelTests, ContainsWithinOneValue) {
+  // "bc" occurs in the data only across the boundary of the first two values
+  auto arr = MakeStringArray({"ab", "cd", "", "xbc", "bc"}, {false, false, false, false, true});
+  std::shared_ptr<Buffer> result;
+  std::shared_ptr<Buffer> valid_bits;
+  ASSERT_OK(StringMatch(MatchOp::CONTAINS, ArrayView(arr), "bc", &result, &valid_bits));
+  ASSERT_FALSE(BitUtil::GetBit(result->data(), 0));
+  ASSERT_FALSE(BitUtil::GetBit(result->data(), 1));
+  ASSERT_FALSE(BitUtil::GetBit(result->data(), 2));
+  ASSERT_TRUE(BitUtil::GetBit(result->data(), 3));
+  ASSERT_FALSE(BitUtil::GetBit(result->data(), 4));
+
+  ASSERT_OK(StringMatch(MatchOp::CONTAINS, ArrayView(arr), "", &result, &valid_bits));
+  for (int64_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(BitUtil::GetBit(result->data(), i));
+  }
+  ASSERT_FALSE(BitUtil::GetBit(result->data(), 4));
+}
+
+TEST(StringKernelTests, CaseAscii) {
+  auto arr = MakeStringArray(
+      {"Hello, World", "", "abcXYZ@[`{09", "x"}, {false, false, false, true});
+  std::shared_ptr<Array> result;
+  ASSERT_OK(StringUpper(ArrayView(arr), &result));
+  auto upper = std::static_pointer_cast<StringArray>(result);
+  ASSERT_EQ("HELLO, WORLD", ValueAt(*upper, 0));
+  ASSERT_EQ("", ValueAt(*upper, 1));
+  ASSERT_EQ("ABCXYZ@[`{09", ValueAt(*upper, 2));
+  ASSERT_TRUE(upper->IsNull(3));
+  // Conversion in place of the bytes keeps the offsets
+  ASSERT_EQ(arr->offsets_buffer(), upper->offsets_buffer());
+
+  ASSERT_OK(StringLower(ArrayView(arr, 2), &result));
+  auto lower = std::static_pointer_cast<StringArray>(result);
+  ASSERT_EQ(2, lower->length());
+  ASSERT_EQ("abcxyz@[`{09", ValueAt(*lower, 0));
+  ASSERT_EQ(0, lower->offsets()[0]);
+  ASSERT_TRUE(lower->IsNull(1));
+}
+
+TEST(StringKernelTests, CaseUnicode) {
+  auto arr = MakeStringArray({"stra\xc3\x9f" "e", "abc", "\xc3\x84rger", ""},
+      {false, false, false, true});
+  std::shared_ptr<Array> result;
+  ASSERT_OK(StringUpper(ArrayView(arr), &result));
+  auto upper = std::static_pointer_cast<StringArray>(result);
+  ASSERT_EQ("STRASSE", ValueAt(*upper, 0));
+  ASSERT_EQ("ABC", ValueAt(*upper, 1));
+  ASSERT_EQ("\xc3\x84RGER", ValueAt(*upper, 2));
+  ASSERT_TRUE(upper->IsNull(3));
+
+  ASSERT_OK(StringLower(ArrayView(arr), &result));
+  auto lower = std::static_pointer_cast<StringArray>(result);
+  ASSERT_EQ("stra\xc3\x9f" "e", ValueAt(*lower, 0));
+  ASSERT_EQ("\xc3\xa4rger", ValueAt(*lower, 2));
+
+  auto invalid = MakeStringArray({"\xc3"}, {false});
+  ASSERT_RAISES(Invalid, StringUpper(ArrayView(invalid), &result));
+}
+
+TEST(StringKernelTests, Hash) {
+  auto arr = MakeStringArray(
+      {"foo", "a longer value than a word", "", "foo", "bar"}, {false, false, false, false, true});
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(StringHash(ArrayView(arr), &buffer));
+  auto hashes = reinterpret_cast<const uint64_t*>(buffer->data());
+  ASSERT_EQ(hashes[0], hashes[3]);
+  ASSERT_NE(hashes[0], hashes[1]);
+  ASSERT_EQ(HashUtil::HashBytes(reinterpret_cast<const uint8_t*>("foo"), 3), hashes[0]);
+  ASSERT_EQ(0, hashes[4]);
+
+  std::shared_ptr<Buffer> sliced;
+  ASSERT_OK(StringHash(ArrayView(arr, 3), &sliced));
+  ASSERT_EQ(hashes[0], reinterpret_cast<const uint64_t*>(sliced->data())[0]);
+}
+
+TEST(StringKernelTests, NotAStringArray) {
+  auto data = std::make_shared<PoolBuffer>();
+  ASSERT_OK(data->Resize(8 * sizeof(int64_t)));
+  ArrayView view(std::make_shared<Int64Array>(8, data));
+  std::shared_ptr<Array> result;
+  ASSERT_RAISES(NotImplemented, StringLength(view, &result));
+  ASSERT_RAISES(NotImplemented, StringUpper(view, &result));
+}
+
+}  // namespace pandas
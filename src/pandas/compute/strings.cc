@@ -0,0 +1,505 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "pandas/compute/strings.h"
+
+#include <Python.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "pandas/common.h"
+#include "pandas/type.h"
+#include "pandas/types/common.h"
+#include "pandas/types/numeric.h"
+#include "pandas/types/string.h"
+#include "pandas/util/bit-util.h"
+#include "pandas/util/hash-util.h"
+
+namespace pandas {
+
+namespace {
+
+// Values are matched in blocks of a byte per value, which are packed into the
+// output bitmap while still in cache. A multiple of 8, so that blocks start on
+// a byte boundary of the output
+constexpr int64_t kBlockSize = 256;
+
+constexpr uint64_t kLowBytes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+// The values of a StringArray seen through an ArrayView: value i spans
+// [offsets[i], offsets[i + 1]) of data for i in [0, length)
+struct StringRange {
+  const StringArray* array;
+  const int32_t* offsets;
+  const uint8_t* data;
+  // nullptr when every value is valid
+  const uint8_t* valid_bits;
+  int64_t bit_offset;
+  int64_t length;
+
+  bool IsNull(int64_t i) const {
+    return valid_bits && BitUtil::BitNotSet(valid_bits, bit_offset + i);
+  }
+};
+
+Status GetStringRange(const ArrayView& view, const char* what, StringRange* out) {
+  if (!view.data()) { return Status::Invalid("ArrayView does not reference an array"); }
+  const DataType& type = *view.data()->type();
+  if (type.type() != DataType::STRING) {
+    return Status::NotImplemented(
+        std::string(what) + " not implemented for type " + type.ToString());
+  }
+  const auto array = static_cast<const StringArray*>(view.data().get());
+  out->array = array;
+  out->offsets = array->offsets() + view.offset();
+  out->data = array->data();
+  out->valid_bits = array->valid_bits() ? array->valid_bits()->data() : nullptr;
+  out->bit_offset = view.offset();
+  out->length = view.length();
+  return Status::OK();
+}
+
+Status CheckBitmapSize(const Buffer& bitmap, int64_t length) {
+  if (bitmap.size() < BitUtil::BytesForBits(length)) {
+    return Status::Invalid("output bitmap is too small");
+  }
+  return Status::OK();
+}
+
+Status AllocateBitmaps(
+    int64_t length, std::shared_ptr<PoolBuffer>* values, std::shared_ptr<PoolBuffer>* valid_bits) {
+  const int64_t nbytes = BitUtil::BytesForBits(length);
+  *values = std::make_shared<PoolBuffer>();
+  *valid_bits = std::make_shared<PoolBuffer>();
+  RETURN_NOT_OK((*values)->Resize(nbytes));
+  return (*valid_bits)->Resize(nbytes);
+}
+
+// The validity bitmap of the viewed values for a new array, shared with the
+// input when the view starts at its first value
+Status ViewValidBits(const StringRange& range, std::shared_ptr<Buffer>* out) {
+  const std::shared_ptr<Buffer>& valid_bits = range.array->valid_bits();
+  if (!valid_bits || range.bit_offset == 0) {
+    *out = valid_bits;
+    return Status::OK();
+  }
+  return CopyBitmap(valid_bits, range.bit_offset, range.length, out);
+}
+
+// Fills out_valid from the input and clears the bits of out_values for nulls
+void FinishBitmaps(const StringRange& range, uint8_t* out_values, uint8_t* out_valid) {
+  if (range.valid_bits) {
+    CopyBits(range.valid_bits, range.bit_offset, range.length, out_valid, 0);
+    BitmapAnd(out_values, 0, out_valid, 0, range.length, out_values, 0);
+  } else {
+    SetBitsTo(out_valid, 0, range.length, true);
+  }
+}
+
+// Sets bit i of out if predicate(bytes, length) holds for value i
+template <typename PREDICATE>
+void MatchValues(const StringRange& range, PREDICATE&& predicate, uint8_t* out) {
+  const int32_t* offsets = range.offsets;
+  uint8_t bytes[kBlockSize];
+  for (int64_t i = 0; i < range.length; i += kBlockSize) {
+    const int64_t n = std::min(kBlockSize, range.length - i);
+    for (int64_t k = 0; k < n; ++k) {
+      const int32_t start = offsets[i + k];
+      bytes[k] = predicate(range.data + start, offsets[i + k + 1] - start);
+    }
+    BytesToBits(bytes, n, out + i / 8);
+  }
+}
+
+// ----------------------------------------------------------------------
+// UTF-8 helpers
+
+bool IsAscii(const uint8_t* p, int64_t nbytes) {
+  // Stop at the first chunk with a non-ASCII byte rather than reading it all
+  constexpr int64_t kChunkSize = 4096;
+  uint64_t any = 0;
+  uint64_t word;
+  int64_t i = 0;
+  while (i + 8 <= nbytes) {
+    const int64_t chunk_end = std::min(nbytes - 7, i + kChunkSize);
+    for (; i < chunk_end; i += 8) {
+      memcpy(&word, p + i, 8);
+      any |= word;
+    }
+    if (any & kHighBits) { return false; }
+  }
+  for (; i < nbytes; ++i) {
+    any |= p[i];
+  }
+  return (any & 0x80) == 0;
+}
+
+// Continuation bytes (10xxxxxx) are the only ones that do not start a code
+// point. In word & ~(word << 1), bit 7 of a byte is set for exactly those
+int64_t CountCodePoints(const uint8_t* p, int64_t nbytes) {
+  int64_t continuation = 0;
+  uint64_t word;
+  int64_t i = 0;
+  for (; i + 8 <= nbytes; i += 8) {
+    memcpy(&word, p + i, 8);
+    continuation += __builtin_popcountll(word & ~(word << 1) & kHighBits);
+  }
+  for (; i < nbytes; ++i) {
+    continuation += (p[i] & 0xC0) == 0x80;
+  }
+  return nbytes - continuation;
+}
+
+// Flips the case of the letters in [FIRST, LAST] among 8 ASCII bytes. Adding
+// to the low 7 bits of each byte sets its high bit without carrying into the
+// next byte, which gives both range checks at once
+template <char FIRST, char LAST>
+inline uint64_t ConvertAsciiWord(uint64_t word) {
+  const uint64_t heptets = word & ~kHighBits;
+  const uint64_t at_least_first = heptets + kLowBytes * (0x80 - FIRST);
+  const uint64_t above_last = heptets + kLowBytes * (0x80 - LAST - 1);
+  const uint64_t in_range = at_least_first & ~above_last & ~word & kHighBits;
+  return word ^ (in_range >> 2);
+}
+
+template <char FIRST, char LAST>
+void ConvertAscii(const uint8_t* src, int64_t nbytes, uint8_t* dst) {
+  uint64_t word;
+  int64_t i = 0;
+  for (; i + 8 <= nbytes; i += 8) {
+    memcpy(&word, src + i, 8);
+    word = ConvertAsciiWord<FIRST, LAST>(word);
+    memcpy(dst + i, &word, 8);
+  }
+  for (; i < nbytes; ++i) {
+    const uint8_t c = src[i];
+    dst[i] = (c >= FIRST && c <= LAST) ? c ^ 0x20 : c;
+  }
+}
+
+// Case conversion of a value with non-ASCII characters, which needs the
+// Unicode tables. The GIL must be held
+Status ConvertWithPython(
+    const uint8_t* value, int32_t length, const char* method, std::string* out) {
+  PyObject* str =
+      PyUnicode_DecodeUTF8(reinterpret_cast<const char*>(value), length, "strict");
+  if (str == nullptr) {
+    PyErr_Clear();
+    return Status::Invalid("string value is not valid UTF-8");
+  }
+  PyObject* converted = PyObject_CallMethod(str, method, nullptr);
+  Py_DECREF(str);
+  if (converted == nullptr) {
+    PyErr_Clear();
+    return Status::Invalid(std::string("str.") + method + " failed");
+  }
+  Py_ssize_t size;
+  const char* utf8 = PyUnicode_AsUTF8AndSize(converted, &size);
+  if (utf8 != nullptr) { out->append(utf8, size); }
+  Py_DECREF(converted);
+  if (utf8 == nullptr) {
+    PyErr_Clear();
+    return Status::Invalid(std::string("str.") + method + " failed");
+  }
+  return Status::OK();
+}
+
+template <char FIRST, char LAST>
+Status ConvertCase(const ArrayView& view, const char* what, const char* method,
+    std::shared_ptr<Array>* out) {
+  StringRange range;
+  RETURN_NOT_OK(GetStringRange(view, what, &range));
+  const int32_t* offsets = range.offsets;
+  const int64_t length = range.length;
+  const int32_t start = offsets[0];
+  const int64_t nbytes = offsets[length] - start;
+
+  std::shared_ptr<Buffer> valid_bits;
+  RETURN_NOT_OK(ViewValidBits(range, &valid_bits));
+
+  if (IsAscii(range.data + start, nbytes)) {
+    // Every value keeps its length
+    auto data = std::make_shared<PoolBuffer>();
+    RETURN_NOT_OK(data->Resize(nbytes));
+    ConvertAscii<FIRST, LAST>(range.data + start, nbytes, data->mutable_data());
+
+    std::shared_ptr<Buffer> new_offsets;
+    if (range.bit_offset == 0 && start == 0) {
+      new_offsets = range.array->offsets_buffer();
+    } else {
+      auto rebased = std::make_shared<PoolBuffer>();
+      RETURN_NOT_OK(rebased->Resize((length + 1) * sizeof(int32_t)));
+      int32_t* dst = reinterpret_cast<int32_t*>(rebased->mutable_data());
+      for (int64_t i = 0; i <= length; ++i) {
+        dst[i] = offsets[i] - start;
+      }
+      new_offsets = rebased;
+    }
+    *out = std::make_shared<StringArray>(length, new_offsets, data, valid_bits);
+    return Status::OK();
+  }
+
+  auto new_offsets = std::make_shared<PoolBuffer>();
+  RETURN_NOT_OK(new_offsets->Resize((length + 1) * sizeof(int32_t)));
+  int32_t* dst_offsets = reinterpret_cast<int32_t*>(new_offsets->mutable_data());
+  std::string converted;
+  converted.reserve(nbytes);
+
+  Status status;
+  PyGILState_STATE gil_state = PyGILState_Ensure();
+  dst_offsets[0] = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    int32_t value_length;
+    const uint8_t* value = range.array->GetValue(range.bit_offset + i, &value_length);
+    if (range.IsNull(i)) {
+      // Nothing is stored for nulls
+    } else if (IsAscii(value, value_length)) {
+      const size_t pos = converted.size();
+      converted.resize(pos + value_length);
+      ConvertAscii<FIRST, LAST>(
+          value, value_length, reinterpret_cast<uint8_t*>(&converted[pos]));
+    } else {
+      status = ConvertWithPython(value, value_length, method, &converted);
+      if (!status.ok()) { break; }
+    }
+    if (converted.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      status = Status::Invalid("converted strings do not fit in int32 offsets");
+      break;
+    }
+    dst_offsets[i + 1] = static_cast<int32_t>(converted.size());
+  }
+  PyGILState_Release(gil_state);
+  RETURN_NOT_OK(status);
+
+  auto data = std::make_shared<PoolBuffer>();
+  RETURN_NOT_OK(data->Resize(converted.size()));
+  memcpy(data->mutable_data(), converted.data(), converted.size());
+  *out = std::make_shared<StringArray>(length, new_offsets, data, valid_bits);
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Substring search
+
+// First occurrence of pattern (m > 0 bytes) starting in [p, end - m], or
+// nullptr. The C library's memchr scans for the first byte with SIMD
+const uint8_t* FindPattern(
+    const uint8_t* p, const uint8_t* end, const uint8_t* pattern, int64_t m) {
+  const uint8_t* last = end - m;
+  while (p <= last) {
+    p = static_cast<const uint8_t*>(memchr(p, pattern[0], last - p + 1));
+    if (p == nullptr) { return nullptr; }
+    if (memcmp(p + 1, pattern + 1, m - 1) == 0) { return p; }
+    ++p;
+  }
+  return nullptr;
+}
+
+// Searches the bytes of all the values in one pass, so that short values do
+// not each pay for starting a search. An occurrence only counts if it lies
+// within one value, and once a value matches the search resumes at the next
+void ContainsValues(
+    const StringRange& range, const uint8_t* pattern, int64_t m, uint8_t* out) {
+  SetBitsTo(out, 0, range.length, false);
+  const int32_t* offsets = range.offsets;
+  const uint8_t* p = range.data + offsets[0];
+  const uint8_t* end = range.data + offsets[range.length];
+  int64_t i = 0;
+  while (end - p >= m) {
+    const uint8_t* found = FindPattern(p, end, pattern, m);
+    if (found == nullptr) { break; }
+    const int64_t position = found - range.data;
+    while (offsets[i + 1] <= position) {
+      ++i;
+    }
+    if (position + m <= offsets[i + 1]) {
+      BitUtil::SetBit(out, i);
+      p = range.data + offsets[++i];
+    } else {
+      p = found + 1;
+    }
+  }
+}
+
+inline int CompareBytes(
+    const uint8_t* left, int64_t left_length, const uint8_t* right, int64_t right_length) {
+  const int result = memcmp(left, right, std::min(left_length, right_length));
+  if (result != 0) { return result; }
+  return (left_length > right_length) - (left_length < right_length);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Public API
+
+Status StringLength(const ArrayView& strings, std::shared_ptr<Array>* out) {
+  StringRange range;
+  RETURN_NOT_OK(GetStringRange(strings, "length", &range));
+  const int32_t* offsets = range.offsets;
+
+  auto data = std::make_shared<PoolBuffer>();
+  RETURN_NOT_OK(data->Resize(range.length * sizeof(int64_t)));
+  int64_t* lengths = reinterpret_cast<int64_t*>(data->mutable_data());
+  if (IsAscii(range.data + offsets[0], offsets[range.length] - offsets[0])) {
+    for (int64_t i = 0; i < range.length; ++i) {
+      lengths[i] = offsets[i + 1] - offsets[i];
+    }
+  } else {
+    for (int64_t i = 0; i < range.length; ++i) {
+      lengths[i] =
+          CountCodePoints(range.data + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  }
+
+  std::shared_ptr<Buffer> valid_bits;
+  RETURN_NOT_OK(ViewValidBits(range, &valid_bits));
+  *out = std::make_shared<Int64Array>(range.length, data, valid_bits);
+  return Status::OK();
+}
+
+Status StringCompare(CompareOp op, const ArrayView& strings, const std::string& value,
+    MutableBuffer* values, MutableBuffer* valid_bits) {
+  StringRange range;
+  RETURN_NOT_OK(GetStringRange(strings, "comparisons", &range));
+  RETURN_NOT_OK(CheckBitmapSize(*values, range.length));
+  RETURN_NOT_OK(CheckBitmapSize(*valid_bits, range.length));
+
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(value.data());
+  const int64_t m = static_cast<int64_t>(value.size());
+  uint8_t* out = values->mutable_data();
+  switch (op) {
+    case CompareOp::EQUAL:
+      MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+        return n == m && memcmp(p, s, n) == 0;
+      }, out);
+      break;
+    case CompareOp::NOT_EQUAL:
+      MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+        return n != m || memcmp(p, s, n) != 0;
+      }, out);
+      break;
+    case CompareOp::LESS:
+      MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+        return CompareBytes(p, n, s, m) < 0;
+      }, out);
+      break;
+    case CompareOp::LESS_EQUAL:
+      MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+        return CompareBytes(p, n, s, m) <= 0;
+      }, out);
+      break;
+    case CompareOp::GREATER:
+      MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+        return CompareBytes(p, n, s, m) > 0;
+      }, out);
+      break;
+    case CompareOp::GREATER_EQUAL:
+      MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+        return CompareBytes(p, n, s, m) >= 0;
+      }, out);
+      break;
+  }
+  FinishBitmaps(range, out, valid_bits->mutable_data());
+  return Status::OK();
+}
+
+Status StringCompare(CompareOp op, const ArrayView& strings, const std::string& value,
+    std::shared_ptr<Buffer>* values, std::shared_ptr<Buffer>* valid_bits) {
+  std::shared_ptr<PoolBuffer> value_buffer;
+  std::shared_ptr<PoolBuffer> valid_buffer;
+  RETURN_NOT_OK(AllocateBitmaps(strings.length(), &value_buffer, &valid_buffer));
+  RETURN_NOT_OK(
+      StringCompare(op, strings, value, value_buffer.get(), valid_buffer.get()));
+  *values = value_buffer;
+  *valid_bits = valid_buffer;
+  return Status::OK();
+}
+
+Status StringMatch(MatchOp op, const ArrayView& strings, const std::string& pattern,
+    MutableBuffer* values, MutableBuffer* valid_bits) {
+  StringRange range;
+  RETURN_NOT_OK(GetStringRange(strings, "matching", &range));
+  RETURN_NOT_OK(CheckBitmapSize(*values, range.length));
+  RETURN_NOT_OK(CheckBitmapSize(*valid_bits, range.length));
+
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(pattern.data());
+  const int64_t m = static_cast<int64_t>(pattern.size());
+  uint8_t* out = values->mutable_data();
+  if (m == 0) {
+    SetBitsTo(out, 0, range.length, true);
+  } else {
+    switch (op) {
+      case MatchOp::STARTS_WITH:
+        MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+          return n >= m && memcmp(p, s, m) == 0;
+        }, out);
+        break;
+      case MatchOp::ENDS_WITH:
+        MatchValues(range, [s, m](const uint8_t* p, int64_t n) {
+          return n >= m && memcmp(p + n - m, s, m) == 0;
+        }, out);
+        break;
+      case MatchOp::CONTAINS:
+        ContainsValues(range, s, m, out);
+        break;
+    }
+  }
+  FinishBitmaps(range, out, valid_bits->mutable_data());
+  return Status::OK();
+}
+
+Status StringMatch(MatchOp op, const ArrayView& strings, const std::string& pattern,
+    std::shared_ptr<Buffer>* values, std::shared_ptr<Buffer>* valid_bits) {
+  std::shared_ptr<PoolBuffer> value_buffer;
+  std::shared_ptr<PoolBuffer> valid_buffer;
+  RETURN_NOT_OK(AllocateBitmaps(strings.length(), &value_buffer, &valid_buffer));
+  RETURN_NOT_OK(
+      StringMatch(op, strings, pattern, value_buffer.get(), valid_buffer.get()));
+  *values = value_buffer;
+  *valid_bits = valid_buffer;
+  return Status::OK();
+}
+
+Status StringUpper(const ArrayView& strings, std::shared_ptr<Array>* out) {
+  return ConvertCase<'a', 'z'>(strings, "upper", "upper", out);
+}
+
+Status StringLower(const ArrayView& strings, std::shared_ptr<Array>* out) {
+  return ConvertCase<'A', 'Z'>(strings, "lower", "lower", out);
+}
+
+Status StringHash(const ArrayView& strings, MutableBuffer* hashes) {
+  StringRange range;
+  RETURN_NOT_OK(GetStringRange(strings, "hashing", &range));
+  if (hashes->size() < range.length * static_cast<int64_t>(sizeof(uint64_t))) {
+    return Status::Invalid("output buffer is too small");
+  }
+  const int32_t* offsets = range.offsets;
+  uint64_t* out = reinterpret_cast<uint64_t*>(hashes->mutable_data());
+  for (int64_t i = 0; i < range.length; ++i) {
+    out[i] = HashUtil::HashBytes(range.data + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+  if (range.valid_bits) {
+    for (int64_t i = 0; i < range.length; ++i) {
+      if (range.IsNull(i)) { out[i] = 0; }
+    }
+  }
+  return Status::OK();
+}
+
+Status StringHash(const ArrayView& strings, std::shared_ptr<Buffer>* hashes) {
+  auto buffer = std::make_shared<PoolBuffer>();
+  RETURN_NOT_OK(buffer->Resize(strings.length() * sizeof(uint64_t)));
+  RETURN_NOT_OK(StringHash(strings, buffer.get()));
+  *hashes = buffer;
+  return Status::OK();
+}
+
+}  // namespace pandas
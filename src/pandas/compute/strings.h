@@ -0,0 +1,62 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Element-wise operations on the values of a StringArray. They work on the
+// UTF-8 bytes directly instead of creating a Python string per value.
+//
+// Comparisons are bytewise, which for valid UTF-8 orders values by code point
+// as Python does. Matching is on literal bytes, not regular expressions. A
+// result is null where the input is null.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/compute/binary.h"
+
+namespace pandas {
+
+enum class MatchOp : int { STARTS_WITH, ENDS_WITH, CONTAINS };
+
+// Number of code points in each value, as an Int64Array
+PANDAS_EXPORT Status StringLength(const ArrayView& strings, std::shared_ptr<Array>* out);
+
+// Compares each value with value, writing bitmaps of length bits as Compare
+// does in binary.h. Both buffers need BytesForBits(length) bytes
+PANDAS_EXPORT Status StringCompare(CompareOp op, const ArrayView& strings,
+    const std::string& value, MutableBuffer* values, MutableBuffer* valid_bits);
+
+// As above, allocating the bitmaps
+PANDAS_EXPORT Status StringCompare(CompareOp op, const ArrayView& strings,
+    const std::string& value, std::shared_ptr<Buffer>* values,
+    std::shared_ptr<Buffer>* valid_bits);
+
+// Whether each value starts with, ends with or contains pattern, as bitmaps
+// laid out as for StringCompare. An empty pattern matches every value
+PANDAS_EXPORT Status StringMatch(MatchOp op, const ArrayView& strings,
+    const std::string& pattern, MutableBuffer* values, MutableBuffer* valid_bits);
+
+// As above, allocating the bitmaps
+PANDAS_EXPORT Status StringMatch(MatchOp op, const ArrayView& strings,
+    const std::string& pattern, std::shared_ptr<Buffer>* values,
+    std::shared_ptr<Buffer>* valid_bits);
+
+// Case conversion into a new StringArray. ASCII data is converted in bulk and
+// shares the offsets of the input where possible; values with other characters
+// go through Python's str.upper / str.lower, which may change their length
+// (e.g. "ß" becomes "SS")
+PANDAS_EXPORT Status StringUpper(const ArrayView& strings, std::shared_ptr<Array>* out);
+PANDAS_EXPORT Status StringLower(const ArrayView& strings, std::shared_ptr<Array>* out);
+
+// HashUtil::HashBytes of each value as uint64, 0 for nulls. hashes needs room
+// for length values
+PANDAS_EXPORT Status StringHash(const ArrayView& strings, MutableBuffer* hashes);
+
+// As above, allocating the hashes
+PANDAS_EXPORT Status StringHash(const ArrayView& strings, std::shared_ptr<Buffer>* hashes);
+
+}  // namespace pandas
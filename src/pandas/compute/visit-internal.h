@@ -0,0 +1,136 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Type dispatch shared by the compute kernels. A visitor has a member template
+// that is instantiated for each numeric DataType subclass:
+//
+//   struct SomeVisitor {
+//     template <typename TYPE>
+//     Status Visit(const ArrayView& view);
+//   };
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/type.h"
+#include "pandas/types/numeric.h"
+
+namespace pandas {
+
+namespace internal {
+
+#define NUMERIC_VISIT_CASE(TYPE_ID, TYPE) \
+  case DataType::TYPE_ID:                 \
+    return visitor->template Visit<TYPE>();
+
+// Calls visitor->Visit<TYPE>() for a numeric type. what names the operation in
+// the error returned for other types
+template <typename VISITOR>
+Status VisitNumericType(const DataType& type, const char* what, VISITOR* visitor) {
+  switch (type.type()) {
+    NUMERIC_VISIT_CASE(INT8, Int8Type);
+    NUMERIC_VISIT_CASE(UINT8, UInt8Type);
+    NUMERIC_VISIT_CASE(INT16, Int16Type);
+    NUMERIC_VISIT_CASE(UINT16, UInt16Type);
+    NUMERIC_VISIT_CASE(INT32, Int32Type);
+    NUMERIC_VISIT_CASE(UINT32, UInt32Type);
+    NUMERIC_VISIT_CASE(INT64, Int64Type);
+    NUMERIC_VISIT_CASE(UINT64, UInt64Type);
+    NUMERIC_VISIT_CASE(FLOAT32, FloatType);
+    NUMERIC_VISIT_CASE(FLOAT64, DoubleType);
+    default:
+      break;
+  }
+  return Status::NotImplemented(
+      std::string(what) + " not implemented for type " + type.ToString());
+}
+
+#undef NUMERIC_VISIT_CASE
+
+template <typename VISITOR>
+struct ViewVisitorAdapter {
+  template <typename TYPE>
+  Status Visit() {
+    return visitor->template Visit<TYPE>(view);
+  }
+
+  const ArrayView& view;
+  VISITOR* visitor;
+};
+
+// Calls visitor->Visit<TYPE>(view) for the type of the viewed array
+template <typename VISITOR>
+Status VisitNumericView(const ArrayView& view, const char* what, VISITOR* visitor) {
+  if (!view.data()) { return Status::Invalid("ArrayView does not reference an array"); }
+  ViewVisitorAdapter<VISITOR> adapter = {view, visitor};
+  return VisitNumericType(*view.data()->type(), what, &adapter);
+}
+
+template <typename LEFT_TYPE, typename VISITOR>
+struct RightTypeVisitor {
+  template <typename RIGHT_TYPE>
+  Status Visit() {
+    return visitor->template Visit<LEFT_TYPE, RIGHT_TYPE>();
+  }
+
+  VISITOR* visitor;
+};
+
+template <typename VISITOR>
+struct LeftTypeVisitor {
+  template <typename LEFT_TYPE>
+  Status Visit() {
+    RightTypeVisitor<LEFT_TYPE, VISITOR> right_visitor = {visitor};
+    return VisitNumericType(right, what, &right_visitor);
+  }
+
+  const DataType& right;
+  const char* what;
+  VISITOR* visitor;
+};
+
+// Calls visitor->Visit<LEFT_TYPE, RIGHT_TYPE>() for a pair of numeric types
+template <typename VISITOR>
+Status VisitNumericTypePair(
+    const DataType& left, const DataType& right, const char* what, VISITOR* visitor) {
+  LeftTypeVisitor<VISITOR> left_visitor = {right, what, visitor};
+  return VisitNumericType(left, what, &left_visitor);
+}
+
+// The values, validity bitmap and bit offset covered by an ArrayView
+template <typename TYPE>
+struct NumericRange {
+  using T = typename TYPE::c_type;
+
+  explicit NumericRange(const ArrayView& view)
+      : bit_offset(view.offset()), length(view.length()) {
+    auto arr = static_cast<const NumericArray<TYPE>*>(view.data().get());
+    values = arr->data() + view.offset();
+    valid_bits = GetValidBits(*arr, std::is_floating_point<T>());
+  }
+
+  static const uint8_t* GetValidBits(const NumericArray<TYPE>& arr, std::true_type) {
+    return nullptr;
+  }
+
+  static const uint8_t* GetValidBits(const NumericArray<TYPE>& arr, std::false_type) {
+    // A bitmap with no cleared bits is dropped so that the kernels take their
+    // dense path; the null count is cached after the first query
+    const auto& bits = static_cast<const IntegerArray<TYPE>&>(arr).valid_bits();
+    return bits && arr.HasNulls() ? bits->data() : nullptr;
+  }
+
+  const T* values;
+  const uint8_t* valid_bits;
+  int64_t bit_offset;
+  int64_t length;
+};
+
+}  // namespace internal
+
+}  // namespace pandas
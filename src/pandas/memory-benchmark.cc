@@ -0,0 +1,154 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/common.h"
+#include "pandas/memory.h"
+
+namespace pandas {
+
+// The previous default pool, for comparison: every call takes a global lock
+// and goes to the system allocator
+class LockingMemoryPool : public MemoryPool {
+ public:
+  LockingMemoryPool() : bytes_allocated_(0) {}
+
+  Status Allocate(int64_t size, uint8_t** out) override {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (posix_memalign(reinterpret_cast<void**>(out), 64, size) != 0) {
+      return Status::OutOfMemory("posix_memalign failed");
+    }
+    bytes_allocated_ += size;
+    return Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size) override {
+    std::lock_guard<std::mutex> guard(lock_);
+    std::free(buffer);
+    bytes_allocated_ -= size;
+  }
+
+  int64_t bytes_allocated() const override {
+    std::lock_guard<std::mutex> guard(lock_);
+    return bytes_allocated_;
+  }
+
+ private:
+  mutable std::mutex lock_;
+  int64_t bytes_allocated_;
+};
+
+static MemoryPool* locking_memory_pool() {
+  static LockingMemoryPool pool;
+  return &pool;
+}
+
+// Each iteration allocates a batch of buffers of mixed sizes, as when building
+// a handful of small arrays, then frees them. Argument: largest size in bytes
+template <MemoryPool* (*GetPool)()>
+static void BM_AllocateFree(benchmark::State& state) {  // NOLINT non-const reference
+  MemoryPool* pool = GetPool();
+  const int64_t max_size = state.range_x();
+  const int kBatchSize = 64;
+  std::vector<uint8_t*> buffers(kBatchSize);
+  std::vector<int64_t> sizes(kBatchSize);
+  for (int i = 0; i < kBatchSize; ++i) {
+    sizes[i] = 64 + (max_size - 64) * i / (kBatchSize - 1);
+  }
+
+  while (state.KeepRunning()) {
+    for (int i = 0; i < kBatchSize; ++i) {
+      if (!pool->Allocate(sizes[i], &buffers[i]).ok()) {
+        state.SkipWithError("allocation failed");
+        return;
+      }
+      buffers[i][0] = 1;
+    }
+    for (int i = 0; i < kBatchSize; ++i) {
+      pool->Free(buffers[i], sizes[i]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+BENCHMARK_TEMPLATE(BM_AllocateFree, default_memory_pool)
+    ->Arg(4096)
+    ->Arg(256 << 10)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AllocateFree, locking_memory_pool)
+    ->Arg(4096)
+    ->Arg(256 << 10)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Temporaries of one operation: many small buffers allocated, then all freed.
+// Argument: number of buffers
+static void BM_OperationTemporaries(benchmark::State& state,  // NOLINT non-const ref
+    bool use_arena) {
+  const int64_t num_buffers = state.range_x();
+  std::vector<uint8_t*> buffers(num_buffers);
+  ArenaMemoryPool arena;
+  MemoryPool* pool = use_arena ? static_cast<MemoryPool*>(&arena) : default_memory_pool();
+
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < num_buffers; ++i) {
+      int64_t size = 64 * (i % 64 + 1);
+      if (!pool->Allocate(size, &buffers[i]).ok()) {
+        state.SkipWithError("allocation failed");
+        return;
+      }
+    }
+    for (int64_t i = 0; i < num_buffers; ++i) {
+      pool->Free(buffers[i], 64 * (i % 64 + 1));
+    }
+    if (use_arena) { arena.Reset(); }
+  }
+  state.SetItemsProcessed(state.iterations() * num_buffers);
+}
+
+BENCHMARK_CAPTURE(BM_OperationTemporaries, default_pool, false)->Arg(1000)->Arg(10000);
+BENCHMARK_CAPTURE(BM_OperationTemporaries, arena, true)->Arg(1000)->Arg(10000);
+
+// Random reads over a 512MB column, which miss the TLB constantly with 4KB
+// pages. Argument: huge page threshold (0 to disable)
+static void BM_RandomGather(benchmark::State& state) {  // NOLINT non-const reference
+  MemoryPoolOptions options;
+  options.huge_page_threshold = state.range_x();
+  InternalMemoryPool pool(options);
+
+  const int64_t length = 64 << 20;
+  uint8_t* buffer;
+  if (!pool.Allocate(length * sizeof(int64_t), &buffer).ok()) {
+    state.SkipWithError("allocation failed");
+    return;
+  }
+  auto values = reinterpret_cast<int64_t*>(buffer);
+  for (int64_t i = 0; i < length; ++i) {
+    values[i] = i;
+  }
+
+  const int kNumReads = 1 << 16;
+  uint64_t index = 0;
+  int64_t total = 0;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < kNumReads; ++i) {
+      // Linear congruential generator; cheap next to a cache miss
+      index = index * 6364136223846793005ULL + 1442695040888963407ULL;
+      total += values[(index >> 20) % length];
+    }
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations() * kNumReads);
+  pool.Free(buffer, length * sizeof(int64_t));
+}
+
+BENCHMARK(BM_RandomGather)->Arg(0)->Arg(1 << 20);
+
+}  // namespace pandas
@@ -0,0 +1,251 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "pandas/common.h"
+#include "pandas/memory.h"
+#include "pandas/test-util.h"
+
+namespace pandas {
+
+TEST(TestDefaultMemoryPool, AllocateFree) {
+  MemoryPool* pool = default_memory_pool();
+  const int64_t initial = pool->bytes_allocated();
+
+  // Sizes inside each size class, on its boundaries, and past the largest
+  std::vector<int64_t> sizes = {0, 1, 63, 64, 65, 1000, 4096, 1 << 20, (1 << 22) - 1,
+      1 << 22, (1 << 22) + 1, 10 << 20};
+  std::vector<uint8_t*> buffers;
+  int64_t total = 0;
+  for (int64_t size : sizes) {
+    uint8_t* buffer;
+    ASSERT_OK(pool->Allocate(size, &buffer));
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(buffer) % 64);
+    memset(buffer, 0xFF, size);
+    buffers.push_back(buffer);
+    total += size;
+    ASSERT_EQ(initial + total, pool->bytes_allocated());
+  }
+
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    pool->Free(buffers[i], sizes[i]);
+  }
+  ASSERT_EQ(initial, pool->bytes_allocated());
+
+  // A freed block is reused by the next request in its size class
+  uint8_t* first;
+  ASSERT_OK(pool->Allocate(1000, &first));
+  pool->Free(first, 1000);
+  uint8_t* second;
+  ASSERT_OK(pool->Allocate(1024, &second));
+  ASSERT_EQ(first, second);
+  pool->Free(second, 1024);
+}
+
+TEST(TestDefaultMemoryPool, MultipleThreads) {
+  MemoryPool* pool = default_memory_pool();
+  const int64_t initial = pool->bytes_allocated();
+
+  // Buffers are allocated on one thread and freed on another
+  const int num_threads = 8;
+  const int num_buffers = 1000;
+  std::vector<std::vector<uint8_t*>> buffers(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([pool, t, &buffers]() {
+      for (int i = 0; i < num_buffers; ++i) {
+        uint8_t* buffer;
+        if (!pool->Allocate(64 * (i % 100 + 1), &buffer).ok()) { return; }
+        buffer[0] = static_cast<uint8_t>(t);
+        buffers[t].push_back(buffer);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  for (int t = 0; t < num_threads; ++t) {
+    ASSERT_EQ(num_buffers, buffers[t].size());
+    threads.emplace_back([pool, t, num_threads, &buffers]() {
+      const auto& to_free = buffers[(t + 1) % num_threads];
+      for (int i = 0; i < num_buffers; ++i) {
+        pool->Free(to_free[i], 64 * (i % 100 + 1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(initial, pool->bytes_allocated());
+}
+
+TEST(TestInternalMemoryPool, HugePages) {
+  MemoryPoolOptions options;
+  options.huge_page_threshold = 1 << 20;
+  options.numa_local = true;
+  InternalMemoryPool pool(options);
+
+  uint8_t* small;
+  ASSERT_OK(pool.Allocate(1000, &small));
+  ASSERT_EQ(0, pool.stats().huge_page_bytes_allocated);
+
+  const int64_t size = (3 << 20) + 100;
+  uint8_t* large;
+  ASSERT_OK(pool.Allocate(size, &large));
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(large) % (2 << 20));
+  memset(large, 0xFF, size);
+
+  MemoryPoolStats stats = pool.stats();
+  ASSERT_EQ(1000 + size, stats.bytes_allocated);
+  ASSERT_EQ(size, stats.huge_page_bytes_allocated);
+  ASSERT_EQ(1, stats.num_huge_page_allocations);
+
+  pool.Free(large, size);
+  pool.Free(small, 1000);
+  stats = pool.stats();
+  ASSERT_EQ(0, stats.bytes_allocated);
+  ASSERT_EQ(0, stats.huge_page_bytes_allocated);
+  ASSERT_EQ(1, stats.num_huge_page_allocations);
+
+  // Disabled by default
+  ASSERT_EQ(0, InternalMemoryPool().options().huge_page_threshold);
+}
+
+TEST(TestArenaMemoryPool, BumpAllocate) {
+  ArenaMemoryPool arena(4096);
+
+  uint8_t* a;
+  uint8_t* b;
+  ASSERT_OK(arena.Allocate(100, &a));
+  ASSERT_OK(arena.Allocate(100, &b));
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(a) % 64);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(b) % 64);
+  ASSERT_EQ(a + 128, b);
+  ASSERT_EQ(200, arena.bytes_allocated());
+  ASSERT_EQ(4096, arena.bytes_reserved());
+
+  // Oversized requests get their own slab without abandoning the current one
+  uint8_t* big;
+  ASSERT_OK(arena.Allocate(10000, &big));
+  memset(big, 0, 10000);
+  uint8_t* c;
+  ASSERT_OK(arena.Allocate(64, &c));
+  ASSERT_EQ(b + 128, c);
+  ASSERT_EQ(2, arena.num_slabs_allocated());
+
+  // Spilling into a new slab
+  uint8_t* d;
+  ASSERT_OK(arena.Allocate(4000, &d));
+  ASSERT_EQ(3, arena.num_slabs_allocated());
+  ASSERT_EQ(4096 * 2 + 10048, arena.bytes_reserved());
+
+  arena.Free(a, 100);
+  arena.Free(b, 100);
+  arena.Free(big, 10000);
+  arena.Free(c, 64);
+  ASSERT_EQ(4000, arena.bytes_allocated());
+  ASSERT_EQ(14264, arena.max_bytes_allocated());
+  arena.Free(d, 4000);
+  ASSERT_EQ(0, arena.bytes_allocated());
+
+  // One slab is kept for reuse
+  arena.Reset();
+  ASSERT_EQ(4096, arena.bytes_reserved());
+  ASSERT_EQ(0, arena.max_bytes_allocated());
+  uint8_t* e;
+  ASSERT_OK(arena.Allocate(64, &e));
+  ASSERT_EQ(3, arena.num_slabs_allocated());
+  arena.Free(e, 64);
+}
+
+TEST(TestArenaMemoryPool, ParentPool) {
+  MemoryPool* pool = default_memory_pool();
+  const int64_t initial = pool->bytes_allocated();
+  {
+    ArenaMemoryPool arena(1 << 16, pool);
+
+    // Works as the pool of a PoolBuffer, including growth
+    auto buffer = std::make_shared<PoolBuffer>(&arena);
+    ASSERT_OK(buffer->Resize(1000));
+    ASSERT_OK(buffer->Resize(100000));
+    ASSERT_EQ(buffer->capacity(), arena.bytes_allocated());
+    ASSERT_EQ(initial + arena.bytes_reserved(), pool->bytes_allocated());
+    buffer.reset();
+    ASSERT_EQ(0, arena.bytes_allocated());
+  }
+  ASSERT_EQ(initial, pool->bytes_allocated());
+}
+
+TEST(TestTrackingMemoryPool, Stats) {
+  TrackingMemoryPool pool;
+
+  uint8_t* a;
+  uint8_t* b;
+  uint8_t* c;
+  ASSERT_OK(pool.Allocate(100, &a));
+  {
+    MemoryTagScope groupby("groupby");
+    ASSERT_OK(pool.Allocate(1000, &b));
+    {
+      MemoryTagScope join("join");
+      ASSERT_OK(pool.Allocate(5000, &c));
+    }
+  }
+  pool.Free(b, 1000);
+
+  AllocationStats stats = pool.stats();
+  ASSERT_EQ(5100, stats.bytes_allocated);
+  ASSERT_EQ(6100, stats.max_bytes_allocated);
+  ASSERT_EQ(3, stats.num_allocations);
+  ASSERT_EQ(5100, pool.bytes_allocated());
+
+  std::vector<int64_t> histogram = pool.size_histogram();
+  ASSERT_EQ(TrackingMemoryPool::kNumHistogramBuckets, histogram.size());
+  ASSERT_EQ(1, histogram[7]);   // 100 in [64, 128)
+  ASSERT_EQ(1, histogram[10]);  // 1000 in [512, 1024)
+  ASSERT_EQ(1, histogram[13]);  // 5000 in [4096, 8192)
+
+  auto tags = pool.tag_stats();
+  ASSERT_EQ(2, tags.size());
+  ASSERT_EQ(0, tags["groupby"].bytes_allocated);
+  ASSERT_EQ(1000, tags["groupby"].max_bytes_allocated);
+  ASSERT_EQ(1, tags["groupby"].num_allocations);
+  ASSERT_EQ(5000, tags["join"].bytes_allocated);
+
+  pool.ResetPeak();
+  ASSERT_EQ(5100, pool.stats().max_bytes_allocated);
+  ASSERT_EQ(0, pool.tag_stats()["groupby"].max_bytes_allocated);
+
+  pool.Free(a, 100);
+  pool.Free(c, 5000);
+  ASSERT_EQ(0, pool.bytes_allocated());
+  ASSERT_EQ(0, pool.tag_stats()["join"].bytes_allocated);
+}
+
+TEST(TestTrackingMemoryPool, DefaultPool) {
+  MemoryPool* builtin = default_memory_pool();
+  TrackingMemoryPool* tracker = default_tracking_memory_pool();
+  set_default_memory_pool(tracker);
+  ASSERT_EQ(tracker, default_memory_pool());
+
+  // Buffers remember their pool, so swapping back with one alive is fine
+  auto buffer = std::make_shared<PoolBuffer>(default_memory_pool());
+  ASSERT_OK(buffer->Resize(1000));
+  ASSERT_EQ(buffer->capacity(), tracker->bytes_allocated());
+  set_default_memory_pool(nullptr);
+  ASSERT_EQ(builtin, default_memory_pool());
+
+  buffer.reset();
+  ASSERT_EQ(0, tracker->bytes_allocated());
+}
+
+}  // namespace pandas
@@ -5,10 +5,21 @@
 
 #include "pandas/memory.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
 #include <cstdlib>
-#include <mutex>
 #include <sstream>
 
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
 #include "pandas/common.h"
 #include "pandas/util/logging.h"
 
@@ -33,49 +44,435 @@ Status AllocateAligned(int64_t size, uint8_t** out) {
   }
   return Status::OK();
 }
-}  // namespace
 
-class InternalMemoryPool : public MemoryPool {
+// ----------------------------------------------------------------------
+// Per-thread cache of freed blocks
+
+// Requests of up to kMaxCachedSize bytes are rounded up to a power of two
+// (at least 64 bytes) and served from a per-thread free list for that size
+// class, so most allocations take no locks and make no system calls. Blocks
+// are plain aligned memory and may be freed on any thread
+constexpr int kMinSizeClassBits = 6;
+constexpr int kMaxSizeClassBits = 22;
+constexpr int kNumSizeClasses = kMaxSizeClassBits - kMinSizeClassBits + 1;
+constexpr int64_t kMaxCachedSize = static_cast<int64_t>(1) << kMaxSizeClassBits;
+
+// Limits on what a single thread holds on to; beyond these freed blocks are
+// returned to the system allocator
+constexpr int kMaxBlocksPerClass = 32;
+constexpr int64_t kMaxThreadCacheBytes = static_cast<int64_t>(16) << 20;
+
+inline int SizeClass(int64_t size) {
+  if (size <= (1 << kMinSizeClassBits)) { return 0; }
+  // Bits needed to represent size - 1, i.e. ceil(log2(size))
+  int bits = 64 - __builtin_clzll(static_cast<uint64_t>(size - 1));
+  return bits - kMinSizeClassBits;
+}
+
+inline int64_t SizeClassBytes(int size_class) {
+  return static_cast<int64_t>(1) << (size_class + kMinSizeClassBits);
+}
+
+class ThreadCache {
  public:
-  InternalMemoryPool() : bytes_allocated_(0) {}
-  virtual ~InternalMemoryPool();
+  ThreadCache() : cached_bytes_(0) {
+    for (int i = 0; i < kNumSizeClasses; ++i) {
+      num_blocks_[i] = 0;
+    }
+  }
 
-  Status Allocate(int64_t size, uint8_t** out) override;
+  ~ThreadCache();
 
-  void Free(uint8_t* buffer, int64_t size) override;
+  uint8_t* Pop(int size_class) {
+    if (num_blocks_[size_class] == 0) { return nullptr; }
+    cached_bytes_ -= SizeClassBytes(size_class);
+    return blocks_[size_class][--num_blocks_[size_class]];
+  }
 
-  int64_t bytes_allocated() const override;
+  // Returns false if the cache is full
+  bool Push(int size_class, uint8_t* block) {
+    int64_t nbytes = SizeClassBytes(size_class);
+    if (num_blocks_[size_class] == kMaxBlocksPerClass ||
+        cached_bytes_ + nbytes > kMaxThreadCacheBytes) {
+      return false;
+    }
+    cached_bytes_ += nbytes;
+    blocks_[size_class][num_blocks_[size_class]++] = block;
+    return true;
+  }
 
  private:
-  mutable std::mutex pool_lock_;
-  int64_t bytes_allocated_;
+  uint8_t* blocks_[kNumSizeClasses][kMaxBlocksPerClass];
+  int num_blocks_[kNumSizeClasses];
+  int64_t cached_bytes_;
 };
 
-Status InternalMemoryPool::Allocate(int64_t size, uint8_t** out) {
-  std::lock_guard<std::mutex> guard(pool_lock_);
-  RETURN_NOT_OK(AllocateAligned(size, out));
-  bytes_allocated_ += size;
+enum class ThreadCacheState : int { UNINITIALIZED, ALIVE, DESTROYED };
+
+// Trivially destructible, so still readable while other thread-local
+// destructors (which may free buffers) run at thread exit
+thread_local ThreadCacheState thread_cache_state = ThreadCacheState::UNINITIALIZED;
+
+ThreadCache::~ThreadCache() {
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    for (int j = 0; j < num_blocks_[i]; ++j) {
+      std::free(blocks_[i][j]);
+    }
+  }
+  thread_cache_state = ThreadCacheState::DESTROYED;
+}
+
+// nullptr once the calling thread's cache has been torn down
+ThreadCache* GetThreadCache() {
+  if (thread_cache_state == ThreadCacheState::DESTROYED) { return nullptr; }
+  static thread_local ThreadCache cache;
+  thread_cache_state = ThreadCacheState::ALIVE;
+  return &cache;
+}
+
+// ----------------------------------------------------------------------
+// Huge page mappings
+
+constexpr int64_t kHugePageSize = static_cast<int64_t>(2) << 20;
+
+inline int64_t HugePageMappingSize(int64_t size) {
+  return (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+}
+
+// Prefer (rather than require) the NUMA node of the CPU the calling thread is
+// running on, so that allocation does not fail when that node is full
+bool BindToLocalNumaNode(uint8_t* data, int64_t size) {
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+  unsigned int cpu;
+  unsigned int node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) { return false; }
+
+  constexpr int kMaxNodes = 1024;
+  constexpr int kBitsPerWord = 8 * sizeof(unsigned long);  // NOLINT
+  if (node >= kMaxNodes) { return false; }
+  unsigned long nodemask[kMaxNodes / kBitsPerWord] = {};  // NOLINT
+  nodemask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+  return syscall(SYS_mbind, data, size, MPOL_PREFERRED, nodemask, kMaxNodes, 0) == 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// InternalMemoryPool
+
+InternalMemoryPool::InternalMemoryPool(const MemoryPoolOptions& options)
+    : options_(options),
+      bytes_allocated_(0),
+      huge_page_bytes_allocated_(0),
+      num_huge_page_allocations_(0),
+      num_numa_bind_failures_(0) {}
 
+Status InternalMemoryPool::AllocateHugePages(int64_t size, uint8_t** out) {
+  // mmap only guarantees page alignment, so map an extra huge page and trim
+  // the ends to get a 2MB-aligned region that can be backed by huge pages
+  const int64_t mapping_size = HugePageMappingSize(size);
+  const int64_t padded_size = mapping_size + kHugePageSize;
+  void* mapped =
+      mmap(nullptr, padded_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) {
+    std::stringstream ss;
+    ss << "mmap of size " << size << " failed";
+    return Status::OutOfMemory(ss.str());
+  }
+
+  uint8_t* start = reinterpret_cast<uint8_t*>(mapped);
+  uint8_t* aligned = reinterpret_cast<uint8_t*>(
+      (reinterpret_cast<uintptr_t>(start) + kHugePageSize - 1) & ~(kHugePageSize - 1));
+  const int64_t head = aligned - start;
+  if (head > 0) { munmap(start, head); }
+  const int64_t tail = padded_size - head - mapping_size;
+  if (tail > 0) { munmap(aligned + mapping_size, tail); }
+
+#ifdef MADV_HUGEPAGE
+  // Advisory; fails harmlessly when transparent huge pages are disabled
+  madvise(aligned, mapping_size, MADV_HUGEPAGE);
+#endif
+
+  if (options_.numa_local && !BindToLocalNumaNode(aligned, mapping_size)) {
+    num_numa_bind_failures_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  huge_page_bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+  num_huge_page_allocations_.fetch_add(1, std::memory_order_relaxed);
+  *out = aligned;
+  return Status::OK();
+}
+
+Status InternalMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (UseHugePages(size)) {
+    RETURN_NOT_OK(AllocateHugePages(size, out));
+  } else if (size <= kMaxCachedSize) {
+    int size_class = SizeClass(size);
+    ThreadCache* cache = GetThreadCache();
+    uint8_t* block = cache != nullptr ? cache->Pop(size_class) : nullptr;
+    if (block == nullptr) {
+      RETURN_NOT_OK(AllocateAligned(SizeClassBytes(size_class), &block));
+    }
+    *out = block;
+  } else {
+    RETURN_NOT_OK(AllocateAligned(size, out));
+  }
+  bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
   return Status::OK();
 }
 
 int64_t InternalMemoryPool::bytes_allocated() const {
-  std::lock_guard<std::mutex> guard(pool_lock_);
-  return bytes_allocated_;
+  return bytes_allocated_.load(std::memory_order_relaxed);
 }
 
 void InternalMemoryPool::Free(uint8_t* buffer, int64_t size) {
-  std::lock_guard<std::mutex> guard(pool_lock_);
-  PANDAS_DCHECK_GE(bytes_allocated_, size);
+  PANDAS_DCHECK_GE(bytes_allocated(), size);
+  bytes_allocated_.fetch_sub(size, std::memory_order_relaxed);
+  if (UseHugePages(size)) {
+    huge_page_bytes_allocated_.fetch_sub(size, std::memory_order_relaxed);
+    munmap(buffer, HugePageMappingSize(size));
+    return;
+  }
+  if (size <= kMaxCachedSize) {
+    ThreadCache* cache = GetThreadCache();
+    if (cache != nullptr && cache->Push(SizeClass(size), buffer)) { return; }
+  }
   std::free(buffer);
-  bytes_allocated_ -= size;
+}
+
+MemoryPoolStats InternalMemoryPool::stats() const {
+  MemoryPoolStats stats;
+  stats.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+  stats.huge_page_bytes_allocated =
+      huge_page_bytes_allocated_.load(std::memory_order_relaxed);
+  stats.num_huge_page_allocations =
+      num_huge_page_allocations_.load(std::memory_order_relaxed);
+  stats.num_numa_bind_failures = num_numa_bind_failures_.load(std::memory_order_relaxed);
+  return stats;
 }
 
 InternalMemoryPool::~InternalMemoryPool() {}
 
+static InternalMemoryPool* builtin_memory_pool() {
+  static InternalMemoryPool builtin_memory_pool_;
+  return &builtin_memory_pool_;
+}
+
+static std::atomic<MemoryPool*> default_memory_pool_(nullptr);
+
 MemoryPool* default_memory_pool() {
-  static InternalMemoryPool default_memory_pool_;
-  return &default_memory_pool_;
+  MemoryPool* pool = default_memory_pool_.load(std::memory_order_acquire);
+  return pool != nullptr ? pool : builtin_memory_pool();
+}
+
+void set_default_memory_pool(MemoryPool* pool) {
+  default_memory_pool_.store(pool, std::memory_order_release);
+}
+
+// ----------------------------------------------------------------------
+// ArenaMemoryPool
+
+// Matches the alignment of the default pool
+constexpr int64_t kArenaAlignment = 64;
+
+constexpr int64_t ArenaMemoryPool::kDefaultSlabSize;
+
+ArenaMemoryPool::ArenaMemoryPool(int64_t slab_size, MemoryPool* parent)
+    : parent_(parent != nullptr ? parent : default_memory_pool()),
+      slab_size_(slab_size),
+      slab_position_(0),
+      bytes_allocated_(0),
+      max_bytes_allocated_(0),
+      bytes_reserved_(0),
+      num_slabs_allocated_(0) {
+  PANDAS_DCHECK_GT(slab_size, 0);
+}
+
+ArenaMemoryPool::~ArenaMemoryPool() {
+  PANDAS_DCHECK_EQ(bytes_allocated_, 0);
+  for (const Slab& slab : slabs_) {
+    parent_->Free(slab.data, slab.size);
+  }
+}
+
+Status ArenaMemoryPool::NewSlab(int64_t size, Slab* out) {
+  out->size = size;
+  RETURN_NOT_OK(parent_->Allocate(size, &out->data));
+  bytes_reserved_ += size;
+  ++num_slabs_allocated_;
+  return Status::OK();
+}
+
+Status ArenaMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  const int64_t padded_size = (size + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+
+  std::lock_guard<std::mutex> guard(lock_);
+  if (padded_size > slab_size_) {
+    // An oversized request gets a slab of its own, placed before the current
+    // slab so that the remainder of that slab is still used
+    Slab slab;
+    RETURN_NOT_OK(NewSlab(padded_size, &slab));
+    if (slabs_.empty()) {
+      slabs_.push_back(slab);
+      slab_position_ = slab.size;
+    } else {
+      slabs_.insert(slabs_.end() - 1, slab);
+    }
+    *out = slab.data;
+  } else {
+    if (slabs_.empty() || slab_position_ + padded_size > slabs_.back().size) {
+      Slab slab;
+      RETURN_NOT_OK(NewSlab(slab_size_, &slab));
+      slabs_.push_back(slab);
+      slab_position_ = 0;
+    }
+    *out = slabs_.back().data + slab_position_;
+    slab_position_ += padded_size;
+  }
+
+  bytes_allocated_ += size;
+  max_bytes_allocated_ = std::max(max_bytes_allocated_, bytes_allocated_);
+  return Status::OK();
+}
+
+void ArenaMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  std::lock_guard<std::mutex> guard(lock_);
+  PANDAS_DCHECK_GE(bytes_allocated_, size);
+  bytes_allocated_ -= size;
+}
+
+int64_t ArenaMemoryPool::bytes_allocated() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return bytes_allocated_;
+}
+
+int64_t ArenaMemoryPool::max_bytes_allocated() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return max_bytes_allocated_;
+}
+
+int64_t ArenaMemoryPool::bytes_reserved() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return bytes_reserved_;
+}
+
+int64_t ArenaMemoryPool::num_slabs_allocated() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return num_slabs_allocated_;
+}
+
+void ArenaMemoryPool::Reset() {
+  std::lock_guard<std::mutex> guard(lock_);
+  PANDAS_DCHECK_EQ(bytes_allocated_, 0);
+
+  std::vector<Slab> kept;
+  for (const Slab& slab : slabs_) {
+    if (kept.empty() && slab.size == slab_size_) {
+      kept.push_back(slab);
+    } else {
+      parent_->Free(slab.data, slab.size);
+      bytes_reserved_ -= slab.size;
+    }
+  }
+  slabs_.swap(kept);
+  slab_position_ = 0;
+  bytes_allocated_ = 0;
+  max_bytes_allocated_ = 0;
+}
+
+// ----------------------------------------------------------------------
+// Instrumentation
+
+static thread_local std::vector<std::string> memory_tags;
+
+void PushMemoryTag(const std::string& tag) {
+  memory_tags.push_back(tag);
+}
+
+void PopMemoryTag() {
+  PANDAS_DCHECK(!memory_tags.empty());
+  memory_tags.pop_back();
+}
+
+static void RecordAllocation(int64_t size, AllocationStats* stats) {
+  stats->bytes_allocated += size;
+  stats->max_bytes_allocated = std::max(stats->max_bytes_allocated, stats->bytes_allocated);
+  ++stats->num_allocations;
+}
+
+constexpr int TrackingMemoryPool::kNumHistogramBuckets;
+
+TrackingMemoryPool::TrackingMemoryPool(MemoryPool* parent)
+    : parent_(parent != nullptr ? parent : builtin_memory_pool()) {
+  std::fill(histogram_, histogram_ + kNumHistogramBuckets, 0);
+}
+
+Status TrackingMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  RETURN_NOT_OK(parent_->Allocate(size, out));
+
+  std::lock_guard<std::mutex> guard(lock_);
+  RecordAllocation(size, &stats_);
+  int bucket = size == 0 ? 0 : 64 - __builtin_clzll(static_cast<uint64_t>(size));
+  ++histogram_[std::min(bucket, kNumHistogramBuckets - 1)];
+
+  if (!memory_tags.empty()) {
+    AllocationStats* tag_stats = &tag_stats_[memory_tags.back()];
+    RecordAllocation(size, tag_stats);
+    tagged_buffers_[*out] = tag_stats;
+  }
+  return Status::OK();
+}
+
+void TrackingMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    PANDAS_DCHECK_GE(stats_.bytes_allocated, size);
+    stats_.bytes_allocated -= size;
+    if (!tagged_buffers_.empty()) {
+      auto it = tagged_buffers_.find(buffer);
+      if (it != tagged_buffers_.end()) {
+        it->second->bytes_allocated -= size;
+        tagged_buffers_.erase(it);
+      }
+    }
+  }
+  parent_->Free(buffer, size);
+}
+
+int64_t TrackingMemoryPool::bytes_allocated() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return stats_.bytes_allocated;
+}
+
+AllocationStats TrackingMemoryPool::stats() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return stats_;
+}
+
+std::vector<int64_t> TrackingMemoryPool::size_histogram() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return std::vector<int64_t>(histogram_, histogram_ + kNumHistogramBuckets);
+}
+
+std::map<std::string, AllocationStats> TrackingMemoryPool::tag_stats() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return tag_stats_;
+}
+
+void TrackingMemoryPool::ResetPeak() {
+  std::lock_guard<std::mutex> guard(lock_);
+  stats_.max_bytes_allocated = stats_.bytes_allocated;
+  for (auto& it : tag_stats_) {
+    it.second.max_bytes_allocated = it.second.bytes_allocated;
+  }
+}
+
+TrackingMemoryPool* default_tracking_memory_pool() {
+  static TrackingMemoryPool default_tracking_memory_pool_;
+  return &default_tracking_memory_pool_;
 }
 
 }  // namespace pandas
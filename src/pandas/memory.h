@@ -5,12 +5,211 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "pandas/common.h"
+#include "pandas/util/macros.h"
 
 namespace pandas {
 
 PANDAS_EXPORT MemoryPool* default_memory_pool();
 
+// Replace the pool returned by default_memory_pool(), e.g. with a
+// TrackingMemoryPool. Buffers free to the pool they were allocated from, so
+// this is safe at any time as long as the previous pool outlives its buffers.
+// nullptr restores the built-in pool
+PANDAS_EXPORT void set_default_memory_pool(MemoryPool* pool);
+
+struct MemoryPoolOptions {
+  MemoryPoolOptions() : huge_page_threshold(0), numa_local(false) {}
+
+  // Allocations of at least this many bytes are mapped directly with mmap,
+  // aligned to 2MB and advised to use transparent huge pages. 0 disables
+  int64_t huge_page_threshold;
+
+  // Whether to bind the pages of those allocations to the NUMA node of the
+  // allocating thread. Linux only; ignored elsewhere
+  bool numa_local;
+};
+
+struct MemoryPoolStats {
+  int64_t bytes_allocated;
+
+  // Portion of bytes_allocated served by huge page mappings
+  int64_t huge_page_bytes_allocated;
+
+  // Cumulative number of huge page mappings
+  int64_t num_huge_page_allocations;
+
+  // Cumulative number of huge page mappings that could not be bound to the
+  // local NUMA node
+  int64_t num_numa_bind_failures;
+};
+
+// The allocator behind default_memory_pool(). Small requests are served from
+// per-thread caches and medium ones by posix_memalign; large ones can be
+// given huge pages via MemoryPoolOptions
+class PANDAS_EXPORT InternalMemoryPool : public MemoryPool {
+ public:
+  explicit InternalMemoryPool(const MemoryPoolOptions& options = MemoryPoolOptions());
+  virtual ~InternalMemoryPool();
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+
+  MemoryPoolStats stats() const;
+
+  const MemoryPoolOptions& options() const { return options_; }
+
+ private:
+  bool UseHugePages(int64_t size) const {
+    return options_.huge_page_threshold > 0 && size >= options_.huge_page_threshold;
+  }
+
+  Status AllocateHugePages(int64_t size, uint8_t** out);
+
+  MemoryPoolOptions options_;
+  std::atomic<int64_t> bytes_allocated_;
+  std::atomic<int64_t> huge_page_bytes_allocated_;
+  std::atomic<int64_t> num_huge_page_allocations_;
+  std::atomic<int64_t> num_numa_bind_failures_;
+
+  DISALLOW_COPY_AND_ASSIGN(InternalMemoryPool);
+};
+
+// Bump allocator for temporaries that die together, such as the intermediate
+// buffers of one groupby or join. Chunks are carved out of large slabs taken
+// from a parent pool, so Free only updates statistics and the slabs are
+// released all at once by Reset or the destructor
+class PANDAS_EXPORT ArenaMemoryPool : public MemoryPool {
+ public:
+  static constexpr int64_t kDefaultSlabSize = 1 << 20;
+
+  explicit ArenaMemoryPool(
+      int64_t slab_size = kDefaultSlabSize, MemoryPool* parent = nullptr);
+  ~ArenaMemoryPool();
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  // Bytes handed out and not yet freed
+  int64_t bytes_allocated() const override;
+
+  // High-water mark of bytes_allocated() since construction or the last Reset
+  int64_t max_bytes_allocated() const;
+
+  // Bytes of slab memory currently held from the parent pool
+  int64_t bytes_reserved() const;
+
+  // Number of slabs requested from the parent pool since construction
+  int64_t num_slabs_allocated() const;
+
+  // Make all memory available for reuse. Every buffer allocated from the arena
+  // must have been freed. The first slab is kept so that an arena reused for
+  // each operation does not return to the parent pool every time
+  void Reset();
+
+ private:
+  struct Slab {
+    uint8_t* data;
+    int64_t size;
+  };
+
+  Status NewSlab(int64_t size, Slab* out);
+
+  MemoryPool* parent_;
+  int64_t slab_size_;
+
+  mutable std::mutex lock_;
+  std::vector<Slab> slabs_;
+  // Bump pointer into the last slab
+  int64_t slab_position_;
+  int64_t bytes_allocated_;
+  int64_t max_bytes_allocated_;
+  int64_t bytes_reserved_;
+  int64_t num_slabs_allocated_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArenaMemoryPool);
+};
+
+// ----------------------------------------------------------------------
+// Instrumentation
+
+// Allocations made by the calling thread between a push and the matching pop
+// are attributed to the tag by any TrackingMemoryPool. Tags nest; the
+// innermost one wins
+PANDAS_EXPORT void PushMemoryTag(const std::string& tag);
+PANDAS_EXPORT void PopMemoryTag();
+
+class MemoryTagScope {
+ public:
+  explicit MemoryTagScope(const std::string& tag) { PushMemoryTag(tag); }
+  ~MemoryTagScope() { PopMemoryTag(); }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MemoryTagScope);
+};
+
+struct AllocationStats {
+  AllocationStats() : bytes_allocated(0), max_bytes_allocated(0), num_allocations(0) {}
+
+  int64_t bytes_allocated;
+  int64_t max_bytes_allocated;
+  int64_t num_allocations;
+};
+
+// Wraps another pool and records what passes through it. Meant for
+// diagnosing memory use rather than the hot path: every call takes a lock
+class PANDAS_EXPORT TrackingMemoryPool : public MemoryPool {
+ public:
+  static constexpr int kNumHistogramBuckets = 64;
+
+  // The parent defaults to the built-in default pool
+  explicit TrackingMemoryPool(MemoryPool* parent = nullptr);
+
+  Status Allocate(int64_t size, uint8_t** out) override;
+
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+
+  AllocationStats stats() const;
+
+  // Bucket 0 counts empty allocations and bucket i > 0 those with sizes in
+  // [2^(i-1), 2^i)
+  std::vector<int64_t> size_histogram() const;
+
+  // Statistics of the allocations made under each tag
+  std::map<std::string, AllocationStats> tag_stats() const;
+
+  // Restart peak tracking from the current usage, overall and for each tag
+  void ResetPeak();
+
+ private:
+  MemoryPool* parent_;
+
+  mutable std::mutex lock_;
+  AllocationStats stats_;
+  int64_t histogram_[kNumHistogramBuckets];
+  std::map<std::string, AllocationStats> tag_stats_;
+  // Live tagged buffers and the stats they are charged to
+  std::unordered_map<uint8_t*, AllocationStats*> tagged_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(TrackingMemoryPool);
+};
+
+// Process-wide tracker in front of the built-in pool. Pass to
+// set_default_memory_pool() to instrument the default allocations
+PANDAS_EXPORT TrackingMemoryPool* default_tracking_memory_pool();
+
 }  // namespace pandas
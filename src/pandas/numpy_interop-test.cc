@@ -0,0 +1,171 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/numpy_interop.h"
+#include "pandas/test-util.h"
+#include "pandas/types/numeric.h"
+#include "pandas/types/string.h"
+
+namespace pandas {
+
+static PyObject* MakeInt64NumPyArray(int64_t length) {
+  npy_intp dims[1] = {length};
+  PyObject* arr = PyArray_SimpleNew(1, dims, NPY_INT64);
+  auto values = reinterpret_cast<int64_t*>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject*>(arr)));
+  for (int64_t i = 0; i < length; ++i) {
+    values[i] = i;
+  }
+  return arr;
+}
+
+TEST(TestNumPyInterop, ZeroCopy) {
+  OwnedRef np_arr(MakeInt64NumPyArray(100));
+  void* np_data = PyArray_DATA(reinterpret_cast<PyArrayObject*>(np_arr.obj()));
+
+  Array* out;
+  ASSERT_OK(array_from_numpy(np_arr.obj(), &out));
+  std::shared_ptr<Array> arr(out);
+  ASSERT_EQ(DataType::INT64, arr->type_id());
+  ASSERT_EQ(100, arr->length());
+  ASSERT_EQ(0, arr->GetNullCount());
+
+  // The NumPy memory is referenced, not copied, and is kept alive by the array
+  auto typed = static_cast<const Int64Array*>(arr.get());
+  ASSERT_EQ(np_data, typed->data());
+  ASSERT_EQ(2, Py_REFCNT(np_arr.obj()));
+  ASSERT_FALSE(arr->owns_data());
+
+  // Mutation copies the data first
+  ArrayView view(arr);
+  arr.reset();
+  ASSERT_OK(view.EnsureMutable());
+  auto copied = static_cast<const Int64Array*>(view.data().get());
+  ASSERT_NE(np_data, copied->data());
+  ASSERT_EQ(99, copied->data()[99]);
+  ASSERT_EQ(1, Py_REFCNT(np_arr.obj()));
+}
+
+TEST(TestNumPyInterop, StridedIsCopied) {
+  OwnedRef np_arr(MakeInt64NumPyArray(100));
+  OwnedRef two(PyLong_FromLong(2));
+  OwnedRef every_other(PySlice_New(nullptr, nullptr, two.obj()));
+  OwnedRef strided(PyObject_GetItem(np_arr.obj(), every_other.obj()));
+
+  Array* out;
+  ASSERT_OK(array_from_numpy(strided.obj(), &out));
+  std::shared_ptr<Array> arr(out);
+  ASSERT_EQ(50, arr->length());
+
+  auto typed = static_cast<const Int64Array*>(arr.get());
+  for (int64_t i = 0; i < 50; ++i) {
+    ASSERT_EQ(2 * i, typed->data()[i]);
+  }
+}
+
+static PyObject* MakeBoolMask(int64_t length, int64_t every) {
+  npy_intp dims[1] = {length};
+  PyObject* mask = PyArray_SimpleNew(1, dims, NPY_BOOL);
+  auto values =
+      reinterpret_cast<uint8_t*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(mask)));
+  for (int64_t i = 0; i < length; ++i) {
+    values[i] = every > 0 && i % every == 0;
+  }
+  return mask;
+}
+
+TEST(TestNumPyInterop, MaskedInteger) {
+  OwnedRef np_arr(MakeInt64NumPyArray(100));
+  OwnedRef mask(MakeBoolMask(100, 3));
+
+  Array* out;
+  ASSERT_OK(array_from_masked_numpy(np_arr.obj(), mask.obj(), &out));
+  std::shared_ptr<Array> arr(out);
+  ASSERT_EQ(34, arr->GetNullCount());
+
+  auto typed = static_cast<const Int64Array*>(arr.get());
+  ASSERT_EQ(PyArray_DATA(reinterpret_cast<PyArrayObject*>(np_arr.obj())), typed->data());
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(i % 3 != 0, BitUtil::GetBit(typed->valid_bits()->data(), i));
+  }
+
+  // No bitmap for an all-false mask
+  OwnedRef empty_mask(MakeBoolMask(100, 0));
+  ASSERT_OK(array_from_masked_numpy(np_arr.obj(), empty_mask.obj(), &out));
+  std::shared_ptr<Int64Array> no_nulls(static_cast<Int64Array*>(out));
+  ASSERT_EQ(nullptr, no_nulls->valid_bits());
+  ASSERT_EQ(0, no_nulls->GetNullCount());
+
+  OwnedRef short_mask(MakeBoolMask(50, 3));
+  ASSERT_RAISES(Invalid, array_from_masked_numpy(np_arr.obj(), short_mask.obj(), &out));
+}
+
+TEST(TestNumPyInterop, MaskedFloating) {
+  npy_intp dims[1] = {10};
+  OwnedRef np_arr(PyArray_SimpleNew(1, dims, NPY_FLOAT64));
+  auto values =
+      reinterpret_cast<double*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(np_arr.obj())));
+  for (int i = 0; i < 10; ++i) {
+    values[i] = i;
+  }
+  OwnedRef mask(MakeBoolMask(10, 4));
+
+  Array* out;
+  ASSERT_OK(array_from_masked_numpy(np_arr.obj(), mask.obj(), &out));
+  std::shared_ptr<Array> arr(out);
+  ASSERT_EQ(3, arr->GetNullCount());
+
+  // The NumPy array is left untouched
+  ASSERT_EQ(0, values[0]);
+  auto typed = static_cast<const DoubleArray*>(arr.get());
+  ASSERT_TRUE(std::isnan(typed->data()[4]));
+  ASSERT_EQ(5, typed->data()[5]);
+}
+
+TEST(TestNumPyInterop, StringBuffers) {
+  // "ab", "", null, "cde"
+  npy_intp offsets_dims[1] = {5};
+  OwnedRef offsets(PyArray_SimpleNew(1, offsets_dims, NPY_INT32));
+  auto offset_values = reinterpret_cast<int32_t*>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject*>(offsets.obj())));
+  const int32_t ex_offsets[5] = {0, 2, 2, 2, 5};
+  for (int i = 0; i < 5; ++i) {
+    offset_values[i] = ex_offsets[i];
+  }
+  npy_intp data_dims[1] = {5};
+  OwnedRef data(PyArray_SimpleNew(1, data_dims, NPY_UINT8));
+  void* np_data = PyArray_DATA(reinterpret_cast<PyArrayObject*>(data.obj()));
+  memcpy(np_data, "abcde", 5);
+  OwnedRef mask(MakeBoolMask(4, 0));
+  reinterpret_cast<uint8_t*>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject*>(mask.obj())))[2] = 1;
+
+  Array* out;
+  ASSERT_OK(string_array_from_numpy(offsets.obj(), data.obj(), mask.obj(), &out));
+  std::shared_ptr<Array> arr(out);
+  ASSERT_EQ(DataType::STRING, arr->type_id());
+  ASSERT_EQ(4, arr->length());
+  ASSERT_EQ(1, arr->GetNullCount());
+
+  auto typed = static_cast<const StringArray*>(arr.get());
+  ASSERT_EQ(np_data, typed->data());
+  ASSERT_EQ(3, typed->value_length(3));
+  ASSERT_TRUE(typed->IsNull(2));
+  ASSERT_FALSE(arr->owns_data());
+
+  // Offsets past the end of the data
+  offset_values[4] = 6;
+  ASSERT_RAISES(
+      Invalid, string_array_from_numpy(offsets.obj(), data.obj(), nullptr, &out));
+}
+
+}  // namespace pandas
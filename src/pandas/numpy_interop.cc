@@ -5,11 +5,17 @@
 
 #include <numpy/arrayobject.h>
 
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <type_traits>
 
 #include "pandas/common.h"
+#include "pandas/memory.h"
 #include "pandas/types/boolean.h"
 #include "pandas/types/numeric.h"
+#include "pandas/types/string.h"
+#include "pandas/util/bit-util.h"
 
 namespace pandas {
 
@@ -60,21 +66,100 @@ Status numpy_type_num_to_pandas(int type_num, DataType::TypeId* pandas_type) {
   return Status::OK();
 }
 
-template <int NPY_TYPE>
-static Status convert_numpy_array(PyObject* arr, Array** out) {
-  // typedef typename NumPyTraits<NPY_TYPE>::ArrayType ArrayType;
-  // ArrayType* inst = new ArrayType();
-  // RETURN_NOT_OK(inst->InitFromNumpy(arr));
-  // *out = static_cast<Array*>(inst);
+// Usually returns early, as masks with any missing values tend to have one
+// near the front
+static bool AnyNonZero(const uint8_t* bytes, int64_t length) {
+  constexpr int64_t kBlockSize = 256;
+  int64_t i = 0;
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+    // OR the block together and test once, rather than testing every byte
+    uint8_t any = 0;
+    for (int64_t j = 0; j < kBlockSize; ++j) {
+      any |= bytes[i + j];
+    }
+    if (any) { return true; }
+  }
+  for (; i < length; ++i) {
+    if (bytes[i]) { return true; }
+  }
+  return false;
+}
+
+// The validity bitmap is only allocated if some value is masked
+static Status mask_to_valid_bits(const uint8_t* mask, int64_t length,
+    std::shared_ptr<Buffer>* valid_bits, int64_t* null_count) {
+  *null_count = 0;
+  if (mask != nullptr && AnyNonZero(mask, length)) {
+    auto bitmap = std::make_shared<PoolBuffer>(default_memory_pool());
+    RETURN_NOT_OK(bitmap->Resize(BitUtil::BytesForBits(length)));
+    *null_count = length - InvertedBytesToBits(mask, length, bitmap->mutable_data());
+    *valid_bits = bitmap;
+  }
+  return Status::OK();
+}
+
+// Integer nulls are recorded in a validity bitmap
+template <typename ArrayType>
+static Status make_masked_array(int64_t length, const std::shared_ptr<Buffer>& data,
+    const uint8_t* mask, std::false_type, Array** out) {
+  std::shared_ptr<Buffer> valid_bits;
+  int64_t null_count;
+  RETURN_NOT_OK(mask_to_valid_bits(mask, length, &valid_bits, &null_count));
+  *out = new ArrayType(length, data, valid_bits, null_count);
+  return Status::OK();
+}
+
+// Floating point nulls are NaN, so masked values are written into a copy of
+// the data rather than into the NumPy array
+template <typename ArrayType>
+static Status make_masked_array(int64_t length, const std::shared_ptr<Buffer>& data,
+    const uint8_t* mask, std::true_type, Array** out) {
+  typedef typename ArrayType::T T;
+
+  std::shared_ptr<Buffer> values = data;
+  if (mask != nullptr && AnyNonZero(mask, length)) {
+    auto copied = std::make_shared<PoolBuffer>(default_memory_pool());
+    RETURN_NOT_OK(copied->Resize(length * sizeof(T)));
+    const T* src = reinterpret_cast<const T*>(data->data());
+    T* dst = reinterpret_cast<T*>(copied->mutable_data());
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    for (int64_t i = 0; i < length; ++i) {
+      dst[i] = mask[i] ? nan : src[i];
+    }
+    values = copied;
+  }
+  *out = new ArrayType(length, values);
   return Status::OK();
 }
 
-#define NUMPY_CONVERTER_CASE(NP_NAME, PD_NAME)                   \
-  case NPY_##NP_NAME:                                            \
-    RETURN_NOT_OK(convert_numpy_array<NPY_##NP_NAME>(arr, out)); \
+// mask is one byte per value, nonzero where the value is missing, or nullptr
+template <int NPY_TYPE>
+static Status convert_numpy_array(PyObject* arr, const uint8_t* mask, Array** out) {
+  typedef typename NumPyTraits<NPY_TYPE>::ArrayType ArrayType;
+
+  auto np_arr = reinterpret_cast<PyArrayObject*>(arr);
+  if (PyArray_NDIM(np_arr) != 1) {
+    return Status::Invalid("Only support 1-dimensional NumPy arrays for now");
+  }
+
+  // Returns a new reference to the same array if it is already contiguous,
+  // aligned and native-endian, and a copy otherwise. Steals the descr
+  OwnedRef contiguous(reinterpret_cast<PyObject*>(PyArray_FromArray(
+      np_arr, PyArray_DescrFromType(NPY_TYPE), NPY_ARRAY_IN_ARRAY)));
+  RETURN_IF_PYERROR();
+
+  auto data = std::make_shared<NumPyArrayBuffer>(
+      reinterpret_cast<PyArrayObject*>(contiguous.obj()));
+  return make_masked_array<ArrayType>(PyArray_SIZE(np_arr), data, mask,
+      std::is_floating_point<typename ArrayType::T>(), out);
+}
+
+#define NUMPY_CONVERTER_CASE(NP_NAME, PD_NAME)                         \
+  case NPY_##NP_NAME:                                                  \
+    RETURN_NOT_OK(convert_numpy_array<NPY_##NP_NAME>(arr, mask, out)); \
     break;
 
-Status array_from_numpy(PyObject* arr, Array** out) {
+static Status convert_numpy(PyObject* arr, const uint8_t* mask, Array** out) {
   int type_num = PyArray_TYPE(reinterpret_cast<PyArrayObject*>(arr));
   switch (type_num) {
     NUMPY_CONVERTER_CASE(INT8, Int8Array);
@@ -87,7 +172,7 @@ Status array_from_numpy(PyObject* arr, Array** out) {
     NUMPY_CONVERTER_CASE(UINT64, UINT64);
     NUMPY_CONVERTER_CASE(FLOAT32, FLOAT);
     NUMPY_CONVERTER_CASE(FLOAT64, DOUBLE);
-    NUMPY_CONVERTER_CASE(BOOL, BOOL);
+    // NUMPY_CONVERTER_CASE(BOOL, BOOL);
     // NUMPY_CONVERTER_CASE(OBJECT, PYOBJECT);
     default:
       return Status::NotImplemented("unsupported numpy type");
@@ -95,10 +180,105 @@ Status array_from_numpy(PyObject* arr, Array** out) {
   return Status::OK();
 }
 
+Status array_from_numpy(PyObject* arr, Array** out) {
+  return convert_numpy(arr, nullptr, out);
+}
+
+static Status check_mask(PyArrayObject* np_mask, int64_t length) {
+  if (PyArray_NDIM(np_mask) != 1 || PyArray_ITEMSIZE(np_mask) != 1 ||
+      !(PyArray_ISBOOL(np_mask) || PyArray_ISINTEGER(np_mask))) {
+    return Status::Invalid("Mask must be a 1-dimensional bool or uint8 array");
+  }
+  if (PyArray_SIZE(np_mask) != length) {
+    return Status::Invalid("Mask must be the same length as the array");
+  }
+  return Status::OK();
+}
+
 // Convert a NumPy array to a pandas::Array with appropriate missing values set
 // according to the passed uint8 dtype mask array
 Status array_from_masked_numpy(PyObject* arr, PyObject* mask, Array** out) {
-  return Status::NotImplemented("NYI");
+  auto np_mask = reinterpret_cast<PyArrayObject*>(mask);
+  RETURN_NOT_OK(check_mask(np_mask, PyArray_SIZE(reinterpret_cast<PyArrayObject*>(arr))));
+
+  OwnedRef contiguous_mask(reinterpret_cast<PyObject*>(
+      PyArray_FromArray(np_mask, nullptr, NPY_ARRAY_IN_ARRAY)));
+  RETURN_IF_PYERROR();
+
+  auto mask_data = reinterpret_cast<const uint8_t*>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject*>(contiguous_mask.obj())));
+  return convert_numpy(arr, mask_data, out);
+}
+
+Status string_array_from_numpy(
+    PyObject* offsets, PyObject* data, PyObject* mask, Array** out) {
+  auto np_offsets = reinterpret_cast<PyArrayObject*>(offsets);
+  auto np_data = reinterpret_cast<PyArrayObject*>(data);
+  if (PyArray_NDIM(np_offsets) != 1 || PyArray_NDIM(np_data) != 1) {
+    return Status::Invalid("Only support 1-dimensional NumPy arrays for now");
+  }
+  if (PyArray_TYPE(np_offsets) != NPY_INT32 || PyArray_ITEMSIZE(np_data) != 1) {
+    return Status::Invalid("Offsets must be int32 and data uint8");
+  }
+  const int64_t length = PyArray_SIZE(np_offsets) - 1;
+  if (length < 0) { return Status::Invalid("Offsets must have length + 1 entries"); }
+
+  OwnedRef contiguous_offsets(reinterpret_cast<PyObject*>(
+      PyArray_FromArray(np_offsets, nullptr, NPY_ARRAY_IN_ARRAY)));
+  RETURN_IF_PYERROR();
+  OwnedRef contiguous_data(reinterpret_cast<PyObject*>(
+      PyArray_FromArray(np_data, nullptr, NPY_ARRAY_IN_ARRAY)));
+  RETURN_IF_PYERROR();
+
+  auto offsets_buffer = std::make_shared<NumPyArrayBuffer>(
+      reinterpret_cast<PyArrayObject*>(contiguous_offsets.obj()));
+  auto data_buffer = std::make_shared<NumPyArrayBuffer>(
+      reinterpret_cast<PyArrayObject*>(contiguous_data.obj()));
+
+  // Kernels read the values without bounds checks
+  const int32_t* offset_values = reinterpret_cast<const int32_t*>(offsets_buffer->data());
+  bool ordered = offset_values[0] >= 0 && offset_values[length] <= data_buffer->size();
+  for (int64_t i = 0; i < length; ++i) {
+    ordered &= offset_values[i] <= offset_values[i + 1];
+  }
+  if (!ordered) {
+    return Status::Invalid("Offsets must be increasing and within the data");
+  }
+
+  const uint8_t* mask_data = nullptr;
+  OwnedRef contiguous_mask;
+  if (mask != nullptr && mask != Py_None) {
+    auto np_mask = reinterpret_cast<PyArrayObject*>(mask);
+    RETURN_NOT_OK(check_mask(np_mask, length));
+    contiguous_mask.reset(reinterpret_cast<PyObject*>(
+        PyArray_FromArray(np_mask, nullptr, NPY_ARRAY_IN_ARRAY)));
+    RETURN_IF_PYERROR();
+    mask_data = reinterpret_cast<const uint8_t*>(
+        PyArray_DATA(reinterpret_cast<PyArrayObject*>(contiguous_mask.obj())));
+  }
+
+  std::shared_ptr<Buffer> valid_bits;
+  int64_t null_count;
+  RETURN_NOT_OK(mask_to_valid_bits(mask_data, length, &valid_bits, &null_count));
+  *out = new StringArray(length, offsets_buffer, data_buffer, valid_bits, null_count);
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Zero-copy buffer
+
+NumPyArrayBuffer::NumPyArrayBuffer(PyArrayObject* arr)
+    : ForeignBuffer(reinterpret_cast<const uint8_t*>(PyArray_DATA(arr)),
+          PyArray_NBYTES(arr)),
+      arr_(arr) {
+  Py_INCREF(arr_);
+}
+
+NumPyArrayBuffer::~NumPyArrayBuffer() {
+  // The last reference to an array may be dropped on a thread not holding the
+  // GIL
+  PyAcquireGIL lock;
+  Py_DECREF(arr_);
 }
 
 // ----------------------------------------------------------------------
@@ -47,9 +47,29 @@ inline int import_numpy() {
 
 Status numpy_type_num_to_pandas(int type_num, DataType::TypeId* pandas_type);
 
+// The resulting array references the NumPy array's memory without copying it,
+// unless the array is strided, misaligned or not in native byte order
 Status array_from_numpy(PyObject* arr, Array** out);
 Status array_from_masked_numpy(PyObject* arr, PyObject* mask, Array** out);
 
+// A StringArray over int32 offsets and uint8 data arrays, referencing their
+// memory; mask is a bool array, true where the value is missing, or nullptr
+Status string_array_from_numpy(
+    PyObject* offsets, PyObject* data, PyObject* mask, Array** out);
+
+// Zero-copy Buffer over the memory of a contiguous NumPy array. Holds a
+// reference to the array until the buffer is destroyed
+class PANDAS_EXPORT NumPyArrayBuffer : public ForeignBuffer {
+ public:
+  explicit NumPyArrayBuffer(PyArrayObject* arr);
+  ~NumPyArrayBuffer();
+
+  PyArrayObject* array() const { return arr_; }
+
+ private:
+  PyArrayObject* arr_;
+};
+
 // Container for strided (but contiguous) data contained in a NumPy array
 class NumPyBuffer {
  public:
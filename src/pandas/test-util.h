@@ -6,6 +6,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "pandas/common.h"
+
 #define ASSERT_RAISES(ENUM, expr) \
   do {                            \
     Status s = (expr);            \
@@ -24,4 +31,27 @@
     EXPECT_TRUE(s.ok()); \
   } while (0)
 
+namespace pandas {
+
+inline std::shared_ptr<Buffer> BitmapFromVector(const std::vector<bool>& is_valid) {
+  auto buffer = std::make_shared<PoolBuffer>();
+  int64_t nbytes = BitUtil::BytesForBits(is_valid.size());
+  EXPECT_OK(buffer->Resize(nbytes));
+  memset(buffer->mutable_data(), 0, nbytes);
+  for (size_t i = 0; i < is_valid.size(); ++i) {
+    if (is_valid[i]) { BitUtil::SetBit(buffer->mutable_data(), i); }
+  }
+  return buffer;
+}
+
+// Wraps the vector's memory without copying it, so values must outlive the
+// buffer
+template <typename T>
+std::shared_ptr<Buffer> BufferFromVector(const std::vector<T>& values) {
+  return std::make_shared<Buffer>(
+      reinterpret_cast<const uint8_t*>(values.data()), values.size() * sizeof(T));
+}
+
+}  // namespace pandas
+
 #endif  // PANDAS_TEST_UTIL_H_
@@ -16,6 +16,13 @@ std::string PyObjectType::ToString() const {
   return name();
 }
 
+// ----------------------------------------------------------------------
+// String
+
+std::string StringType::ToString() const {
+  return name();
+}
+
 // ----------------------------------------------------------------------
 // Timestamp
 
@@ -94,6 +94,17 @@ class PANDAS_EXPORT PyObjectType : public DataType {
   std::string ToString() const override;
 };
 
+class PANDAS_EXPORT StringType : public DataType {
+ public:
+  StringType() : DataType(DataType::STRING) {}
+
+  StringType(const StringType& other) : StringType() {}
+
+  static char const* name() { return "string"; }
+
+  std::string ToString() const override;
+};
+
 template <typename DERIVED, typename C_TYPE, DataType::TypeId TYPE_ID,
     std::size_t SIZE = sizeof(C_TYPE)>
 class PANDAS_EXPORT NumericType : public DataType {
@@ -12,13 +12,24 @@ namespace pandas {
 
 Status CopyBitmap(const std::shared_ptr<Buffer>& bitmap, int64_t bit_offset,
     int64_t length, std::shared_ptr<Buffer>* out) {
-  // TODO(wesm): Optimize this bitmap copy for each bit_offset mod 8
   int64_t nbytes = BitUtil::BytesForBits(length);
   auto buf = std::make_shared<PoolBuffer>();
   RETURN_NOT_OK(buf->Resize(nbytes));
 
-  // Set to all 1s, since all valid
-  memset(buf->mutable_data(), 0xFF, nbytes);
+  const uint8_t* src = bitmap->data() + bit_offset / 8;
+  uint8_t* dst = buf->mutable_data();
+  const int shift = bit_offset % 8;
+  if (shift == 0) {
+    memcpy(dst, src, nbytes);
+  } else {
+    // Each output byte straddles two input bytes. The last input byte is only
+    // read if the copied range reaches into it
+    const int64_t src_nbytes = BitUtil::BytesForBits(shift + length);
+    for (int64_t i = 0; i < nbytes; ++i) {
+      uint8_t next = i + 1 < src_nbytes ? src[i + 1] : 0;
+      dst[i] = static_cast<uint8_t>((src[i] >> shift) | (next << (8 - shift)));
+    }
+  }
 
   *out = buf;
   return Status::OK();
@@ -36,4 +47,9 @@ Status AllocateValidityBitmap(int64_t length, std::shared_ptr<Buffer>* out) {
   return Status::OK();
 }
 
+bool OwnsBuffer(const std::shared_ptr<Buffer>& buffer) {
+  return buffer.use_count() == 1 &&
+         dynamic_cast<const ForeignBuffer*>(buffer.get()) == nullptr;
+}
+
 }  // namespace pandas
@@ -15,4 +15,8 @@ Status CopyBitmap(const std::shared_ptr<Buffer>& bitmap, int64_t bit_offset,
 
 Status AllocateValidityBitmap(int64_t length, std::shared_ptr<Buffer>* out);
 
+// True if the buffer is referenced only by the caller and its memory is not
+// owned by some other object
+bool OwnsBuffer(const std::shared_ptr<Buffer>& buffer);
+
 }  // namespace pandas
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 
 #include "pandas/common.h"
@@ -13,6 +14,7 @@
 #include "pandas/pytypes.h"
 #include "pandas/type.h"
 #include "pandas/types/common.h"
+#include "pandas/util/bit-util.h"
 
 namespace pandas {
 
@@ -20,9 +22,9 @@ namespace pandas {
 // Generic numeric class
 
 template <typename TYPE>
-NumericArray<TYPE>::NumericArray(
-    const DataTypePtr& type, int64_t length, const std::shared_ptr<Buffer>& data)
-    : Array(type, length), data_(data) {}
+NumericArray<TYPE>::NumericArray(const DataTypePtr& type, int64_t length,
+    const std::shared_ptr<Buffer>& data, int64_t null_count)
+    : Array(type, length, null_count), data_(data) {}
 
 template <typename TYPE>
 auto NumericArray<TYPE>::data() const -> const T* {
@@ -35,6 +37,18 @@ auto NumericArray<TYPE>::mutable_data() const -> T* {
   return reinterpret_cast<T*>(mutable_buf->mutable_data());
 }
 
+// Instantiate templates
+template class NumericArray<UInt8Type>;
+template class NumericArray<Int8Type>;
+template class NumericArray<UInt16Type>;
+template class NumericArray<Int16Type>;
+template class NumericArray<UInt32Type>;
+template class NumericArray<Int32Type>;
+template class NumericArray<UInt64Type>;
+template class NumericArray<Int64Type>;
+template class NumericArray<FloatType>;
+template class NumericArray<DoubleType>;
+
 // ----------------------------------------------------------------------
 // Floating point class
 
@@ -43,9 +57,14 @@ FloatingArray<TYPE>::FloatingArray(int64_t length, const std::shared_ptr<Buffer>
     : NumericArray<TYPE>(TYPE::SINGLETON, length, data) {}
 
 template <typename TYPE>
-int64_t FloatingArray<TYPE>::GetNullCount() {
-  // TODO(wesm)
-  return 0;
+int64_t FloatingArray<TYPE>::ComputeNullCount() const {
+  const typename TYPE::c_type* values = this->data();
+  int64_t count = 0;
+  for (int64_t i = 0; i < this->length_; ++i) {
+    // NaN is the only value unequal to itself
+    count += values[i] != values[i];
+  }
+  return count;
 }
 
 template <typename TYPE>
@@ -68,12 +87,25 @@ Status FloatingArray<TYPE>::Copy(
 
 template <typename TYPE>
 Status FloatingArray<TYPE>::SetItem(int64_t i, PyObject* val) {
+  if (!this->data_->is_mutable()) {
+    return Status::Invalid("Underlying buffer is immutable");
+  }
+
+  double cval;
+  if (py::is_na(val)) {
+    cval = std::numeric_limits<double>::quiet_NaN();
+  } else {
+    cval = PyFloat_AsDouble(val);
+    RETURN_IF_PYERROR();
+  }
+  this->mutable_data()[i] = static_cast<typename TYPE::c_type>(cval);
+  this->InvalidateNullCount();
   return Status::OK();
 }
 
 template <typename TYPE>
 bool FloatingArray<TYPE>::owns_data() const {
-  return this->data_.use_count() == 1;
+  return OwnsBuffer(this->data_);
 }
 
 // Instantiate templates
@@ -92,14 +124,14 @@ IntegerArray<TYPE>::IntegerArray(int64_t length, const std::shared_ptr<Buffer>&
 
 template <typename TYPE>
 IntegerArray<TYPE>::IntegerArray(int64_t length, const std::shared_ptr<Buffer>& data,
-    const std::shared_ptr<Buffer>& valid_bits)
-    : NumericArray<TYPE>(TYPE::SINGLETON, length, data), valid_bits_(valid_bits) {}
+    const std::shared_ptr<Buffer>& valid_bits, int64_t null_count)
+    : NumericArray<TYPE>(TYPE::SINGLETON, length, data, valid_bits ? null_count : 0),
+      valid_bits_(valid_bits) {}
 
 template <typename TYPE>
-int64_t IntegerArray<TYPE>::GetNullCount() {
-  // TODO(wesm)
-  // return nulls_.set_count();
-  return 0;
+int64_t IntegerArray<TYPE>::ComputeNullCount() const {
+  if (!valid_bits_) { return 0; }
+  return this->length_ - CountSetBits(valid_bits_->data(), 0, this->length_);
 }
 
 template <typename TYPE>
@@ -113,8 +145,8 @@ PyObject* IntegerArray<TYPE>::GetItem(int64_t i) {
 
 template <typename TYPE>
 bool IntegerArray<TYPE>::owns_data() const {
-  bool owns_data = this->data_.use_count() == 1;
-  if (valid_bits_) { owns_data &= valid_bits_.use_count() == 1; }
+  bool owns_data = OwnsBuffer(this->data_);
+  if (valid_bits_) { owns_data &= OwnsBuffer(valid_bits_); }
   return owns_data;
 }
 
@@ -128,10 +160,13 @@ Status IntegerArray<TYPE>::Copy(
 
   RETURN_NOT_OK(this->data_->Copy(offset * itemsize, length * itemsize, &copied_data));
 
+  int64_t null_count = Array::kUnknownNullCount;
   if (valid_bits_) {
-    RETURN_NOT_OK(CopyBitmap(this->data_, offset, length, &copied_valid_bits));
+    RETURN_NOT_OK(CopyBitmap(valid_bits_, offset, length, &copied_valid_bits));
+    if (offset == 0 && length == this->length_) { null_count = this->GetNullCount(); }
   }
-  *out = std::make_shared<FloatingArray<TYPE>>(length, copied_data);
+  *out = std::make_shared<IntegerArray<TYPE>>(
+      length, copied_data, copied_valid_bits, null_count);
   return Status::OK();
 }
 
@@ -151,7 +186,7 @@ Status IntegerArray<TYPE>::SetItem(int64_t i, PyObject* val) {
     return Status::Invalid("Underlying buffer is immutable");
   }
 
-  if (!valid_bits_->is_mutable()) {
+  if (valid_bits_ && !valid_bits_->is_mutable()) {
     // TODO(wesm): copy-on-write?
     return Status::Invalid("Valid bits buffer is immutable");
   }
@@ -164,14 +199,17 @@ Status IntegerArray<TYPE>::SetItem(int64_t i, PyObject* val) {
     auto mutable_bits = static_cast<MutableBuffer*>(valid_bits_.get())->mutable_data();
     BitUtil::ClearBit(mutable_bits, i);
   } else {
-    auto mutable_bits = static_cast<MutableBuffer*>(valid_bits_.get())->mutable_data();
-    if (valid_bits_) { BitUtil::SetBit(mutable_bits, i); }
     int64_t cval;
     RETURN_NOT_OK(PyObjectToInt64(val, &cval));
+    if (valid_bits_) {
+      auto mutable_bits = static_cast<MutableBuffer*>(valid_bits_.get())->mutable_data();
+      BitUtil::SetBit(mutable_bits, i);
+    }
 
     // Overflow issues
     this->mutable_data()[i] = cval;
   }
+  this->InvalidateNullCount();
   RETURN_IF_PYERROR();
   return Status::OK();
 }
@@ -18,10 +18,13 @@ class PANDAS_EXPORT NumericArray : public Array {
   using DataTypePtr = std::shared_ptr<TYPE>;
   using Array::Array;
 
-  NumericArray(
-      const DataTypePtr& type, int64_t length, const std::shared_ptr<Buffer>& data);
+  NumericArray(const DataTypePtr& type, int64_t length,
+      const std::shared_ptr<Buffer>& data, int64_t null_count = kUnknownNullCount);
 
   auto data() const -> const T*;
+
+  // Writing through this pointer bypasses the null count cache; prefer
+  // SetItem
   auto mutable_data() const -> T*;
 
  protected:
@@ -32,10 +35,11 @@ template <typename TYPE>
 class PANDAS_EXPORT IntegerArray : public NumericArray<TYPE> {
  public:
   IntegerArray(int64_t length, const std::shared_ptr<Buffer>& data);
+  // If known, the number of cleared bits in valid_bits can be passed to save
+  // counting them later
   IntegerArray(int64_t length, const std::shared_ptr<Buffer>& data,
-      const std::shared_ptr<Buffer>& valid_bits);
-
-  int64_t GetNullCount() override;
+      const std::shared_ptr<Buffer>& valid_bits,
+      int64_t null_count = Array::kUnknownNullCount);
 
   Status Copy(int64_t offset, int64_t length, std::shared_ptr<Array>* out) const override;
 
@@ -44,6 +48,12 @@ class PANDAS_EXPORT IntegerArray : public NumericArray<TYPE> {
 
   bool owns_data() const override;
 
+  // Validity bitmap, or nullptr when every value is valid
+  const std::shared_ptr<Buffer>& valid_bits() const { return valid_bits_; }
+
+ protected:
+  int64_t ComputeNullCount() const override;
+
  private:
   std::shared_ptr<Buffer> valid_bits_;
 };
@@ -57,9 +67,11 @@ class PANDAS_EXPORT FloatingArray : public NumericArray<TYPE> {
   PyObject* GetItem(int64_t i) override;
   Status SetItem(int64_t i, PyObject* val) override;
 
-  int64_t GetNullCount() override;
-
   bool owns_data() const override;
+
+ protected:
+  // NaN is null
+  int64_t ComputeNullCount() const override;
 };
 
 using FloatArray = FloatingArray<FloatType>;
@@ -78,6 +90,16 @@ using Int64Array = IntegerArray<Int64Type>;
 using UInt64Array = IntegerArray<UInt64Type>;
 
 // Only instantiate these templates once
+extern template class PANDAS_EXPORT NumericArray<Int8Type>;
+extern template class PANDAS_EXPORT NumericArray<UInt8Type>;
+extern template class PANDAS_EXPORT NumericArray<Int16Type>;
+extern template class PANDAS_EXPORT NumericArray<UInt16Type>;
+extern template class PANDAS_EXPORT NumericArray<Int32Type>;
+extern template class PANDAS_EXPORT NumericArray<UInt32Type>;
+extern template class PANDAS_EXPORT NumericArray<Int64Type>;
+extern template class PANDAS_EXPORT NumericArray<UInt64Type>;
+extern template class PANDAS_EXPORT NumericArray<FloatType>;
+extern template class PANDAS_EXPORT NumericArray<DoubleType>;
 extern template class PANDAS_EXPORT IntegerArray<Int8Type>;
 extern template class PANDAS_EXPORT IntegerArray<UInt8Type>;
 extern template class PANDAS_EXPORT IntegerArray<Int16Type>;
@@ -0,0 +1,83 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "pandas/types/string.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "pandas/common.h"
+#include "pandas/memory.h"
+#include "pandas/pytypes.h"
+#include "pandas/type.h"
+#include "pandas/types/common.h"
+#include "pandas/util/bit-util.h"
+
+namespace pandas {
+
+StringArray::StringArray(int64_t length, const std::shared_ptr<Buffer>& offsets,
+    const std::shared_ptr<Buffer>& data)
+    : StringArray(length, offsets, data, nullptr) {}
+
+StringArray::StringArray(int64_t length, const std::shared_ptr<Buffer>& offsets,
+    const std::shared_ptr<Buffer>& data, const std::shared_ptr<Buffer>& valid_bits,
+    int64_t null_count)
+    : Array(std::make_shared<StringType>(), length, valid_bits ? null_count : 0),
+      offsets_(offsets),
+      data_(data),
+      valid_bits_(valid_bits) {}
+
+int64_t StringArray::ComputeNullCount() const {
+  if (!valid_bits_) { return 0; }
+  return length_ - CountSetBits(valid_bits_->data(), 0, length_);
+}
+
+PyObject* StringArray::GetItem(int64_t i) {
+  if (IsNull(i)) {
+    Py_INCREF(py::NA);
+    return py::NA;
+  }
+  int32_t length;
+  const uint8_t* value = GetValue(i, &length);
+  return PyUnicode_DecodeUTF8(reinterpret_cast<const char*>(value), length, "strict");
+}
+
+Status StringArray::SetItem(int64_t i, PyObject* val) {
+  return Status::NotImplemented("StringArray values cannot be set in place");
+}
+
+bool StringArray::owns_data() const {
+  bool owns_data = OwnsBuffer(offsets_) && OwnsBuffer(data_);
+  if (valid_bits_) { owns_data &= OwnsBuffer(valid_bits_); }
+  return owns_data;
+}
+
+Status StringArray::Copy(
+    int64_t offset, int64_t length, std::shared_ptr<Array>* out) const {
+  const int32_t* offsets = this->offsets() + offset;
+  const int32_t start = offsets[0];
+
+  // The copied offsets start from 0 again
+  auto copied_offsets = std::make_shared<PoolBuffer>(default_memory_pool());
+  RETURN_NOT_OK(copied_offsets->Resize((length + 1) * sizeof(int32_t)));
+  int32_t* dst = reinterpret_cast<int32_t*>(copied_offsets->mutable_data());
+  for (int64_t i = 0; i <= length; ++i) {
+    dst[i] = offsets[i] - start;
+  }
+
+  std::shared_ptr<Buffer> copied_data;
+  RETURN_NOT_OK(data_->Copy(start, offsets[length] - start, &copied_data));
+
+  std::shared_ptr<Buffer> copied_valid_bits;
+  int64_t null_count = Array::kUnknownNullCount;
+  if (valid_bits_) {
+    RETURN_NOT_OK(CopyBitmap(valid_bits_, offset, length, &copied_valid_bits));
+    if (offset == 0 && length == length_) { null_count = GetNullCount(); }
+  }
+  *out = std::make_shared<StringArray>(
+      length, copied_offsets, copied_data, copied_valid_bits, null_count);
+  return Status::OK();
+}
+
+}  // namespace pandas
@@ -0,0 +1,77 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#pragma once
+
+#include "pandas/config.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "pandas/array.h"
+#include "pandas/common.h"
+#include "pandas/type.h"
+
+namespace pandas {
+
+// Variable-length UTF-8 strings in the Arrow layout: the bytes of all the
+// values back to back in one buffer, and an int32 offsets buffer of length + 1
+// entries, value i spanning [offsets[i], offsets[i + 1]) of the data. Null
+// values are recorded in a validity bitmap, which may be omitted if there are
+// none
+class PANDAS_EXPORT StringArray : public Array {
+ public:
+  StringArray(int64_t length, const std::shared_ptr<Buffer>& offsets,
+      const std::shared_ptr<Buffer>& data);
+  // If known, the number of cleared bits in valid_bits can be passed to save
+  // counting them later
+  StringArray(int64_t length, const std::shared_ptr<Buffer>& offsets,
+      const std::shared_ptr<Buffer>& data, const std::shared_ptr<Buffer>& valid_bits,
+      int64_t null_count = Array::kUnknownNullCount);
+
+  Status Copy(int64_t offset, int64_t length, std::shared_ptr<Array>* out) const override;
+
+  PyObject* GetItem(int64_t i) override;
+
+  // The values are packed together, so they cannot be replaced in place
+  Status SetItem(int64_t i, PyObject* val) override;
+
+  bool owns_data() const override;
+
+  const int32_t* offsets() const {
+    return reinterpret_cast<const int32_t*>(offsets_->data());
+  }
+  const uint8_t* data() const { return data_->data(); }
+
+  const std::shared_ptr<Buffer>& offsets_buffer() const { return offsets_; }
+  const std::shared_ptr<Buffer>& data_buffer() const { return data_; }
+
+  // Validity bitmap, or nullptr when every value is valid
+  const std::shared_ptr<Buffer>& valid_bits() const { return valid_bits_; }
+
+  bool IsNull(int64_t i) const {
+    return valid_bits_ && BitUtil::BitNotSet(valid_bits_->data(), i);
+  }
+
+  int32_t value_length(int64_t i) const {
+    const int32_t* offsets = this->offsets();
+    return offsets[i + 1] - offsets[i];
+  }
+
+  // The bytes of value i, which are not null-terminated
+  const uint8_t* GetValue(int64_t i, int32_t* length) const {
+    const int32_t* offsets = this->offsets();
+    *length = offsets[i + 1] - offsets[i];
+    return data_->data() + offsets[i];
+  }
+
+ protected:
+  int64_t ComputeNullCount() const override;
+
+ private:
+  std::shared_ptr<Buffer> offsets_;
+  std::shared_ptr<Buffer> data_;
+  std::shared_ptr<Buffer> valid_bits_;
+};
+
+}  // namespace pandas
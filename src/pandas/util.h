@@ -7,6 +7,8 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "pandas/util/bit-util.h"
+
 #define DISALLOW_COPY_AND_ASSIGN(TypeName) \
   TypeName(const TypeName&) = delete;      \
   void operator=(const TypeName&) = delete
@@ -43,27 +45,9 @@ static inline size_t next_power2(size_t n) {
   return n;
 }
 
-static void bytes_to_bits(uint8_t* bytes, size_t length, uint8_t* bits) {
-  for (size_t i = 0; i < length; ++i) {
-    set_bit(bits, i, static_cast<bool>(bytes[i]));
-  }
-}
-
-static uint8_t* bytes_to_bits(uint8_t* bytes, size_t length, size_t* out_length) {
-  if (!length) { return nullptr; }
-  size_t bit_length = *out_length = ceil_byte(length) / 8;
-
-  // TODO: it would be better to do this in preallocated memory
-  uint8_t* result = reinterpret_cast<uint8_t*>(malloc(bit_length));
-
-  if (result == nullptr) {
-    // malloc failed
-    return result;
-  }
-
-  memset(result, 0, bit_length);
-  bytes_to_bits(bytes, length, result);
-  return result;
+// bits must have room for ceil_byte(length) / 8 bytes, e.g. from a PoolBuffer
+static inline void bytes_to_bits(const uint8_t* bytes, size_t length, uint8_t* bits) {
+  BytesToBits(bytes, static_cast<int64_t>(length), bits);
 }
 
 }  // namespace util
@@ -0,0 +1,10 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "benchmark/benchmark.h"
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
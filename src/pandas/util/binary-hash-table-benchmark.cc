@@ -0,0 +1,51 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/util/binary-hash-table.h"
+
+namespace pandas {
+
+constexpr int64_t kLength = 1 << 20;
+
+// kLength strings of 8 to 24 bytes drawn from cardinality distinct values,
+// packed as offsets and data
+static void MakeStrings(
+    int64_t cardinality, std::vector<int32_t>* offsets, std::vector<uint8_t>* data) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+  offsets->assign(1, 0);
+  data->clear();
+  for (int64_t i = 0; i < kLength; ++i) {
+    const int64_t value = dist(rng);
+    const std::string s = "value_" + std::to_string(value) +
+                          std::string(static_cast<size_t>(value % 11), '.');
+    data->insert(data->end(), s.begin(), s.end());
+    offsets->push_back(static_cast<int32_t>(data->size()));
+  }
+}
+
+static void BM_Factorize(benchmark::State& state) {  // NOLINT non-const reference
+  std::vector<int32_t> offsets;
+  std::vector<uint8_t> data;
+  MakeStrings(state.range_x(), &offsets, &data);
+  std::vector<int64_t> labels(kLength);
+  while (state.KeepRunning()) {
+    BinaryHashTable table;
+    int64_t next_label = 0;
+    table.GetOrInsert(offsets.data(), data.data(), kLength, &next_label, labels.data());
+    benchmark::DoNotOptimize(labels.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(BM_Factorize)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+}  // namespace pandas
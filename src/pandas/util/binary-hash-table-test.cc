@@ -0,0 +1,146 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pandas/util/binary-hash-table.h"
+
+namespace pandas {
+
+static const uint8_t* Bytes(const std::string& s) {
+  return reinterpret_cast<const uint8_t*>(s.data());
+}
+
+// Packs strings into offsets and data
+static void Pack(const std::vector<std::string>& strings, std::vector<int32_t>* offsets,
+    std::string* data) {
+  offsets->assign(1, 0);
+  data->clear();
+  for (const auto& s : strings) {
+    data->append(s);
+    offsets->push_back(static_cast<int32_t>(data->size()));
+  }
+}
+
+TEST(BinaryHashTableTests, SetAndFind) {
+  BinaryHashTable table;
+  const std::string foo = "foo", bar = "bar", empty = "", prefix = "fo";
+  int64_t value;
+  ASSERT_FALSE(table.Find(Bytes(foo), foo.size(), &value));
+
+  ASSERT_TRUE(table.Set(Bytes(foo), foo.size(), 1));
+  ASSERT_TRUE(table.Set(Bytes(empty), 0, 2));
+  ASSERT_TRUE(table.Set(Bytes(bar), bar.size(), 3));
+  ASSERT_EQ(3, table.size());
+
+  ASSERT_TRUE(table.Find(Bytes(foo), foo.size(), &value));
+  ASSERT_EQ(1, value);
+  ASSERT_TRUE(table.Find(Bytes(empty), 0, &value));
+  ASSERT_EQ(2, value);
+  ASSERT_FALSE(table.Find(Bytes(prefix), prefix.size(), &value));
+
+  ASSERT_TRUE(table.Set(Bytes(foo), foo.size(), 10));
+  ASSERT_EQ(3, table.size());
+  ASSERT_TRUE(table.Find(Bytes(foo), foo.size(), &value));
+  ASSERT_EQ(10, value);
+
+  // The keys are kept in insertion order
+  const int64_t* offsets = table.key_offsets();
+  const uint8_t* data = table.key_data();
+  ASSERT_EQ("foo", std::string(reinterpret_cast<const char*>(data), offsets[1]));
+  ASSERT_EQ(offsets[1], offsets[2]);
+  ASSERT_EQ("bar", std::string(reinterpret_cast<const char*>(data + offsets[2]),
+                       offsets[3] - offsets[2]));
+}
+
+TEST(BinaryHashTableTests, KeysAreCopied) {
+  BinaryHashTable table;
+  std::string key = "mutable";
+  ASSERT_TRUE(table.Set(Bytes(key), key.size(), 1));
+  key[0] = 'n';
+  int64_t value;
+  ASSERT_FALSE(table.Find(Bytes(key), key.size(), &value));
+  const std::string original = "mutable";
+  ASSERT_TRUE(table.Find(Bytes(original), original.size(), &value));
+}
+
+TEST(BinaryHashTableTests, Factorize) {
+  std::vector<std::string> strings;
+  for (int i = 0; i < 50000; ++i) {
+    // Many keys share prefixes and lengths
+    strings.push_back("key_" + std::to_string((i * 7919) % 3001) +
+                      std::string(i % 17, 'x'));
+  }
+  std::vector<int32_t> offsets;
+  std::string data;
+  Pack(strings, &offsets, &data);
+
+  BinaryHashTable table;
+  std::vector<int64_t> labels(strings.size());
+  int64_t next_label = 0;
+  ASSERT_TRUE(table.GetOrInsert(offsets.data(), Bytes(data), strings.size(), &next_label,
+      labels.data()));
+
+  std::unordered_map<std::string, int64_t> expected;
+  for (size_t i = 0; i < strings.size(); ++i) {
+    auto it = expected.emplace(strings[i], expected.size()).first;
+    ASSERT_EQ(it->second, labels[i]);
+  }
+  ASSERT_EQ(static_cast<int64_t>(expected.size()), next_label);
+  ASSERT_EQ(next_label, table.size());
+
+  // The arena holds the uniques in label order
+  for (const auto& item : expected) {
+    const int64_t start = table.key_offsets()[item.second];
+    const int64_t length = table.key_offsets()[item.second + 1] - start;
+    ASSERT_EQ(item.first,
+        std::string(reinterpret_cast<const char*>(table.key_data() + start), length));
+  }
+
+  std::vector<int64_t> found(strings.size());
+  table.Find(offsets.data(), Bytes(data), strings.size(), -1, found.data());
+  ASSERT_EQ(labels, found);
+
+  const std::vector<std::string> missing = {"key_", "key_3001", "absent"};
+  Pack(missing, &offsets, &data);
+  table.Find(offsets.data(), Bytes(data), missing.size(), -1, found.data());
+  ASSERT_EQ(-1, found[0]);
+  ASSERT_EQ(-1, found[1]);
+  ASSERT_EQ(-1, found[2]);
+}
+
+TEST(BinaryHashTableTests, Skip) {
+  const std::vector<std::string> strings = {"a", "b", "a", "c", "b"};
+  const uint8_t skip[] = {0, 1, 0, 0, 0};
+  std::vector<int32_t> offsets;
+  std::string data;
+  Pack(strings, &offsets, &data);
+
+  BinaryHashTable table;
+  int64_t labels[5];
+  int64_t next_label = 0;
+  ASSERT_TRUE(table.GetOrInsert(offsets.data(), Bytes(data), 5, &next_label, labels,
+      skip, -1));
+  ASSERT_EQ(0, labels[0]);
+  ASSERT_EQ(-1, labels[1]);
+  ASSERT_EQ(0, labels[2]);
+  ASSERT_EQ(1, labels[3]);
+  ASSERT_EQ(2, labels[4]);
+  ASSERT_EQ(3, next_label);
+
+  // Single keys continue the labels
+  int64_t value;
+  ASSERT_TRUE(table.GetOrInsert(Bytes(strings[3]), 1, &next_label, &value));
+  ASSERT_EQ(1, value);
+  const std::string d = "d";
+  ASSERT_TRUE(table.GetOrInsert(Bytes(d), 1, &next_label, &value));
+  ASSERT_EQ(3, value);
+  ASSERT_EQ(4, next_label);
+}
+
+}  // namespace pandas
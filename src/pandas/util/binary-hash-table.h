@@ -0,0 +1,275 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Hash table from byte strings to int64 values, with the same layout of
+// control bytes and 16-slot groups as HashTable (see hash-table.h).
+//
+// The keys are copied into one contiguous arena in insertion order, so the
+// table owns them and they can be read back as offsets and data, the layout
+// of StringArray. A slot holds the full 64-bit hash of its key next to its
+// position in the arena: a probe compares hashes first and only then the
+// lengths and bytes, and growing the table never hashes a key again.
+//
+// This header does not depend on Arrow. Allocation failures are reported by
+// returning false.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "pandas/util/hash-table.h"
+#include "pandas/util/hash-util.h"
+#include "pandas/util/macros.h"
+
+namespace pandas {
+
+class BinaryHashTable {
+ public:
+  BinaryHashTable()
+      : ctrl_(nullptr), slots_(nullptr), capacity_(0), group_mask_(0), size_(0),
+        max_size_(0), key_data_(nullptr), key_data_capacity_(0), key_offsets_(nullptr),
+        key_offsets_capacity_(0) {}
+
+  ~BinaryHashTable() {
+    free(ctrl_);
+    free(slots_);
+    free(key_data_);
+    free(key_offsets_);
+  }
+
+  // Number of keys
+  int64_t size() const { return size_; }
+
+  // Number of slots
+  int64_t capacity() const { return capacity_; }
+
+  // The keys in insertion order: key i is the key_offsets()[i + 1] -
+  // key_offsets()[i] bytes at key_data() + key_offsets()[i]. Both are null
+  // while the table is empty, and inserting keys invalidates them
+  const uint8_t* key_data() const { return key_data_; }
+  const int64_t* key_offsets() const { return key_offsets_; }
+
+  // Makes room for size keys without growing again
+  bool Reserve(int64_t size) {
+    if (size <= max_size_) { return true; }
+    int64_t capacity = std::max(int64_t(kGroupSize), capacity_ * 2);
+    while (capacity - capacity / 8 < size) {
+      capacity *= 2;
+    }
+    return Rehash(capacity);
+  }
+
+  // Sets *value to the value of key if it is present
+  bool Find(const uint8_t* key, int64_t length, int64_t* value) const {
+    if (size_ == 0) { return false; }
+    bool found;
+    const int64_t i = Probe(key, length, HashUtil::HashBytes(key, length), &found);
+    if (found) { *value = slots_[i].value; }
+    return found;
+  }
+
+  // Sets the value of key, inserting it if needed
+  bool Set(const uint8_t* key, int64_t length, int64_t value) {
+    if (!Reserve(size_ + 1)) { return false; }
+    const uint64_t hash = HashUtil::HashBytes(key, length);
+    bool found;
+    const int64_t i = Probe(key, length, hash, &found);
+    if (found) {
+      slots_[i].value = value;
+      return true;
+    }
+    return InsertAt(i, key, length, hash, value);
+  }
+
+  // Sets *value to the value of key, inserting it with the value
+  // (*next_value)++ if it is not present
+  bool GetOrInsert(const uint8_t* key, int64_t length, int64_t* next_value,
+      int64_t* value) {
+    if (!Reserve(size_ + 1)) { return false; }
+    const uint64_t hash = HashUtil::HashBytes(key, length);
+    bool found;
+    const int64_t i = Probe(key, length, hash, &found);
+    if (!found && !InsertAt(i, key, length, hash, *next_value)) { return false; }
+    if (!found) { ++*next_value; }
+    *value = slots_[i].value;
+    return true;
+  }
+
+  // The batch operations take the keys as offsets and data: key i is the
+  // offsets[i + 1] - offsets[i] bytes at data + offsets[i]
+
+  // values[i] is the value of key i, or missing if it is not present
+  void Find(const int32_t* offsets, const uint8_t* data, int64_t length, int64_t missing,
+      int64_t* values) const {
+    if (size_ == 0) {
+      std::fill(values, values + length, missing);
+      return;
+    }
+    uint64_t hashes[kBatchSize];
+    for (int64_t start = 0; start < length; start += kBatchSize) {
+      const int64_t n = std::min(int64_t(kBatchSize), length - start);
+      HashBatch(offsets + start, data, n, hashes);
+      for (int64_t k = 0; k < n; ++k) {
+        const int32_t* key_offsets = offsets + start + k;
+        bool found;
+        const int64_t i = Probe(
+            data + key_offsets[0], key_offsets[1] - key_offsets[0], hashes[k], &found);
+        values[start + k] = found ? slots_[i].value : missing;
+      }
+    }
+  }
+
+  // values[i] is the value of key i, where keys not yet present are inserted
+  // with the values *next_value, *next_value + 1, ... in order of first
+  // occurrence. Keys for which skip (if given) is nonzero are not inserted
+  // and get skip_value instead
+  bool GetOrInsert(const int32_t* offsets, const uint8_t* data, int64_t length,
+      int64_t* next_value, int64_t* values, const uint8_t* skip = nullptr,
+      int64_t skip_value = -1) {
+    uint64_t hashes[kBatchSize];
+    for (int64_t start = 0; start < length; start += kBatchSize) {
+      const int64_t n = std::min(int64_t(kBatchSize), length - start);
+      // The table must not grow between hashing a batch and probing for it
+      if (!Reserve(size_ + n)) { return false; }
+      HashBatch(offsets + start, data, n, hashes);
+      for (int64_t k = 0; k < n; ++k) {
+        if (skip != nullptr && skip[start + k]) {
+          values[start + k] = skip_value;
+          continue;
+        }
+        const uint8_t* key = data + offsets[start + k];
+        const int64_t key_length = offsets[start + k + 1] - offsets[start + k];
+        bool found;
+        const int64_t i = Probe(key, key_length, hashes[k], &found);
+        if (!found) {
+          if (!InsertAt(i, key, key_length, hashes[k], *next_value)) { return false; }
+          ++*next_value;
+        }
+        values[start + k] = slots_[i].value;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr int64_t kGroupSize = internal::kHashGroupSize;
+  static constexpr int64_t kBatchSize = 16;
+  static constexpr int8_t kEmpty = internal::kHashEmpty;
+
+  struct Slot {
+    uint64_t hash;
+    // Position of the key in insertion order
+    int64_t index;
+    int64_t value;
+  };
+
+  void HashBatch(
+      const int32_t* offsets, const uint8_t* data, int64_t n, uint64_t* hashes) const {
+    for (int64_t k = 0; k < n; ++k) {
+      hashes[k] = HashUtil::HashBytes(data + offsets[k], offsets[k + 1] - offsets[k]);
+      const int64_t group = (hashes[k] >> 7) & group_mask_;
+      internal::Prefetch(ctrl_ + group * kGroupSize);
+      internal::Prefetch(slots_ + group * kGroupSize);
+    }
+  }
+
+  bool KeyEquals(const Slot& slot, const uint8_t* key, int64_t length) const {
+    const int64_t start = key_offsets_[slot.index];
+    return key_offsets_[slot.index + 1] - start == length &&
+           memcmp(key_data_ + start, key, length) == 0;
+  }
+
+  // The slot holding key, or if it is absent the first empty slot on its
+  // probe sequence
+  int64_t Probe(const uint8_t* key, int64_t length, uint64_t hash, bool* found) const {
+    return internal::HashProbe(ctrl_, group_mask_, hash,
+        [this, key, length, hash](int64_t i) {
+          return slots_[i].hash == hash && KeyEquals(slots_[i], key, length);
+        },
+        found);
+  }
+
+  // Copies the key to the arena and puts it in slot i
+  bool InsertAt(int64_t i, const uint8_t* key, int64_t length, uint64_t hash,
+      int64_t value) {
+    const int64_t start = size_ == 0 ? 0 : key_offsets_[size_];
+    if (!Grow(&key_data_, &key_data_capacity_, start + length) ||
+        !Grow(&key_offsets_, &key_offsets_capacity_, size_ + 2)) {
+      return false;
+    }
+    if (length > 0) { memcpy(key_data_ + start, key, length); }
+    key_offsets_[size_] = start;
+    key_offsets_[size_ + 1] = start + length;
+
+    ctrl_[i] = internal::HashControlByte(hash);
+    slots_[i].hash = hash;
+    slots_[i].index = size_;
+    slots_[i].value = value;
+    ++size_;
+    return true;
+  }
+
+  // Makes room for size elements in *buffer, at least doubling it
+  template <typename T>
+  static bool Grow(T** buffer, int64_t* capacity, int64_t size) {
+    if (size <= *capacity) { return true; }
+    const int64_t new_capacity = std::max<int64_t>(size, std::max<int64_t>(64, *capacity * 2));
+    T* grown = static_cast<T*>(realloc(*buffer, new_capacity * sizeof(T)));
+    if (grown == nullptr) { return false; }
+    *buffer = grown;
+    *capacity = new_capacity;
+    return true;
+  }
+
+  bool Rehash(int64_t capacity) {
+    int8_t* ctrl = static_cast<int8_t*>(malloc(capacity));
+    Slot* slots = static_cast<Slot*>(malloc(capacity * sizeof(Slot)));
+    if (ctrl == nullptr || slots == nullptr) {
+      free(ctrl);
+      free(slots);
+      return false;
+    }
+    memset(ctrl, kEmpty, capacity);
+
+    const uint64_t group_mask = capacity / kGroupSize - 1;
+    // The keys are distinct and their hashes are cached, so each goes to the
+    // first empty slot of its probe sequence without comparing keys
+    const auto distinct = [](int64_t) { return false; };
+    for (int64_t i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] == kEmpty) { continue; }
+      bool found;
+      const int64_t j =
+          internal::HashProbe(ctrl, group_mask, slots_[i].hash, distinct, &found);
+      ctrl[j] = ctrl_[i];
+      slots[j] = slots_[i];
+    }
+    free(ctrl_);
+    free(slots_);
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = capacity;
+    group_mask_ = group_mask;
+    max_size_ = capacity - capacity / 8;
+    return true;
+  }
+
+  int8_t* ctrl_;
+  Slot* slots_;
+  int64_t capacity_;
+  uint64_t group_mask_;
+  int64_t size_;
+  int64_t max_size_;
+
+  // The keys in insertion order
+  uint8_t* key_data_;
+  int64_t key_data_capacity_;
+  int64_t* key_offsets_;
+  int64_t key_offsets_capacity_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryHashTable);
+};
+
+}  // namespace pandas
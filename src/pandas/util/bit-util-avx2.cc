@@ -0,0 +1,46 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// AVX2 bitmap kernels. This translation unit is compiled with -mavx2 and must
+// only be entered after checking GetSimdLevel()
+
+#include <immintrin.h>
+
+#include <cstdint>
+
+#include "pandas/util/bit-util.h"
+
+namespace pandas {
+
+namespace internal {
+
+// Nibble lookup popcount (Mula, Kurz and Lemire): count 32 bytes per step
+// with two table shuffles, and widen the byte counts into 64-bit lanes with
+// SAD against zero
+int64_t PopcountBytesAvx2(const uint8_t* bytes, int64_t nbytes) {
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0F);
+
+  __m256i total = _mm256_setzero_si256();
+  int64_t i = 0;
+  for (; i + 32 <= nbytes; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i counts =
+        _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+
+  int64_t count = _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+                  _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+  for (; i < nbytes; ++i) {
+    count += __builtin_popcount(bytes[i]);
+  }
+  return count;
+}
+
+}  // namespace internal
+
+}  // namespace pandas
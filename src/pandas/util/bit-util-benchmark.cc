@@ -0,0 +1,69 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/util/bit-util.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+constexpr int64_t kNumBits = 1 << 20;
+
+static std::vector<uint8_t> MakeBitmap(uint32_t seed) {
+  // Room for offsets of up to 64 bits past the end
+  std::vector<uint8_t> bits(kNumBits / 8 + 8);
+  std::mt19937 rng(seed);
+  for (auto& byte : bits) {
+    byte = static_cast<uint8_t>(rng());
+  }
+  return bits;
+}
+
+// Argument: SIMD level
+static void BM_CountSetBits(benchmark::State& state) {  // NOLINT non-const reference
+  SetSimdLevel(static_cast<SimdLevel>(state.range_x()));
+  auto bits = MakeBitmap(1);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(CountSetBits(bits.data(), 0, kNumBits));
+  }
+  state.SetBytesProcessed(state.iterations() * kNumBits / 8);
+  SetSimdLevel(DetectSimdLevel());
+}
+
+// Arguments: left offset, out offset. Offsets that are not multiples of 8
+// take the word-at-a-time shifting path
+static void BM_BitmapAnd(benchmark::State& state) {  // NOLINT non-const reference
+  auto left = MakeBitmap(1);
+  auto right = MakeBitmap(2);
+  std::vector<uint8_t> out(left.size());
+  while (state.KeepRunning()) {
+    BitmapAnd(left.data(), state.range_x(), right.data(), 0, kNumBits, out.data(),
+        state.range_y());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumBits / 8);
+}
+
+static void BM_SetBitRunReader(benchmark::State& state) {  // NOLINT non-const reference
+  auto bits = MakeBitmap(3);
+  while (state.KeepRunning()) {
+    SetBitRunReader reader(bits.data(), 0, kNumBits);
+    int64_t total = 0;
+    for (BitRun run = reader.NextRun(); run.length != 0; run = reader.NextRun()) {
+      total += run.length;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetBytesProcessed(state.iterations() * kNumBits / 8);
+}
+
+BENCHMARK(BM_CountSetBits)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(BM_BitmapAnd)->ArgPair(0, 0)->ArgPair(3, 0)->ArgPair(3, 5);
+BENCHMARK(BM_SetBitRunReader);
+
+}  // namespace pandas
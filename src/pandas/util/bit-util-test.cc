@@ -0,0 +1,205 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pandas/common.h"
+#include "pandas/util/bit-util.h"
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+static int64_t NaiveCountSetBits(
+    const std::vector<uint8_t>& bits, int64_t bit_offset, int64_t length) {
+  int64_t count = 0;
+  for (int64_t i = bit_offset; i < bit_offset + length; ++i) {
+    count += BitUtil::GetBit(bits.data(), i);
+  }
+  return count;
+}
+
+TEST(BitUtilTests, CountSetBits) {
+  const int64_t nbytes = 100;
+  std::vector<uint8_t> bits(nbytes);
+  std::mt19937 rng(42);
+  for (auto& byte : bits) {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  // Offsets and lengths that straddle byte and word boundaries
+  for (int64_t offset : {0, 1, 7, 8, 9, 63, 64, 65, 100}) {
+    for (int64_t length : {0, 1, 5, 8, 63, 64, 65, 255, 256, 257, 600}) {
+      ASSERT_EQ(NaiveCountSetBits(bits, offset, length),
+          CountSetBits(bits.data(), offset, length))
+          << "offset " << offset << " length " << length;
+    }
+  }
+
+  std::vector<uint8_t> ones(nbytes, 0xFF);
+  ASSERT_EQ(nbytes * 8, CountSetBits(ones.data(), 0, nbytes * 8));
+  ASSERT_EQ(nbytes * 8 - 3, CountSetBits(ones.data(), 3, nbytes * 8 - 3));
+}
+
+static std::vector<uint8_t> RandomBits(int64_t nbytes, uint32_t seed) {
+  std::vector<uint8_t> bits(nbytes);
+  std::mt19937 rng(seed);
+  for (auto& byte : bits) {
+    byte = static_cast<uint8_t>(rng());
+  }
+  return bits;
+}
+
+TEST(BitUtilTests, CountSetBitsSimdLevels) {
+  auto bits = RandomBits(5000, 7);
+  const int64_t expected = NaiveCountSetBits(bits, 3, 39000);
+  for (SimdLevel level : {SimdLevel::NONE, SimdLevel::SSE4_2, SimdLevel::AVX2}) {
+    if (static_cast<int>(level) > static_cast<int>(DetectSimdLevel())) { continue; }
+    SetSimdLevel(level);
+    ASSERT_EQ(expected, CountSetBits(bits.data(), 3, 39000));
+  }
+  SetSimdLevel(DetectSimdLevel());
+}
+
+TEST(BitUtilTests, SetBitsTo) {
+  for (int64_t offset : {0, 3, 8, 61}) {
+    for (int64_t length : {0, 1, 5, 8, 64, 100, 200}) {
+      for (bool value : {true, false}) {
+        auto bits = RandomBits(40, 1);
+        auto expected = bits;
+        for (int64_t i = offset; i < offset + length; ++i) {
+          if (value) {
+            BitUtil::SetBit(expected.data(), i);
+          } else {
+            BitUtil::ClearBit(expected.data(), i);
+          }
+        }
+        SetBitsTo(bits.data(), offset, length, value);
+        ASSERT_EQ(expected, bits) << offset << " " << length;
+      }
+    }
+  }
+}
+
+TEST(BitUtilTests, CopyBits) {
+  auto src = RandomBits(100, 5);
+  for (int64_t src_offset : {0, 3, 8}) {
+    for (int64_t dest_offset : {0, 6, 16}) {
+      for (int64_t length : {0, 7, 64, 300}) {
+        auto dest = RandomBits(100, 6);
+        auto expected = dest;
+        for (int64_t i = 0; i < length; ++i) {
+          if (BitUtil::GetBit(src.data(), src_offset + i)) {
+            BitUtil::SetBit(expected.data(), dest_offset + i);
+          } else {
+            BitUtil::ClearBit(expected.data(), dest_offset + i);
+          }
+        }
+        CopyBits(src.data(), src_offset, length, dest.data(), dest_offset);
+        ASSERT_EQ(expected, dest) << src_offset << " " << dest_offset << " " << length;
+      }
+    }
+  }
+}
+
+TEST(BitUtilTests, BinaryOps) {
+  typedef void (*BitmapOpFunc)(const uint8_t*, int64_t, const uint8_t*, int64_t,
+      int64_t, uint8_t*, int64_t);
+  struct Case {
+    BitmapOpFunc func;
+    std::function<bool(bool, bool)> op;
+  };
+  std::vector<Case> cases = {{BitmapAnd, [](bool l, bool r) { return l && r; }},
+      {BitmapOr, [](bool l, bool r) { return l || r; }},
+      {BitmapXor, [](bool l, bool r) { return l != r; }},
+      {BitmapAndNot, [](bool l, bool r) { return l && !r; }}};
+
+  auto left = RandomBits(100, 2);
+  auto right = RandomBits(100, 3);
+  for (const Case& c : cases) {
+    // Aligned and unaligned combinations of offsets
+    for (int64_t left_offset : {0, 5, 8}) {
+      for (int64_t right_offset : {0, 3, 16}) {
+        for (int64_t out_offset : {0, 7, 64}) {
+          for (int64_t length : {0, 1, 13, 64, 200, 650}) {
+            auto out = RandomBits(100, 4);
+            auto expected = out;
+            for (int64_t i = 0; i < length; ++i) {
+              bool value = c.op(BitUtil::GetBit(left.data(), left_offset + i),
+                  BitUtil::GetBit(right.data(), right_offset + i));
+              if (value) {
+                BitUtil::SetBit(expected.data(), out_offset + i);
+              } else {
+                BitUtil::ClearBit(expected.data(), out_offset + i);
+              }
+            }
+            c.func(left.data(), left_offset, right.data(), right_offset, length,
+                out.data(), out_offset);
+            ASSERT_EQ(expected, out) << left_offset << " " << right_offset << " "
+                                     << out_offset << " " << length;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(BitUtilTests, SetBitRunReader) {
+  // Runs crossing word boundaries, a long run, and runs at both ends
+  std::vector<uint8_t> bits(40, 0);
+  std::vector<BitRun> runs = {{0, 3}, {10, 1}, {60, 10}, {100, 150}, {310, 10}};
+  for (const BitRun& run : runs) {
+    SetBitsTo(bits.data(), run.position, run.length, true);
+  }
+
+  for (int64_t offset : {0, 5}) {
+    // Reading from offset moves the first run and truncates it
+    SetBitRunReader reader(bits.data(), offset, 320 - offset);
+    for (const BitRun& run : runs) {
+      int64_t position = std::max<int64_t>(run.position - offset, 0);
+      int64_t length = run.position + run.length - offset - position;
+      if (length <= 0) { continue; }
+      BitRun actual = reader.NextRun();
+      ASSERT_EQ(position, actual.position);
+      ASSERT_EQ(length, actual.length);
+    }
+    ASSERT_EQ(0, reader.NextRun().length);
+  }
+
+  std::vector<uint8_t> empty(16, 0);
+  SetBitRunReader empty_reader(empty.data(), 0, 128);
+  ASSERT_EQ(0, empty_reader.NextRun().length);
+}
+
+TEST(BitUtilTests, BytesToBits) {
+  std::mt19937 rng(42);
+  std::bernoulli_distribution is_set(0.3);
+
+  // Lengths around the 64-value block size
+  for (int64_t length : {0, 1, 7, 8, 63, 64, 65, 130, 1000}) {
+    std::vector<uint8_t> bytes(length);
+    int64_t ex_count = 0;
+    for (auto& byte : bytes) {
+      // Any nonzero byte counts as set
+      byte = is_set(rng) ? static_cast<uint8_t>(1 + rng() % 255) : 0;
+      ex_count += byte != 0;
+    }
+
+    std::vector<uint8_t> bits(BitUtil::BytesForBits(length));
+    std::vector<uint8_t> inverted(BitUtil::BytesForBits(length));
+    ASSERT_EQ(ex_count, BytesToBits(bytes.data(), length, bits.data()));
+    ASSERT_EQ(length - ex_count,
+        InvertedBytesToBits(bytes.data(), length, inverted.data()));
+    for (int64_t i = 0; i < length; ++i) {
+      ASSERT_EQ(bytes[i] != 0, BitUtil::GetBit(bits.data(), i)) << i;
+      ASSERT_EQ(bytes[i] == 0, BitUtil::GetBit(inverted.data(), i)) << i;
+    }
+  }
+}
+
+}  // namespace pandas
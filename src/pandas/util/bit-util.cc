@@ -0,0 +1,317 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "pandas/util/bit-util.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "pandas/util/cpu-info.h"
+
+namespace pandas {
+
+namespace {
+
+inline int Popcount64(uint64_t word) {
+  // Compiles to the POPCNT instruction with the -msse4.2 baseline
+  return __builtin_popcountll(word);
+}
+
+inline bool GetBit(const uint8_t* bits, int64_t i) {
+  return (bits[i / 8] >> (i % 8)) & 1;
+}
+
+// AVX2 only pays off once there is enough data to amortize the dispatch
+constexpr int64_t kMinAvx2PopcountBytes = 256;
+
+int64_t PopcountBytes(const uint8_t* p, int64_t nbytes) {
+  if (nbytes >= kMinAvx2PopcountBytes && GetSimdLevel() >= SimdLevel::AVX2) {
+    return internal::PopcountBytesAvx2(p, nbytes);
+  }
+
+  // Four words at a time to keep several POPCNTs in flight
+  int64_t count = 0;
+  int64_t i = 0;
+  uint64_t words[4];
+  for (; i + 32 <= nbytes; i += 32) {
+    memcpy(words, p + i, 32);
+    count += Popcount64(words[0]) + Popcount64(words[1]) + Popcount64(words[2]) +
+             Popcount64(words[3]);
+  }
+  for (; i + 8 <= nbytes; i += 8) {
+    memcpy(words, p + i, 8);
+    count += Popcount64(words[0]);
+  }
+  for (; i < nbytes; ++i) {
+    count += Popcount64(p[i]);
+  }
+  return count;
+}
+
+inline uint64_t LowBitsMask(int64_t nbits) {
+  return nbits >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << nbits) - 1;
+}
+
+// The nbits (at most 64) bits starting at bit_offset, in the low bits of the
+// result. Only bytes overlapping the range are read
+inline uint64_t LoadBits(const uint8_t* bits, int64_t bit_offset, int64_t nbits) {
+  const uint8_t* p = bits + bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  uint64_t word;
+  if (nbits == 64) {
+    memcpy(&word, p, sizeof(word));
+    word >>= shift;
+    if (shift != 0) { word |= static_cast<uint64_t>(p[8]) << (64 - shift); }
+    return word;
+  }
+  const int64_t nbytes = (shift + nbits + 7) / 8;
+  word = p[0] >> shift;
+  for (int64_t k = 1; k < nbytes; ++k) {
+    word |= static_cast<uint64_t>(p[k]) << (8 * k - shift);
+  }
+  return word & LowBitsMask(nbits);
+}
+
+// Write the low nbits (at most 64) bits of word starting at bit_offset,
+// preserving the neighbouring bits
+inline void StoreBits(uint8_t* bits, int64_t bit_offset, uint64_t word, int64_t nbits) {
+  if (nbits == 64) {
+    uint8_t* p = bits + bit_offset / 8;
+    const int shift = static_cast<int>(bit_offset % 8);
+    if (shift == 0) {
+      memcpy(p, &word, sizeof(word));
+      return;
+    }
+    // The word straddles nine bytes: keep the low shift bits of the first and
+    // the high bits of the ninth
+    const uint64_t keep = LowBitsMask(shift);
+    uint64_t current;
+    memcpy(&current, p, sizeof(current));
+    current = (current & keep) | (word << shift);
+    memcpy(p, &current, sizeof(current));
+    p[8] = static_cast<uint8_t>((p[8] & ~keep) | (word >> (64 - shift)));
+    return;
+  }
+  int64_t i = 0;
+  while (i < nbits) {
+    const int64_t position = bit_offset + i;
+    const int shift = static_cast<int>(position % 8);
+    const int64_t n = std::min<int64_t>(8 - shift, nbits - i);
+    const uint8_t mask = static_cast<uint8_t>(((1 << n) - 1) << shift);
+    const uint8_t value = static_cast<uint8_t>((word >> i) << shift) & mask;
+    bits[position / 8] = static_cast<uint8_t>((bits[position / 8] & ~mask) | value);
+    i += n;
+  }
+}
+
+struct AndOp {
+  static uint64_t Call(uint64_t left, uint64_t right) { return left & right; }
+};
+
+struct OrOp {
+  static uint64_t Call(uint64_t left, uint64_t right) { return left | right; }
+};
+
+struct XorOp {
+  static uint64_t Call(uint64_t left, uint64_t right) { return left ^ right; }
+};
+
+struct AndNotOp {
+  static uint64_t Call(uint64_t left, uint64_t right) { return left & ~right; }
+};
+
+template <typename Op>
+void BitmapOp(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, uint8_t* out, int64_t out_offset) {
+  int64_t i = 0;
+  if (left_offset % 8 == 0 && right_offset % 8 == 0 && out_offset % 8 == 0) {
+    // Byte-aligned: a plain loop over whole bytes, which the compiler
+    // vectorizes
+    const uint8_t* l = left + left_offset / 8;
+    const uint8_t* r = right + right_offset / 8;
+    uint8_t* o = out + out_offset / 8;
+    const int64_t nbytes = length / 8;
+    for (int64_t k = 0; k < nbytes; ++k) {
+      o[k] = static_cast<uint8_t>(Op::Call(l[k], r[k]));
+    }
+    i = nbytes * 8;
+  } else {
+    // Shift each input into place a word at a time
+    for (; i + 64 <= length; i += 64) {
+      uint64_t word =
+          Op::Call(LoadBits(left, left_offset + i, 64), LoadBits(right, right_offset + i, 64));
+      StoreBits(out, out_offset + i, word, 64);
+    }
+  }
+  if (i < length) {
+    const int64_t nbits = length - i;
+    uint64_t word = Op::Call(
+        LoadBits(left, left_offset + i, nbits), LoadBits(right, right_offset + i, nbits));
+    StoreBits(out, out_offset + i, word, nbits);
+  }
+}
+
+// Bit k of the result is set if bytes[k] is zero, for k < 64
+inline uint64_t ZeroBytesToWord(const uint8_t* bytes) {
+  const __m128i zero = _mm_setzero_si128();
+  uint64_t word = 0;
+  for (int k = 0; k < 4; ++k) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 16 * k));
+    uint64_t mask = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)));
+    word |= mask << (16 * k);
+  }
+  return word;
+}
+
+template <bool INVERT>
+int64_t PackBytes(const uint8_t* bytes, int64_t length, uint8_t* bits) {
+  int64_t count = 0;
+  int64_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    uint64_t word = ZeroBytesToWord(bytes + i);
+    if (!INVERT) { word = ~word; }
+    count += Popcount64(word);
+    memcpy(bits + i / 8, &word, sizeof(word));
+  }
+
+  // Fewer than 64 values remain; pack them a byte at a time
+  for (; i < length; i += 8) {
+    uint8_t byte = 0;
+    for (int64_t j = 0; j < 8 && i + j < length; ++j) {
+      byte |= static_cast<uint8_t>(((bytes[i + j] == 0) == INVERT) << j);
+    }
+    count += Popcount64(byte);
+    bits[i / 8] = byte;
+  }
+  return count;
+}
+
+}  // namespace
+
+int64_t CountSetBits(const uint8_t* bits, int64_t bit_offset, int64_t length) {
+  int64_t count = 0;
+  int64_t i = bit_offset;
+  const int64_t end = bit_offset + length;
+
+  // Leading bits up to a byte boundary
+  for (; i < end && i % 8 != 0; ++i) {
+    count += GetBit(bits, i);
+  }
+
+  // Whole bytes. i is now byte-aligned unless the range ended first
+  if (i < end) {
+    const int64_t nbytes = (end - i) / 8;
+    count += PopcountBytes(bits + i / 8, nbytes);
+    i += nbytes * 8;
+  }
+
+  // Trailing bits
+  for (; i < end; ++i) {
+    count += GetBit(bits, i);
+  }
+  return count;
+}
+
+void SetBitsTo(uint8_t* bits, int64_t bit_offset, int64_t length, bool value) {
+  int64_t i = bit_offset;
+  const int64_t end = bit_offset + length;
+
+  // Leading bits up to a byte boundary, whole bytes, then trailing bits
+  const uint8_t fill = value ? 0xFF : 0;
+  if (i % 8 != 0) {
+    const int64_t nbits = std::min<int64_t>(8 - i % 8, length);
+    StoreBits(bits, i, value ? LowBitsMask(nbits) : 0, nbits);
+    i += nbits;
+  }
+  if (i < end) {
+    const int64_t nbytes = (end - i) / 8;
+    memset(bits + i / 8, fill, nbytes);
+    i += nbytes * 8;
+  }
+  if (i < end) { StoreBits(bits, i, value ? LowBitsMask(end - i) : 0, end - i); }
+}
+
+void CopyBits(const uint8_t* src, int64_t src_offset, int64_t length, uint8_t* dest,
+    int64_t dest_offset) {
+  int64_t i = 0;
+  if (src_offset % 8 == 0 && dest_offset % 8 == 0) {
+    const int64_t nbytes = length / 8;
+    memcpy(dest + dest_offset / 8, src + src_offset / 8, nbytes);
+    i = nbytes * 8;
+  } else {
+    for (; i + 64 <= length; i += 64) {
+      StoreBits(dest, dest_offset + i, LoadBits(src, src_offset + i, 64), 64);
+    }
+  }
+  if (i < length) {
+    const int64_t nbits = length - i;
+    StoreBits(dest, dest_offset + i, LoadBits(src, src_offset + i, nbits), nbits);
+  }
+}
+
+void BitmapAnd(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, uint8_t* out, int64_t out_offset) {
+  BitmapOp<AndOp>(left, left_offset, right, right_offset, length, out, out_offset);
+}
+
+void BitmapOr(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, uint8_t* out, int64_t out_offset) {
+  BitmapOp<OrOp>(left, left_offset, right, right_offset, length, out, out_offset);
+}
+
+void BitmapXor(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, uint8_t* out, int64_t out_offset) {
+  BitmapOp<XorOp>(left, left_offset, right, right_offset, length, out, out_offset);
+}
+
+void BitmapAndNot(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, uint8_t* out, int64_t out_offset) {
+  BitmapOp<AndNotOp>(left, left_offset, right, right_offset, length, out, out_offset);
+}
+
+int64_t BytesToBits(const uint8_t* bytes, int64_t length, uint8_t* bits) {
+  return PackBytes<false>(bytes, length, bits);
+}
+
+int64_t InvertedBytesToBits(const uint8_t* bytes, int64_t length, uint8_t* bits) {
+  return PackBytes<true>(bytes, length, bits);
+}
+
+// ----------------------------------------------------------------------
+// SetBitRunReader
+
+SetBitRunReader::SetBitRunReader(const uint8_t* bits, int64_t bit_offset, int64_t length)
+    : bits_(bits), bit_offset_(bit_offset), length_(length), position_(0) {}
+
+BitRun SetBitRunReader::NextRun() {
+  // Skip clear bits
+  while (position_ < length_) {
+    const int64_t nbits = std::min<int64_t>(64, length_ - position_);
+    const uint64_t word = LoadBits(bits_, bit_offset_ + position_, nbits);
+    if (word != 0) {
+      position_ += __builtin_ctzll(word);
+      break;
+    }
+    position_ += nbits;
+  }
+  if (position_ >= length_) { return {length_, 0}; }
+
+  // Find the end of the run: the next clear bit
+  const int64_t start = position_;
+  while (position_ < length_) {
+    const int64_t nbits = std::min<int64_t>(64, length_ - position_);
+    const uint64_t clear =
+        ~LoadBits(bits_, bit_offset_ + position_, nbits) & LowBitsMask(nbits);
+    if (clear != 0) {
+      position_ += __builtin_ctzll(clear);
+      break;
+    }
+    position_ += nbits;
+  }
+  return {start, position_ - start};
+}
+
+}  // namespace pandas
@@ -0,0 +1,85 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Bulk operations on LSB-ordered bitmaps, such as validity bitmaps. Ranges are
+// given as a bit offset and a length in bits, and offsets need not be
+// multiples of 8
+
+#pragma once
+
+#include <cstdint>
+
+#include "pandas/visibility.h"
+
+namespace pandas {
+
+// Number of set bits in [bit_offset, bit_offset + length)
+PANDAS_EXPORT int64_t CountSetBits(
+    const uint8_t* bits, int64_t bit_offset, int64_t length);
+
+// Set (or clear) every bit in [bit_offset, bit_offset + length)
+PANDAS_EXPORT void SetBitsTo(
+    uint8_t* bits, int64_t bit_offset, int64_t length, bool value);
+
+// Copy length bits from src to dest. Bits of dest outside the range are left
+// untouched
+PANDAS_EXPORT void CopyBits(const uint8_t* src, int64_t src_offset, int64_t length,
+    uint8_t* dest, int64_t dest_offset);
+
+// out[out_offset + i] = left[left_offset + i] OP right[right_offset + i] for i
+// in [0, length). Bits of out outside the range are left untouched. AndNot
+// computes left & ~right, e.g. to clear the bits of a mask
+PANDAS_EXPORT void BitmapAnd(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, uint8_t* out,
+    int64_t out_offset);
+PANDAS_EXPORT void BitmapOr(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, uint8_t* out,
+    int64_t out_offset);
+PANDAS_EXPORT void BitmapXor(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, uint8_t* out,
+    int64_t out_offset);
+PANDAS_EXPORT void BitmapAndNot(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, uint8_t* out,
+    int64_t out_offset);
+
+// Pack one byte per value into one bit per value, starting at bit 0 of bits:
+// bit i is set if bytes[i] is nonzero. Returns the number of set bits
+PANDAS_EXPORT int64_t BytesToBits(const uint8_t* bytes, int64_t length, uint8_t* bits);
+
+// As BytesToBits, but bit i is set if bytes[i] is zero. Turns a NumPy-style
+// mask (true meaning missing) into a validity bitmap
+PANDAS_EXPORT int64_t InvertedBytesToBits(
+    const uint8_t* bytes, int64_t length, uint8_t* bits);
+
+// A maximal run of consecutive set bits. position is relative to the start of
+// the range being read
+struct BitRun {
+  int64_t position;
+  int64_t length;
+};
+
+// Yields the runs of set bits in a range in order, skipping clear bits a word
+// at a time. Useful for visiting only the valid values of an array
+class PANDAS_EXPORT SetBitRunReader {
+ public:
+  SetBitRunReader(const uint8_t* bits, int64_t bit_offset, int64_t length);
+
+  // A run of length 0 marks the end of the range
+  BitRun NextRun();
+
+ private:
+  const uint8_t* bits_;
+  int64_t bit_offset_;
+  int64_t length_;
+  int64_t position_;
+};
+
+namespace internal {
+
+// Number of set bits in nbytes whole bytes. Lives in a translation unit
+// compiled with -mavx2; only call after checking GetSimdLevel()
+int64_t PopcountBytesAvx2(const uint8_t* bytes, int64_t nbytes);
+
+}  // namespace internal
+
+}  // namespace pandas
@@ -27,4 +27,35 @@ TEST(BitArrayTests, TestBasics) {
   ASSERT_FALSE(arr.IsSet(5));
 }
 
+TEST(BitArrayTests, TestRanges) {
+  BitArray arr;
+  ASSERT_OK(arr.Init(1000));
+
+  arr.SetRange(5, 900);
+  ASSERT_EQ(895, arr.set_count());
+  ASSERT_FALSE(arr.IsSet(4));
+  ASSERT_TRUE(arr.IsSet(5));
+  ASSERT_TRUE(arr.IsSet(899));
+  ASSERT_FALSE(arr.IsSet(900));
+
+  // Overlapping ranges only count the bits that change
+  arr.SetRange(850, 1000);
+  ASSERT_EQ(995, arr.set_count());
+  arr.UnsetRange(0, 100);
+  ASSERT_EQ(900, arr.set_count());
+  arr.Unset(100);
+  arr.Unset(100);
+  ASSERT_EQ(899, arr.set_count());
+
+  arr.mutable_data()[20] = 0;
+  arr.UpdateSetCount();
+  ASSERT_EQ(891, arr.set_count());
+
+  // Short arrays still have room for a whole word
+  BitArray small;
+  ASSERT_OK(small.Init(3));
+  small.SetRange(0, 3);
+  ASSERT_EQ(3, small.set_count());
+}
+
 }  // namespace pandas
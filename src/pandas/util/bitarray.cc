@@ -7,6 +7,7 @@
 
 #include "pandas/common.h"
 #include "pandas/util.h"
+#include "pandas/util/bit-util.h"
 
 namespace pandas {
 
@@ -15,7 +16,8 @@ BitArray::~BitArray() {
 }
 
 Status BitArray::Init(size_t length) {
-  size_t bufsize = util::ceil_byte(length / 8);
+  // Whole words, so that word-at-a-time operations stay in bounds
+  size_t bufsize = util::ceil_byte(BitUtil::BytesForBits(length));
   try {
     bits_ = new uint8_t[bufsize];
     memset(bits_, 0, bufsize);
@@ -27,4 +29,18 @@ Status BitArray::Init(size_t length) {
   return Status::OK();
 }
 
+void BitArray::SetRange(size_t start, size_t end) {
+  count_ += (end - start) - CountSetBits(bits_, start, end - start);
+  SetBitsTo(bits_, start, end - start, true);
+}
+
+void BitArray::UnsetRange(size_t start, size_t end) {
+  count_ -= CountSetBits(bits_, start, end - start);
+  SetBitsTo(bits_, start, end - start, false);
+}
+
+void BitArray::UpdateSetCount() {
+  count_ = CountSetBits(bits_, 0, length_);
+}
+
 }  // namespace pandas
@@ -20,37 +20,38 @@ class BitArray {
 
   bool IsSet(size_t i) { return bits_[i / 8] & (1 << (i % 8)); }
 
+  // Branch-free; the set count is adjusted by whether the bit changed
   void Set(size_t i) {
-    if (!IsSet(i)) ++count_;
+    count_ += !IsSet(i);
     bits_[i / 8] |= (1 << (i % 8));
   }
 
   void Unset(size_t i) {
-    if (IsSet(i)) --count_;
+    count_ -= IsSet(i);
     // clear bit
     bits_[i / 8] &= ~(1 << (i % 8));
   }
 
   // Set a range from start (inclusive) to end (not inclusive)
   // Bounds are not checked
-  // void SetRange(size_t start, size_t end) {
-  //   for (size_t i = start; i < end; ++i) {
-  //     Set(i);
-  //   }
-  // }
+  void SetRange(size_t start, size_t end);
 
   // Unset a range from start (inclusive) to end (not inclusive)
   // Bounds are not checked
-  // void UnsetRange(size_t start, size_t end) {
-  //   for (size_t i = start; i < end; ++i) {
-  //     Unset(i);
-  //   }
-  // }
+  void UnsetRange(size_t start, size_t end);
 
   size_t set_count() { return count_; }
 
   size_t length() { return length_; }
 
+  // The bits, padded to a multiple of 8 bytes, for use with the functions in
+  // pandas/util/bit-util.h
+  const uint8_t* data() const { return bits_; }
+  uint8_t* mutable_data() { return bits_; }
+
+  // Recompute set_count() after the bits were modified through mutable_data()
+  void UpdateSetCount();
+
  private:
   size_t length_;
   uint8_t* bits_;
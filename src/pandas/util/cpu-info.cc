@@ -0,0 +1,45 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include "pandas/util/cpu-info.h"
+
+#include <atomic>
+
+namespace pandas {
+
+namespace {
+
+std::atomic<int> g_simd_level(-1);
+
+}  // namespace
+
+SimdLevel DetectSimdLevel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  static const SimdLevel detected = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { return SimdLevel::AVX2; }
+    if (__builtin_cpu_supports("sse4.2")) { return SimdLevel::SSE4_2; }
+    return SimdLevel::NONE;
+  }();
+  return detected;
+#else
+  return SimdLevel::NONE;
+#endif
+}
+
+SimdLevel GetSimdLevel() {
+  int level = g_simd_level.load(std::memory_order_relaxed);
+  if (level < 0) {
+    level = static_cast<int>(DetectSimdLevel());
+    g_simd_level.store(level, std::memory_order_relaxed);
+  }
+  return static_cast<SimdLevel>(level);
+}
+
+void SetSimdLevel(SimdLevel level) {
+  const SimdLevel detected = DetectSimdLevel();
+  if (static_cast<int>(level) > static_cast<int>(detected)) { level = detected; }
+  g_simd_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+}  // namespace pandas
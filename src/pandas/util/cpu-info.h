@@ -0,0 +1,26 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#pragma once
+
+#include "pandas/visibility.h"
+
+namespace pandas {
+
+// Instruction set levels for which we compile specialized kernels. Kernels are
+// selected at runtime so that a single binary can run on older hardware.
+enum class SimdLevel : int { NONE = 0, SSE4_2 = 1, AVX2 = 2 };
+
+// The highest level supported by the host CPU
+PANDAS_EXPORT SimdLevel DetectSimdLevel();
+
+// The level that kernels should dispatch to: the detected level, capped by
+// SetSimdLevel
+PANDAS_EXPORT SimdLevel GetSimdLevel();
+
+// Cap the dispatch level, for example to compare kernels in tests and
+// benchmarks. Requesting a level the CPU does not support selects the detected
+// level instead
+PANDAS_EXPORT void SetSimdLevel(SimdLevel level);
+
+}  // namespace pandas
@@ -0,0 +1,135 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pandas/util/direct-table.h"
+#include "pandas/util/hash-table.h"
+
+namespace pandas {
+
+TEST(DirectTableTests, SetAndFind) {
+  DirectTable<int8_t> table;
+  int64_t value;
+  ASSERT_FALSE(table.Find(5, &value));
+  ASSERT_EQ(0, table.capacity());
+
+  ASSERT_TRUE(table.Set(5, 50));
+  ASSERT_TRUE(table.Set(-128, 70));
+  ASSERT_TRUE(table.Set(127, 90));
+  ASSERT_EQ(3, table.size());
+  ASSERT_EQ(256, table.capacity());
+  ASSERT_TRUE(table.Find(5, &value));
+  ASSERT_EQ(50, value);
+  ASSERT_TRUE(table.Find(-128, &value));
+  ASSERT_EQ(70, value);
+  ASSERT_TRUE(table.Find(127, &value));
+  ASSERT_EQ(90, value);
+  ASSERT_FALSE(table.Find(6, &value));
+
+  // Replacing a value keeps the key count
+  ASSERT_TRUE(table.Set(5, 51));
+  ASSERT_EQ(3, table.size());
+  ASSERT_TRUE(table.Find(5, &value));
+  ASSERT_EQ(51, value);
+}
+
+// GetOrInsert and Find give the same values as HashTable
+template <typename T>
+static void CheckSameAsHashTable() {
+  std::vector<T> keys;
+  for (int64_t i = 0; i < 100000; ++i) {
+    keys.push_back(static_cast<T>(i * i * 31 + i));
+  }
+  std::vector<uint8_t> skip(keys.size());
+  for (size_t i = 0; i < skip.size(); i += 7) {
+    skip[i] = 1;
+  }
+
+  HashTable<T> hash_table;
+  std::vector<int64_t> expected(keys.size());
+  std::vector<uint8_t> expected_inserted(keys.size());
+  int64_t expected_count = 3;
+  ASSERT_TRUE(hash_table.GetOrInsert(keys.data(), keys.size(), &expected_count,
+      expected.data(), skip.data(), -1, expected_inserted.data()));
+
+  DirectTable<T> table;
+  std::vector<int64_t> labels(keys.size());
+  std::vector<uint8_t> inserted(keys.size());
+  int64_t count = 3;
+  ASSERT_TRUE(table.GetOrInsert(keys.data(), keys.size(), &count, labels.data(),
+      skip.data(), -1, inserted.data()));
+  ASSERT_EQ(expected, labels);
+  ASSERT_EQ(expected_inserted, inserted);
+  ASSERT_EQ(expected_count, count);
+  ASSERT_EQ(hash_table.size(), table.size());
+
+  table.Find(keys.data(), keys.size(), -1, labels.data());
+  hash_table.Find(keys.data(), keys.size(), -1, expected.data());
+  ASSERT_EQ(expected, labels);
+}
+
+TEST(DirectTableTests, SameAsHashTable) {
+  CheckSameAsHashTable<int8_t>();
+  CheckSameAsHashTable<uint8_t>();
+  CheckSameAsHashTable<int16_t>();
+  CheckSameAsHashTable<uint16_t>();
+}
+
+TEST(DirectTableTests, DirectRange) {
+  int8_t min8;
+  uint64_t range;
+  const int8_t keys8[] = {3, -128, 127};
+  ASSERT_TRUE(DirectRange(keys8, 3, nullptr, &min8, &range));
+  ASSERT_EQ(-128, min8);
+  ASSERT_EQ(256u, range);
+
+  // Wide keys qualify if they span no more than kMinDirectRange values or
+  // than there are keys
+  const int64_t big = std::numeric_limits<int64_t>::max();
+  int64_t min;
+  const int64_t keys[] = {big - kMinDirectRange + 1, big, big - 5};
+  ASSERT_TRUE(DirectRange(keys, 3, nullptr, &min, &range));
+  ASSERT_EQ(big - kMinDirectRange + 1, min);
+  ASSERT_EQ(static_cast<uint64_t>(kMinDirectRange), range);
+
+  const int64_t wide[] = {0, kMinDirectRange, 1};
+  ASSERT_FALSE(DirectRange(wide, 3, nullptr, &min, &range));
+  const int64_t extremes[] = {std::numeric_limits<int64_t>::min(), big};
+  ASSERT_FALSE(DirectRange(extremes, 2, nullptr, &min, &range));
+
+  std::vector<int32_t> dense(100000);
+  for (size_t i = 0; i < dense.size(); ++i) {
+    dense[i] = static_cast<int32_t>(i * 3 - 1000);
+  }
+  int32_t min32;
+  ASSERT_FALSE(DirectRange(dense.data(), dense.size(), nullptr, &min32, &range));
+  for (size_t i = 0; i < dense.size(); ++i) {
+    dense[i] = static_cast<int32_t>(i / 2 - 1000);
+  }
+  ASSERT_TRUE(DirectRange(dense.data(), dense.size(), nullptr, &min32, &range));
+  ASSERT_EQ(-1000, min32);
+  ASSERT_EQ(50000u, range);
+
+  // Skipped keys do not count
+  const uint64_t ukeys[] = {std::numeric_limits<uint64_t>::max(), 10, 12};
+  const uint8_t skip[] = {1, 0, 0};
+  uint64_t umin;
+  ASSERT_FALSE(DirectRange(ukeys, 3, nullptr, &umin, &range));
+  ASSERT_TRUE(DirectRange(ukeys, 3, skip, &umin, &range));
+  ASSERT_EQ(10u, umin);
+  ASSERT_EQ(3u, range);
+  const uint8_t skip_all[] = {1, 1, 1};
+  ASSERT_TRUE(DirectRange(ukeys, 3, skip_all, &umin, &range));
+  ASSERT_EQ(0u, range);
+
+  const double doubles[] = {1.0, 2.0};
+  double dmin;
+  ASSERT_FALSE(DirectRange(doubles, 2, nullptr, &dmin, &range));
+}
+
+}  // namespace pandas
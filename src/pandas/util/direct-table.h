@@ -0,0 +1,190 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Direct addressing for integer keys drawn from a small range. Instead of
+// hashing, the offset of a key from the smallest one indexes straight into an
+// array, so there are no probes, no collisions and no key comparisons, and a
+// pass over the keys runs at the speed of reading them.
+//
+// DirectTable is a drop-in replacement for HashTable over the whole domain of
+// an 8 or 16-bit type. DirectRange finds whether wider keys happen to fall in
+// a range narrow enough to address directly.
+//
+// Like hash-table.h this header does not depend on Arrow. Allocation
+// failures are reported by returning false.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "pandas/util/macros.h"
+
+namespace pandas {
+
+// Keys spanning at most this many values are addressed directly whatever
+// their number
+constexpr int64_t kMinDirectRange = 1 << 12;
+
+// Sets *min to the smallest of the keys for which skip (if given) is zero and
+// *range to the number of values from it to the largest, and returns whether
+// the range is at most the larger of length and kMinDirectRange. An array of
+// that many int64 is then no larger than the labels of the keys. The range is
+// 0 if every key is skipped
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, bool>::type DirectRange(
+    const T* keys, int64_t length, const uint8_t* skip, T* min, uint64_t* range) {
+  T lo = std::numeric_limits<T>::max();
+  T hi = std::numeric_limits<T>::min();
+  if (skip == nullptr) {
+    for (int64_t i = 0; i < length; ++i) {
+      lo = std::min(lo, keys[i]);
+      hi = std::max(hi, keys[i]);
+    }
+  } else {
+    for (int64_t i = 0; i < length; ++i) {
+      if (skip[i]) { continue; }
+      lo = std::min(lo, keys[i]);
+      hi = std::max(hi, keys[i]);
+    }
+  }
+  *min = lo;
+  if (lo > hi) {
+    *range = 0;
+    return true;
+  }
+  // Unsigned arithmetic gives the width of any range of 64-bit keys
+  const uint64_t width = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+  const uint64_t limit = static_cast<uint64_t>(std::max(length, kMinDirectRange));
+  if (width >= limit) { return false; }
+  *range = width + 1;
+  return true;
+}
+
+// Floating point keys are never addressed directly
+template <typename T>
+typename std::enable_if<!std::is_integral<T>::value, bool>::type DirectRange(
+    const T* keys, int64_t length, const uint8_t* skip, T* min, uint64_t* range) {
+  return false;
+}
+
+// Offset of key from min, where key >= min
+template <typename T>
+inline uint64_t DirectOffset(T key, T min) {
+  return static_cast<uint64_t>(key) - static_cast<uint64_t>(min);
+}
+
+// Table from 8 or 16-bit keys to int64 values with the interface of
+// HashTable, holding a value and a presence flag for every possible key. The
+// arrays are allocated on the first insertion
+template <typename T>
+class DirectTable {
+ public:
+  static_assert(std::is_integral<T>::value && sizeof(T) <= 2,
+      "DirectTable addresses the keys of 8 and 16-bit integer types");
+
+  DirectTable() : values_(nullptr), present_(nullptr), size_(0) {}
+
+  ~DirectTable() {
+    free(values_);
+    free(present_);
+  }
+
+  // Number of keys
+  int64_t size() const { return size_; }
+
+  // Number of slots
+  int64_t capacity() const { return values_ == nullptr ? 0 : kDomain; }
+
+  // Every key has a slot, so this only allocates the arrays
+  bool Reserve(int64_t size) { return size <= 0 || Allocate(); }
+
+  // Sets *value to the value of key if it is present
+  bool Find(T key, int64_t* value) const {
+    if (size_ == 0 || !present_[Slot(key)]) { return false; }
+    *value = values_[Slot(key)];
+    return true;
+  }
+
+  // Sets the value of key, inserting it if needed
+  bool Set(T key, int64_t value) {
+    if (!Allocate()) { return false; }
+    const uint64_t i = Slot(key);
+    size_ += !present_[i];
+    present_[i] = 1;
+    values_[i] = value;
+    return true;
+  }
+
+  // values[i] is the value of keys[i], or missing if it is not present
+  void Find(const T* keys, int64_t length, int64_t missing, int64_t* values) const {
+    if (size_ == 0) {
+      std::fill(values, values + length, missing);
+      return;
+    }
+    for (int64_t i = 0; i < length; ++i) {
+      const uint64_t slot = Slot(keys[i]);
+      values[i] = present_[slot] ? values_[slot] : missing;
+    }
+  }
+
+  // As HashTable::GetOrInsert
+  bool GetOrInsert(const T* keys, int64_t length, int64_t* next_value, int64_t* values,
+      const uint8_t* skip = nullptr, int64_t skip_value = -1,
+      uint8_t* inserted = nullptr) {
+    if (length > 0 && !Allocate()) { return false; }
+    for (int64_t i = 0; i < length; ++i) {
+      if (skip != nullptr && skip[i]) {
+        values[i] = skip_value;
+        if (inserted != nullptr) { inserted[i] = 0; }
+        continue;
+      }
+      const uint64_t slot = Slot(keys[i]);
+      const bool found = present_[slot];
+      if (!found) {
+        present_[slot] = 1;
+        values_[slot] = (*next_value)++;
+        ++size_;
+      }
+      values[i] = values_[slot];
+      if (inserted != nullptr) { inserted[i] = !found; }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr int64_t kDomain = int64_t(1) << (8 * sizeof(T));
+
+  static uint64_t Slot(T key) {
+    return static_cast<typename std::make_unsigned<T>::type>(key);
+  }
+
+  bool Allocate() {
+    if (values_ != nullptr) { return true; }
+    values_ = static_cast<int64_t*>(calloc(kDomain, sizeof(int64_t)));
+    present_ = static_cast<uint8_t*>(calloc(kDomain, 1));
+    if (values_ == nullptr || present_ == nullptr) {
+      free(values_);
+      free(present_);
+      values_ = nullptr;
+      present_ = nullptr;
+      return false;
+    }
+    return true;
+  }
+
+  int64_t* values_;
+  uint8_t* present_;
+  int64_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectTable);
+};
+
+template <typename T>
+constexpr int64_t DirectTable<T>::kDomain;
+
+}  // namespace pandas
@@ -0,0 +1,180 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cmath>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pandas/util/factorize.h"
+#include "pandas/util/hash-table.h"
+
+namespace pandas {
+
+static std::vector<int64_t> RandomKeys(int64_t length, int64_t cardinality) {
+  std::mt19937_64 rng(7);
+  std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+  std::vector<int64_t> keys(length);
+  for (auto& key : keys) {
+    key = dist(rng) * 7919 - 1000;
+  }
+  return keys;
+}
+
+template <typename T>
+static void CheckSameAsSerial(const std::vector<T>& keys, int num_threads,
+    const uint8_t* skip = nullptr) {
+  const int64_t length = keys.size();
+
+  HashTable<T> table;
+  std::vector<int64_t> expected(length);
+  int64_t count = 0;
+  ASSERT_TRUE(table.GetOrInsert(keys.data(), length, &count, expected.data(), skip, -1));
+
+  std::vector<int64_t> labels(length);
+  std::vector<T> uniques;
+  ASSERT_TRUE(ParallelFactorize(
+      keys.data(), length, num_threads, labels.data(), &uniques, skip, -1));
+  ASSERT_EQ(expected, labels);
+  ASSERT_EQ(count, static_cast<int64_t>(uniques.size()));
+  for (int64_t i = 0; i < length; ++i) {
+    if (labels[i] == -1) { continue; }
+    ASSERT_TRUE(HashTraits<T>::Equal(keys[i], uniques[labels[i]]));
+  }
+}
+
+TEST(FactorizeTests, SameAsSerial) {
+  const int64_t length = kMinParallelFactorizeLength * 2 + 17;
+  for (int64_t cardinality : {1, 1000, 1 << 20}) {
+    const std::vector<int64_t> keys = RandomKeys(length, cardinality);
+    for (int num_threads : {1, 2, 3, 8}) {
+      CheckSameAsSerial(keys, num_threads);
+    }
+  }
+}
+
+TEST(FactorizeTests, ParallelForFailure) {
+  // An allocation failure in a task, on the calling thread or a helper, is
+  // reported instead of terminating
+  for (int64_t failing : {0, 5}) {
+    std::atomic<int64_t> done(0);
+    ASSERT_FALSE(internal::ParallelFor(4, 64, [&](int64_t i) {
+      if (i == failing) { throw std::bad_alloc(); }
+      ++done;
+    }));
+    ASSERT_LT(done.load(), 64);
+  }
+
+  std::atomic<int64_t> done(0);
+  ASSERT_TRUE(internal::ParallelFor(4, 64, [&](int64_t i) { ++done; }));
+  ASSERT_EQ(64, done.load());
+}
+
+TEST(FactorizeTests, Skip) {
+  const int64_t length = kMinParallelFactorizeLength + 3;
+  const std::vector<int64_t> keys = RandomKeys(length, 5000);
+  std::vector<uint8_t> skip(length);
+  for (int64_t i = 0; i < length; ++i) {
+    skip[i] = keys[i] % 3 == 0;
+  }
+  CheckSameAsSerial(keys, 4, skip.data());
+}
+
+TEST(FactorizeTests, FloatingPointKeys) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<int64_t> ints = RandomKeys(kMinParallelFactorizeLength, 100);
+  std::vector<double> keys(ints.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys[i] = ints[i] % 11 == 0 ? nan : ints[i] * 0.5;
+  }
+  keys[1] = 0.0;
+  keys[2] = -0.0;
+  CheckSameAsSerial(keys, 4);
+}
+
+TEST(FactorizeTests, DirectAddressing) {
+  // Keys in a small range are addressed directly, whatever their type
+  const std::vector<int64_t> ints = RandomKeys(100000, 50);
+  std::vector<int8_t> int8_keys(ints.begin(), ints.end());
+  std::vector<uint16_t> uint16_keys(ints.begin(), ints.end());
+  std::vector<int32_t> int32_keys(ints.size());
+  std::vector<uint64_t> uint64_keys(ints.size());
+  std::vector<uint8_t> skip(ints.size());
+  for (size_t i = 0; i < ints.size(); ++i) {
+    int32_keys[i] = static_cast<int32_t>(i / 3) - 7;
+    uint64_keys[i] = std::numeric_limits<uint64_t>::max() - i % 1000;
+    skip[i] = i % 5 == 0;
+  }
+  CheckSameAsSerial(int8_keys, 1);
+  CheckSameAsSerial(uint16_keys, 4, skip.data());
+  CheckSameAsSerial(int32_keys, 1);
+  CheckSameAsSerial(uint64_keys, 1, skip.data());
+  // Skipped keys may be out of the range of the others
+  int32_keys[5] = std::numeric_limits<int32_t>::min();
+  CheckSameAsSerial(int32_keys, 1, skip.data());
+}
+
+template <typename T>
+static void CheckValueCounts(const std::vector<T>& keys, const uint8_t* skip = nullptr) {
+  std::vector<int64_t> labels(keys.size());
+  std::vector<T> expected_uniques;
+  ASSERT_TRUE(ParallelFactorize(
+      keys.data(), keys.size(), 1, labels.data(), &expected_uniques, skip, -1));
+  std::vector<int64_t> expected_counts(expected_uniques.size());
+  for (int64_t label : labels) {
+    if (label >= 0) { ++expected_counts[label]; }
+  }
+
+  std::vector<T> uniques;
+  std::vector<int64_t> counts;
+  ASSERT_TRUE(ValueCounts(keys.data(), keys.size(), &uniques, &counts, skip));
+  ASSERT_EQ(expected_uniques.size(), uniques.size());
+  ASSERT_EQ(uniques.size(), counts.size());
+  // The order may differ from that of first occurrence
+  HashTable<T> table;
+  for (size_t k = 0; k < expected_uniques.size(); ++k) {
+    ASSERT_TRUE(table.Set(expected_uniques[k], k));
+  }
+  for (size_t j = 0; j < uniques.size(); ++j) {
+    int64_t expected;
+    ASSERT_TRUE(table.Find(uniques[j], &expected));
+    ASSERT_EQ(expected_counts[expected], counts[j]);
+  }
+}
+
+TEST(FactorizeTests, ValueCounts) {
+  const std::vector<int64_t> wide = RandomKeys(100000, 3000);
+  std::vector<uint8_t> skip(wide.size());
+  for (size_t i = 0; i < wide.size(); ++i) {
+    skip[i] = i % 3 == 0;
+  }
+  CheckValueCounts(wide);
+  CheckValueCounts(wide, skip.data());
+
+  std::vector<int16_t> narrow(wide.begin(), wide.end());
+  CheckValueCounts(narrow);
+  CheckValueCounts(narrow, skip.data());
+
+  // Counted directly, the keys come out in ascending order
+  const uint8_t small[] = {9, 3, 9, 200, 3, 9};
+  std::vector<uint8_t> uniques;
+  std::vector<int64_t> counts;
+  ASSERT_TRUE(ValueCounts(small, 6, &uniques, &counts));
+  ASSERT_EQ(std::vector<uint8_t>({3, 9, 200}), uniques);
+  ASSERT_EQ(std::vector<int64_t>({2, 3, 1}), counts);
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double doubles[] = {nan, 1.5, -0.0, nan, 0.0};
+  std::vector<double> double_uniques;
+  ASSERT_TRUE(ValueCounts(doubles, 5, &double_uniques, &counts));
+  ASSERT_EQ(3u, double_uniques.size());
+  ASSERT_TRUE(std::isnan(double_uniques[0]));
+  ASSERT_EQ(std::vector<int64_t>({2, 1, 2}), counts);
+}
+
+}  // namespace pandas
@@ -0,0 +1,335 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Factorization and value counts of arrays of keys.
+//
+// Integer keys in a small range are handled by direct addressing (see
+// direct-table.h). Otherwise large arrays can be factorized on several
+// threads: the keys are radix partitioned by the top bits of their hashes, so that
+// equal keys land in the same partition, and the partitions are factorized
+// independently on the worker threads with tables small enough to stay in
+// cache. The labels local to each partition are then renumbered in order of
+// first occurrence in the whole array, which gives the same labels as
+// HashTable::GetOrInsert on an empty table.
+//
+// Like hash-table.h this header does not depend on Arrow. Allocation
+// failures are reported by returning false.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "pandas/util/direct-table.h"
+#include "pandas/util/hash-table.h"
+
+namespace pandas {
+
+namespace internal {
+
+// Runs task(0), ..., task(num_tasks - 1) on up to num_threads threads,
+// including the calling one. If threads cannot be started the remaining
+// tasks run on the threads that could. An exception escaping a task stops
+// the tasks not yet started and makes this return false once every thread
+// has finished
+template <typename TASK>
+bool ParallelFor(int num_threads, int64_t num_tasks, TASK&& task) {
+  std::atomic<int64_t> next_task(0);
+  std::atomic<bool> ok(true);
+  auto worker = [&]() {
+    for (int64_t i = next_task++; i < num_tasks; i = next_task++) {
+      try {
+        task(i);
+      } catch (...) {
+        ok = false;
+        next_task = num_tasks;
+      }
+    }
+  };
+  const int64_t num_helpers = std::min<int64_t>(num_threads, num_tasks) - 1;
+  std::vector<std::thread> threads;
+  // Reserved up front so that nothing but starting a thread can throw while
+  // some are running
+  threads.reserve(std::max<int64_t>(num_helpers, 0));
+  for (int64_t i = 0; i < num_helpers; ++i) {
+    try {
+      threads.emplace_back(worker);
+    } catch (const std::system_error&) { break; }
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return ok;
+}
+
+// Factorizes keys whose offsets from min are below range, with an array of
+// labels indexed by offset. Throws std::bad_alloc
+template <typename T>
+void DirectFactorize(const T* keys, int64_t length, T min, uint64_t range,
+    int64_t* labels, std::vector<T>* uniques, const uint8_t* skip, int64_t skip_value) {
+  std::vector<int64_t> slots(range, -1);
+  uniques->clear();
+  for (int64_t i = 0; i < length; ++i) {
+    if (skip != nullptr && skip[i]) {
+      labels[i] = skip_value;
+      continue;
+    }
+    int64_t& slot = slots[DirectOffset(keys[i], min)];
+    if (slot < 0) {
+      slot = static_cast<int64_t>(uniques->size());
+      uniques->push_back(keys[i]);
+    }
+    labels[i] = slot;
+  }
+}
+
+}  // namespace internal
+
+// Below this many keys ParallelFactorize does not start threads
+constexpr int64_t kMinParallelFactorizeLength = 1 << 20;
+
+// labels[i] is the position of keys[i] in uniques, which holds the distinct
+// keys in order of first occurrence. Keys for which skip (if given) is
+// nonzero are left out and get skip_value instead. Integer keys in a small
+// range are addressed directly, otherwise up to num_threads threads are used
+// if length is at least kMinParallelFactorizeLength
+template <typename T, typename TRAITS = HashTraits<T>>
+bool ParallelFactorize(const T* keys, int64_t length, int num_threads, int64_t* labels,
+    std::vector<T>* uniques, const uint8_t* skip = nullptr, int64_t skip_value = -1) {
+  try {
+    T min = T();
+    uint64_t range = 0;
+    if (DirectRange(keys, length, skip, &min, &range)) {
+      internal::DirectFactorize(keys, length, min, range, labels, uniques, skip, skip_value);
+      return true;
+    }
+
+    if (num_threads <= 1 || length < kMinParallelFactorizeLength) {
+      HashTable<T, TRAITS> table;
+      int64_t count = 0;
+      if (!table.GetOrInsert(keys, length, &count, labels, skip, skip_value)) {
+        return false;
+      }
+      uniques->resize(count);
+      int64_t seen = 0;
+      for (int64_t i = 0; i < length && seen < count; ++i) {
+        if (labels[i] == seen && (skip == nullptr || !skip[i])) {
+          (*uniques)[seen++] = keys[i];
+        }
+      }
+      return true;
+    }
+
+    // Aim for partitions of about 64K keys, whose tables fit in L2 unless
+    // most of the keys are distinct
+    int partition_bits = 6;
+    while (partition_bits < 12 && (length >> (partition_bits + 16)) > 0) {
+      ++partition_bits;
+    }
+    const int64_t num_partitions = int64_t(1) << partition_bits;
+    const int shift = 64 - partition_bits;
+
+    // The passes over the keys in order cut them into one chunk per thread
+    const int64_t num_chunks = num_threads;
+    const int64_t chunk_length = (length + num_chunks - 1) / num_chunks;
+    auto chunk_start = [=](int64_t chunk) { return std::min(chunk * chunk_length, length); };
+
+    // 1. Find the partition of each key and count the keys of each chunk
+    // going to each partition
+    std::unique_ptr<uint16_t[]> partitions(new uint16_t[length]);
+    std::vector<int64_t> counts(num_chunks * num_partitions, 0);
+    internal::ParallelFor(num_threads, num_chunks, [&](int64_t chunk) {
+      int64_t* chunk_counts = counts.data() + chunk * num_partitions;
+      for (int64_t i = chunk_start(chunk); i < chunk_start(chunk + 1); ++i) {
+        if (skip != nullptr && skip[i]) {
+          labels[i] = skip_value;
+          continue;
+        }
+        const uint64_t p = TRAITS::Hash(keys[i]) >> shift;
+        partitions[i] = static_cast<uint16_t>(p);
+        ++chunk_counts[p];
+      }
+    });
+
+    // Each partition is laid out chunk by chunk, so that its keys stay in
+    // their original order. The keys of a chunk in partition p start at
+    // offsets[chunk * num_partitions + p]
+    std::vector<int64_t> offsets(num_chunks * num_partitions);
+    std::vector<int64_t> partition_starts(num_partitions + 1);
+    int64_t total = 0;
+    for (int64_t p = 0; p < num_partitions; ++p) {
+      partition_starts[p] = total;
+      for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+        offsets[chunk * num_partitions + p] = total;
+        total += counts[chunk * num_partitions + p];
+      }
+    }
+    partition_starts[num_partitions] = total;
+
+    // The passes over a chunk keep the position of its next key in each
+    // partition in a cursor. They are allocated here so that the tasks only
+    // copy into them
+    std::vector<std::vector<int64_t>> cursors(
+        num_chunks, std::vector<int64_t>(num_partitions));
+    auto reset_cursor = [&](int64_t chunk) -> std::vector<int64_t>& {
+      std::copy(offsets.begin() + chunk * num_partitions,
+          offsets.begin() + (chunk + 1) * num_partitions, cursors[chunk].begin());
+      return cursors[chunk];
+    };
+
+    // 2. Scatter the keys into the partitions
+    std::unique_ptr<T[]> partitioned_keys(new T[total]);
+    internal::ParallelFor(num_threads, num_chunks, [&](int64_t chunk) {
+      std::vector<int64_t>& cursor = reset_cursor(chunk);
+      for (int64_t i = chunk_start(chunk); i < chunk_start(chunk + 1); ++i) {
+        if (skip != nullptr && skip[i]) { continue; }
+        partitioned_keys[cursor[partitions[i]]++] = keys[i];
+      }
+    });
+
+    // 3. Factorize each partition. The first occurrence of a key gets the
+    // complement ~label of its local label, and firsts counts the first
+    // occurrences of each chunk in each partition
+    std::unique_ptr<int64_t[]> local_labels(new int64_t[total]);
+    std::vector<int64_t> firsts(num_chunks * num_partitions);
+    std::vector<std::vector<int64_t>> global_labels(num_partitions);
+    std::atomic<bool> ok(true);
+    const bool factorized =
+        internal::ParallelFor(num_threads, num_partitions, [&](int64_t p) {
+          const int64_t start = partition_starts[p];
+          const int64_t n = partition_starts[p + 1] - start;
+          int64_t* partition_labels = local_labels.get() + start;
+          HashTable<T, TRAITS> table;
+          int64_t count = 0;
+          if (!table.GetOrInsert(partitioned_keys.get() + start, n, &count,
+                  partition_labels)) {
+            ok = false;
+            return;
+          }
+          // Labels are handed out in order, so a key is new where its label is
+          // the next one
+          int64_t seen = 0;
+          for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+            const int64_t seen_before = seen;
+            const int64_t end = offsets[chunk * num_partitions + p] - start +
+                                counts[chunk * num_partitions + p];
+            for (int64_t j = offsets[chunk * num_partitions + p] - start; j < end; ++j) {
+              if (partition_labels[j] == seen) { partition_labels[j] = ~seen++; }
+            }
+            firsts[chunk * num_partitions + p] = seen - seen_before;
+          }
+          global_labels[p].resize(count);
+        });
+    if (!factorized || !ok) { return false; }
+
+    // 4. The label of a key is the number of distinct keys occurring before
+    // it, so the labels of the first occurrences in a chunk follow those of
+    // the chunks before it
+    std::vector<int64_t> chunk_labels(num_chunks + 1, 0);
+    for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+      chunk_labels[chunk + 1] = chunk_labels[chunk];
+      for (int64_t p = 0; p < num_partitions; ++p) {
+        chunk_labels[chunk + 1] += firsts[chunk * num_partitions + p];
+      }
+    }
+    uniques->resize(chunk_labels[num_chunks]);
+    internal::ParallelFor(num_threads, num_chunks, [&](int64_t chunk) {
+      std::vector<int64_t>& cursor = reset_cursor(chunk);
+      int64_t label = chunk_labels[chunk];
+      // With few distinct keys the first occurrences are all near the start
+      for (int64_t i = chunk_start(chunk); label < chunk_labels[chunk + 1]; ++i) {
+        if (skip != nullptr && skip[i]) { continue; }
+        const int64_t p = partitions[i];
+        const int64_t local = local_labels[cursor[p]++];
+        if (local < 0) {
+          (*uniques)[label] = keys[i];
+          global_labels[p][~local] = label++;
+        }
+      }
+    });
+
+    // 5. Replace the local labels by the global ones, then put them back in
+    // the original order
+    internal::ParallelFor(num_threads, num_partitions, [&](int64_t p) {
+      const std::vector<int64_t>& partition_labels = global_labels[p];
+      for (int64_t j = partition_starts[p]; j < partition_starts[p + 1]; ++j) {
+        const int64_t local = local_labels[j];
+        local_labels[j] = partition_labels[local < 0 ? ~local : local];
+      }
+    });
+    internal::ParallelFor(num_threads, num_chunks, [&](int64_t chunk) {
+      std::vector<int64_t>& cursor = reset_cursor(chunk);
+      for (int64_t i = chunk_start(chunk); i < chunk_start(chunk + 1); ++i) {
+        if (skip != nullptr && skip[i]) { continue; }
+        labels[i] = local_labels[cursor[partitions[i]]++];
+      }
+    });
+    return true;
+  } catch (const std::bad_alloc&) { return false; }
+}
+
+// uniques holds the distinct keys for which skip (if given) is zero and
+// counts[j] the number of occurrences of uniques[j]. Integer keys in a small
+// range are counted in an array indexed by key and come out in ascending
+// order, other keys come out in order of first occurrence
+template <typename T, typename TRAITS = HashTraits<T>>
+bool ValueCounts(const T* keys, int64_t length, std::vector<T>* uniques,
+    std::vector<int64_t>* counts, const uint8_t* skip = nullptr) {
+  try {
+    uniques->clear();
+    counts->clear();
+
+    T min = T();
+    uint64_t range = 0;
+    if (DirectRange(keys, length, skip, &min, &range)) {
+      std::vector<int64_t> tally(range, 0);
+      if (skip == nullptr) {
+        for (int64_t i = 0; i < length; ++i) {
+          ++tally[DirectOffset(keys[i], min)];
+        }
+      } else {
+        for (int64_t i = 0; i < length; ++i) {
+          if (!skip[i]) { ++tally[DirectOffset(keys[i], min)]; }
+        }
+      }
+      for (uint64_t k = 0; k < range; ++k) {
+        if (tally[k] == 0) { continue; }
+        uniques->push_back(static_cast<T>(static_cast<uint64_t>(min) + k));
+        counts->push_back(tally[k]);
+      }
+      return true;
+    }
+
+    // Label the keys a block at a time, so that the labels stay in cache
+    constexpr int64_t kBlockSize = 1024;
+    HashTable<T, TRAITS> table;
+    int64_t labels[kBlockSize];
+    int64_t count = 0;
+    for (int64_t start = 0; start < length; start += kBlockSize) {
+      const int64_t n = std::min(kBlockSize, length - start);
+      if (!table.GetOrInsert(keys + start, n, &count, labels,
+              skip == nullptr ? nullptr : skip + start)) {
+        return false;
+      }
+      for (int64_t k = 0; k < n; ++k) {
+        const int64_t label = labels[k];
+        if (label < 0) { continue; }
+        if (label == static_cast<int64_t>(counts->size())) {
+          uniques->push_back(keys[start + k]);
+          counts->push_back(0);
+        }
+        ++(*counts)[label];
+      }
+    }
+    return true;
+  } catch (const std::bad_alloc&) { return false; }
+}
+
+}  // namespace pandas
@@ -0,0 +1,130 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "pandas/util/factorize.h"
+#include "pandas/util/hash-table.h"
+
+namespace pandas {
+
+constexpr int64_t kLength = 1 << 22;
+
+// kLength keys drawn from range_x() distinct values
+static std::vector<int64_t> MakeKeys(int64_t cardinality) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+  std::vector<int64_t> keys(kLength);
+  for (auto& key : keys) {
+    // Spread the values out so that they are not consecutive integers
+    key = dist(rng) * 2654435761LL;
+  }
+  return keys;
+}
+
+// kLength keys drawn from the range_x() consecutive values from -10, a range
+// small enough to be addressed directly
+template <typename T>
+static std::vector<T> MakeDenseKeys(int64_t cardinality) {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int64_t> dist(-10, cardinality - 11);
+  std::vector<T> keys(kLength);
+  for (auto& key : keys) {
+    key = static_cast<T>(dist(rng));
+  }
+  return keys;
+}
+
+static void BM_Factorize(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<int64_t> keys = MakeKeys(state.range_x());
+  std::vector<int64_t> labels(kLength);
+  while (state.KeepRunning()) {
+    HashTable<int64_t> table;
+    int64_t next_label = 0;
+    table.GetOrInsert(keys.data(), kLength, &next_label, labels.data());
+    benchmark::DoNotOptimize(labels.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+// range_x() distinct keys on range_y() threads
+static void BM_ParallelFactorize(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<int64_t> keys = MakeKeys(state.range_x());
+  std::vector<int64_t> labels(kLength);
+  while (state.KeepRunning()) {
+    std::vector<int64_t> uniques;
+    ParallelFactorize(keys.data(), kLength, static_cast<int>(state.range_y()),
+        labels.data(), &uniques);
+    benchmark::DoNotOptimize(labels.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+template <typename T>
+static void BM_FactorizeDense(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<T> keys = MakeDenseKeys<T>(state.range_x());
+  std::vector<int64_t> labels(kLength);
+  while (state.KeepRunning()) {
+    std::vector<T> uniques;
+    ParallelFactorize(keys.data(), kLength, 1, labels.data(), &uniques);
+    benchmark::DoNotOptimize(labels.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+static void BM_ValueCounts(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<int64_t> keys = MakeKeys(state.range_x());
+  while (state.KeepRunning()) {
+    std::vector<int64_t> uniques;
+    std::vector<int64_t> counts;
+    ValueCounts(keys.data(), kLength, &uniques, &counts);
+    benchmark::DoNotOptimize(counts.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+template <typename T>
+static void BM_ValueCountsDense(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<T> keys = MakeDenseKeys<T>(state.range_x());
+  while (state.KeepRunning()) {
+    std::vector<T> uniques;
+    std::vector<int64_t> counts;
+    ValueCounts(keys.data(), kLength, &uniques, &counts);
+    benchmark::DoNotOptimize(counts.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+static void BM_Lookup(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<int64_t> keys = MakeKeys(state.range_x());
+  std::vector<int64_t> labels(kLength);
+  HashTable<int64_t> table;
+  int64_t next_label = 0;
+  table.GetOrInsert(keys.data(), kLength, &next_label, labels.data());
+  while (state.KeepRunning()) {
+    table.Find(keys.data(), kLength, -1, labels.data());
+    benchmark::DoNotOptimize(labels.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kLength);
+}
+
+BENCHMARK(BM_Factorize)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(BM_ParallelFactorize)
+    ->ArgPair(1 << 10, 1)
+    ->ArgPair(1 << 10, 4)
+    ->ArgPair(1 << 22, 1)
+    ->ArgPair(1 << 22, 4)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_FactorizeDense, int8_t)->Arg(100);
+BENCHMARK_TEMPLATE(BM_FactorizeDense, int32_t)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_FactorizeDense, int64_t)->Arg(1 << 16);
+BENCHMARK(BM_ValueCounts)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ValueCountsDense, uint8_t)->Arg(200);
+BENCHMARK_TEMPLATE(BM_ValueCountsDense, int32_t)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_Lookup)->Arg(1 << 10)->Arg(1 << 22);
+
+}  // namespace pandas
@@ -0,0 +1,153 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "pandas/util/hash-table.h"
+
+namespace pandas {
+
+TEST(HashTableTests, SetAndFind) {
+  HashTable<int64_t> table;
+  int64_t value;
+  ASSERT_FALSE(table.Find(5, &value));
+
+  ASSERT_TRUE(table.Set(5, 50));
+  ASSERT_TRUE(table.Set(-7, 70));
+  ASSERT_EQ(2, table.size());
+  ASSERT_TRUE(table.Find(5, &value));
+  ASSERT_EQ(50, value);
+  ASSERT_TRUE(table.Find(-7, &value));
+  ASSERT_EQ(70, value);
+  ASSERT_FALSE(table.Find(6, &value));
+
+  // Replacing a value keeps the key count
+  ASSERT_TRUE(table.Set(5, 51));
+  ASSERT_EQ(2, table.size());
+  ASSERT_TRUE(table.Find(5, &value));
+  ASSERT_EQ(51, value);
+}
+
+TEST(HashTableTests, Grows) {
+  HashTable<int64_t> table;
+  const int64_t n = 100000;
+  for (int64_t i = 0; i < n; ++i) {
+    ASSERT_TRUE(table.Set(i * 7919, i));
+  }
+  ASSERT_EQ(n, table.size());
+  ASSERT_LE(n, table.capacity() - table.capacity() / 8);
+  for (int64_t i = 0; i < n; ++i) {
+    int64_t value;
+    ASSERT_TRUE(table.Find(i * 7919, &value));
+    ASSERT_EQ(i, value);
+  }
+}
+
+TEST(HashTableTests, Factorize) {
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int64_t> dist(-500, 500);
+  std::vector<int64_t> keys(10000);
+  for (auto& key : keys) {
+    key = dist(rng);
+  }
+
+  HashTable<int64_t> table;
+  std::vector<int64_t> labels(keys.size());
+  int64_t next_label = 0;
+  ASSERT_TRUE(table.GetOrInsert(keys.data(), keys.size(), &next_label, labels.data()));
+
+  // Labels are assigned in order of first occurrence
+  std::unordered_map<int64_t, int64_t> expected;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto it = expected.emplace(keys[i], expected.size()).first;
+    ASSERT_EQ(it->second, labels[i]);
+  }
+  ASSERT_EQ(static_cast<int64_t>(expected.size()), next_label);
+  ASSERT_EQ(next_label, table.size());
+
+  // A second pass finds every key and adds none
+  std::vector<int64_t> found(keys.size());
+  table.Find(keys.data(), keys.size(), -1, found.data());
+  ASSERT_EQ(labels, found);
+  ASSERT_TRUE(table.GetOrInsert(keys.data(), keys.size(), &next_label, found.data()));
+  ASSERT_EQ(labels, found);
+  ASSERT_EQ(static_cast<int64_t>(expected.size()), next_label);
+
+  const int64_t missing[] = {1000, -1000};
+  table.Find(missing, 2, -1, found.data());
+  ASSERT_EQ(-1, found[0]);
+  ASSERT_EQ(-1, found[1]);
+}
+
+TEST(HashTableTests, Skip) {
+  const int64_t keys[] = {3, 4, 3, 5, 4};
+  const uint8_t skip[] = {0, 1, 0, 0, 0};
+  HashTable<int64_t> table;
+  int64_t labels[5];
+  int64_t next_label = 10;
+  ASSERT_TRUE(table.GetOrInsert(keys, 5, &next_label, labels, skip, -1));
+  ASSERT_EQ(10, labels[0]);
+  ASSERT_EQ(-1, labels[1]);
+  ASSERT_EQ(10, labels[2]);
+  ASSERT_EQ(11, labels[3]);
+  ASSERT_EQ(12, labels[4]);
+  ASSERT_EQ(13, next_label);
+}
+
+// Values set directly may collide with the labels handed out later, so only
+// inserted tells the new keys apart
+TEST(HashTableTests, Inserted) {
+  HashTable<int64_t> table;
+  ASSERT_TRUE(table.Set(5, 1));
+  ASSERT_TRUE(table.Set(6, 2));
+
+  const int64_t keys[] = {6, 9, 9, 7};
+  const uint8_t skip[] = {0, 0, 0, 1};
+  int64_t labels[4];
+  uint8_t inserted[4];
+  int64_t next_label = 2;
+  ASSERT_TRUE(table.GetOrInsert(keys, 4, &next_label, labels, skip, -1, inserted));
+  ASSERT_EQ(2, labels[0]);
+  ASSERT_EQ(2, labels[1]);
+  ASSERT_EQ(2, labels[2]);
+  ASSERT_EQ(-1, labels[3]);
+  ASSERT_EQ(0, inserted[0]);
+  ASSERT_EQ(1, inserted[1]);
+  ASSERT_EQ(0, inserted[2]);
+  ASSERT_EQ(0, inserted[3]);
+  ASSERT_EQ(3, next_label);
+}
+
+TEST(HashTableTests, FloatingPointKeys) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double keys[] = {0.0, -0.0, nan, -nan, 1.5, 1.5};
+  HashTable<double> table;
+  int64_t labels[6];
+  int64_t next_label = 0;
+  ASSERT_TRUE(table.GetOrInsert(keys, 6, &next_label, labels));
+  ASSERT_EQ(3, next_label);
+  ASSERT_EQ(labels[0], labels[1]);
+  ASSERT_EQ(labels[2], labels[3]);
+  ASSERT_EQ(labels[4], labels[5]);
+  ASSERT_NE(labels[0], labels[2]);
+}
+
+TEST(HashTableTests, Reserve) {
+  HashTable<int32_t> table;
+  ASSERT_TRUE(table.Reserve(1000));
+  const int64_t capacity = table.capacity();
+  ASSERT_LE(1000, capacity - capacity / 8);
+  for (int32_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(table.Set(i, i));
+  }
+  ASSERT_EQ(capacity, table.capacity());
+}
+
+}  // namespace pandas
@@ -0,0 +1,345 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Open-addressing hash table from fixed-size keys to int64 values, laid out
+// as in Abseil's SwissTable. Next to the slots is an array of control bytes,
+// one per slot, holding either kEmpty or the low 7 bits of the hash of the
+// slot's key. A probe loads a group of 16 control bytes and compares them all
+// at once (with SSE2 where available), so only slots whose 7 hash bits match
+// are read. The table stays at most 7/8 full and keys cannot be removed.
+//
+// The batch operations hash a batch of keys and prefetch their groups before
+// probing for any of them, so that the cache misses of large tables overlap.
+//
+// This header does not depend on Arrow, so that the C extensions can use it
+// without linking libpandas. Allocation failures are reported by returning
+// false.
+
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PANDAS_HASH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "pandas/util/hash-util.h"
+#include "pandas/util/macros.h"
+
+namespace pandas {
+
+namespace internal {
+
+// The control bytes shared by HashTable and BinaryHashTable
+constexpr int64_t kHashGroupSize = 16;
+constexpr int8_t kHashEmpty = -128;
+
+inline int8_t HashControlByte(uint64_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+// Index of the lowest set bit of a nonzero mask
+inline int LowestSetBit(uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;  // NOLINT
+  _BitScanForward(&index, mask);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+inline void Prefetch(const void* address) {
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#elif defined(PANDAS_HASH_SSE2)
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#endif
+}
+
+// A group of kHashGroupSize control bytes. Match returns a mask with bit i set
+// when byte i equals value
+class HashGroup {
+ public:
+#if defined(PANDAS_HASH_SSE2)
+  explicit HashGroup(const int8_t* ctrl)
+      : bytes_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  uint32_t Match(int8_t value) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes_, _mm_set1_epi8(value)));
+  }
+
+ private:
+  __m128i bytes_;
+#else
+  explicit HashGroup(const int8_t* ctrl) : ctrl_(ctrl) {}
+
+  uint32_t Match(int8_t value) const {
+    uint32_t mask = 0;
+    for (int i = 0; i < kHashGroupSize; ++i) {
+      mask |= static_cast<uint32_t>(ctrl_[i] == value) << i;
+    }
+    return mask;
+  }
+
+ private:
+  const int8_t* ctrl_;
+#endif
+};
+
+// The slot i whose control byte matches hash and for which equal(i) holds,
+// setting *found, or if there is none the first empty slot on the probe
+// sequence of hash. Groups are probed in triangular order, which visits every
+// group when there is a power of two of them
+template <typename EQUAL>
+int64_t HashProbe(const int8_t* ctrl, uint64_t group_mask, uint64_t hash,
+    const EQUAL& equal, bool* found) {
+  const int8_t control = HashControlByte(hash);
+  uint64_t group = (hash >> 7) & group_mask;
+  for (uint64_t step = 1;; ++step) {
+    const HashGroup bytes(ctrl + group * kHashGroupSize);
+    uint32_t matches = bytes.Match(control);
+    while (matches != 0) {
+      const int64_t i = group * kHashGroupSize + LowestSetBit(matches);
+      if (equal(i)) {
+        *found = true;
+        return i;
+      }
+      matches &= matches - 1;
+    }
+    const uint32_t empties = bytes.Match(kHashEmpty);
+    if (empties != 0) {
+      *found = false;
+      return group * kHashGroupSize + LowestSetBit(empties);
+    }
+    group = (group + step) & group_mask;
+  }
+}
+
+}  // namespace internal
+
+// Hashing and equality of the keys of a HashTable
+template <typename T, typename Enable = void>
+struct HashTraits;
+
+template <typename T>
+struct HashTraits<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+  static uint64_t Hash(T key) { return HashUtil::Mix64(static_cast<uint64_t>(key)); }
+  static bool Equal(T left, T right) { return left == right; }
+};
+
+// Floating point keys are equal if they are equal as numbers, which makes 0.0
+// and -0.0 one key, or if both are NaN
+template <typename T>
+struct HashTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+  using Bits = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+
+  static uint64_t Hash(T key) {
+    if (key == 0) { key = 0; }
+    if (key != key) { key = std::numeric_limits<T>::quiet_NaN(); }
+    Bits bits;
+    memcpy(&bits, &key, sizeof(T));
+    return HashUtil::Mix64(bits);
+  }
+
+  static bool Equal(T left, T right) {
+    return left == right || (left != left && right != right);
+  }
+};
+
+template <typename T, typename TRAITS = HashTraits<T>>
+class HashTable {
+ public:
+  HashTable()
+      : ctrl_(nullptr), slots_(nullptr), capacity_(0), group_mask_(0), size_(0),
+        max_size_(0) {}
+
+  ~HashTable() {
+    free(ctrl_);
+    free(slots_);
+  }
+
+  // Number of keys
+  int64_t size() const { return size_; }
+
+  // Number of slots
+  int64_t capacity() const { return capacity_; }
+
+  // Makes room for size keys without growing again
+  bool Reserve(int64_t size) {
+    if (size <= max_size_) { return true; }
+    int64_t capacity = std::max<int64_t>(kGroupSize, capacity_ * 2);
+    while (capacity - capacity / 8 < size) {
+      capacity *= 2;
+    }
+    return Rehash(capacity);
+  }
+
+  // Sets *value to the value of key if it is present
+  bool Find(T key, int64_t* value) const {
+    if (size_ == 0) { return false; }
+    bool found;
+    const int64_t i = Probe(key, TRAITS::Hash(key), &found);
+    if (found) { *value = slots_[i].value; }
+    return found;
+  }
+
+  // Sets the value of key, inserting it if needed
+  bool Set(T key, int64_t value) {
+    if (!Reserve(size_ + 1)) { return false; }
+    const uint64_t hash = TRAITS::Hash(key);
+    bool found;
+    const int64_t i = Probe(key, hash, &found);
+    if (found) {
+      slots_[i].value = value;
+    } else {
+      InsertAt(i, key, hash, value);
+    }
+    return true;
+  }
+
+  // values[i] is the value of keys[i], or missing if it is not present
+  void Find(const T* keys, int64_t length, int64_t missing, int64_t* values) const {
+    if (size_ == 0) {
+      std::fill(values, values + length, missing);
+      return;
+    }
+    uint64_t hashes[kBatchSize];
+    for (int64_t start = 0; start < length; start += kBatchSize) {
+      const int64_t n = std::min(kBatchSize, length - start);
+      HashBatch(keys + start, n, hashes);
+      for (int64_t k = 0; k < n; ++k) {
+        bool found;
+        const int64_t i = Probe(keys[start + k], hashes[k], &found);
+        values[start + k] = found ? slots_[i].value : missing;
+      }
+    }
+  }
+
+  // values[i] is the value of keys[i], where keys not yet present are
+  // inserted with the values *next_value, *next_value + 1, ... in order of
+  // first occurrence. This is factorization when the table starts empty and
+  // *next_value at 0. Keys for which skip (if given) is nonzero are not
+  // inserted and get skip_value instead. inserted[i] (if given) is whether
+  // keys[i] was inserted by this call, as opposed to found or skipped
+  bool GetOrInsert(const T* keys, int64_t length, int64_t* next_value, int64_t* values,
+      const uint8_t* skip = nullptr, int64_t skip_value = -1,
+      uint8_t* inserted = nullptr) {
+    uint64_t hashes[kBatchSize];
+    for (int64_t start = 0; start < length; start += kBatchSize) {
+      const int64_t n = std::min(kBatchSize, length - start);
+      // The table must not grow between hashing a batch and probing for it
+      if (!Reserve(size_ + n)) { return false; }
+      HashBatch(keys + start, n, hashes);
+      for (int64_t k = 0; k < n; ++k) {
+        if (skip != nullptr && skip[start + k]) {
+          values[start + k] = skip_value;
+          if (inserted != nullptr) { inserted[start + k] = 0; }
+          continue;
+        }
+        const T key = keys[start + k];
+        bool found;
+        const int64_t i = Probe(key, hashes[k], &found);
+        if (!found) { InsertAt(i, key, hashes[k], (*next_value)++); }
+        values[start + k] = slots_[i].value;
+        if (inserted != nullptr) { inserted[start + k] = !found; }
+      }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr int64_t kGroupSize = internal::kHashGroupSize;
+  static constexpr int64_t kBatchSize = 16;
+  static constexpr int8_t kEmpty = internal::kHashEmpty;
+
+  struct Slot {
+    T key;
+    int64_t value;
+  };
+
+  void HashBatch(const T* keys, int64_t n, uint64_t* hashes) const {
+    for (int64_t k = 0; k < n; ++k) {
+      hashes[k] = TRAITS::Hash(keys[k]);
+      const int64_t group = (hashes[k] >> 7) & group_mask_;
+      internal::Prefetch(ctrl_ + group * kGroupSize);
+      internal::Prefetch(slots_ + group * kGroupSize);
+    }
+  }
+
+  // The slot holding key, or if it is absent the first empty slot on its
+  // probe sequence
+  int64_t Probe(T key, uint64_t hash, bool* found) const {
+    return internal::HashProbe(ctrl_, group_mask_, hash,
+        [this, key](int64_t i) { return TRAITS::Equal(slots_[i].key, key); }, found);
+  }
+
+  void InsertAt(int64_t i, T key, uint64_t hash, int64_t value) {
+    ctrl_[i] = internal::HashControlByte(hash);
+    slots_[i].key = key;
+    slots_[i].value = value;
+    ++size_;
+  }
+
+  bool Rehash(int64_t capacity) {
+    int8_t* ctrl = static_cast<int8_t*>(malloc(capacity));
+    Slot* slots = static_cast<Slot*>(malloc(capacity * sizeof(Slot)));
+    if (ctrl == nullptr || slots == nullptr) {
+      free(ctrl);
+      free(slots);
+      return false;
+    }
+    memset(ctrl, kEmpty, capacity);
+
+    int8_t* old_ctrl = ctrl_;
+    Slot* old_slots = slots_;
+    const int64_t old_capacity = capacity_;
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = capacity;
+    group_mask_ = capacity / kGroupSize - 1;
+    max_size_ = capacity - capacity / 8;
+    size_ = 0;
+
+    // The keys are distinct, so each goes to the first empty slot of its
+    // probe sequence
+    for (int64_t i = 0; i < old_capacity; ++i) {
+      if (old_ctrl[i] == kEmpty) { continue; }
+      const uint64_t hash = TRAITS::Hash(old_slots[i].key);
+      bool found;
+      const int64_t j = Probe(old_slots[i].key, hash, &found);
+      InsertAt(j, old_slots[i].key, hash, old_slots[i].value);
+    }
+    free(old_ctrl);
+    free(old_slots);
+    return true;
+  }
+
+  int8_t* ctrl_;
+  Slot* slots_;
+  int64_t capacity_;
+  uint64_t group_mask_;
+  int64_t size_;
+  int64_t max_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(HashTable);
+};
+
+template <typename T, typename TRAITS>
+constexpr int64_t HashTable<T, TRAITS>::kGroupSize;
+
+template <typename T, typename TRAITS>
+constexpr int64_t HashTable<T, TRAITS>::kBatchSize;
+
+template <typename T, typename TRAITS>
+constexpr int8_t HashTable<T, TRAITS>::kEmpty;
+
+}  // namespace pandas
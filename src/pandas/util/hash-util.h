@@ -0,0 +1,69 @@
+// This file is a part of pandas. See LICENSE for details about reuse and
+// copyright holders
+
+// Fast non-cryptographic hashing of fixed-size values and byte strings, for
+// hash kernels and hash tables. The hashes are not stable across versions and
+// must not be persisted
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace pandas {
+
+namespace HashUtil {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+inline uint64_t RotateLeft(uint64_t x, int bits) {
+  return (x << bits) | (x >> (64 - bits));
+}
+
+// The finalizer of MurmurHash3: every input bit affects every output bit, so
+// the low bits can be used directly as a table index
+inline uint64_t Mix64(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xFF51AFD7ED558CCDULL;
+  x ^= x >> 33;
+  x *= 0xC4CEB9FE1A85EC53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+// Hash of length bytes, consumed 8 at a time. The length is part of the hash,
+// so values that differ only by trailing zero bytes hash differently
+inline uint64_t HashBytes(const uint8_t* data, int64_t length) {
+  uint64_t h = static_cast<uint64_t>(length) * kPrime1;
+  uint64_t word;
+  // Everything is read with fixed-size loads, which unlike a memcpy of
+  // variable size compile to single instructions. The last word of a value of
+  // 8 bytes or more overlaps the one before it instead of being partial. As
+  // the length is already hashed, bytes read twice lose nothing
+  if (length >= 8) {
+    const uint8_t* last = data + length - 8;
+    for (; data < last; data += 8) {
+      memcpy(&word, data, 8);
+      h = RotateLeft(h ^ (word * kPrime2), 31) * kPrime1;
+    }
+    memcpy(&word, last, 8);
+  } else if (length >= 4) {
+    uint32_t low;
+    uint32_t high;
+    memcpy(&low, data, 4);
+    memcpy(&high, data + length - 4, 4);
+    word = static_cast<uint64_t>(low) | (static_cast<uint64_t>(high) << 32);
+  } else if (length > 0) {
+    word = static_cast<uint64_t>(data[0]) | (static_cast<uint64_t>(data[length / 2]) << 8) |
+           (static_cast<uint64_t>(data[length - 1]) << 16);
+  } else {
+    word = 0;
+  }
+  h = RotateLeft(h ^ (word * kPrime2), 31) * kPrime1;
+  return Mix64(h);
+}
+
+}  // namespace HashUtil
+
+}  // namespace pandas